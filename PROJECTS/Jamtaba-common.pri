@@ -32,6 +32,11 @@ macx{
 
 CONFIG += c++11
 
+# 'qmake CONFIG+=count_allocations' replace the allocators (malloc with glibc, operator new in other platforms) to count the allocations in offline render benchmarks
+count_allocations {
+    DEFINES += JT_COUNT_ALLOCATIONS
+}
+
 PRECOMPILED_HEADER += PreCompiledHeaders.h
 
 HEADERS += midi/MidiDriver.h
@@ -42,18 +47,33 @@ HEADERS += audio/core/AudioNode.h
 HEADERS += audio/core/LocalInputNode.h
 HEADERS += audio/core/LocalInputGroup.h
 HEADERS += audio/core/AudioNodeProcessor.h
+HEADERS += audio/core/FixedBlockAdapter.h
+HEADERS += audio/core/RenderStatistics.h
+HEADERS += audio/core/AllocationCounter.h
+HEADERS += audio/core/DelayLine.h
+HEADERS += audio/core/DspLoadMeter.h
+HEADERS += audio/core/SamplesRingBuffer.h
+HEADERS += audio/core/EventsQueue.h
 HEADERS += audio/core/AudioMixer.h
 HEADERS += audio/core/SamplesBuffer.h
+HEADERS += audio/core/Interleaving.h
+HEADERS += audio/core/PcmConversion.h
 HEADERS += audio/core/AudioPeak.h
 HEADERS += audio/core/Plugins.h
 HEADERS += audio/vorbis/VorbisDecoder.h
 HEADERS += audio/vorbis/VorbisEncoder.h
+HEADERS += audio/vorbis/VorbisQualityController.h
 HEADERS += audio/RoomStreamerNode.h
 HEADERS += audio/NinjamTrackNode.h
+HEADERS += audio/LateIntervalTracker.h
+HEADERS += audio/SilenceGate.h
 HEADERS += audio/MetronomeTrackNode.h
 HEADERS += audio/SamplesBufferResampler.h
 HEADERS += audio/SamplesBufferRecorder.h
 HEADERS += audio/codec.h
+HEADERS += audio/Mp3DecoderPool.h
+HEADERS += audio/RoomStreamPreviewer.h
+HEADERS += audio/OfflineAudioDriver.h
 HEADERS += audio/Resampler.h
 HEADERS += audio/file/FileReader.h
 HEADERS += audio/file/FileReaderFactory.h
@@ -83,7 +103,8 @@ HEADERS += gui/NinjamTrackGroupView.h
 HEADERS += gui/NinjamPanel.h
 HEADERS += gui/BusyDialog.h
 HEADERS += gui/chat/ChatPanel.h
-HEADERS += gui/chat/ChatMessagePanel.h
+HEADERS += gui/chat/ChatMessagesModel.h
+HEADERS += gui/chat/ChatMessageDelegate.h
 HEADERS += gui/chat/NinjamVotingMessageParser.h
 HEADERS += gui/Highligther.h
 HEADERS += gui/TrackGroupView.h
@@ -117,14 +138,17 @@ HEADERS += gui/ThemeLoader.h
 HEADERS += ninjam/UserChannel.h
 HEADERS += geo/IpToLocationResolver.h
 HEADERS += geo/WebIpToLocationResolver.h
+HEADERS += geo/IpRangeIndex.h
 HEADERS += Utils.h
 HEADERS += Configurator.h
 HEADERS += persistence/Settings.h
 HEADERS += persistence/UsersDataCache.h
 HEADERS += persistence/CacheHeader.h
 HEADERS += log/Logging.h
+HEADERS += log/AsyncLogWriter.h
 HEADERS += UploadIntervalData.h
-#HEADERS +=performance/PerformanceMonitor.h
+HEADERS += performance/PerformanceMonitor.h
+HEADERS += performance/Profiler.h
 
 SOURCES += MainController.cpp
 SOURCES += NinjamController.cpp
@@ -137,18 +161,33 @@ SOURCES += audio/core/AudioNode.cpp
 SOURCES += audio/core/LocalInputNode.cpp
 SOURCES += audio/core/LocalInputGroup.cpp
 SOURCES += audio/core/AudioNodeProcessor.cpp
+SOURCES += audio/core/FixedBlockAdapter.cpp
+SOURCES += audio/core/RenderStatistics.cpp
+SOURCES += audio/core/AllocationCounter.cpp
+SOURCES += audio/core/DelayLine.cpp
+SOURCES += audio/core/DspLoadMeter.cpp
+SOURCES += audio/core/SamplesRingBuffer.cpp
 SOURCES += audio/core/AudioMixer.cpp
 SOURCES += audio/RoomStreamerNode.cpp
 SOURCES += audio/core/Plugins.cpp
 SOURCES += audio/codec.cpp
+SOURCES += audio/Mp3DecoderPool.cpp
+SOURCES += audio/RoomStreamPreviewer.cpp
+SOURCES += audio/OfflineAudioDriver.cpp
 SOURCES += audio/NinjamTrackNode.cpp
+SOURCES += audio/LateIntervalTracker.cpp
+SOURCES += audio/SilenceGate.cpp
 SOURCES += audio/MetronomeTrackNode.cpp
 SOURCES += audio/core/SamplesBuffer.cpp
+SOURCES += audio/core/Interleaving.cpp
+SOURCES += audio/core/PcmConversion.cpp
 SOURCES += audio/SamplesBufferResampler.cpp
 SOURCES += audio/vorbis/VorbisDecoder.cpp
 SOURCES += audio/vorbis/VorbisEncoder.cpp
+SOURCES += audio/vorbis/VorbisQualityController.cpp
 SOURCES += audio/core/AudioPeak.cpp
 SOURCES += audio/Resampler.cpp
+SOURCES += audio/file/FileReader.cpp
 SOURCES += audio/file/FileReaderFactory.cpp
 SOURCES += audio/file/WaveFileReader.cpp
 SOURCES += audio/file/OggFileReader.cpp
@@ -177,7 +216,8 @@ SOURCES += gui/NinjamTrackGroupView.cpp
 SOURCES += gui/NinjamPanel.cpp
 SOURCES += gui/BusyDialog.cpp
 SOURCES += gui/chat/ChatPanel.cpp
-SOURCES += gui/chat/ChatMessagePanel.cpp
+SOURCES += gui/chat/ChatMessagesModel.cpp
+SOURCES += gui/chat/ChatMessageDelegate.cpp
 SOURCES += gui/chat/NinjamVotingMessageParser.cpp
 SOURCES += gui/Highligther.cpp
 SOURCES += gui/TrackGroupView.cpp
@@ -208,7 +248,10 @@ SOURCES += gui/GuiUtils.cpp
 SOURCES += gui/ThemeLoader.cpp
 SOURCES += geo/IpToLocationResolver.cpp
 SOURCES += log/logging.cpp
+SOURCES += log/AsyncLogWriter.cpp
+SOURCES += performance/Profiler.cpp
 SOURCES += geo/WebIpToLocationResolver.cpp
+SOURCES += geo/IpRangeIndex.cpp
 SOURCES += loginserver/LoginService.cpp
 SOURCES += Configurator.cpp
 SOURCES += persistence/UsersDataCache.cpp
@@ -217,8 +260,13 @@ SOURCES += persistence/CacheHeader.cpp
 SOURCES += UploadIntervalData.cpp
 
 #multiplatform implementations
-#win32:SOURCES += $$PWD/src/performance/WindowsPerformanceMonitor.cpp
-#macx:SOURCES += $$PWD/src/performance/MacPerformanceMonitor.cpp
+win32{
+    SOURCES += performance/WindowsPerformanceMonitor.cpp
+    LIBS += -lPsapi
+    DEFINES += PSAPI_VERSION=1
+}
+macx:SOURCES += performance/MacPerformanceMonitor.cpp
+linux:SOURCES += performance/LinuxPerformanceMonitor.cpp
 
 FORMS += gui/PreferencesDialog.ui
 FORMS += gui/PluginScanDialog.ui
@@ -226,7 +274,6 @@ FORMS += gui/NinjamRoomWindow.ui
 FORMS += gui/NinjamPanel.ui
 FORMS += gui/BusyDialog.ui
 FORMS += gui/chat/ChatPanel.ui
-FORMS += gui/chat/ChatMessagePanel.ui
 FORMS += gui/JamRoomViewPanel.ui
 FORMS += gui/PrivateServerDialog.ui
 FORMS += gui/UserNameDialog.ui
@@ -42,6 +42,7 @@ HEADERS += vst/VstPlugin.h
 HEADERS += vst/VstHost.h
 HEADERS += vst/VstLoader.h
 HEADERS += vst/PluginFinder.h
+HEADERS += vst/PluginFolderIndex.h
 HEADERS += Libs/SingleApplication/singleapplication.h
 HEADERS += audio/core/PluginDescriptor.h
 
@@ -60,6 +61,7 @@ SOURCES += midi/RtMidiDriver.cpp
 SOURCES += vst/VstPlugin.cpp
 SOURCES += vst/VstHost.cpp
 SOURCES += vst/PluginFinder.cpp
+SOURCES += vst/PluginFolderIndex.cpp
 SOURCES += vst/VstLoader.cpp
 SOURCES += Libs/SingleApplication/singleapplication.cpp
 SOURCES += audio/PortAudioDriver.cpp
@@ -116,9 +118,7 @@ win32{
        LIBS += -L$$PWD/../../libs/$$LIBS_PATH -lportaudio -lminimp3 -lrtmidi -lvorbisfile -lvorbisenc -lvorbis -logg
     }
 
-    LIBS +=  -lwinmm -lole32 -lws2_32 -lAdvapi32 -lUser32 #-lPsapi
-    #performance monitor lib
-    #QMAKE_CXXFLAGS += -DPSAPI_VERSION=1
+    LIBS +=  -lwinmm -lole32 -lws2_32 -lAdvapi32 -lUser32
 
     RC_FILE = ../Jamtaba2.rc #windows icon
 }
@@ -69,9 +69,7 @@ SOURCES += $$VST_SDK_PATH/public.sdk/source/vst2.x/audioeffect.cpp
 win32 {
     message("Windows VST build")
 
-    LIBS +=  -lwinmm -lole32 -lws2_32 -lAdvapi32 -lUser32 #-lPsapi
-    #performance monitor lib
-    #QMAKE_CXXFLAGS += -DPSAPI_VERSION=1
+    LIBS +=  -lwinmm -lole32 -lws2_32 -lAdvapi32 -lUser32
 
     !contains(QMAKE_TARGET.arch, x86_64) {
         message("x86 build") ## Windows x86 (32bit) specific build here
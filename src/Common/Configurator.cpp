@@ -4,6 +4,7 @@
 #include <QApplication>
 
 #include "log/Logging.h"
+#include "log/AsyncLogWriter.h"
 
 QScopedPointer<Configurator> Configurator::instance(nullptr);
 
@@ -13,64 +14,20 @@ const QString Configurator::LOG_CONFIG_FILE_NAME = "logging.ini";
 
 void Configurator::LogHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
-    QByteArray localMsg = msg.toLocal8Bit();
-    QString stringMsg;
-    QString fullFileName(context.file);
-    QString file;
-    int lastPathSeparatorIndex = fullFileName.lastIndexOf(QDir::separator());
-    if (lastPathSeparatorIndex)
-        file = fullFileName.right(fullFileName.size() - lastPathSeparatorIndex - 1);
-    else
-        file = fullFileName;
-
-    QTextStream stream(&stringMsg);
-    switch (type) {
-    case QtDebugMsg:
-        stream << context.category << ".DEBUG:  " << localMsg.constData() << " "  << " in "
-               << file << " " << context.line << endl;
-        break;
-    case QtWarningMsg:
-        stream << context.category << ".WARNING:  " << localMsg.constData() <<  context.function
-               <<  " " << file << context.line << endl << endl;
-        break;
-    case QtCriticalMsg:
-        stream << context.category << ".CRITICAL:  " << localMsg.constData() <<  context.function
-               << " " << file << context.line << endl << endl;
-        break;
-    case QtFatalMsg:
-        stream << context.category  << ".FATAL:  " << localMsg.constData() << context.function
-               << file << context.line << endl << endl;
-        break;
-    default:
-        stream << context.category << ".INFO:  " << localMsg.constData() <<endl;
-    }
-
-    QTextStream(stdout) << stringMsg;
-
-    Configurator *configurator = Configurator::getInstance();
-    QDir logDir = configurator->getBaseDir();
-    QString path = logDir.absoluteFilePath("log.txt");
-
-    QFile outFile(path);
-    QIODevice::OpenMode ioFlags = QIODevice::WriteOnly;
-    if (configurator->logFileIsCreated()) {
-        ioFlags |= QIODevice::Append;
-    } else {
-        ioFlags |= QIODevice::Truncate;
-        configurator->setFileCreatedFlag();
-    }
-    if (outFile.open(ioFlags)) {
-        QTextStream ts(&outFile);
-        ts << stringMsg;
-    }
-
-    if (type == QtFatalMsg)
+    // the messages are formatted and written in the log writer thread, the audio thread is never blocked by the log
+    AsyncLogWriter *logWriter = Configurator::getInstance()->logWriter.data();
+    if (logWriter)
+        logWriter->log(type, context, msg);
+
+    if (type == QtFatalMsg) {
+        if (logWriter)
+            logWriter->flush();
         abort();
+    }
 }
 
 Configurator::Configurator() :
-    logConfigFileName(LOG_CONFIG_FILE_NAME),
-    logFileCreated(false)
+    logConfigFileName(LOG_CONFIG_FILE_NAME)
 {
 
 }
@@ -120,6 +77,10 @@ void Configurator::setupLogConfigFile()
     QString logConfigFilePath = baseDir.absoluteFilePath(logConfigFileName);
     if (!logConfigFilePath.isEmpty()) {
         qputenv("QT_LOGGING_CONF", QByteArray(logConfigFilePath.toUtf8()));
+        if (!logWriter) {
+            logWriter.reset(new AsyncLogWriter(baseDir.absoluteFilePath("log.txt")));
+            logWriter->start(QThread::LowPriority);
+        }
         qInstallMessageHandler(&Configurator::LogHandler);
     }
 }
@@ -207,6 +168,10 @@ void Configurator::deletePreset(const QString &name)
 
 Configurator::~Configurator()
 {
+    if (logWriter) {
+        qInstallMessageHandler(nullptr);
+        logWriter->stop(); // write the pending messages
+    }
 }
 
 // -------------------------------------------------------------------------------
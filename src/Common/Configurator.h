@@ -5,6 +5,8 @@
 #include <QDir>
 #include <QScopedPointer>
 
+class AsyncLogWriter;
+
 // ! Configurator class for Jamtaba !
 // ! Easy to use , it is intended to create the folders tree in the user local folder.
 // ! It will create on folder for the plugin version , where the log file and the config
@@ -17,9 +19,6 @@ public:
 
     ~Configurator();
 
-    bool logFileIsCreated() const;
-    void setFileCreatedFlag();
-
     bool setUp();
 
     bool folderTreeExists() const; // check if Jamtaba 2 folder exists in application data
@@ -44,7 +43,7 @@ private:
     QDir presetsDir;
     QDir baseDir;
 
-    bool logFileCreated;
+    QScopedPointer<AsyncLogWriter> logWriter;
 
     static QScopedPointer<Configurator> instance;// using a QScopedPointer to auto delete the singleton instance and avoid leak
 
@@ -59,16 +58,6 @@ private:
 };
 
 
-inline bool Configurator::logFileIsCreated() const
-{
-    return logFileCreated;
-}
-
-inline void Configurator::setFileCreatedFlag()
-{
-    logFileCreated = true;
-}
-
 inline QDir Configurator::getCacheDir() const {
     return cacheDir;
 }
@@ -10,6 +10,7 @@
 #include "log/Logging.h"
 #include "audio/core/AudioNode.h"
 #include "audio/core/LocalInputNode.h"
+#include "performance/Profiler.h"
 #include "ThemeLoader.h"
 
 using namespace Persistence;
@@ -100,6 +101,7 @@ void MainController::disconnectFromNinjamServer(const Server &server)
 void MainController::setupNinjamControllerSignals(){
     Q_ASSERT(ninjamController.data());
     connect(ninjamController.data(), SIGNAL(encodedAudioAvailableToSend(const QByteArray &, quint8, bool, bool)), this, SLOT(enqueueAudioDataToUpload(const QByteArray &, quint8, bool, bool)));
+    connect(ninjamController.data(), SIGNAL(silentIntervalAvailableToSend(quint8)), this, SLOT(sendSilentIntervalToUpload(quint8)));
     connect(ninjamController.data(), SIGNAL(startingNewInterval()), this, SLOT(on_newNinjamInterval()));
     connect(ninjamController.data(), SIGNAL(currentBpiChanged(int)), this, SLOT(updateBpi(int)));
     connect(ninjamController.data(), SIGNAL(currentBpmChanged(int)), this, SLOT(updateBpm(int)));
@@ -190,6 +192,14 @@ void MainController::enqueueAudioDataToUpload(const QByteArray &encodedAudio, qu
             jamRecorder->appendLocalUserAudio(encodedAudio, channelIndex, isFirstPart, isLastPart);
 }
 
+void MainController::sendSilentIntervalToUpload(quint8 channelIndex)
+{
+    // nothing was encoded in this interval, an empty interval is sent and the receivers are playing silence
+    if (intervalsToUpload.contains(channelIndex))
+        delete intervalsToUpload.take(channelIndex);
+    ninjamService.sendSilentAudioInterval(channelIndex);
+}
+
 // ++++++++++++++++++++
 int MainController::getMaxChannelsForEncodingInTrackGroup(uint trackGroupIndex) const
 {
@@ -224,6 +234,11 @@ Geo::Location MainController::getGeoLocation(const QString &ip)
     return ipToLocationResolver->resolve(ip, getTranslationLanguage());
 }
 
+QList<Geo::Location> MainController::getGeoLocations(const QStringList &ips)
+{
+    return ipToLocationResolver->resolveAll(ips, getTranslationLanguage());
+}
+
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++
 void MainController::mixGroupedInputs(int groupIndex, Audio::SamplesBuffer &out)
 {
@@ -231,6 +246,20 @@ void MainController::mixGroupedInputs(int groupIndex, Audio::SamplesBuffer &out)
         trackGroups[groupIndex]->mixGroupedInputs(out);
 }
 
+int MainController::getInputTrackGroupLatency(int groupIndex) const
+{
+    if (trackGroups.contains(groupIndex))
+        return trackGroups[groupIndex]->getLatency();
+    return 0;
+}
+
+void MainController::updateInputTrackGroupsLatency()
+{
+    QMutexLocker locker(&mutex); // the delay lines are resized while the audio thread is not processing
+    foreach (Audio::LocalInputGroup *inputGroup, trackGroups)
+        inputGroup->updateDelayLines();
+}
+
 // ++++++++++++++++++++++++
 // this is called when a new ninjam interval is received and the 'record multi track' option is enabled
 void MainController::saveEncodedAudio(const QString &userName, quint8 channelIndex,
@@ -386,6 +415,14 @@ void MainController::storeIOSettings(int firstIn, int lastIn, int firstOut, int
 
 // +++++++++++++++++
 
+void MainController::setTrackOutputBus(long trackID, int bus)
+{
+    QMutexLocker locker(&mutex);
+    Audio::AudioNode *trackNode = tracksNodes.value(trackID);
+    if (trackNode)
+        audioMixer.setOutputBus(trackNode, bus);
+}
+
 void MainController::removeTrack(long trackID)
 {
     QMutexLocker locker(&mutex);
@@ -405,13 +442,17 @@ void MainController::doAudioProcess(const Audio::SamplesBuffer &in, Audio::Sampl
 {
     audioMixer.process(in, out, sampleRate, pullMidiMessagesFromDevices());
 
-    out.applyGain(masterGain, 1.0f);// using 1 as boost factor/multiplier (no boost)
-    masterPeak.update(out.computePeak());
+    // the tracks routed to other output buses (multi output VST plugin) are not affected by the master fader
+    Audio::SamplesBuffer &masterBus = audioMixer.getOutputBus(out, Audio::AudioMixer::MASTER_BUS);
+    masterBus.applyGain(masterGain, 1.0f);// using 1 as boost factor/multiplier (no boost)
+    masterPeak.update(masterBus.computePeak());
 }
 
 void MainController::process(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &out,
                              int sampleRate)
 {
+    JT_PROFILE_SCOPE("MainController::process");
+
     QMutexLocker locker(&mutex);
     if (!started)
         return;
@@ -650,12 +691,43 @@ bool MainController::isPlayingRoomStream() const
     return roomStreamer->isStreaming();
 }
 
+void MainController::previewRoomStreams(const QList<Login::RoomInfo> &rooms)
+{
+    if (!roomStreamPreviewer)
+        return;
+
+    QStringList streamsToPreview;
+    foreach (const Login::RoomInfo &roomInfo, rooms) {
+        if (streamsToPreview.size() >= roomStreamPreviewer->getMaxPreviews())
+            break;
+        if (roomInfo.hasStream() && !roomInfo.isEmpty())
+            streamsToPreview.append(roomInfo.getStreamUrl());
+    }
+
+    // the played stream is never stopped here
+    foreach (const QString &streamUrl, roomStreamPreviewer->getPreviewedStreams()) {
+        if (!streamsToPreview.contains(streamUrl) && !roomStreamPreviewer->getStream(streamUrl)->isAudible())
+            roomStreamPreviewer->stopPreview(streamUrl);
+    }
+
+    foreach (const QString &streamUrl, streamsToPreview)
+        roomStreamPreviewer->startPreview(streamUrl);
+}
+
+void MainController::stopRoomStreamPreviews()
+{
+    if (roomStreamPreviewer)
+        roomStreamPreviewer->stopAllPreviews();
+}
+
 void MainController::enterInRoom(const Login::RoomInfo &room, const QStringList &channelsNames, const QString &password)
 {
     qCDebug(jtCore) << "EnterInRoom slot";
     if (isPlayingRoomStream())
         stopRoomStream();
 
+    stopRoomStreamPreviews(); // all bandwidth is used in the ninjam room
+
     if (room.getType() == Login::RoomTYPE::NINJAM)
         tryConnectInNinjamServer(room, channelsNames, password);
 }
@@ -697,7 +769,8 @@ void MainController::start()
             setTheme(settings.getTheme());
 
         qCInfo(jtCore) << "Creating roomStreamer ...";
-        roomStreamer.reset(new Audio::NinjamRoomStreamerNode()); // new Audio::AudioFileStreamerNode(":/teste.mp3");
+        roomStreamPreviewer.reset(new Audio::RoomStreamPreviewer());
+        roomStreamer.reset(new Audio::NinjamRoomStreamerNode(roomStreamPreviewer.data())); // new Audio::AudioFileStreamerNode(":/teste.mp3");
         this->audioMixer.addNode(roomStreamer.data());
 
         QObject::connect(&ninjamService, SIGNAL(connectedInServer(const Ninjam::Server &)), this,
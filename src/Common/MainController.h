@@ -12,6 +12,7 @@
 #include "audio/core/AudioNode.h"
 #include "audio/core/AudioMixer.h"
 #include "audio/RoomStreamerNode.h"
+#include "audio/RoomStreamPreviewer.h"
 #include "midi/MidiDriver.h"
 #include "UploadIntervalData.h"
 #include "audio/core/LocalInputGroup.h"
@@ -68,10 +69,16 @@ public:
 
     bool addTrack(long trackID, Audio::AudioNode *trackNode);
     void removeTrack(long trackID);
+    void setTrackOutputBus(long trackID, int bus); // see AudioMixer::setOutputBus()
 
     void playRoomStream(const Login::RoomInfo &roomInfo);
     bool isPlayingRoomStream() const;
 
+    // keep the first rooms streams pre-buffered, so switching the played room stream is instantaneous. The rooms
+    // are the visible rooms in the lobby, the previews of other rooms (except the played stream) are stopped
+    void previewRoomStreams(const QList<Login::RoomInfo> &rooms);
+    void stopRoomStreamPreviews();
+
     bool isPlayingInNinjamRoom() const;
     virtual void stopNinjamController();
 
@@ -136,6 +143,11 @@ public:
 
     Audio::AudioPeak getRoomStreamPeak();
     Audio::AudioPeak getTrackPeak(int trackID);
+
+    inline virtual float getDspLoad() const // the audio callback execution time divided by the buffer period
+    {
+        return 0;
+    }
     inline Audio::AudioPeak getMasterPeak()
     {
         return masterPeak;
@@ -156,6 +168,7 @@ public:
     }
 
     Geo::Location getGeoLocation(const QString &ip);
+    QList<Geo::Location> getGeoLocations(const QStringList &ips);
 
     Audio::LocalInputNode *getInputTrack(int localInputIndex);
     virtual int addInputTrackNode(Audio::LocalInputNode *inputTrackNode);
@@ -173,6 +186,9 @@ public:
 
     void mixGroupedInputs(int groupIndex, Audio::SamplesBuffer &out);
 
+    int getInputTrackGroupLatency(int groupIndex) const; // plugins latency (in samples) compensated in the grouped inputs mix
+    void updateInputTrackGroupsLatency(); // called when plugins are added, removed, bypassed or the plugins block size change
+
     virtual int getSampleRate() const = 0;
 
     static QByteArray newGUID();
@@ -308,6 +324,7 @@ private:
     // audio process is here too (see MainController::process)
     void doAudioProcess(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &out, int sampleRate);
 
+    QScopedPointer<Audio::RoomStreamPreviewer> roomStreamPreviewer; // declared before roomStreamer, the previewer is deleted after the streamer
     QScopedPointer<Audio::AbstractMp3Streamer> roomStreamer;
     long long currentStreamingRoomID;
 
@@ -353,6 +370,7 @@ protected slots:
     virtual void quitFromNinjamServer(const QString &error);
     virtual void enqueueAudioDataToUpload(const QByteArray &, quint8 channelIndex,
                                           bool isFirstPart, bool isLastPart);
+    virtual void sendSilentIntervalToUpload(quint8 channelIndex);
     virtual void updateBpi(int newBpi);
     virtual void updateBpm(int newBpm);
 
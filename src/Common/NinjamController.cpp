@@ -27,6 +27,7 @@
 #include "audio/SamplesBufferRecorder.h"
 #include "Utils.h"
 #include <QWaitCondition>
+#include <QElapsedTimer>
 #include "log/Logging.h"
 
 using namespace Controller;
@@ -35,7 +36,7 @@ using namespace Controller;
 class NinjamController::EncodingThread : public QThread{//TODO: use better thread approach, avoid inheritance form QThread
 public:
     EncodingThread(NinjamController* controller)
-        :stopRequested(false), controller(controller){
+        :stopRequested(false), controller(controller), totalEncodedBytes(0){
         qCDebug(jtNinjamCore) << "Starting Encoding Thread";
         start();
     }
@@ -44,15 +45,32 @@ public:
         stop();
     }
 
-    void addSamplesToEncode(const Audio::SamplesBuffer& samplesToEncode, quint8 channelIndex, bool isFirstPart, bool isLastPart){
+    //'leadingSilence' zeroed frames are encoded before the samples, the silence is not buffered in the audio thread
+    void addSamplesToEncode(const Audio::SamplesBuffer& samplesToEncode, quint8 channelIndex, bool isFirstPart, bool isLastPart, long leadingSilence = 0){
         //qCDebug(jtNinjamCore) << "Adding samples to encode";
         QMutexLocker locker(&mutex);
-        chunksToEncode.append(new EncodingChunk(samplesToEncode, channelIndex, isFirstPart, isLastPart));
+        chunksToEncode.append(new EncodingChunk(samplesToEncode, channelIndex, isFirstPart, isLastPart, leadingSilence));
         //this method is called by Qt main thread (the producer thread).
         hasAvailableChunksToEncode.wakeAll();//wakeup the encoding thread (consumer thread)
 
     }
 
+    //the whole interval is silent, nothing is encoded. The chunk is queued to keep the intervals order.
+    void addSilentInterval(quint8 channelIndex){
+        QMutexLocker locker(&mutex);
+        chunksToEncode.append(new EncodingChunk(Audio::SamplesBuffer(1, 0), channelIndex, true, true, 0, true));
+        hasAvailableChunksToEncode.wakeAll();
+    }
+
+    //the encoding time (nanoseconds) used by each channel group and the encoded bytes since the last call
+    void takeStatistics(QMap<quint8, qint64> &encodingTimes, qint64 &encodedBytes){
+        QMutexLocker locker(&mutex);
+        encodingTimes = this->encodingTimes;
+        encodedBytes = totalEncodedBytes;
+        this->encodingTimes.clear();
+        totalEncodedBytes = 0;
+    }
+
     void stop(){
         if(!stopRequested){
             //QMutexLocker locker(&mutex);
@@ -76,27 +94,59 @@ protected:
             EncodingChunk* chunk = chunksToEncode.first();
             chunksToEncode.removeFirst();
             mutex.unlock();
-            if (chunk){
-                QByteArray encodedBytes( controller->encode(chunk->buffer, chunk->channelIndex));
+            if (chunk && chunk->silentInterval){
+                emit controller->silentIntervalAvailableToSend(chunk->channelIndex);
+                delete chunk;
+            }
+            else if (chunk){
+                QElapsedTimer encodingTimer;
+                encodingTimer.start();
+                QByteArray encodedBytes;
+                if (chunk->leadingSilence > 0)
+                    encodedBytes.append(encodeSilence(chunk->buffer.getChannels(), chunk->leadingSilence, chunk->channelIndex));
+                encodedBytes.append( controller->encode(chunk->buffer, chunk->channelIndex));
                 if (chunk->lastPart){
                     encodedBytes.append( controller->encodeLastPartOfInterval(chunk->channelIndex));
                 }
 
+                mutex.lock();
+                encodingTimes[chunk->channelIndex] += encodingTimer.nsecsElapsed();
+                totalEncodedBytes += encodedBytes.size();
+                mutex.unlock();
+
                 if(!encodedBytes.isEmpty()){
                     emit controller->encodedAudioAvailableToSend(encodedBytes, chunk->channelIndex, chunk->firstPart, chunk->lastPart);
                 }
                 delete chunk;
             }
 
+            mutex.lock();
+            bool idle = chunksToEncode.isEmpty();
+            mutex.unlock();
+            if (idle && !stopRequested){
+                controller->prepareEncodersForNextInterval();
+            }
         }
         qCDebug(jtNinjamCore) << "Encoding thread stopped!";
     }
 
 private:
+    QByteArray encodeSilence(int channels, long frames, quint8 channelIndex){
+        Audio::SamplesBuffer silence(channels, qMin(frames, (long)SILENCE_BLOCK_FRAMES));
+        silence.zero();
+        QByteArray encodedBytes;
+        while (frames > 0) {
+            silence.setFrameLenght(qMin(frames, (long)SILENCE_BLOCK_FRAMES));
+            encodedBytes.append(controller->encode(silence, channelIndex));
+            frames -= silence.getFrameLenght();
+        }
+        return encodedBytes;
+    }
+
     class EncodingChunk{
     public:
-        EncodingChunk(const Audio::SamplesBuffer& buffer, quint8 channelIndex, bool firstPart, bool lastPart)
-            :buffer(buffer), channelIndex(channelIndex), firstPart(firstPart), lastPart(lastPart ) {
+        EncodingChunk(const Audio::SamplesBuffer& buffer, quint8 channelIndex, bool firstPart, bool lastPart, long leadingSilence, bool silentInterval = false)
+            :buffer(buffer), channelIndex(channelIndex), firstPart(firstPart), lastPart(lastPart ), leadingSilence(leadingSilence), silentInterval(silentInterval) {
 
         }
 
@@ -104,24 +154,33 @@ private:
         quint8 channelIndex;
         bool firstPart;
         bool lastPart;
+        long leadingSilence;
+        bool silentInterval;
     };
 
+    static const long SILENCE_BLOCK_FRAMES = 4096;
+
     QList<EncodingChunk*> chunksToEncode;
     QMutex mutex;
     volatile bool stopRequested;
     NinjamController* controller;
     QWaitCondition hasAvailableChunksToEncode;
 
+    QMap<quint8, qint64> encodingTimes;
+    qint64 totalEncodedBytes;
+
 };
 
 //+++++++++++++++++ Nested classes to handle schedulable events ++++++++++++++++
 
+//the events are created and deleted in the main thread, the audio thread is only calling process()
 class NinjamController::SchedulableEvent{//an event scheduled to be processed in next interval
 public:
     SchedulableEvent(NinjamController* controller)
-        :controller(controller){}
+        :nextInQueue(nullptr), controller(controller){}
     virtual void process() = 0;
     virtual ~SchedulableEvent(){}
+    SchedulableEvent* nextInQueue;//used by EventsQueue
 protected:
     NinjamController* controller;
 };
@@ -135,6 +194,9 @@ public:
     void process(){
         controller->currentBpi = newBpi;
         controller->samplesInInterval = controller->computeTotalSamplesInInterval();
+        controller->metronomeTrackNode->setBeatsPerInterval(newBpi);
+        if (controller->currentBpm > 0) // bpm is unknown in the first bpi change
+            controller->metronomeTrackNode->setSamplesPerBeat(controller->getSamplesPerBeat());
         emit controller->currentBpiChanged(controller->currentBpi);
     }
 private:
@@ -156,13 +218,21 @@ private:
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 class NinjamController::InputChannelChangedEvent : public SchedulableEvent{
     public:
+        //the new encoder is created here, not in the audio thread
         InputChannelChangedEvent(NinjamController* controller, int channelIndex)
-            :SchedulableEvent(controller), channelIndex(channelIndex){}
+            :SchedulableEvent(controller), channelIndex(channelIndex), encoder(controller->createEncoderForChannel(channelIndex)){}
+        ~InputChannelChangedEvent(){
+            delete encoder;//the replaced encoder, or the new encoder if the event was not processed or the current encoder was kept
+        }
         void process(){
-            controller->recreateEncoderForChannel(channelIndex);
+            //the sample rate can be changed after this event is scheduled, in this case the encoders were recreated
+            if(encoder && encoder->getSampleRate() == controller->mainController->getSampleRate()){
+                encoder = controller->swapEncoder(channelIndex, encoder);
+            }
         }
     private:
         int channelIndex;
+        VorbisEncoder* encoder;
 };
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
@@ -178,12 +248,19 @@ NinjamController::NinjamController(Controller::MainController* mainController)
     currentBpm(0),
     mutex(QMutex::Recursive),
     encodersMutex(QMutex::Recursive),
+    inputMixBuffer(2),
+    intervalLastPart(2),
+    intervalFirstPart(2),
     encodingThread(nullptr),
     preparedForTransmit(false),
     waitingIntervals(0)//waiting for start transmit
 {
     running = false;
 
+    //the encoding quality is updated in the main thread
+    connect(this, SIGNAL(startingNewInterval()), this, SLOT(updateEncodingQuality()));
+    connect(this, SIGNAL(startingNewInterval()), this, SLOT(deleteProcessedEvents()));
+    connect(this, SIGNAL(startingNewInterval()), this, SLOT(deleteRetiredMetronomeIntervals()));
 }
 
 
@@ -198,6 +275,21 @@ Ninjam::User NinjamController::getUserByName(const QString &userName) const
     return Ninjam::User();
 }
 
+NinjamTrackNode::IntervalStatistics NinjamController::getUserIntervalStatistics(const Ninjam::User &user)
+{
+    NinjamTrackNode::IntervalStatistics userStatistics = {0, 0};
+    QMutexLocker locker(&mutex);
+    foreach (const Ninjam::UserChannel &channel, user.getChannels()) {
+        NinjamTrackNode *trackNode = trackNodes.value(getUniqueKeyForChannel(channel));
+        if (trackNode) {
+            NinjamTrackNode::IntervalStatistics statistics = trackNode->getIntervalStatistics();
+            userStatistics.lateStartedIntervals += statistics.lateStartedIntervals;
+            userStatistics.droppedIntervals += statistics.droppedIntervals;
+        }
+    }
+    return userStatistics;
+}
+
 //++++++++++++++++++++++++++
 void NinjamController::setBpm(int newBpm){
     currentBpm = newBpm;
@@ -207,13 +299,6 @@ void NinjamController::setBpm(int newBpm){
     emit currentBpmChanged(currentBpm);
 }
 
-void NinjamController::removeEncoder(int groupChannelIndex){
-    QMutexLocker locker(&mutex);
-    if(encoders.contains(groupChannelIndex)){
-        encoders.remove(groupChannelIndex);
-    }
-}
-
 //+++++++++++++++++++++++++ THE MAIN LOGIC IS HERE  ++++++++++++++++++++++++++++++++++++++++++++++++
 void NinjamController::process(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &out, int sampleRate){
 
@@ -264,23 +349,25 @@ void NinjamController::process(const Audio::SamplesBuffer &in, Audio::SamplesBuf
 
         if(preparedForTransmit){
             //1) mix input subchannels, 2) encode and 3) send the encoded audio
-            bool isFirstPart = intervalPosition == 0;
             int groupedChannels = mainController->getInputTrackGroupsCount();
             for (int groupIndex = 0; groupIndex < groupedChannels; ++groupIndex) {
+                bool encoding = false;
                 if(mainController->isTransmiting(groupIndex)){
                     int channels = mainController->getMaxChannelsForEncodingInTrackGroup(groupIndex);
                     if(channels > 0){
-                        Audio::SamplesBuffer inputMixBuffer(channels, samplesToProcessInThisStep);
-
-                        if(encoders.contains(groupIndex)){
+                        if(getEncoder(groupIndex)){
+                            resizeBuffer(inputMixBuffer, channels, samplesToProcessInThisStep);
                             inputMixBuffer.zero();
                             mainController->mixGroupedInputs(groupIndex, inputMixBuffer);
 
-                            //encoding is running in another thread to avoid slow down the audio thread
-                            encodingThread->addSamplesToEncode( inputMixBuffer, groupIndex, isFirstPart, isLastPart);
+                            encodeGroupedInputs(groupIndex, inputMixBuffer, intervalPosition);
+                            encoding = true;
                         }
                     }
                 }
+                if(!encoding){
+                    encodingAlignments.remove(groupIndex);//realign when the transmission restart
+                }
             }
         }
 
@@ -292,6 +379,80 @@ void NinjamController::process(const Audio::SamplesBuffer &in, Audio::SamplesBuf
     while( samplesProcessed < totalSamplesToProcess);
 }
 
+void NinjamController::encodeGroupedInputs(int groupIndex, const Audio::SamplesBuffer &inputMix, long mixIntervalPosition)
+{
+    /** The mixed input is late 'latency' samples because the plugins latency, so the encoded
+        interval starts 'latency' samples after the ninjam interval start. A partial encoded interval
+        (without the first part) is discarded by MainController::enqueueAudioDataToUpload. */
+
+    if (!encodingAlignments.contains(groupIndex)) { // starting to transmit
+        EncodingAlignment alignment;
+        alignment.latency = qBound(0L, (long)mainController->getInputTrackGroupLatency(groupIndex), samplesInInterval - 1);
+        alignment.position = (mixIntervalPosition - alignment.latency + samplesInInterval) % samplesInInterval;
+        alignment.length = samplesInInterval;
+        encodingAlignments.insert(groupIndex, alignment); // the silence gate is open, a partial interval is not gated (it will be discarded)
+    }
+
+    EncodingAlignment &alignment = encodingAlignments[groupIndex];
+    int frames = inputMix.getFrameLenght();
+    long framesUntilIntervalEnd = alignment.length - alignment.position;
+    bool isFirstPart = alignment.position == 0;
+
+    if (frames < framesUntilIntervalEnd) {
+        //encoding is running in another thread to avoid slow down the audio thread
+        addGatedSamplesToEncode(groupIndex, alignment, inputMix, isFirstPart, false);
+        alignment.position += frames;
+        return;
+    }
+
+    // the encoded interval is finished in this buffer
+    resizeBuffer(intervalLastPart, inputMix.getChannels(), framesUntilIntervalEnd);
+    intervalLastPart.set(inputMix, 0, framesUntilIntervalEnd, 0);
+    addGatedSamplesToEncode(groupIndex, alignment, intervalLastPart, isFirstPart, true);
+
+    // the next encoded interval is shorter or longer when the plugins latency change
+    long newLatency = qBound(0L, (long)mainController->getInputTrackGroupLatency(groupIndex), samplesInInterval - 1);
+    alignment.length = samplesInInterval + newLatency - alignment.latency;
+    alignment.latency = newLatency;
+    alignment.position = 0;
+
+    // start the next encoded interval with the remaining samples
+    int remainingFrames = frames - framesUntilIntervalEnd;
+    if (remainingFrames > 0) {
+        resizeBuffer(intervalFirstPart, inputMix.getChannels(), remainingFrames);
+        intervalFirstPart.set(inputMix, framesUntilIntervalEnd, remainingFrames, 0);
+        addGatedSamplesToEncode(groupIndex, alignment, intervalFirstPart, true, false);
+        alignment.position = remainingFrames;
+    }
+}
+
+void NinjamController::resizeBuffer(Audio::SamplesBuffer &buffer, int channels, int frames)
+{
+    if (channels == 1)
+        buffer.setToMono();
+    else
+        buffer.setToStereo();
+    buffer.setFrameLenght(frames);
+}
+
+void NinjamController::addGatedSamplesToEncode(int groupIndex, EncodingAlignment &alignment, const Audio::SamplesBuffer &samples, bool isFirstPart, bool isLastPart)
+{
+    // the intervals below -100 dB are sent as empty intervals, see SilenceGate
+    switch (alignment.silenceGate.process(samples, isFirstPart, isLastPart)) {
+    case Audio::SilenceGate::HOLD_SILENCE:
+        break;
+    case Audio::SilenceGate::SEND_SILENT_INTERVAL:
+        encodingThread->addSilentInterval(groupIndex);
+        break;
+    case Audio::SilenceGate::ENCODE_HELD_SILENCE: // the held silence is encoded (in the encoding thread) before the samples
+        encodingThread->addSamplesToEncode(samples, groupIndex, true, isLastPart, alignment.silenceGate.takeHeldSilence());
+        break;
+    case Audio::SilenceGate::ENCODE:
+        encodingThread->addSamplesToEncode(samples, groupIndex, isFirstPart, isLastPart);
+        break;
+    }
+}
+
 //++++++++++++++
 Audio::MetronomeTrackNode* NinjamController::createMetronomeTrackNode(int sampleRate){
     Audio::SamplesBuffer firstBeatBuffer(2);
@@ -325,12 +486,14 @@ void NinjamController::recreateMetronome(int newSampleRate)
 
     //recreate metronome using the new sample rate
     this->metronomeTrackNode = createMetronomeTrackNode(newSampleRate);
+    this->metronomeTrackNode->setBeatsPerAccent(oldBeatsPerAccent);
+    this->metronomeTrackNode->setBeatsPerInterval(currentBpi);
     this->metronomeTrackNode->setSamplesPerBeat(getSamplesPerBeat());
+    prepareMetronomeForCurrentInterval();
     this->metronomeTrackNode->setGain( oldGain );
     this->metronomeTrackNode->setPan( oldPan );
     this->metronomeTrackNode->setMute( oldMutedStatus );
     this->metronomeTrackNode->setSolo( oldSoloStatus );
-    this->metronomeTrackNode->setBeatsPerAccent(oldBeatsPerAccent);
     mainController->addTrack(METRONOME_TRACK_ID, this->metronomeTrackNode);
 }
 
@@ -365,15 +528,12 @@ void NinjamController::stop(bool emitDisconnectedingSignal){
         encodingThread = nullptr;
     }
 
-    foreach (VorbisEncoder* encoder, encoders.values()) {
-        delete encoder;
-    }
-    encoders.clear();
+    deleteEncoders();
+    encodingAlignments.clear();
 
     //delete possible non consumed events
-    foreach (SchedulableEvent *e, scheduledEvents)
-        delete e;
-    scheduledEvents.clear();
+    deleteEvents(scheduledEvents.takeAll());
+    deleteProcessedEvents();
 
     qCDebug(jtNinjamCore) << "NinjamController destructor - disconnecting...";
 
@@ -402,29 +562,32 @@ NinjamController::~NinjamController(){
     }
 
     //delete possible non consumed events
-    foreach (SchedulableEvent *e, scheduledEvents) {
-        delete e;
-    }
-
+    deleteEvents(scheduledEvents.takeAll());
+    deleteProcessedEvents();
 }
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 void NinjamController::start(const Ninjam::Server& server){
     qCDebug(jtNinjamCore) << "starting ninjam controller...";
     QMutexLocker locker(&mutex);
 
+    //each room starts with the default encoding quality
+    qualityControllers.clear();
+
     //schedule an update in internal attributes
-    scheduledEvents.append(new BpiChangeEvent(this, server.getBpi()));
-    scheduledEvents.append(new BpmChangeEvent(this, server.getBpm()));
+    scheduledEvents.push(new BpiChangeEvent(this, server.getBpi()));
+    scheduledEvents.push(new BpmChangeEvent(this, server.getBpm()));
     preparedForTransmit = false; //the xmit start after the first interval is received
     emit preparingTransmission();
 
     //schedule the encoders creation (one encoder for each channel)
     int channels = mainController->getInputTrackGroupsCount();
     for (int channelIndex = 0; channelIndex < channels; ++channelIndex) {
-        scheduledEvents.append(new InputChannelChangedEvent(this, channelIndex));
+        scheduledEvents.push(new InputChannelChangedEvent(this, channelIndex));
     }
 
     processScheduledChanges();
+    deleteProcessedEvents();
+    prepareMetronomeForCurrentInterval();
 
     if(!running){
 
@@ -547,6 +710,7 @@ void NinjamController::addTrack(const Ninjam::User &user, const Ninjam::UserChan
         return;
     }
     NinjamTrackNode* trackNode = new NinjamTrackNode(generateNewTrackID());
+    trackNode->setLateStartWindow(mainController->getSettings().getLateIntervalStartWindow());
 
     bool trackAdded = false;
 
@@ -644,12 +808,29 @@ void NinjamController::handleNewInterval(){
     emit startingNewInterval();
 }
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//called in the interval start, the events are not allocated or deleted in the audio thread
 void NinjamController::processScheduledChanges(){
-    foreach (SchedulableEvent* event, scheduledEvents) {
+    SchedulableEvent* event = scheduledEvents.takeAll();
+    while(event){
+        SchedulableEvent* next = event->nextInQueue;
         event->process();
-        delete event;
+        processedEvents.push(event);//deleted in main thread
+        event = next;
+    }
+}
+
+void NinjamController::deleteProcessedEvents(){
+    //the processed events are deleting the replaced encoders, maybe used in the encoding thread
+    QMutexLocker locker(&encodersMutex);
+    deleteEvents(processedEvents.takeAll());
+}
+
+void NinjamController::deleteEvents(SchedulableEvent *firstEvent){
+    while(firstEvent){
+        SchedulableEvent* next = firstEvent->nextInQueue;
+        delete firstEvent;
+        firstEvent = next;
     }
-    scheduledEvents.clear();
 }
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 long NinjamController::getSamplesPerBeat(){
@@ -657,9 +838,33 @@ long NinjamController::getSamplesPerBeat(){
 }
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 long NinjamController::computeTotalSamplesInInterval(){
-    double intervalPeriod =  60000.0 / currentBpm * currentBpi;
+    return computeTotalSamplesInInterval(currentBpm, currentBpi);
+}
+
+long NinjamController::computeTotalSamplesInInterval(int bpm, int bpi){
+    double intervalPeriod =  60000.0 / bpm * bpi;
     return (long)(mainController->getSampleRate() * intervalPeriod / 1000.0);
 }
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void NinjamController::prepareMetronomeForCurrentInterval(){
+    //the bpm and bpi changes are applied in the audio thread, the metronome interval is rendered here
+    if (currentBpm > 0 && currentBpi > 0)
+        metronomeTrackNode->prepareInterval(getSamplesPerBeat(), currentBpi);
+}
+
+void NinjamController::deleteRetiredMetronomeIntervals(){
+    if (running) //the metronome track is deleted when the controller is stopped
+        metronomeTrackNode->deleteRetiredIntervals();
+}
+
+void NinjamController::prepareMetronomeForNextInterval(){
+    // the server already has the voted bpm and bpi, the metronome is rendered before the change is applied in the next interval
+    Ninjam::Server *server = mainController->getNinjamService()->getCurrentServer();
+    int nextBpm = server->getBpm();
+    int nextBpi = server->getBpi();
+    if (nextBpm > 0 && nextBpi > 0)
+        metronomeTrackNode->prepareInterval(computeTotalSamplesInInterval(nextBpm, nextBpi)/nextBpi, nextBpi);
+}
 
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 //ninjam slots
@@ -694,101 +899,173 @@ void NinjamController::on_ninjamUserChannelUpdated(const Ninjam::User &user, con
 
 void NinjamController::on_ninjamServerBpiChanged(quint16 newBpi, quint16 oldBpi){
     Q_UNUSED(oldBpi);
-    scheduledEvents.append(new BpiChangeEvent(this, newBpi));
+    deleteProcessedEvents();
+    scheduledEvents.push(new BpiChangeEvent(this, newBpi));
+    prepareMetronomeForNextInterval();
 }
 
 void NinjamController::on_ninjamServerBpmChanged(quint16 newBpm){
     Q_UNUSED(newBpm)
-    scheduledEvents.append(new BpmChangeEvent(this, newBpm));
+    deleteProcessedEvents();
+    scheduledEvents.push(new BpmChangeEvent(this, newBpm));
+    prepareMetronomeForNextInterval();
 }
 
 void NinjamController::on_ninjamAudiointervalCompleted(const Ninjam::User &user, quint8 channelIndex, const QByteArray &encodedAudioData){
 
-    if(mainController->isRecordingMultiTracksActivated()){
+    if(mainController->isRecordingMultiTracksActivated() && !encodedAudioData.isEmpty()){//silent intervals are not recorded
         Geo::Location geoLocation = mainController->getGeoLocation(user.getIp());
         QString userName = user.getName() + " from " + geoLocation.getCountryName();
         mainController->saveEncodedAudio(userName, channelIndex, encodedAudioData);
     }
 
-    Ninjam::UserChannel channel = user.getChannel(channelIndex);
-    QString channelKey = getUniqueKeyForChannel(channel);
-    QMutexLocker locker(&mutex);
-    if(trackNodes.contains(channelKey)){
-        NinjamTrackNode* trackNode = trackNodes[channelKey];
-        if(trackNode){
-            trackNode->addVorbisEncodedInterval(encodedAudioData);
-            emit channelAudioFullyDownloaded(trackNode->getID());
-        }
-    }
-    else{
+    if(!addEncodedInterval(user.getChannel(channelIndex), encodedAudioData)){
         qWarning() << "o canal " << channelIndex << " do usuário " << user.getName() << " não foi encontrado no mapa!";
     }
 }
 
+bool NinjamController::addEncodedInterval(const Ninjam::UserChannel &channel, const QByteArray &encodedInterval){
+    QMutexLocker locker(&mutex);
+    NinjamTrackNode* trackNode = trackNodes.value(getUniqueKeyForChannel(channel));
+    if(!trackNode){
+        return false;
+    }
+    trackNode->addVorbisEncodedInterval(encodedInterval);
+    emit channelAudioFullyDownloaded(trackNode->getID());
+    return true;
+}
+
 void NinjamController::reset(bool keepRecentIntervals){
     QMutexLocker locker(&mutex);
     foreach (NinjamTrackNode* trackNode, trackNodes.values()) {
         trackNode->discardIntervals(keepRecentIntervals);
     }
     intervalPosition = lastBeat = 0;
+    encodingAlignments.clear();
 }
 
 void NinjamController::scheduleEncoderChangeForChannel(int channelIndex){
-    scheduledEvents.append(new InputChannelChangedEvent(this, channelIndex));
+    deleteProcessedEvents();
+    scheduledEvents.push(new InputChannelChangedEvent(this, channelIndex));
 }
 
+VorbisEncoder* NinjamController::getEncoder(int channelIndex) const{
+    if(channelIndex < 0 || channelIndex >= MAX_ENCODERS){
+        return nullptr;
+    }
+    return encoders[channelIndex].loadAcquire();
+}
+
+//the encoders are used with the encodersMutex locked, the replaced encoders are deleted with the same lock
 QByteArray NinjamController::encode(const Audio::SamplesBuffer &buffer, uint channelIndex){
     QMutexLocker locker(&encodersMutex);
-    if(encoders.contains(channelIndex)){
-        return encoders[channelIndex]->encode(buffer);
+    VorbisEncoder* encoder = getEncoder(channelIndex);
+    if(encoder){
+        return encoder->encode(buffer);
     }
     return QByteArray();
 }
 
 QByteArray NinjamController::encodeLastPartOfInterval(uint channelIndex){
     QMutexLocker locker(&encodersMutex);
-    if(encoders.contains(channelIndex)){
-        return encoders[channelIndex]->finishIntervalEncoding();
+    VorbisEncoder* encoder = getEncoder(channelIndex);
+    if(encoder){
+        return encoder->finishIntervalEncoding();
     }
     return QByteArray();
 }
 
-void NinjamController::recreateEncoderForChannel(int channelIndex){
+void NinjamController::updateEncodingQuality(){
+    if(!encodingThread || samplesInInterval <= 0){
+        return;
+    }
+
+    VorbisQualityController::IntervalStatistics statistics;
+    QMap<quint8, qint64> encodingTimes;
+    encodingThread->takeStatistics(encodingTimes, statistics.encodedBytes);
+    Ninjam::Service* ninjamService = mainController->getNinjamService();
+    statistics.uploadBacklog = ninjamService->getUploadBacklog();
+    statistics.intervalTime = (qint64)samplesInInterval * 1000000000 / mainController->getSampleRate();
+    Ninjam::Server* server = ninjamService->getCurrentServer();
+    statistics.usersInRoom = server ? server->getUsers().size() : 0;
 
     QMutexLocker locker(&encodersMutex);
+    for (int groupIndex = 0; groupIndex < MAX_ENCODERS; ++groupIndex) {
+        VorbisEncoder* encoder = getEncoder(groupIndex);
+        if(!encoder || !mainController->isTransmiting(groupIndex)){
+            continue;
+        }
+        statistics.encodingTime = encodingTimes.value(groupIndex);
+        VorbisQualityController &qualityController = qualityControllers[groupIndex];
+        if(qualityController.update(statistics)){
+            float quality = qualityController.getQuality();
+            qCDebug(jtNinjamCore) << "channel group" << groupIndex << "encoding quality:" << quality << "reason:" << qualityController.getReason();
+            encoder->setQuality(quality);
+            emit encodingQualityChanged(groupIndex, quality, qualityController.getReason());
+        }
+    }
+}
+
+void NinjamController::prepareEncodersForNextInterval(){
+    //the encoders streams are initialized during the interval, not in the interval start (when all the channels are starting a new interval)
+    QMutexLocker locker(&encodersMutex);
+    for (int channelIndex = 0; channelIndex < MAX_ENCODERS; ++channelIndex) {
+        VorbisEncoder* encoder = getEncoder(channelIndex);
+        if(encoder){
+            encoder->prepareNextInterval();
+        }
+    }
+}
+
+//the encoder is always created, other changes in the same channel can be scheduled before this one is processed
+VorbisEncoder* NinjamController::createEncoderForChannel(int channelIndex){
     int maxChannelsForEncoding = mainController->getMaxChannelsForEncodingInTrackGroup(channelIndex);
     //qWarning() << "recreating encoding using " << maxChannelsForEncoding << " channels";
     if(maxChannelsForEncoding <= 0){//input tracks are setted as noInput?
-        return;
+        return nullptr;
     }
-    bool currentEncoderIsInvalid = encoders.contains(channelIndex) &&
-            (encoders[channelIndex]->getChannels() != maxChannelsForEncoding
-                || encoders[channelIndex]->getSampleRate() != mainController->getSampleRate());
+    float quality = qualityControllers.value(channelIndex).getQuality();
+    VorbisEncoder *encoder = new VorbisEncoder(maxChannelsForEncoding, mainController->getSampleRate(), quality);
+    const Persistence::Settings &settings = mainController->getSettings();
+    encoder->setPagePolicy(settings.getVorbisPageSize(), settings.getVorbisPageLatency());
+    return encoder;
+}
 
-    if(!encoders.contains(channelIndex) || currentEncoderIsInvalid){//a new encoder is necessary?
-        //qDebug() << "recreating encoder for channel index" << channelIndex;
-        if(currentEncoderIsInvalid){
-            delete encoders[channelIndex];
-        }
-        encoders[channelIndex] = new VorbisEncoder(maxChannelsForEncoding, mainController->getSampleRate());
+//called in the audio thread, the only thread replacing the encoders while the controller is running. The
+//encoders are not created or deleted here and the encodersMutex is not locked, the encoding thread can
+//be using the current encoder. The replaced encoder is deleted in the main thread with the processed event.
+VorbisEncoder* NinjamController::swapEncoder(int channelIndex, VorbisEncoder *newEncoder){
+    if(channelIndex < 0 || channelIndex >= MAX_ENCODERS){
+        return newEncoder;
+    }
+    VorbisEncoder* currentEncoder = encoders[channelIndex].loadAcquire();
+    bool currentEncoderIsValid = currentEncoder
+            && currentEncoder->getChannels() == newEncoder->getChannels()
+            && currentEncoder->getSampleRate() == newEncoder->getSampleRate();
+    if(currentEncoderIsValid){
+        return newEncoder;//keeping the current encoder, the new encoder is not necessary
     }
+    return encoders[channelIndex].fetchAndStoreOrdered(newEncoder);
 }
 
+//the current encoders are replaced in the audio thread, the new sample rate encoders are used in the next interval start
 void NinjamController::recreateEncoders(){
     if(isRunning()){
-        QMutexLocker locker(&encodersMutex); //this method is called from main thread, and the encoders are used in audio thread every time
-        for (int e = 0; e < encoders.size(); ++e) {
-            delete encoders[e];
-        }
-        encoders.clear();//new encoders will be create on demand
-
         int trackGroupsCount = mainController->getInputTrackGroupsCount();
         for (int channelIndex = 0; channelIndex < trackGroupsCount; ++channelIndex) {
-            recreateEncoderForChannel(channelIndex);
+            scheduleEncoderChangeForChannel(channelIndex);
         }
     }
 }
 
+//called when the controller is stopped, the encoding thread is finished and the audio thread is not using the encoders
+void NinjamController::deleteEncoders(){
+    QMutexLocker locker(&encodersMutex);
+    for (int channelIndex = 0; channelIndex < MAX_ENCODERS; ++channelIndex) {
+        delete encoders[channelIndex].fetchAndStoreOrdered(nullptr);
+    }
+}
+
 void NinjamController::setSampleRate(int newSampleRate){
     if(!isRunning()){
         return;
@@ -811,6 +1088,7 @@ void NinjamController::on_ninjamAudioIntervalDownloading(const Ninjam::User &use
     if(trackNodes.contains(channelKey)){
         NinjamTrackNode* track = trackNodes[channelKey];
         if(track){
+            track->setDownloadingInterval(true);//used to wait the late intervals in the interval start
             if(!track->isPlaying()){//track is not playing yet and receive the first interval bytes
                 emit channelXmitChanged(track->getID(), true);
             }
@@ -3,14 +3,17 @@
 
 #include <QObject>
 #include <QMutex>
+#include <QAtomicPointer>
 #include "ninjam/User.h"
 #include "ninjam/Server.h"
 #include "audio/vorbis/VorbisEncoder.h"
+#include "audio/vorbis/VorbisQualityController.h"
+#include "audio/NinjamTrackNode.h"
+#include "audio/SilenceGate.h"
+#include "audio/core/EventsQueue.h"
 
 #include <QThread>
 
-class NinjamTrackNode;
-
 namespace Audio {
 class MetronomeTrackNode;
 class SamplesBuffer;
@@ -60,9 +63,9 @@ public:
 
     QByteArray encode(const Audio::SamplesBuffer &buffer, uint channelIndex);
     QByteArray encodeLastPartOfInterval(uint channelIndex);
+    void prepareEncodersForNextInterval(); // called by the encoding thread when there is nothing to encode
 
     void scheduleEncoderChangeForChannel(int channelIndex);
-    void removeEncoder(int groupChannelIndex);
 
     void scheduleXmitChange(int channelID, bool transmiting);// schedule the change for the next interval
 
@@ -89,6 +92,12 @@ public:
 
     Ninjam::User getUserByName(const QString &userName) const;
 
+    // late started and dropped intervals in all user channels
+    NinjamTrackNode::IntervalStatistics getUserIntervalStatistics(const Ninjam::User &user);
+
+    // the intervals are received from the server, the offline render benchmark is adding intervals directly
+    bool addEncodedInterval(const Ninjam::UserChannel &channel, const QByteArray &encodedInterval);
+
 signals:
     void currentBpiChanged(int newBpi); //emitted when a scheduled bpi change is processed in interval start (first beat).
     void currentBpmChanged(int newBpm);
@@ -109,6 +118,8 @@ signals:
     void topicMessageReceived(const QString &message);
 
     void encodedAudioAvailableToSend(const QByteArray &encodedAudio, quint8 channelIndex, bool isFirstPart, bool isLastPart);
+    void silentIntervalAvailableToSend(quint8 channelIndex);
+    void encodingQualityChanged(int groupIndex, float quality, VorbisQualityController::Reason reason);
 
     void userBlockedInChat(const QString &userName);
     void userUnblockedInChat(const QString &userName);
@@ -122,6 +133,9 @@ protected:
 
 private slots:
     void handleReceivedChatMessage(const Ninjam::User &user, const QString &message);
+    void updateEncodingQuality();
+    void deleteProcessedEvents();
+    void deleteRetiredMetronomeIntervals();
 
 private:
     Controller::MainController *mainController;
@@ -147,9 +161,10 @@ private:
 
     QMutex mutex;
 
-    QMutex encodersMutex;
+    QMutex encodersMutex; // the encoders are used and deleted with this lock, the audio thread only swap the slots pointers
 
     long computeTotalSamplesInInterval();
+    long computeTotalSamplesInInterval(int bpm, int bpi);
     long getSamplesPerBeat();
 
     void processScheduledChanges();
@@ -161,21 +176,49 @@ private:
     static long generateNewTrackID();
 
     Audio::MetronomeTrackNode *createMetronomeTrackNode(int sampleRate);
+    void prepareMetronomeForNextInterval();
+    void prepareMetronomeForCurrentInterval();
 
-    QMap<int, VorbisEncoder *> encoders;
-    VorbisEncoder *getEncoder(quint8 channelIndex);
+    static const int MAX_ENCODERS = 32; // one encoder for each channel group, the NINJAM channels limit
+    QAtomicPointer<VorbisEncoder> encoders[MAX_ENCODERS]; // replaced in the audio thread without allocations or locks
+    QMap<int, VorbisQualityController> qualityControllers; // the encoders quality, updated in each interval start
+    VorbisEncoder *getEncoder(int channelIndex) const; // nullptr when the channel group is not encoding
 
     void handleNewInterval();
-    void recreateEncoderForChannel(int channelIndex);
+    VorbisEncoder *createEncoderForChannel(int channelIndex); // nullptr when the channel group has no inputs
+    VorbisEncoder *swapEncoder(int channelIndex, VorbisEncoder *newEncoder); // return the encoder to delete, 'newEncoder' when the current encoder has the same channels and sample rate
+    void deleteEncoders();
 
     void setXmitStatus(int channelID, bool transmiting);
 
+    // the encoded intervals are shifted by the plugins latency, so the transmitted audio is aligned with the interval start
+    void encodeGroupedInputs(int groupIndex, const Audio::SamplesBuffer &inputMix, long mixIntervalPosition);
+
+    struct EncodingAlignment
+    {
+        long position; // position in the current encoded interval
+        long length; // the current encoded interval length, changed when plugins latency change
+        long latency; // the latency is updated only when a new encoded interval is started
+        Audio::SilenceGate silenceGate; // the silence in the encoded interval start is not encoded
+    };
+    QMap<int, EncodingAlignment> encodingAlignments;
+
+    void addGatedSamplesToEncode(int groupIndex, EncodingAlignment &alignment, const Audio::SamplesBuffer &samples, bool isFirstPart, bool isLastPart);
+
+    // reused in every audio callback, the samples storage only grows when the audio driver buffer size grows
+    Audio::SamplesBuffer inputMixBuffer;
+    Audio::SamplesBuffer intervalLastPart; // the samples finishing an encoded interval
+    Audio::SamplesBuffer intervalFirstPart; // the samples starting the next encoded interval
+    static void resizeBuffer(Audio::SamplesBuffer &buffer, int channels, int frames);
+
     // ++++++++++++++++++++ nested classes to handle scheduled events +++++++++++++++++
     class SchedulableEvent;// the interface for all events
     class BpiChangeEvent;
     class BpmChangeEvent;
     class InputChannelChangedEvent;// user change the channel input selection from mono to stereo or vice-versa, or user added a new channel, both cases requires a new encoder in next interval
-    QList<SchedulableEvent *> scheduledEvents;
+    Audio::EventsQueue<SchedulableEvent> scheduledEvents; // created in main thread, processed in audio thread
+    Audio::EventsQueue<SchedulableEvent> processedEvents; // returned by the audio thread, deleted in main thread
+    static void deleteEvents(SchedulableEvent *firstEvent); // the linked events returned by EventsQueue::takeAll()
 
     class EncodingThread;
 
@@ -0,0 +1,75 @@
+#include "LateIntervalTracker.h"
+
+using namespace Audio;
+
+LateIntervalTracker::LateIntervalTracker() :
+    window(0),
+    countingDroppedInterval(false),
+    consecutiveLateStarts(0),
+    waiting(0),
+    waitedFrames(0),
+    sampleRate(44100),
+    lateStartedIntervals(0),
+    droppedIntervals(0)
+{
+}
+
+void LateIntervalTracker::startNewInterval(bool intervalReceived, bool downloadingInterval, bool previousIntervalReceived)
+{
+    if (isWaiting()) // the previous late interval was not downloaded in the entire interval
+        drop();
+
+    countingDroppedInterval = previousIntervalReceived;
+    if (intervalReceived) {
+        consecutiveLateStarts = 0; // the decoders queue is refilled
+        return;
+    }
+    if (!downloadingInterval)
+        return;
+
+    // the interval is still downloading, waiting the late interval instead of keep silent in the entire interval
+    if (window > 0 && consecutiveLateStarts < MAX_CONSECUTIVE_LATE_STARTS) {
+        waitedFrames.storeRelease(0);
+        waiting.storeRelease(1);
+        return;
+    }
+
+    // silent in this interval, the late interval is played in full in the next interval
+    consecutiveLateStarts = 0;
+    if (countingDroppedInterval)
+        droppedIntervals.ref();
+}
+
+bool LateIntervalTracker::wait(int frames, int sampleRate)
+{
+    if (!isWaiting() || sampleRate <= 0)
+        return false;
+
+    this->sampleRate.storeRelease(sampleRate);
+    int totalFrames = waitedFrames.fetchAndAddOrdered(frames) + frames;
+    if ((qint64)totalFrames * 1000 / sampleRate > window) {
+        drop(); // the track is silent until the next interval
+        return false;
+    }
+    return true;
+}
+
+int LateIntervalTracker::start()
+{
+    waiting.storeRelease(0);
+    lateStartedIntervals.ref();
+    consecutiveLateStarts++;
+    return waitedFrames.load();
+}
+
+void LateIntervalTracker::cancel()
+{
+    waiting.storeRelease(0);
+}
+
+void LateIntervalTracker::drop()
+{
+    waiting.storeRelease(0);
+    if (countingDroppedInterval)
+        droppedIntervals.ref();
+}
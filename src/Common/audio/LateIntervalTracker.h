@@ -0,0 +1,85 @@
+#ifndef _LATE_INTERVAL_TRACKER_H_
+#define _LATE_INTERVAL_TRACKER_H_
+
+#include <QAtomicInt>
+#include <QtGlobal>
+
+namespace Audio {
+
+/**
+ * Track the intervals downloaded after the interval start (late intervals). A late interval is
+ * played in the right interval position if the download is finished in the late start window,
+ * otherwise the interval is dropped and the track is silent until the next interval.
+ * A user always sending the intervals a bit late would be late started in every interval, because
+ * the decoders queue is never refilled. After MAX_CONSECUTIVE_LATE_STARTS the next late interval is
+ * not waited, it is played in the next interval and the following intervals are played in full.
+ * The waiting state is changed in the audio thread, the waited frames and the counters are read
+ * in any thread without locks.
+ */
+
+class LateIntervalTracker
+{
+public:
+    LateIntervalTracker();
+
+    // zero disable the late start, the track is silent until the next interval
+    inline void setWindow(int milliseconds)
+    {
+        window = milliseconds;
+    }
+
+    // audio thread, the previous interval was received if the track played something in the previous interval
+    void startNewInterval(bool intervalReceived, bool downloadingInterval, bool previousIntervalReceived);
+
+    // audio thread, count the frames processed while waiting the late interval. Return false when the window expired
+    bool wait(int frames, int sampleRate);
+
+    // audio thread, the late interval is started. Return the interval position (the frames to skip)
+    int start();
+
+    void cancel();
+
+    inline bool isWaiting() const
+    {
+        return waiting.load() != 0;
+    }
+
+    // the waited frames and the sample rate are read in the network thread to decode the skipped samples
+    inline int getWaitedFrames() const
+    {
+        return waitedFrames.load();
+    }
+
+    inline int getSampleRate() const
+    {
+        return sampleRate.load();
+    }
+
+    inline quint32 getLateStartedIntervals() const
+    {
+        return lateStartedIntervals.load();
+    }
+
+    inline quint32 getDroppedIntervals() const
+    {
+        return droppedIntervals.load();
+    }
+
+    static const int MAX_CONSECUTIVE_LATE_STARTS = 2;
+
+private:
+    int window; // in milliseconds
+    bool countingDroppedInterval; // a user starting the transmission in the middle of an interval is not dropping intervals
+    int consecutiveLateStarts; // audio thread only, zeroed when an interval is received in time
+    QAtomicInt waiting;
+    QAtomicInt waitedFrames;
+    QAtomicInt sampleRate;
+    QAtomicInt lateStartedIntervals;
+    QAtomicInt droppedIntervals;
+
+    void drop();
+};
+
+} // namespace
+
+#endif
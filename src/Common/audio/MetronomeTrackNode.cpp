@@ -1,9 +1,54 @@
 #include "MetronomeTrackNode.h"
 #include "audio/core/AudioDriver.h"
 #include "audio/core/SamplesBuffer.h"
+#include <QMutexLocker>
 
 using namespace Audio;
 
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+bool MetronomeTrackNode::IntervalLayout::isValid() const
+{
+    return samplesPerBeat > 0 && beatsPerInterval > 0;
+}
+
+bool MetronomeTrackNode::IntervalLayout::operator==(const IntervalLayout &other) const
+{
+    return samplesPerBeat == other.samplesPerBeat
+           && beatsPerInterval == other.beatsPerInterval
+           && beatsPerAccent == other.beatsPerAccent
+           && soundsVersion == other.soundsVersion;
+}
+
+bool MetronomeTrackNode::IntervalLayout::operator!=(const IntervalLayout &other) const
+{
+    return !(*this == other);
+}
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+class MetronomeTrackNode::RenderedInterval
+{
+public:
+    RenderedInterval(const IntervalLayout &layout, const SamplesBuffer &firstBeat,
+                     const SamplesBuffer &secondaryBeat) :
+        layout(layout),
+        samples(2, layout.samplesPerBeat * layout.beatsPerInterval),
+        nextInQueue(nullptr)
+    {
+        samples.zero();
+        for (int beat = 0; beat < layout.beatsPerInterval; ++beat) {
+            bool isAccent = beat == 0 || (layout.beatsPerAccent > 0 && beat % layout.beatsPerAccent == 0);
+            const SamplesBuffer &click = isAccent ? firstBeat : secondaryBeat;
+            int samplesToCopy = std::min((long)click.getFrameLenght(), layout.samplesPerBeat);
+            if (samplesToCopy > 0)
+                samples.set(click, 0, samplesToCopy, beat * layout.samplesPerBeat);
+        }
+    }
+
+    const IntervalLayout layout;
+    SamplesBuffer samples;
+    RenderedInterval *nextInQueue; // used by EventsQueue
+};
+
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 MetronomeTrackNode::MetronomeTrackNode(const SamplesBuffer &firstBeatSamples, const SamplesBuffer &secondaryBeatSamples) :
     firstBeatBuffer(firstBeatSamples),
@@ -12,31 +57,43 @@ MetronomeTrackNode::MetronomeTrackNode(const SamplesBuffer &firstBeatSamples, co
     intervalPosition(0),
     beatPosition(0),
     currentBeat(0),
-    beatsPerAccent(0)
+    beatsPerAccent(0),
+    beatsPerInterval(0),
+    soundsVersion(0),
+    pendingInterval(nullptr),
+    renderedInterval(nullptr)
 {
+    lastRequestedLayout = getCurrentLayout();
     resetInterval();
 }
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 MetronomeTrackNode::~MetronomeTrackNode()
 {
-
+    delete renderedInterval;
+    delete pendingInterval.fetchAndStoreOrdered(nullptr);
+    deleteRetiredIntervals();
 }
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 void MetronomeTrackNode::setPrimaryBeatSamples(const SamplesBuffer &firstBeatSamples)
 {
     firstBeatBuffer.set(firstBeatSamples);
+    soundsVersion.fetchAndAddOrdered(1);
+    requestRender(getCurrentLayout());
 }
 
 void MetronomeTrackNode::setSecondaryBeatSamples(const SamplesBuffer &secondaryBeatSamples)
 {
     secondaryBeatBuffer.set(secondaryBeatSamples);
+    soundsVersion.fetchAndAddOrdered(1);
+    requestRender(getCurrentLayout());
 }
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 void MetronomeTrackNode::setBeatsPerAccent(int beatsPerAccent)
 {
-    this->beatsPerAccent = beatsPerAccent;
+    this->beatsPerAccent.storeRelease(beatsPerAccent);
+    requestRender(getCurrentLayout());
 }
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -48,6 +105,80 @@ void MetronomeTrackNode::setSamplesPerBeat(long samplesPerBeat)
     resetInterval();
 }
 
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void MetronomeTrackNode::setBeatsPerInterval(int beatsPerInterval)
+{
+    this->beatsPerInterval = beatsPerInterval;
+}
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void MetronomeTrackNode::prepareInterval(long samplesPerBeat, int beatsPerInterval)
+{
+    IntervalLayout layout = getCurrentLayout();
+    layout.samplesPerBeat = samplesPerBeat;
+    layout.beatsPerInterval = beatsPerInterval;
+    requestRender(layout);
+}
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+MetronomeTrackNode::IntervalLayout MetronomeTrackNode::getCurrentLayout() const
+{
+    IntervalLayout layout;
+    layout.samplesPerBeat = samplesPerBeat;
+    layout.beatsPerInterval = beatsPerInterval;
+    layout.beatsPerAccent = beatsPerAccent.loadAcquire();
+    layout.soundsVersion = soundsVersion.loadAcquire();
+    return layout;
+}
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void MetronomeTrackNode::requestRender(const IntervalLayout &layout)
+{
+    deleteRetiredIntervals();
+
+    if (!layout.isValid())
+        return;
+
+    QMutexLocker locker(&requestMutex);
+    if (layout == lastRequestedLayout)
+        return;
+
+    lastRequestedLayout = layout;
+    RenderedInterval *interval = new RenderedInterval(layout, firstBeatBuffer, secondaryBeatBuffer);
+    delete pendingInterval.fetchAndStoreOrdered(interval); // the previous pending interval was never played
+}
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void MetronomeTrackNode::deleteRetiredIntervals()
+{
+    RenderedInterval *interval = retiredIntervals.takeAll();
+    while (interval) {
+        RenderedInterval *next = interval->nextInQueue;
+        delete interval;
+        interval = next;
+    }
+}
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// The audio thread owns the pending interval after the exchange, the replaced intervals are
+// returned in 'retiredIntervals', so the audio thread never allocate or release memory.
+void MetronomeTrackNode::swapRenderedInterval()
+{
+    RenderedInterval *pending = pendingInterval.fetchAndStoreOrdered(nullptr);
+    if (!pending)
+        return;
+
+    if (pending->layout != getCurrentLayout()) { // prepared for a future bpm/bpi change, keep it pending
+        if (!pendingInterval.testAndSetOrdered(nullptr, pending)) // a newer interval was published
+            retiredIntervals.push(pending);
+        return;
+    }
+
+    if (renderedInterval)
+        retiredIntervals.push(renderedInterval);
+    renderedInterval = pending;
+}
+
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 void MetronomeTrackNode::resetInterval()
 {
@@ -67,25 +198,29 @@ void MetronomeTrackNode::setIntervalPosition(long intervalPosition)
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 SamplesBuffer *MetronomeTrackNode::getSamplesBuffer(int beat)
 {
-    if (beat == 0 || (isPlayingAccents() && beat % beatsPerAccent == 0)){
+    int accent = beatsPerAccent.loadAcquire(); // loaded once, can be changed by other thread
+    if (beat == 0 || (accent > 0 && beat % accent == 0)){
         return &firstBeatBuffer;
     }
     return &secondaryBeatBuffer;
 }
 
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-void MetronomeTrackNode::processReplacing(const SamplesBuffer &in, SamplesBuffer &out,
-                                          int SampleRate, const Midi::MidiMessageBuffer &midiBuffer)
+void MetronomeTrackNode::copyRenderedSamples(int frames)
 {
-    if (samplesPerBeat <= 0)
-        return;
-    internalInputBuffer.setFrameLenght(out.getFrameLenght());
-    internalInputBuffer.zero();
+    const SamplesBuffer &samples = renderedInterval->samples;
+    int samplesToCopy = std::min(frames, (int)(samples.getFrameLenght() - intervalPosition));
+    if (samplesToCopy > 0)
+        internalInputBuffer.set(samples, intervalPosition, samplesToCopy, 0);
+}
 
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void MetronomeTrackNode::copyClickSamples(int frames)
+{
     SamplesBuffer *samplesBuffer = getSamplesBuffer(currentBeat);
     int samplesToCopy = std::min(
-        (int)(samplesBuffer->getFrameLenght() - beatPosition), out.getFrameLenght());
-    int nextBeatSample = beatPosition + out.getFrameLenght();
+        (int)(samplesBuffer->getFrameLenght() - beatPosition), frames);
+    int nextBeatSample = beatPosition + frames;
     int internalOffset = 0;
     int clickSoundBufferOffset = beatPosition;
     if (nextBeatSample > samplesPerBeat) {// next beat starting in this audio buffer?
@@ -98,5 +233,25 @@ void MetronomeTrackNode::processReplacing(const SamplesBuffer &in, SamplesBuffer
     if (samplesToCopy > 0)
         internalInputBuffer.set(*samplesBuffer, clickSoundBufferOffset, samplesToCopy,
                                 internalOffset);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void MetronomeTrackNode::processReplacing(const SamplesBuffer &in, SamplesBuffer &out,
+                                          int SampleRate, const Midi::MidiMessageBuffer &midiBuffer)
+{
+    if (samplesPerBeat <= 0)
+        return;
+    internalInputBuffer.setFrameLenght(out.getFrameLenght());
+    internalInputBuffer.zero();
+
+    if (intervalPosition == 0)
+        swapRenderedInterval(); // a new rendered interval is used only in interval start
+
+    // the beat by beat copy is used until the interval for the current bpm/bpi is rendered
+    if (renderedInterval && renderedInterval->layout == getCurrentLayout())
+        copyRenderedSamples(out.getFrameLenght());
+    else
+        copyClickSamples(out.getFrameLenght());
+
     AudioNode::processReplacing(in, out, SampleRate, midiBuffer);
 }
@@ -2,6 +2,10 @@
 #define METRONOMETRACKNODE_H
 
 #include "core/AudioNode.h"
+#include "core/EventsQueue.h"
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QMutex>
 
 namespace Audio {
 class SamplesBuffer;
@@ -14,7 +18,9 @@ public:
     ~MetronomeTrackNode();
     virtual void processReplacing(const SamplesBuffer &in, SamplesBuffer &out, int SampleRate,
                                   const Midi::MidiMessageBuffer &midiBuffer);
+    // called in the interval start (audio thread), the interval is not rendered, see prepareInterval()
     void setSamplesPerBeat(long samplesPerBeat);
+    void setBeatsPerInterval(int beatsPerInterval);
     void setIntervalPosition(long intervalPosition);
     void resetInterval();
 
@@ -27,7 +33,28 @@ public:
     void setPrimaryBeatSamples(const Audio::SamplesBuffer &firstBeatSamples);
     void setSecondaryBeatSamples(const Audio::SamplesBuffer &secondaryBeatSamples);
 
+    // Render the interval in the caller thread (main or network thread, where the bpm/bpi changes are received) before
+    // the change is applied, avoiding a fallback interval after votes. The audio thread is only swapping the intervals.
+    void prepareInterval(long samplesPerBeat, int beatsPerInterval);
+
+    void deleteRetiredIntervals(); // the intervals replaced by the audio thread, called in main thread
+
 private:
+    // the interval is rendered using these values as key, a rendered interval is played only if the key match the current values
+    struct IntervalLayout
+    {
+        long samplesPerBeat;
+        int beatsPerInterval;
+        int beatsPerAccent;
+        int soundsVersion; // incremented when the click sounds are changed
+
+        bool isValid() const;
+        bool operator==(const IntervalLayout &other) const;
+        bool operator!=(const IntervalLayout &other) const;
+    };
+
+    class RenderedInterval;
+
     SamplesBuffer secondaryBeatBuffer;
     SamplesBuffer firstBeatBuffer;
 
@@ -35,19 +62,36 @@ private:
     long intervalPosition;
     long beatPosition;
     int currentBeat;
-    int beatsPerAccent;
+    QAtomicInt beatsPerAccent; // written in GUI/network thread, read in audio thread
+    int beatsPerInterval;
+    QAtomicInt soundsVersion;
 
     SamplesBuffer *getSamplesBuffer(int beat);// return the correct buffer to play in each beat
+
+    IntervalLayout getCurrentLayout() const;
+
+    void requestRender(const IntervalLayout &layout);
+    QMutex requestMutex;
+    IntervalLayout lastRequestedLayout;
+
+    QAtomicPointer<RenderedInterval> pendingInterval; // published by the render, taken by the audio thread in the interval start
+    EventsQueue<RenderedInterval> retiredIntervals; // returned by the audio thread, deleted in main thread
+    RenderedInterval *renderedInterval; // the interval in use, touched only in audio thread
+
+    void swapRenderedInterval(); // called in interval start
+
+    void copyRenderedSamples(int frames);
+    void copyClickSamples(int frames);
 };
 
 inline bool MetronomeTrackNode::isPlayingAccents() const
 {
-    return beatsPerAccent > 0;
+    return beatsPerAccent.loadAcquire() > 0;
 }
 
 inline int MetronomeTrackNode::getBeatsPerAccent() const
 {
-    return beatsPerAccent;
+    return beatsPerAccent.loadAcquire();
 }
 
 }//namespace
@@ -0,0 +1,231 @@
+#include "Mp3DecoderPool.h"
+#include "codec.h"
+#include "log/Logging.h"
+#include <QThread>
+#include <QMutexLocker>
+#include <algorithm>
+
+using namespace Audio;
+
+const int Mp3Stream::DEFAULT_RING_CAPACITY = 48000 * 10; // 10 seconds in the higher sample rate used in ninjam streams
+
+Mp3Stream::Mp3Stream(Mp3Decoder *decoder, int ringCapacity) :
+    decoder(decoder),
+    ringBuffer(2, ringCapacity),
+    bytesOffset(0),
+    pendingSamples(2),
+    sampleRate(0),
+    audible(0)
+{
+}
+
+Mp3Stream::~Mp3Stream()
+{
+    delete decoder;
+}
+
+void Mp3Stream::addBytes(const QByteArray &bytes)
+{
+    QMutexLocker locker(&mutex);
+    bytesToDecode.append(bytes);
+}
+
+void Mp3Stream::reset()
+{
+    QMutexLocker locker(&mutex);
+    bytesToDecode.clear();
+    bytesOffset = 0;
+    pendingSamples.setFrameLenght(0);
+    decoder->reset();
+    sampleRate.store(0);
+    ringBuffer.reset(); // the stream is not audible or the audio thread is not reading
+}
+
+void Mp3Stream::setAudible(bool audible)
+{
+    QMutexLocker locker(&mutex); // wait the current chunk, non audible streams can discard samples while decoding
+    this->audible.store(audible ? 1 : 0);
+}
+
+bool Mp3Stream::isAudible() const
+{
+    return audible.load() != 0;
+}
+
+int Mp3Stream::getSampleRate() const
+{
+    return sampleRate.load();
+}
+
+int Mp3Stream::getBufferedBytes()
+{
+    QMutexLocker locker(&mutex);
+    return getBytesToDecode();
+}
+
+int Mp3Stream::getBytesToDecode() const
+{
+    return bytesToDecode.size() - bytesOffset;
+}
+
+bool Mp3Stream::hasWorkToDo()
+{
+    QMutexLocker locker(&mutex);
+    bool ringIsFull = isAudible() && ringBuffer.getFreeFrames() <= 0; // audible streams wait for the audio thread
+    if (ringIsFull)
+        return false;
+    return !pendingSamples.isEmpty() || getBytesToDecode() > 0;
+}
+
+bool Mp3Stream::writePendingSamples()
+{
+    if (!isAudible()) { // the oldest samples are dropped to keep the preview 'live'
+        int framesToDrop = pendingSamples.getFrameLenght() - ringBuffer.getFreeFrames();
+        if (framesToDrop > 0)
+            ringBuffer.discard(framesToDrop);
+    }
+
+    int framesWritten = ringBuffer.write(pendingSamples);
+    pendingSamples.discardFirstSamples(framesWritten);
+    return pendingSamples.isEmpty();
+}
+
+bool Mp3Stream::decodeNextChunk()
+{
+    QMutexLocker locker(&mutex);
+
+    // the samples decoded in last chunk but not consumed yet are written first
+    if (!pendingSamples.isEmpty()) {
+        if (!writePendingSamples())
+            return false;
+    }
+
+    int bytesToProcess = std::min(getBytesToDecode(), (int)MAX_BYTES_PER_DECODING);
+    if (bytesToProcess <= 0)
+        return false;
+
+    const SamplesBuffer *decodedBuffer = decoder->decode(bytesToDecode.data() + bytesOffset, bytesToProcess);
+    bytesOffset += bytesToProcess;
+    if (bytesOffset >= bytesToDecode.size()/2) { // compacting the decoded bytes
+        bytesToDecode.remove(0, bytesOffset);
+        bytesOffset = 0;
+    }
+
+    if (!decodedBuffer->isEmpty()) {
+        sampleRate.store(decoder->getSampleRate());
+        pendingSamples.setFrameLenght(0);
+        pendingSamples.append(*decodedBuffer);
+        writePendingSamples();
+    }
+    return true;
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+class Mp3DecoderPool::DecodingThread : public QThread
+{
+public:
+    explicit DecodingThread(Mp3DecoderPool *pool) :
+        pool(pool)
+    {
+        start(QThread::LowPriority);
+    }
+
+protected:
+    void run()
+    {
+        pool->runDecodingLoop();
+    }
+
+private:
+    Mp3DecoderPool *pool;
+};
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+const int Mp3DecoderPool::DEFAULT_THREADS = 2;
+const unsigned long Mp3DecoderPool::IDLE_TIME = 10;
+
+Mp3DecoderPool::Mp3DecoderPool(int threads) :
+    nextStreamIndex(0),
+    stopRequested(false)
+{
+    for (int i = 0; i < std::max(1, threads); ++i)
+        this->threads.append(new DecodingThread(this));
+}
+
+Mp3DecoderPool::~Mp3DecoderPool()
+{
+    {
+        QMutexLocker locker(&mutex);
+        stopRequested = true;
+        hasWorkToDo.wakeAll();
+    }
+    foreach (DecodingThread *thread, threads) {
+        thread->wait();
+        delete thread;
+    }
+    qCDebug(jtNinjamRoomStreamer) << "Mp3 decoder pool stopped!";
+}
+
+void Mp3DecoderPool::addStream(const QSharedPointer<Mp3Stream> &stream)
+{
+    QMutexLocker locker(&mutex);
+    if (!streams.contains(stream))
+        streams.append(stream);
+    hasWorkToDo.wakeAll();
+}
+
+void Mp3DecoderPool::removeStream(const QSharedPointer<Mp3Stream> &stream)
+{
+    QMutexLocker locker(&mutex);
+    streams.removeOne(stream);
+    while (busyStreams.contains(stream.data()))
+        streamReleased.wait(&mutex);
+}
+
+void Mp3DecoderPool::wakeUp()
+{
+    QMutexLocker locker(&mutex);
+    hasWorkToDo.wakeAll();
+}
+
+QSharedPointer<Mp3Stream> Mp3DecoderPool::takeStream()
+{
+    // the audible stream is decoded first
+    foreach (const QSharedPointer<Mp3Stream> &stream, streams) {
+        if (stream->isAudible() && !busyStreams.contains(stream.data()) && stream->hasWorkToDo())
+            return stream;
+    }
+
+    for (int i = 0; i < streams.size(); ++i) {
+        const QSharedPointer<Mp3Stream> &stream = streams.at((nextStreamIndex + i) % streams.size());
+        if (!busyStreams.contains(stream.data()) && stream->hasWorkToDo()) {
+            nextStreamIndex = (nextStreamIndex + i + 1) % streams.size();
+            return stream;
+        }
+    }
+
+    return QSharedPointer<Mp3Stream>();
+}
+
+void Mp3DecoderPool::runDecodingLoop()
+{
+    QMutexLocker locker(&mutex);
+    while (!stopRequested) {
+        QSharedPointer<Mp3Stream> stream = takeStream();
+        if (!stream) {
+            hasWorkToDo.wait(&mutex, IDLE_TIME); // no bytes to decode or the rings are full
+            continue;
+        }
+
+        busyStreams.insert(stream.data());
+        locker.unlock();
+
+        stream->decodeNextChunk();
+
+        locker.relock();
+        busyStreams.remove(stream.data());
+        streamReleased.wakeAll();
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef MP3_DECODER_POOL_H
+#define MP3_DECODER_POOL_H
+
+#include "core/SamplesRingBuffer.h"
+#include <QByteArray>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QSharedPointer>
+#include <QList>
+#include <QSet>
+
+namespace Audio {
+
+class Mp3Decoder;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+/**
+ * The decoding state of one mp3 stream. The downloaded bytes are decoded by the
+ * Mp3DecoderPool threads and the decoded samples are written in a ring read by the audio thread.
+ * Non audible streams (previews) drop the oldest samples when the ring is full, so they are
+ * always pre-buffered with the most recent audio.
+ */
+
+class Mp3Stream
+{
+public:
+    explicit Mp3Stream(Mp3Decoder *decoder, int ringCapacity = DEFAULT_RING_CAPACITY);
+    ~Mp3Stream();
+
+    void addBytes(const QByteArray &bytes);
+    void reset(); // discard the downloaded bytes, the decoder state and the decoded samples
+
+    // the audio thread can read the ring only when the stream is audible
+    void setAudible(bool audible);
+    bool isAudible() const;
+
+    int getSampleRate() const; // zero until the first samples are decoded
+    int getBufferedBytes();
+
+    inline SamplesRingBuffer &getRingBuffer()
+    {
+        return ringBuffer;
+    }
+
+    bool hasWorkToDo();
+    bool decodeNextChunk(); // called by the decoding threads, return false if nothing was done
+
+    static const int DEFAULT_RING_CAPACITY; // in frames
+
+private:
+    Mp3Decoder *decoder;
+    SamplesRingBuffer ringBuffer;
+    QByteArray bytesToDecode;
+    int bytesOffset;
+    SamplesBuffer pendingSamples; // decoded samples waiting for free space in the ring
+    QAtomicInt sampleRate;
+    QAtomicInt audible;
+    QMutex mutex;
+
+    int getBytesToDecode() const;
+    bool writePendingSamples();
+
+    static const int MAX_BYTES_PER_DECODING = 2048;
+};
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+/**
+ * A few low priority threads shared by all mp3 streams. The audible stream is always decoded first.
+ */
+
+class Mp3DecoderPool
+{
+public:
+    explicit Mp3DecoderPool(int threads = DEFAULT_THREADS);
+    ~Mp3DecoderPool();
+
+    void addStream(const QSharedPointer<Mp3Stream> &stream);
+    void removeStream(const QSharedPointer<Mp3Stream> &stream); // wait if the stream is being decoded
+
+    void wakeUp(); // called when new bytes are available to decode
+
+    static const int DEFAULT_THREADS;
+
+private:
+    class DecodingThread;
+    QList<DecodingThread *> threads;
+
+    QList<QSharedPointer<Mp3Stream> > streams;
+    QSet<Mp3Stream *> busyStreams; // streams being decoded
+    int nextStreamIndex; // round robin between the non audible streams
+
+    QMutex mutex;
+    QWaitCondition hasWorkToDo;
+    QWaitCondition streamReleased;
+    bool stopRequested;
+
+    QSharedPointer<Mp3Stream> takeStream(); // mutex must be locked
+    void runDecodingLoop();
+
+    static const unsigned long IDLE_TIME; // ms
+};
+
+}//namespace
+
+#endif
@@ -7,6 +7,7 @@
 #include <QMutexLocker>
 #include <QDateTime>
 #include <QtConcurrent/QtConcurrent>
+#include "log/Logging.h"
 
 
 class NinjamTrackNode::IntervalDecoder
@@ -16,22 +17,68 @@ public:
     void decode(quint32 maxSamplesToDecode);
     quint32 getDecodedSamples(Audio::SamplesBuffer &outBuffer, int samplesToDecode);
     inline int getSampleRate() { return vorbisDecoder.getSampleRate(); }
+    inline bool isSilent() const { return silent; }
+    void skip(int frames, int sampleRate); // the frames (in the audio driver sample rate) are discarded before the next decoded samples
+    inline int getSkippedFrames() const { return skippedFrames.load(); } // not zero in the intervals prepared to a late start
 private:
+    bool silent; // empty interval, nothing to decode
     VorbisDecoder vorbisDecoder;
     Audio::SamplesBuffer decodedBuffer;
     QMutex mutex;
+    QAtomicInt framesToSkip;
+    QAtomicInt skipSampleRate;
+    QAtomicInt skippedFrames;
+
+    void discardSkippedSamples();
 };
 
 NinjamTrackNode::IntervalDecoder::IntervalDecoder(const QByteArray &vorbisData)
-    :decodedBuffer(2)
+    :silent(vorbisData.isEmpty()),
+    decodedBuffer(2),
+    framesToSkip(0),
+    skipSampleRate(44100),
+    skippedFrames(0)
 {
-    vorbisDecoder.setInputData(vorbisData);
+    if (!silent)
+        vorbisDecoder.setInputData(vorbisData);
+}
+
+void NinjamTrackNode::IntervalDecoder::skip(int frames, int sampleRate)
+{
+    skipSampleRate = sampleRate;
+    framesToSkip.fetchAndAddOrdered(frames);
+    skippedFrames.fetchAndAddOrdered(frames);
+}
+
+void NinjamTrackNode::IntervalDecoder::discardSkippedSamples()
+{
+    int framesToDiscard = framesToSkip.fetchAndStoreOrdered(0);
+    if (framesToDiscard <= 0 || silent)
+        return;
+
+    if (decodedBuffer.isEmpty())
+        decodedBuffer.append(vorbisDecoder.decode(256)); // the decoder is initialized in the first decode, the sample rate is known after this
+
+    // the skipped frames are counted in the audio driver sample rate
+    quint32 samplesToDiscard = (qint64)framesToDiscard * vorbisDecoder.getSampleRate() / skipSampleRate.load();
+    while (samplesToDiscard > 0) {
+        if (decodedBuffer.isEmpty()) {
+            const Audio::SamplesBuffer &decodedSamples = vorbisDecoder.decode(qMin(samplesToDiscard, 4096u));
+            if (decodedSamples.isEmpty())
+                break; //no more samples to decode
+            decodedBuffer.append(decodedSamples);
+        }
+        quint32 discardedSamples = qMin(samplesToDiscard, decodedBuffer.getFrameLenght());
+        decodedBuffer.discardFirstSamples(discardedSamples);
+        samplesToDiscard -= discardedSamples;
+    }
 }
 
 void NinjamTrackNode::IntervalDecoder::decode(quint32 maxSamplesToDecode)
 {
     mutex.lock();
 
+    discardSkippedSamples();
     decodedBuffer.append(vorbisDecoder.decode(maxSamplesToDecode));
 
     mutex.unlock();
@@ -40,6 +87,7 @@ void NinjamTrackNode::IntervalDecoder::decode(quint32 maxSamplesToDecode)
 quint32 NinjamTrackNode::IntervalDecoder::getDecodedSamples(Audio::SamplesBuffer &outBuffer, int samplesToDecode)
 {
     mutex.lock();
+    discardSkippedSamples();
     while (decodedBuffer.getFrameLenght() < samplesToDecode) { //need decode more samples to fill outBuffer?
         quint32 toDecode = samplesToDecode - decodedBuffer.getFrameLenght();
         const Audio::SamplesBuffer &decodedSamples = vorbisDecoder.decode(toDecode);
@@ -62,14 +110,23 @@ NinjamTrackNode::NinjamTrackNode(int ID) :
     ID(ID),
     processingLastPartOfInterval(false),
     currentDecoder(nullptr),
-    decodersMutex(QMutex::NonRecursive)
+    decodersMutex(QMutex::NonRecursive),
+    downloadingInterval(0)
 {
 
 }
 
+NinjamTrackNode::IntervalStatistics NinjamTrackNode::getIntervalStatistics() const
+{
+    IntervalStatistics statistics;
+    statistics.lateStartedIntervals = lateIntervalTracker.getLateStartedIntervals();
+    statistics.droppedIntervals = lateIntervalTracker.getDroppedIntervals();
+    return statistics;
+}
+
 int NinjamTrackNode::getSampleRate() const
 {
-    if (currentDecoder)
+    if (currentDecoder && !currentDecoder->isSilent())
         return currentDecoder->getSampleRate();
     return 44100;
 }
@@ -98,6 +155,8 @@ void NinjamTrackNode::discardIntervals(bool keepMostRecentInterval)
         while(decoders.size() > 1)//keep the last downloaded interval
             delete decoders.takeFirst();
     }
+    lateIntervalTracker.cancel();
+    downloadingInterval = 0;
     qDebug() << "intervals discarded";
     decodersMutex.unlock();
 }
@@ -105,30 +164,79 @@ void NinjamTrackNode::discardIntervals(bool keepMostRecentInterval)
 bool NinjamTrackNode::isPlaying()
 {
     QMutexLocker locker(&decodersMutex);
-    return currentDecoder != nullptr;
+    return currentDecoder != nullptr && !currentDecoder->isSilent();
 }
 
 bool NinjamTrackNode::startNewInterval()
 {
     decodersMutex.lock();
+    bool previousIntervalReceived = currentDecoder != nullptr;
     if (currentDecoder) {
         delete currentDecoder; //discard the precious interval decoder
         currentDecoder = nullptr;
     }
+
+    // prepared to a late start in the previous interval, but the late start window was expired
+    while (!decoders.isEmpty() && decoders.first()->getSkippedFrames() > 0)
+        delete decoders.takeFirst();
+
     if (!decoders.isEmpty())
         currentDecoder = decoders.takeFirst(); //using the next buffered decoder (next interval)
 
+    lateIntervalTracker.startNewInterval(currentDecoder != nullptr, downloadingInterval.load(), previousIntervalReceived);
+
     decodersMutex.unlock();
     return isPlaying();
 }
 
+void NinjamTrackNode::startLateInterval(int outFrames, int sampleRate)
+{
+    if (!lateIntervalTracker.wait(outFrames, sampleRate))
+        return; // the late start window expired, the track is silent until the next interval
+
+    if (!decodersMutex.tryLock())
+        return; // the network thread is adding the late interval, trying again in the next audio callback
+
+    if (decoders.isEmpty()) {
+        decodersMutex.unlock();
+        return;
+    }
+
+    currentDecoder = decoders.takeFirst();
+    decodersMutex.unlock();
+
+    // the late interval starts in the current interval position, this block included. The network thread
+    // already decoded the skipped samples, only the frames processed after the download are skipped here
+    int intervalPosition = lateIntervalTracker.start();
+    int framesToSkip = intervalPosition - currentDecoder->getSkippedFrames();
+    if (framesToSkip > 0 && !currentDecoder->isSilent())
+        currentDecoder->skip(framesToSkip, sampleRate);
+}
+
 void NinjamTrackNode::addVorbisEncodedInterval(const QByteArray &vorbisData)
 {
-    decodersMutex.lock();
+    downloadingInterval = 0;
+
     IntervalDecoder *newIntervalDecoder = new IntervalDecoder(vorbisData);
+
+    // the track is waiting this late interval, the samples until the current interval position are
+    // decoded (and discarded) here instead of the audio thread
+    bool lateInterval = lateIntervalTracker.isWaiting() && !vorbisData.isEmpty();
+    if (lateInterval) {
+        int waitedFrames = lateIntervalTracker.getWaitedFrames();
+        newIntervalDecoder->skip(qMax(waitedFrames, 1), lateIntervalTracker.getSampleRate()); // at least one frame, the decoder is marked as prepared to a late start
+        newIntervalDecoder->decode(256);
+        qCDebug(jtNinjamCore) << "track" << ID << "late interval downloaded"
+                              << (qint64)waitedFrames * 1000 / lateIntervalTracker.getSampleRate() << "ms after the interval start";
+    }
+
+    decodersMutex.lock();
     decoders.append(newIntervalDecoder);
     decodersMutex.unlock();
 
+    if (vorbisData.isEmpty() || lateInterval)
+        return; // silent interval, or the first samples are already decoded
+
     //decoding the first samples in a separated thread to avoid slow down the audio thread in interval start (first beat)
     QtConcurrent::run(newIntervalDecoder, &NinjamTrackNode::IntervalDecoder::decode, 256);
 }
@@ -144,6 +252,11 @@ int NinjamTrackNode::getFramesToProcess(int targetSampleRate, int outFrameLenght
 void NinjamTrackNode::processReplacing(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &out,
                                        int sampleRate, const Midi::MidiMessageBuffer &midiBuffer)
 {
+    if (lateIntervalTracker.isWaiting()) {
+        startLateInterval(out.getFrameLenght(), sampleRate);
+        return; // silent until the late interval is started
+    }
+
     if (!isPlaying())
         return;
 
@@ -168,7 +281,7 @@ void NinjamTrackNode::processReplacing(const Audio::SamplesBuffer &in, Audio::Sa
 
 bool NinjamTrackNode::needResamplingFor(int targetSampleRate) const
 {
-    if (currentDecoder)
+    if (currentDecoder && !currentDecoder->isSilent())
         return currentDecoder->getSampleRate() != targetSampleRate;
     return false;
 }
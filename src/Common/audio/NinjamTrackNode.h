@@ -3,8 +3,10 @@
 
 #include "core/AudioNode.h"
 #include <QByteArray>
+#include <QAtomicInt>
 #include "vorbis/VorbisDecoder.h"
 #include "SamplesBufferResampler.h"
+#include "LateIntervalTracker.h"
 
 namespace Audio {
 class SamplesBuffer;
@@ -35,6 +37,26 @@ public:
         this->processingLastPartOfInterval = status;
     }
 
+    // an interval downloaded after the interval start is played (in the right position) if the download
+    // is finished in this window. Zero disable the late start and the track is silent until the next interval.
+    inline void setLateStartWindow(int milliseconds)
+    {
+        lateIntervalTracker.setWindow(milliseconds);
+    }
+
+    inline void setDownloadingInterval(bool downloading)
+    {
+        downloadingInterval = downloading;
+    }
+
+    struct IntervalStatistics
+    {
+        quint32 lateStartedIntervals; // downloaded after the interval start, but played
+        quint32 droppedIntervals; // downloaded after the late start window, the track was silent
+    };
+
+    IntervalStatistics getIntervalStatistics() const;
+
 private:
     int ID;
     SamplesBufferResampler resampler;
@@ -51,6 +73,11 @@ private:
     IntervalDecoder* currentDecoder;
     QMutex decodersMutex;
 
+    QAtomicInt downloadingInterval;
+    Audio::LateIntervalTracker lateIntervalTracker;
+
+    void startLateInterval(int outFrames, int sampleRate);
+
 };
 
 #endif // NINJAMTRACKNODE_H
@@ -0,0 +1,265 @@
+#include "OfflineAudioDriver.h"
+#include "MainController.h"
+#include "core/AllocationCounter.h"
+#include "file/FileReaderFactory.h"
+#include "file/FileReader.h"
+#include "log/Logging.h"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <cmath>
+#include <algorithm>
+
+using namespace Audio;
+
+class OfflineAudioDriver::RenderThread : public QThread
+{
+public:
+    explicit RenderThread(OfflineAudioDriver *driver) :
+        driver(driver)
+    {
+    }
+
+protected:
+    void run() override
+    {
+        driver->render();
+    }
+
+private:
+    OfflineAudioDriver *driver;
+};
+
+// +++++++++++++++++++++++++++++++++++++++++++
+
+OfflineAudioDriver::OfflineAudioDriver(Controller::MainController *mainController,
+                                       int sampleRate, int bufferSize, int inputChannels,
+                                       int outputChannels) :
+    AudioDriver(mainController),
+    sourceType(SourceType::Silence),
+    fileSamples(qBound(1, inputChannels, (int)MAX_CHANNELS)),
+    sourcePosition(0),
+    noiseSeed(1),
+    renderLength(60),
+    stopRequested(0),
+    renderThread(new RenderThread(this))
+{
+    this->sampleRate = sampleRate;
+    this->bufferSize = bufferSize;
+    this->audioDeviceIndex = 0;
+    globalInputRange = ChannelRange(0, qBound(1, inputChannels, (int)MAX_CHANNELS));
+    globalOutputRange = ChannelRange(0, qBound(1, outputChannels, (int)MAX_CHANNELS));
+}
+
+OfflineAudioDriver::~OfflineAudioDriver()
+{
+    stop();
+    delete renderThread;
+}
+
+bool OfflineAudioDriver::setSource(const QString &source)
+{
+    if (source.isEmpty() || source == "silence") {
+        sourceType = SourceType::Silence;
+        return true;
+    }
+    if (source == "sine") {
+        sourceType = SourceType::Sine;
+        return true;
+    }
+    if (source == "noise") {
+        sourceType = SourceType::Noise;
+        return true;
+    }
+
+    if (!QFileInfo(source).isFile()) {
+        qCCritical(jtAudio) << "Offline render source not found:" << source;
+        return false;
+    }
+
+    SamplesBuffer decodedSamples(2);
+    quint32 fileSampleRate = 0;
+    std::unique_ptr<FileReader> reader = FileReaderFactory::createFileReader(source);
+    reader->read(source, decodedSamples, fileSampleRate);
+    if (decodedSamples.isEmpty()) {
+        qCCritical(jtAudio) << "Can't read the offline render source" << source;
+        return false;
+    }
+
+    if (fileSampleRate != (quint32)sampleRate)
+        qCWarning(jtAudio) << "Offline render source sample rate is" << fileSampleRate << "and the driver is using" << sampleRate;
+
+    // the file channels are copied to the inputs, the last file channel is repeated when the inputs have more channels
+    int frames = decodedSamples.getFrameLenght();
+    fileSamples.setFrameLenght(frames);
+    for (int c = 0; c < fileSamples.getChannels(); ++c) {
+        const float *channelSamples = decodedSamples.getSamplesArray(qMin(c, decodedSamples.getChannels() - 1));
+        std::copy(channelSamples, channelSamples + frames, fileSamples.getSamplesArray(c));
+    }
+
+    sourceType = SourceType::File;
+    return true;
+}
+
+void OfflineAudioDriver::setRenderLength(int seconds)
+{
+    renderLength = qMax(1, seconds);
+}
+
+bool OfflineAudioDriver::start()
+{
+    stop();
+
+    recreateBuffers();
+    sourcePosition = 0;
+    stopRequested.store(0);
+
+    qCInfo(jtAudio) << "Starting offline render:" << renderLength << "seconds," << sampleRate << "Hz," << bufferSize << "samples per callback";
+
+    emit started();
+    renderThread->start(QThread::HighPriority);
+    return true;
+}
+
+void OfflineAudioDriver::stop(bool refreshDevicesList)
+{
+    Q_UNUSED(refreshDevicesList)
+
+    if (renderThread->isRunning()) {
+        stopRequested.store(1);
+        renderThread->wait();
+        emit stopped();
+    }
+}
+
+void OfflineAudioDriver::release()
+{
+    stop();
+}
+
+RenderStatistics OfflineAudioDriver::getStatistics() const
+{
+    return statistics;
+}
+
+void OfflineAudioDriver::render()
+{
+    const int frames = bufferSize;
+    const qint64 totalFrames = (qint64)renderLength * sampleRate;
+    const qint64 deadline = (qint64)frames * 1000000000 / sampleRate; // the buffer duration in nanoseconds
+    statistics.reset(deadline, totalFrames / frames + 1);
+
+    QElapsedTimer timer;
+    qint64 renderedFrames = 0;
+    while (renderedFrames < totalFrames && !stopRequested.load()) {
+        fillInputBuffer(frames);
+        outputBuffer->setFrameLenght(frames);
+        outputBuffer->zero();
+
+        quint64 allocationsBefore = AllocationCounter::getThreadAllocations();
+        timer.start();
+
+        if (mainController)
+            mainController->process(*inputBuffer, *outputBuffer, sampleRate);
+
+        qint64 elapsedTime = timer.nsecsElapsed();
+        statistics.addCallback(elapsedTime, AllocationCounter::getThreadAllocations() - allocationsBefore);
+        dspLoadMeter.update(elapsedTime, frames, sampleRate);
+
+        renderedFrames += frames;
+    }
+
+    qCInfo(jtAudio) << "Offline render finished, callbacks:" << statistics.getCallbacks();
+    emit renderFinished();
+}
+
+void OfflineAudioDriver::fillInputBuffer(int frames)
+{
+    inputBuffer->setFrameLenght(frames);
+    const int channels = inputBuffer->getChannels();
+
+    switch (sourceType) {
+    case SourceType::Silence:
+        inputBuffer->zero();
+        break;
+
+    case SourceType::Sine: {
+        const double phaseIncrement = 2.0 * 3.14159265358979323846 * 440.0 / sampleRate; // 440 Hz
+        float *firstChannel = inputBuffer->getSamplesArray(0);
+        for (int i = 0; i < frames; ++i)
+            firstChannel[i] = 0.5f * std::sin(phaseIncrement * (sourcePosition + i));
+        for (int c = 1; c < channels; ++c)
+            std::copy(firstChannel, firstChannel + frames, inputBuffer->getSamplesArray(c));
+        break;
+    }
+
+    case SourceType::Noise:
+        for (int c = 0; c < channels; ++c) {
+            float *channelSamples = inputBuffer->getSamplesArray(c);
+            for (int i = 0; i < frames; ++i) {
+                noiseSeed = noiseSeed * 1664525u + 1013904223u; // a cheap LCG, qrand() is not thread safe
+                channelSamples[i] = ((noiseSeed >> 8) / 8388608.0f - 1.0f) * 0.5f;
+            }
+        }
+        break;
+
+    case SourceType::File: {
+        const qint64 fileFrames = fileSamples.getFrameLenght();
+        int copiedFrames = 0;
+        while (copiedFrames < frames) { // looping the file
+            qint64 position = sourcePosition % fileFrames;
+            int framesToCopy = (int)qMin((qint64)(frames - copiedFrames), fileFrames - position);
+            for (int c = 0; c < channels; ++c) {
+                const float *channelSamples = fileSamples.getSamplesArray(c) + position;
+                std::copy(channelSamples, channelSamples + framesToCopy, inputBuffer->getSamplesArray(c) + copiedFrames);
+            }
+            copiedFrames += framesToCopy;
+            sourcePosition += framesToCopy;
+        }
+        return; // the source position is already updated
+    }
+    }
+
+    sourcePosition += frames;
+}
+
+QList<int> OfflineAudioDriver::getValidSampleRates(int deviceIndex) const
+{
+    Q_UNUSED(deviceIndex)
+    return QList<int>() << 44100 << 48000 << 96000 << 192000;
+}
+
+QList<int> OfflineAudioDriver::getValidBufferSizes(int deviceIndex) const
+{
+    Q_UNUSED(deviceIndex)
+    QList<int> bufferSizes;
+    for (int size = 32; size <= 4096; size *= 2)
+        bufferSizes.append(size);
+    return bufferSizes;
+}
+
+int OfflineAudioDriver::getMaxInputs() const
+{
+    return MAX_CHANNELS;
+}
+
+int OfflineAudioDriver::getMaxOutputs() const
+{
+    return MAX_CHANNELS;
+}
+
+QString OfflineAudioDriver::getInputChannelName(const unsigned int index) const
+{
+    return "Offline input " + QString::number(index + 1);
+}
+
+QString OfflineAudioDriver::getOutputChannelName(const unsigned int index) const
+{
+    return "Offline output " + QString::number(index + 1);
+}
+
+QString OfflineAudioDriver::getAudioDeviceName(int index) const
+{
+    Q_UNUSED(index)
+    return "Offline render";
+}
@@ -0,0 +1,117 @@
+#ifndef _OFFLINE_AUDIO_DRIVER_H_
+#define _OFFLINE_AUDIO_DRIVER_H_
+
+#include "core/AudioDriver.h"
+#include "core/RenderStatistics.h"
+#include <QThread>
+#include <QAtomicInt>
+
+namespace Audio {
+
+/**
+ * A driver without audio device. The full processing chain (MainController::process)
+ * is called in a tight loop, as fast as possible, feeding the inputs with samples
+ * from an audio file or from a synthetic source. Used to benchmark the engine in
+ * machines without sound card, the time spent in each callback is collected in
+ * RenderStatistics.
+ */
+
+class OfflineAudioDriver : public AudioDriver
+{
+    Q_OBJECT
+
+public:
+    OfflineAudioDriver(Controller::MainController *mainController, int sampleRate,
+                       int bufferSize, int inputChannels = 2, int outputChannels = 2);
+    ~OfflineAudioDriver();
+
+    // 'silence', 'sine', 'noise' or a .wav/.ogg file path. The file is looped and
+    // played without resampling.
+    bool setSource(const QString &source);
+
+    void setRenderLength(int seconds);
+
+    inline int getRenderLength() const
+    {
+        return renderLength;
+    }
+
+    bool start() override;
+    void stop(bool refreshDevicesList = false) override;
+    void release() override;
+
+    RenderStatistics getStatistics() const; // call after the render is finished
+
+    QList<int> getValidSampleRates(int deviceIndex) const override;
+    QList<int> getValidBufferSizes(int deviceIndex) const override;
+
+    int getMaxInputs() const override;
+    int getMaxOutputs() const override;
+
+    QString getInputChannelName(unsigned const int index) const override;
+    QString getOutputChannelName(unsigned const int index) const override;
+
+    QString getAudioDeviceName(int index) const override;
+
+    inline int getAudioDeviceIndex() const override
+    {
+        return 0;
+    }
+
+    inline void setAudioDeviceIndex(int) override
+    {
+    }
+
+    inline int getDevicesCount() const override
+    {
+        return 1;
+    }
+
+    inline bool canBeStarted() const override
+    {
+        return true;
+    }
+
+    inline bool hasControlPanel() const override
+    {
+        return false;
+    }
+
+    inline void openControlPanel(void *) override
+    {
+    }
+
+    static const int MAX_CHANNELS = 8;
+
+signals:
+    void renderFinished(); // emitted in the render thread
+
+private:
+    class RenderThread;
+    friend class RenderThread;
+
+    enum class SourceType {
+        Silence,
+        Sine,
+        Noise,
+        File
+    };
+
+    void render(); // called in the render thread
+    void fillInputBuffer(int frames);
+
+    SourceType sourceType;
+    SamplesBuffer fileSamples; // the entire file, using the input channels
+    qint64 sourcePosition;
+    quint32 noiseSeed;
+
+    int renderLength; // in seconds
+    QAtomicInt stopRequested;
+
+    RenderThread *renderThread;
+    RenderStatistics statistics;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,130 @@
+#include "RoomStreamPreviewer.h"
+#include "codec.h"
+#include "log/Logging.h"
+#include <QNetworkRequest>
+#include <QUrl>
+#include <algorithm>
+
+using namespace Audio;
+
+const int RoomStreamPreviewer::DEFAULT_MAX_PREVIEWS = 4;
+
+RoomStreamPreviewer::RoomStreamPreviewer(int maxPreviews, int decodingThreads) :
+    maxPreviews(std::max(1, maxPreviews)),
+    decoderPool(decodingThreads)
+{
+}
+
+RoomStreamPreviewer::~RoomStreamPreviewer()
+{
+    stopAllPreviews();
+}
+
+QSharedPointer<Mp3Stream> RoomStreamPreviewer::startPreview(const QString &streamUrl)
+{
+    if (streamUrl.isEmpty())
+        return QSharedPointer<Mp3Stream>();
+
+    if (previews.contains(streamUrl)) {
+        previewsOrder.removeOne(streamUrl); // the most recent used stream is moved to the list end
+        previewsOrder.append(streamUrl);
+        return previews[streamUrl].stream;
+    }
+
+    if (previews.size() >= maxPreviews)
+        stopOldestPreview();
+
+    qCDebug(jtNinjamRoomStreamer) << "starting preview of" << streamUrl;
+
+    Preview preview;
+    preview.stream = QSharedPointer<Mp3Stream>(new Mp3Stream(new Mp3DecoderMiniMp3()));
+    preview.reply = httpClient.get(QNetworkRequest(QUrl(streamUrl)));
+    preview.reply->setProperty("streamUrl", streamUrl);
+    connect(preview.reply, SIGNAL(readyRead()), this, SLOT(readDownloadedBytes()));
+    connect(preview.reply, SIGNAL(error(QNetworkReply::NetworkError)), this,
+            SLOT(handleNetworkError(QNetworkReply::NetworkError)));
+
+    previews.insert(streamUrl, preview);
+    previewsOrder.append(streamUrl);
+    decoderPool.addStream(preview.stream);
+
+    return preview.stream;
+}
+
+void RoomStreamPreviewer::stopPreview(const QString &streamUrl)
+{
+    if (!previews.contains(streamUrl))
+        return;
+
+    qCDebug(jtNinjamRoomStreamer) << "stopping preview of" << streamUrl;
+
+    Preview preview = previews.take(streamUrl);
+    previewsOrder.removeOne(streamUrl);
+
+    preview.reply->disconnect(this);
+    preview.reply->abort();
+    preview.reply->deleteLater();
+
+    // the stream is deleted when the last reference is released, an audible stream can be used by the streamer node
+    decoderPool.removeStream(preview.stream);
+}
+
+void RoomStreamPreviewer::stopAllPreviews()
+{
+    foreach (const QString &streamUrl, previews.keys())
+        stopPreview(streamUrl);
+}
+
+void RoomStreamPreviewer::stopOldestPreview()
+{
+    foreach (const QString &streamUrl, previewsOrder) {
+        if (!previews[streamUrl].stream->isAudible()) {
+            stopPreview(streamUrl);
+            return;
+        }
+    }
+}
+
+bool RoomStreamPreviewer::isPreviewing(const QString &streamUrl) const
+{
+    return previews.contains(streamUrl);
+}
+
+QStringList RoomStreamPreviewer::getPreviewedStreams() const
+{
+    return previewsOrder;
+}
+
+QSharedPointer<Mp3Stream> RoomStreamPreviewer::getStream(const QString &streamUrl) const
+{
+    if (previews.contains(streamUrl))
+        return previews[streamUrl].stream;
+    return QSharedPointer<Mp3Stream>();
+}
+
+QString RoomStreamPreviewer::getStreamUrl(QNetworkReply *reply) const
+{
+    if (!reply)
+        return QString();
+    return reply->property("streamUrl").toString();
+}
+
+void RoomStreamPreviewer::readDownloadedBytes()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    QString streamUrl = getStreamUrl(reply);
+    if (!previews.contains(streamUrl))
+        return;
+
+    previews[streamUrl].stream->addBytes(reply->readAll());
+    decoderPool.wakeUp();
+}
+
+void RoomStreamPreviewer::handleNetworkError(QNetworkReply::NetworkError)
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    QString streamUrl = getStreamUrl(reply);
+    QString errorMessage = reply ? reply->errorString() : QString();
+    qCCritical(jtNinjamRoomStreamer) << "ERROR in room stream" << streamUrl << errorMessage;
+    emit error(streamUrl, errorMessage);
+}
@@ -0,0 +1,72 @@
+#ifndef ROOM_STREAM_PREVIEWER_H
+#define ROOM_STREAM_PREVIEWER_H
+
+#include "Mp3DecoderPool.h"
+#include <QObject>
+#include <QMap>
+#include <QStringList>
+#include <QNetworkReply>
+#include <QNetworkAccessManager>
+
+namespace Audio {
+
+/**
+ * Keep some public rooms streams downloading and pre-buffered at low priority, all streams
+ * are decoded by a shared Mp3DecoderPool. The audible stream is selected in NinjamRoomStreamerNode,
+ * so switching between pre-buffered rooms is instantaneous.
+ */
+
+class RoomStreamPreviewer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RoomStreamPreviewer(int maxPreviews = DEFAULT_MAX_PREVIEWS,
+                                 int decodingThreads = Mp3DecoderPool::DEFAULT_THREADS);
+    ~RoomStreamPreviewer();
+
+    // start downloading and decoding the stream, or return the stream if it's already previewed
+    QSharedPointer<Mp3Stream> startPreview(const QString &streamUrl);
+
+    void stopPreview(const QString &streamUrl);
+    void stopAllPreviews();
+
+    bool isPreviewing(const QString &streamUrl) const;
+    QStringList getPreviewedStreams() const;
+    QSharedPointer<Mp3Stream> getStream(const QString &streamUrl) const;
+
+    inline int getMaxPreviews() const
+    {
+        return maxPreviews;
+    }
+
+    static const int DEFAULT_MAX_PREVIEWS;
+
+signals:
+    void error(const QString &streamUrl, const QString &errorMessage);
+
+private slots:
+    void readDownloadedBytes();
+    void handleNetworkError(QNetworkReply::NetworkError);
+
+private:
+    struct Preview
+    {
+        QNetworkReply *reply;
+        QSharedPointer<Mp3Stream> stream;
+    };
+
+    QMap<QString, Preview> previews;
+    QStringList previewsOrder; // the oldest non audible preview is stopped when 'maxPreviews' is reached
+
+    int maxPreviews;
+    QNetworkAccessManager httpClient;
+    Mp3DecoderPool decoderPool;
+
+    void stopOldestPreview();
+    QString getStreamUrl(QNetworkReply *reply) const;
+};
+
+}//namespace
+
+#endif
@@ -2,6 +2,7 @@
 #include "codec.h"
 #include "core/AudioDriver.h"
 #include "core/SamplesBuffer.h"
+#include "RoomStreamPreviewer.h"
 #include "log/Logging.h"
 
 #include <QNetworkAccessManager>
@@ -41,7 +42,8 @@ void AbstractMp3Streamer::stopCurrentStream()
     qCDebug(jtNinjamRoomStreamer) << "stopping room stream";
 
     if (device) {
-        decoder->reset();// discard unprocessed bytes
+        if (decoder)
+            decoder->reset();// discard unprocessed bytes
         device->deleteLater();
         device = nullptr;
         bufferedSamples.zero();// discard samples
@@ -74,7 +76,13 @@ void AbstractMp3Streamer::processReplacing(const Audio::SamplesBuffer &in,
 
     internalInputBuffer.setFrameLenght(samplesToRender);
     internalInputBuffer.set(bufferedSamples);
+    bufferedSamples.discardFirstSamples(samplesToRender);// keep non rendered samples for next audio callback
+
+    renderInternalInputBuffer(out, targetSampleRate);
+}
 
+void AbstractMp3Streamer::renderInternalInputBuffer(Audio::SamplesBuffer &out, int targetSampleRate)
+{
     if (needResamplingFor(targetSampleRate)) {
         const Audio::SamplesBuffer &resampledBuffer = resampler.resample(internalInputBuffer,
                                                                          out.getFrameLenght());
@@ -85,8 +93,6 @@ void AbstractMp3Streamer::processReplacing(const Audio::SamplesBuffer &in,
         internalOutputBuffer.set(internalInputBuffer);
     }
 
-    bufferedSamples.discardFirstSamples(samplesToRender);// keep non rendered samples for next audio callback
-
     if (internalOutputBuffer.getFrameLenght() < out.getFrameLenght())
         qCDebug(jtNinjamRoomStreamer) << out.getFrameLenght()
             - internalOutputBuffer.getFrameLenght() << " samples missing";
@@ -147,13 +153,14 @@ void AbstractMp3Streamer::setStreamPath(const QString &streamPath)
 
 // +++++++++++++++++++++++++++++++++++++++
 
-const int NinjamRoomStreamerNode::BUFFER_SIZE = 128000;
+const int NinjamRoomStreamerNode::PREBUFFERING_TIME = 3000;
 
-NinjamRoomStreamerNode::NinjamRoomStreamerNode(const QUrl &streamPath) :
-    AbstractMp3Streamer(new Mp3DecoderMiniMp3()),
-    httpClient(nullptr),
+NinjamRoomStreamerNode::NinjamRoomStreamerNode(RoomStreamPreviewer *previewer, const QUrl &streamPath) :
+    AbstractMp3Streamer(nullptr), // the streams are decoded by the previewer decoders pool
+    previewer(previewer),
     buffering(false)
 {
+    connect(previewer, SIGNAL(error(QString, QString)), this, SLOT(handleStreamError(QString, QString)));
     setStreamPath(streamPath.toString());
 }
 
@@ -164,48 +171,69 @@ bool NinjamRoomStreamerNode::needResamplingFor(int targetSampleRate) const
     return AbstractMp3Streamer::needResamplingFor(targetSampleRate);
 }
 
+int NinjamRoomStreamerNode::getSampleRate() const
+{
+    int sampleRate = currentStream ? currentStream->getSampleRate() : 0;
+    if (sampleRate <= 0)
+        return 44100;
+    return sampleRate;
+}
+
+int NinjamRoomStreamerNode::getPrebufferingFrames() const
+{
+    int frames = (qint64)getSampleRate() * PREBUFFERING_TIME / 1000;
+    if (currentStream)
+        return std::min(frames, currentStream->getRingBuffer().getCapacity());
+    return frames;
+}
+
 void NinjamRoomStreamerNode::initialize(const QString &streamPath)
 {
     AbstractMp3Streamer::initialize(streamPath);
     buffering = true;
-    bufferedSamples.zero();
-    bytesToDecode.clear();
     if (!streamPath.isEmpty()) {
         qCDebug(jtNinjamRoomStreamer) << "connecting in " << streamPath;
-        if (httpClient)
-            httpClient->deleteLater();
-        httpClient = new QNetworkAccessManager(this);
-        QNetworkReply *reply = httpClient->get(QNetworkRequest(QUrl(streamPath)));
-        QObject::connect(reply, SIGNAL(readyRead()), this, SLOT(on_reply_read()));
-        QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), this,
-                         SLOT(on_reply_error(QNetworkReply::NetworkError)));
-        this->device = reply;
+
+        // a pre-buffered stream is played instantly
+        QSharedPointer<Mp3Stream> stream = previewer->startPreview(streamPath);
+        QMutexLocker locker(&streamMutex);
+        stream->setAudible(true); // the decoder stop dropping samples, the audio thread is the ring consumer now
+
+        // the preview can have some seconds in the ring, just the prebuffering time is kept
+        SamplesRingBuffer &ringBuffer = stream->getRingBuffer();
+        currentStream = stream;
+        int framesToDiscard = ringBuffer.getAvailableFrames() - getPrebufferingFrames();
+        if (framesToDiscard > 0)
+            ringBuffer.discard(framesToDiscard);
+
+        currentStreamUrl = streamPath;
     }
 }
 
-void NinjamRoomStreamerNode::on_reply_error(QNetworkReply::NetworkError /*error*/)
+void NinjamRoomStreamerNode::stopCurrentStream()
 {
-    QString msg = "ERROR playing room stream";
-    qCCritical(jtNinjamRoomStreamer) << msg;
-    emit error(msg);
+    qCDebug(jtNinjamRoomStreamer) << "stopping room stream";
+
+    QMutexLocker locker(&streamMutex); // the audio thread is not reading the stream ring while the mutex is locked
+    if (currentStream) {
+        currentStream->setAudible(false); // the stream is still pre-buffered by the previewer
+        currentStream.clear();
+    }
+    currentStreamUrl.clear();
+    streaming = false;
+    buffering = true;
+    lastPeak.zero();
 }
 
-void NinjamRoomStreamerNode::on_reply_read()
+void NinjamRoomStreamerNode::handleStreamError(const QString &streamUrl, const QString &errorMessage)
 {
-    if (!device) {
-        qCDebug(jtNinjamRoomStreamer) << "device is null!";
-        return;
-    }
-    if (device->isOpen() && device->isReadable()) {
-        QMutexLocker locker(&mutex);
-        bytesToDecode.append(device->readAll());
-        if (buffering) {
-            qCDebug(jtNinjamRoomStreamer) << "bytes downloaded  bytesToDecode:"<<bytesToDecode.size()
-                                      << " bufferedSamples: " << bufferedSamples.getFrameLenght();
-        }
-    } else {
-        qCCritical(jtNinjamRoomStreamer) << "problem in device!";
-    }
+    Q_UNUSED(errorMessage)
+    if (streamUrl != currentStreamUrl)
+        return; // error in a non audible preview
+
+    QString msg = "ERROR playing room stream";
+    qCCritical(jtNinjamRoomStreamer) << msg;
+    emit error(msg);
 }
 
 NinjamRoomStreamerNode::~NinjamRoomStreamerNode()
@@ -216,30 +244,42 @@ void NinjamRoomStreamerNode::processReplacing(const SamplesBuffer &in, SamplesBu
                                               int sampleRate, const Midi::MidiMessageBuffer &midiBuffer)
 {
     Q_UNUSED(in)
-    QMutexLocker locker(&mutex);
-    if (buffering && bytesToDecode.size() >= BUFFER_SIZE)
-        buffering = false;
-    if (!buffering && bytesToDecode.isEmpty())
-        buffering = true;
-    if (buffering)
+    Q_UNUSED(midiBuffer)
+
+    if (!streamMutex.tryLock()) // the stream is changing
         return;
-    int samplesToRender = getSamplesToRender(sampleRate, out.getFrameLenght());
-    while (bufferedSamples.getFrameLenght() < samplesToRender) {// need decoding?
-        decode(256);
-        if (bytesToDecode.isEmpty()) {// no more bytes to decode
-            qCritical() << "no more bytes to decode and not enough buffered samples. Buffering ...";
-            buffering = true;
-            break;
+
+    Mp3Stream *stream = currentStream.data();
+    if (stream && streaming) {
+        SamplesRingBuffer &ringBuffer = stream->getRingBuffer();
+        int availableFrames = ringBuffer.getAvailableFrames();
+        if (buffering && availableFrames >= getPrebufferingFrames())
+            buffering = false;
+
+        if (!buffering) {
+            int samplesToRender = getSamplesToRender(sampleRate, out.getFrameLenght());
+            if (availableFrames < samplesToRender) {
+                qCDebug(jtNinjamRoomStreamer) << "not enough decoded samples. Buffering ...";
+                buffering = true;
+            } else if (samplesToRender > 0) {
+                internalInputBuffer.setFrameLenght(samplesToRender);
+                ringBuffer.read(internalInputBuffer, samplesToRender);
+                renderInternalInputBuffer(out, sampleRate);
+            }
         }
     }
-    if (!bufferedSamples.isEmpty())
-        AbstractMp3Streamer::processReplacing(in, out, sampleRate, midiBuffer);
+
+    streamMutex.unlock();
 }
 
 int NinjamRoomStreamerNode::getBufferingPercentage() const
 {
-    if (buffering)
-        return bytesToDecode.size()/(float)BUFFER_SIZE * 100;
+    if (buffering) {
+        if (!currentStream)
+            return 0;
+        int availableFrames = currentStream->getRingBuffer().getAvailableFrames();
+        return std::min(100, availableFrames * 100 / getPrebufferingFrames());
+    }
 
     if (!streaming)
         return 0;
@@ -6,17 +6,20 @@
 #include <QNetworkAccessManager>
 // #include <deque>
 #include "SamplesBufferResampler.h"
+#include "Mp3DecoderPool.h"
+#include <QMutex>
 
 class QIODevice;
 
 namespace Audio {
 class Mp3Decoder;
+class RoomStreamPreviewer;
 
 class AbstractMp3Streamer : public AudioNode
 {
     Q_OBJECT
 public:
-    explicit AbstractMp3Streamer(Audio::Mp3Decoder *decoder);
+    explicit AbstractMp3Streamer(Audio::Mp3Decoder *decoder); // the decoder is null when the subclass is not decoding (the stream is decoded by other object)
     ~AbstractMp3Streamer();
     virtual void processReplacing(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &out,
                                   int sampleRate, const Midi::MidiMessageBuffer &midiBuffer);
@@ -50,6 +53,9 @@ protected:
     SamplesBufferResampler resampler;
 
     int getSamplesToRender(int targetSampleRate, int outLenght);
+
+    // resample (if necessary) the samples in internalInputBuffer and add in 'out'
+    void renderInternalInputBuffer(Audio::SamplesBuffer &out, int targetSampleRate);
 };
 
 // +++++++++++++++++++++++++++++++++++++++++++++
@@ -58,7 +64,8 @@ class NinjamRoomStreamerNode : public AbstractMp3Streamer
     Q_OBJECT
 
 public:
-    NinjamRoomStreamerNode(const QUrl &streamPath = QUrl(""));
+    // the streams are downloaded and decoded by the previewer, this node just play the audible stream
+    explicit NinjamRoomStreamerNode(Audio::RoomStreamPreviewer *previewer, const QUrl &streamPath = QUrl(""));
     ~NinjamRoomStreamerNode();
 
     virtual void processReplacing(const SamplesBuffer &in, SamplesBuffer &out, int sampleRate,
@@ -69,17 +76,27 @@ public:
 
     int getBufferingPercentage() const override;
 
+    void stopCurrentStream() override;
+
+    int getSampleRate() const override;
+
 protected:
     void initialize(const QString &streamPath);
 private:
-    QNetworkAccessManager *httpClient;
+    Audio::RoomStreamPreviewer *previewer;
     bool buffering;
 
-    static const int BUFFER_SIZE;
+    QString currentStreamUrl;
+    QSharedPointer<Mp3Stream> currentStream; // the audible stream, the audio thread just read the decoded samples from the stream ring
+
+    QMutex streamMutex; // locked when the stream is changed, the audio thread skip the node instead of wait
+
+    int getPrebufferingFrames() const; // how many decoded frames are necessary to start (or restart) the playback
+
+    static const int PREBUFFERING_TIME; // in milliseconds
 
 private slots:
-    void on_reply_error(QNetworkReply::NetworkError);
-    void on_reply_read();
+    void handleStreamError(const QString &streamUrl, const QString &errorMessage);
 };
 // ++++++++++++++++++++++++++++
 class AudioFileStreamerNode : public AbstractMp3Streamer
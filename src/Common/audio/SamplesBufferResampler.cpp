@@ -1,6 +1,7 @@
 #include "SamplesBufferResampler.h"
 #include <algorithm>
 #include <QDebug>
+#include "performance/Profiler.h"
 
 SamplesBufferResampler::SamplesBufferResampler() :
     outBuffer(2, 4096 * 2)
@@ -14,6 +15,7 @@ SamplesBufferResampler::~SamplesBufferResampler()
 const Audio::SamplesBuffer &SamplesBufferResampler::resample(const Audio::SamplesBuffer &in,
                                                              int desiredOutLenght)
 {
+    JT_PROFILE_SCOPE("SamplesBufferResampler::resample");
     outBuffer.zero();
     outBuffer.setFrameLenght(desiredOutLenght * 2);// enough space
     int channels = std::min(in.getChannels(), outBuffer.getChannels());
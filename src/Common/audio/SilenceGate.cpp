@@ -0,0 +1,39 @@
+#include "SilenceGate.h"
+#include "audio/core/SamplesBuffer.h"
+
+using namespace Audio;
+
+const float SilenceGate::DEFAULT_THRESHOLD = 0.00001f;
+
+SilenceGate::SilenceGate(float threshold) :
+    threshold(threshold),
+    gating(false),
+    heldSilence(0)
+{
+}
+
+SilenceGate::Action SilenceGate::process(const SamplesBuffer &samples, bool isFirstPart, bool isLastPart)
+{
+    if (isFirstPart) {
+        gating = true;
+        heldSilence = 0;
+    }
+
+    if (!gating)
+        return ENCODE;
+
+    if (samples.isSilent(threshold)) {
+        heldSilence += samples.getFrameLenght();
+        return isLastPart ? SEND_SILENT_INTERVAL : HOLD_SILENCE;
+    }
+
+    gating = false; // sound detected
+    return ENCODE_HELD_SILENCE;
+}
+
+long SilenceGate::takeHeldSilence()
+{
+    long frames = heldSilence;
+    heldSilence = 0;
+    return frames;
+}
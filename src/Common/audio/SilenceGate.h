@@ -0,0 +1,49 @@
+#ifndef _SILENCE_GATE_H_
+#define _SILENCE_GATE_H_
+
+namespace Audio {
+
+class SamplesBuffer;
+
+/**
+ * Decide how the samples of an encoded interval are sent to the encoder. The silence in the
+ * interval start is held (not encoded) until some sound is detected, then the held silence is
+ * encoded before the samples. When the whole interval is silent an empty interval is sent, so
+ * the encoder and all the receivers decoders are idle. Used only in the audio thread.
+ */
+
+class SilenceGate
+{
+public:
+    explicit SilenceGate(float threshold = DEFAULT_THRESHOLD);
+
+    enum Action
+    {
+        HOLD_SILENCE, // silent samples in the interval start, nothing is encoded
+        SEND_SILENT_INTERVAL, // the whole interval is silent
+        ENCODE_HELD_SILENCE, // the first sound in the interval, encode the held silence and the samples
+        ENCODE // the gate is open, encode the samples
+    };
+
+    // a partial interval (the transmission started in the middle of the interval) is not gated
+    Action process(const SamplesBuffer &samples, bool isFirstPart, bool isLastPart);
+
+    // the silent frames to encode before the samples when the gate is opened, zeroed by this call
+    long takeHeldSilence();
+
+    inline bool isGating() const
+    {
+        return gating;
+    }
+
+    static const float DEFAULT_THRESHOLD; // -100 dB
+
+private:
+    float threshold;
+    bool gating; // the encoded interval is silent until now
+    long heldSilence; // silent frames not sent to encoder yet
+};
+
+} // namespace
+
+#endif
@@ -8,13 +8,13 @@
 using namespace Audio;
 
 const int Mp3DecoderMiniMp3::MINIMUM_SIZE_TO_DECODE = 1024 + 256;
-const int Mp3DecoderMiniMp3::AUDIO_SAMPLES_BUFFER_MAX_SIZE = 4096 * 2;
 const int Mp3DecoderMiniMp3::INTERNAL_SHORT_BUFFER_SIZE = MP3_MAX_SAMPLES_PER_FRAME *8 * 2;
 
 Mp3DecoderMiniMp3::Mp3DecoderMiniMp3() :
     mp3Decoder(nullptr),
     buffer(nullptr),
-    NULL_BUFFER(nullptr)
+    NULL_BUFFER(nullptr),
+    arrayOffset(0)
 {
     mp3Decoder = mp3_create();
     internalShortBuffer = new signed short[INTERNAL_SHORT_BUFFER_SIZE];// recommend by the minimp3 author
@@ -33,6 +33,7 @@ Mp3DecoderMiniMp3::~Mp3DecoderMiniMp3()
 void Mp3DecoderMiniMp3::reset()
 {
     array.clear();
+    arrayOffset = 0;
     for (int i = 0; i < INTERNAL_SHORT_BUFFER_SIZE; ++i)
         internalShortBuffer[i] = 0;
     if (buffer) {
@@ -51,15 +52,19 @@ int Mp3DecoderMiniMp3::getSampleRate() const
 const SamplesBuffer *Mp3DecoderMiniMp3::decode(char *inputBuffer, int inputBufferLenght)
 {
     array.append(inputBuffer, inputBufferLenght);
-    if (array.size() < MINIMUM_SIZE_TO_DECODE)
+    int bytesLeft = array.size() - arrayOffset;
+    if (bytesLeft < MINIMUM_SIZE_TO_DECODE)
         return NULL_BUFFER;
     int totalBytesDecoded = 0;
     int bytesDecoded = 0;
     signed short *out = internalShortBuffer;
-    char *in = array.data();
+    const signed short *outEnd = internalShortBuffer + INTERNAL_SHORT_BUFFER_SIZE;
+    char *in = array.data() + arrayOffset;
     int totalSamplesDecoded = 0;
-    int bytesLeft = array.size() - totalBytesDecoded;
     do {
+        // the remaining frames are decoded in the next call, the short buffer is never truncated
+        if (out + MP3_MAX_SAMPLES_PER_FRAME > outEnd)
+            break;
         bytesDecoded = mp3_decode((void **)mp3Decoder, in, bytesLeft, out, &mp3Info);
         if (bytesDecoded > 0) {
             bytesLeft -= bytesDecoded;
@@ -70,24 +75,22 @@ const SamplesBuffer *Mp3DecoderMiniMp3::decode(char *inputBuffer, int inputBuffe
             totalBytesDecoded += bytesDecoded;
         }
     } while (bytesDecoded > 0 && bytesLeft > 0);
-    array = array.right(array.size() - totalBytesDecoded);// keep just the undecoded bytes to the next call for decode
-    if (totalBytesDecoded <= 0)
+
+    // keep just the undecoded bytes to the next call for decode
+    arrayOffset += totalBytesDecoded;
+    if (arrayOffset >= array.size()/2) {
+        array.remove(0, arrayOffset);
+        arrayOffset = 0;
+    }
+
+    if (totalBytesDecoded <= 0 || mp3Info.channels <= 0)
         return NULL_BUFFER;
     // +++++++++++++++++++++++++++
     int framesDecoded = totalSamplesDecoded/mp3Info.channels;
 
     if (!buffer)
         buffer = new Audio::SamplesBuffer(mp3Info.channels);
-    if (framesDecoded > AUDIO_SAMPLES_BUFFER_MAX_SIZE)
-        framesDecoded = AUDIO_SAMPLES_BUFFER_MAX_SIZE;
-    buffer->setFrameLenght(framesDecoded);
-    int internalIndex = 0;
-    for (int i = 0; i < framesDecoded; ++i) {
-        for (int c = 0; c < buffer->getChannels(); ++c)
-            buffer->set(c, i, (float)internalShortBuffer[internalIndex++] / SHRT_MAX);
-    }
+    buffer->setInterleaved(internalShortBuffer, framesDecoded, mp3Info.channels);
 
     return buffer;
 }
-
-
@@ -32,7 +32,6 @@ public:
     virtual int getSampleRate() const;
 private:
     static const int MINIMUM_SIZE_TO_DECODE;
-    static const int AUDIO_SAMPLES_BUFFER_MAX_SIZE;
     static const int INTERNAL_SHORT_BUFFER_SIZE;
     mp3_decoder_t mp3Decoder;
     mp3_info_t mp3Info;
@@ -40,6 +39,7 @@ private:
     Audio::SamplesBuffer *buffer;
     Audio::SamplesBuffer *NULL_BUFFER;
     QByteArray array;
+    int arrayOffset; // the decoded bytes are skipped, the array is compacted only when half of it was decoded
 };
 }
 
@@ -0,0 +1,108 @@
+#include "AllocationCounter.h"
+
+#ifdef JT_COUNT_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+static thread_local quint64 threadAllocations = 0;
+
+#ifdef __GLIBC__
+
+// glibc allows replacing malloc in the executable, the Qt containers (QByteArray, QVector, QList)
+// are using malloc/realloc directly and the operator new is calling malloc too.
+
+extern "C" {
+
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *memory, size_t size);
+
+void *malloc(size_t size)
+{
+    threadAllocations++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    threadAllocations++;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *memory, size_t size)
+{
+    threadAllocations++; // counted even when the block is grown in place
+    return __libc_realloc(memory, size);
+}
+
+} // extern "C"
+
+bool Audio::AllocationCounter::isCountingMalloc()
+{
+    return true;
+}
+
+#else
+
+// only the operator new is replaced, malloc and realloc (used by the Qt containers) are not counted
+
+void *operator new(std::size_t size)
+{
+    threadAllocations++;
+    void *memory = std::malloc(size ? size : 1);
+    if (!memory)
+        throw std::bad_alloc();
+    return memory;
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    std::free(memory);
+}
+
+bool Audio::AllocationCounter::isCountingMalloc()
+{
+    return false;
+}
+
+#endif
+
+bool Audio::AllocationCounter::isEnabled()
+{
+    return true;
+}
+
+quint64 Audio::AllocationCounter::getThreadAllocations()
+{
+    return threadAllocations;
+}
+
+#else
+
+bool Audio::AllocationCounter::isEnabled()
+{
+    return false;
+}
+
+bool Audio::AllocationCounter::isCountingMalloc()
+{
+    return false;
+}
+
+quint64 Audio::AllocationCounter::getThreadAllocations()
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef _ALLOCATION_COUNTER_H_
+#define _ALLOCATION_COUNTER_H_
+
+#include <QtGlobal>
+
+namespace Audio {
+
+/**
+ * Count the memory allocations made by each thread. The allocators are replaced only when
+ * JT_COUNT_ALLOCATIONS is defined (benchmark builds), otherwise nothing is counted. With glibc
+ * malloc, calloc and realloc are counted, in other platforms only the operator new is counted.
+ */
+
+namespace AllocationCounter {
+
+bool isEnabled();
+bool isCountingMalloc(); // false when the Qt containers allocations are not counted
+quint64 getThreadAllocations(); // allocations made by the current thread
+
+} // namespace
+
+} // namespace
+
+#endif
@@ -2,6 +2,7 @@
 #define AUDIO_DRIVER_H
 
 #include "SamplesBuffer.h"
+#include "DspLoadMeter.h"
 #include <QObject>
 #include <QMutex>
 
@@ -128,6 +129,12 @@ public:
 
     virtual bool hasControlPanel() const = 0; // ASIO drivers can open control panels to change audio device parameters
     virtual void openControlPanel(void *mainWindowHandle) = 0;
+
+    inline float getDspLoad() const // the audio callback execution time divided by the buffer period
+    {
+        return dspLoadMeter.getLoad();
+    }
+
 protected:
     ChannelRange globalInputRange;// the range of input channels selected in audio preferences menu
     ChannelRange globalOutputRange;// the range of output channels selected in audio preferences menu
@@ -142,6 +149,8 @@ protected:
 
     void recreateBuffers();
 
+    DspLoadMeter dspLoadMeter; // updated in the audio callbacks
+
     Controller::MainController *mainController;
 };
 
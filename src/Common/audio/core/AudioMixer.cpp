@@ -11,6 +11,10 @@ using namespace Audio;
 AudioMixer::AudioMixer(int sampleRate) :
     sampleRate(sampleRate)
 {
+    for (int bus = 0; bus < MAX_OUTPUT_BUSES; ++bus) {
+        float *unboundChannels[2] = {nullptr, nullptr};
+        busesViews.append(new SamplesBuffer(unboundChannels, 2, 0));
+    }
 }
 
 void AudioMixer::addNode(AudioNode *node)
@@ -23,6 +27,7 @@ void AudioMixer::removeNode(AudioNode *node)
 {
     SamplesBufferResampler *resampler = resamplers[node];
     nodes.removeOne(node);
+    outputBuses.remove(node);
     if (resampler) {
         resamplers[node] = nullptr;
         delete resampler;
@@ -34,9 +39,33 @@ AudioMixer::~AudioMixer()
     qCDebug(jtAudio) << "Audio mixer destructor...";
     foreach (Audio::AudioNode *node, resamplers.keys())
         removeNode(node);
+    qDeleteAll(busesViews);
     qCDebug(jtAudio) << "Audio mixer destructor finished!";
 }
 
+void AudioMixer::setOutputBus(AudioNode *node, int bus)
+{
+    if (bus <= MASTER_BUS || bus >= MAX_OUTPUT_BUSES)
+        outputBuses.remove(node);
+    else
+        outputBuses.insert(node, bus);
+}
+
+SamplesBuffer &AudioMixer::getOutputBus(SamplesBuffer &out, int bus)
+{
+    int buses = qMin(out.getChannels() / 2, MAX_OUTPUT_BUSES);
+    if (buses <= 1) // mono or stereo output, only the master bus
+        return out;
+
+    if (bus < 0 || bus >= buses)
+        bus = MASTER_BUS;
+
+    float *channels[2] = {out.getSamplesArray(bus * 2), out.getSamplesArray(bus * 2 + 1)};
+    SamplesBuffer *view = busesViews.at(bus);
+    view->bind(channels, out.getFrameLenght());
+    return *view;
+}
+
 void AudioMixer::process(const SamplesBuffer &in, SamplesBuffer &out, int sampleRate,
                          const Midi::MidiMessageBuffer &midiBuffer, bool attenuateAfterSumming)
 {
@@ -44,16 +73,20 @@ void AudioMixer::process(const SamplesBuffer &in, SamplesBuffer &out, int sample
     // --------------------------------------
     bool hasSoloedBuffers = soloedBuffersInLastProcess > 0;
     soloedBuffersInLastProcess = 0;
+    bool hasOutputBuses = !outputBuses.isEmpty() && out.getChannels() > 2;
     foreach (AudioNode *node, nodes) {
         bool canProcess = (!hasSoloedBuffers && !node->isMuted())
                           || (hasSoloedBuffers && node->isSoloed());
+        qint64 processingStart = DspLoadMeter::now();
         if (canProcess) {
-            node->processReplacing(in, out, sampleRate, midiBuffer);
+            int bus = hasOutputBuses ? outputBuses.value(node, MASTER_BUS) : MASTER_BUS;
+            node->processReplacing(in, getOutputBus(out, bus), sampleRate, midiBuffer);
         } else {// just discard the samples if node is muted, the internalBuffer is not copyed to out buffer
             static Audio::SamplesBuffer internalBuffer(2);
             internalBuffer.setFrameLenght(out.getFrameLenght());
             node->processReplacing(in, internalBuffer, sampleRate, midiBuffer);
         }
+        node->updateDspLoad(DspLoadMeter::now() - processingStart, out.getFrameLenght(), sampleRate);// the per track load, used to find who is eating the audio callback time
         if (node->isSoloed())
             soloedBuffersInLastProcess++;
     }
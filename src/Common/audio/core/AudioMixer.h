@@ -31,6 +31,14 @@ public:
     void addNode(AudioNode *node);
     void removeNode(AudioNode *node);
 
+    /** The output buffer can have more than one stereo pair (multi output VST plugin). The first pair
+        is the master mix, the nodes routed to other pairs are not summed in the master mix. */
+    void setOutputBus(AudioNode *node, int bus);
+    SamplesBuffer &getOutputBus(SamplesBuffer &out, int bus);
+
+    static const int MASTER_BUS = 0;
+    static const int MAX_OUTPUT_BUSES = 8; // the VST plugin multi outputs (master mix and 7 remote users)
+
     inline void setSampleRate(int newSampleRate)
     {
         this->sampleRate = newSampleRate;
@@ -40,6 +48,8 @@ private:
     QList<AudioNode *> nodes;
     int sampleRate;
     QMap<AudioNode *, SamplesBufferResampler *> resamplers;
+    QMap<AudioNode *, int> outputBuses; // only the nodes not routed to master bus
+    QList<SamplesBuffer *> busesViews; // created in the constructor, bound to the output channels in each process()
     Controller::MainController *mainController;
 };
 // +++++++++++++++++++++++
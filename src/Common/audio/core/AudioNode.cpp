@@ -10,6 +10,7 @@
 #include <QMutexLocker>
 
 #include "audio/Resampler.h"
+#include "performance/Profiler.h"
 
 using namespace Audio;
 
@@ -26,6 +27,8 @@ void AudioNode::processReplacing(const SamplesBuffer &in, SamplesBuffer &out, in
     if (!isActivated())
         return;
 
+    JT_PROFILE_OBJECT_SCOPE(this);
+
     internalInputBuffer.setFrameLenght(out.getFrameLenght());
     internalOutputBuffer.setFrameLenght(out.getFrameLenght());
 
@@ -50,7 +53,7 @@ void AudioNode::processReplacing(const SamplesBuffer &in, SamplesBuffer &out, in
             tempInputBuffer.setFrameLenght(internalOutputBuffer.getFrameLenght());
             tempInputBuffer.set(internalOutputBuffer); //the output from previous plugin is used as input to the next plugin in the chain
 
-            processor->process(tempInputBuffer, internalOutputBuffer, midiMessages);
+            processor->processBuffered(tempInputBuffer, internalOutputBuffer, midiMessages);
 
             // some plugins are blocking the midi messages. If a VSTi can't generate messages the previous messages list will be sended for the next plugin in the chain. The messages list is cleared only when the plugin can generate midi messages.
             if (processor->isVirtualInstrument() && processor->canGenerateMidiMessages())
@@ -233,6 +236,17 @@ void AudioNode::updateProcessorsGui()
     }
 }
 
+int AudioNode::getProcessorsLatency() const
+{
+    int latency = 0;
+    for (int i = 0; i < MAX_PROCESSORS_PER_TRACK; ++i) {
+        AudioNodeProcessor *processor = processors[i];
+        if (processor && !processor->isBypassed())
+            latency += processor->getLatency();
+    }
+    return latency;
+}
+
 void AudioNode::resumeProcessors()
 {
     for (int i = 0; i < MAX_PROCESSORS_PER_TRACK; ++i) {
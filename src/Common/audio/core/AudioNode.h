@@ -5,6 +5,7 @@
 #include <QMutex>
 #include "SamplesBuffer.h"
 #include "AudioDriver.h"
+#include "DspLoadMeter.h"
 #include "midi/MidiMessage.h"
 #include <QDebug>
 #include <QList>
@@ -51,6 +52,7 @@ public:
     void suspendProcessors();
     void resumeProcessors();
     virtual void updateProcessorsGui();
+    int getProcessorsLatency() const; // sum of the latencies (in samples) reported by the active processors
 
     void setGain(float gainValue);
     inline void setBoost(float boostValue)
@@ -76,6 +78,16 @@ public:
 
     AudioPeak getLastPeak() const;
 
+    inline float getDspLoad() const // the node processing time divided by the buffer period
+    {
+        return dspLoadMeter.getLoad();
+    }
+
+    inline void updateDspLoad(qint64 processingNanoseconds, int frames, int sampleRate)
+    {
+        dspLoadMeter.update(processingNanoseconds, frames, sampleRate);
+    }
+
     void resetLastPeak();
 
     void setRmsWindowSize(int samples);
@@ -110,6 +122,7 @@ protected:
     SamplesBuffer internalOutputBuffer;
 
     mutable Audio::AudioPeak lastPeak;
+    DspLoadMeter dspLoadMeter;
     QMutex mutex; // used to protected connections manipulation because nodes can be added or removed by different threads
 private:
     AudioNode(const AudioNode &other);
@@ -2,16 +2,59 @@
 
 #include "midi/MidiDriver.h"
 #include "audio/core/SamplesBuffer.h"
+#include "audio/core/FixedBlockAdapter.h"
+#include "performance/Profiler.h"
 
 using namespace Audio;
 
 AudioNodeProcessor::AudioNodeProcessor() :
-    bypassed(false)
+    bypassed(false),
+    fixedBlockSize(0),
+    fixedBlockAdapter(nullptr)
 {
 }
 
+AudioNodeProcessor::~AudioNodeProcessor()
+{
+    delete fixedBlockAdapter.fetchAndStoreOrdered(nullptr);
+}
+
 void AudioNodeProcessor::setBypass(bool state)
 {
     if (state != bypassed)
         bypassed = state;
 }
+
+void AudioNodeProcessor::setFixedBlockSize(int blockSize)
+{
+    if (blockSize > 0)
+        blockSize = FixedBlockAdapter::toPowerOfTwo(blockSize);
+    else
+        blockSize = 0;
+
+    if (blockSize == fixedBlockSize.load())
+        return;
+
+    FixedBlockAdapter *newAdapter = blockSize > 0 ? new FixedBlockAdapter(FIXED_BLOCK_CHANNELS, blockSize) : nullptr;
+    fixedBlockSize.store(blockSize);
+    delete fixedBlockAdapter.fetchAndStoreOrdered(newAdapter); // the audio thread is not using the old adapter, see the header
+}
+
+int AudioNodeProcessor::getLatency() const
+{
+    return FixedBlockAdapter::computeLatency(getFixedBlockSize());
+}
+
+void AudioNodeProcessor::processBuffered(const SamplesBuffer &in, SamplesBuffer &out,
+                                         const QList<Midi::MidiMessage> &midiMessages)
+{
+    JT_PROFILE_OBJECT_SCOPE(this); // the class name identify the plugin type, the instance address identify the plugin
+
+    FixedBlockAdapter *adapter = fixedBlockAdapter.loadAcquire();
+    if (!adapter || out.getChannels() > adapter->getChannels()) { // mono buffers are processed as stereo
+        process(in, out, midiMessages);
+        return;
+    }
+
+    adapter->process(this, in, out, midiMessages);
+}
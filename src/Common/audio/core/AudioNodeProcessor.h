@@ -2,20 +2,21 @@
 #define _AUDIO_NODE_PROCESSOR_H_
 
 #include <QObject>
+#include <QAtomicInt>
+#include <QAtomicPointer>
 #include "midi/MidiMessage.h"
 
 
 namespace Audio {
 
 class SamplesBuffer;
+class FixedBlockAdapter;
 
 class AudioNodeProcessor : public QObject  // TODO - this inheritance is really necessary?
 {
 public:
     AudioNodeProcessor();
-    virtual ~AudioNodeProcessor()
-    {
-    }
+    virtual ~AudioNodeProcessor();
 
     virtual void process(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &out,
                          const QList<Midi::MidiMessage> &midiMessages) = 0;
@@ -44,8 +45,34 @@ public:
         return false;
     }
 
+    // called by AudioNode, the samples are routed through the fixed block adapter when it is enabled
+    void processBuffered(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &out,
+                         const QList<Midi::MidiMessage> &midiMessages);
+
+    // 0 disable the fixed block adapter, other values are rounded up to the next power of two. Called
+    // before the processor is added in a track, or with the audio processing locked (like the plugins loading)
+    virtual void setFixedBlockSize(int blockSize);
+
+    inline int getFixedBlockSize() const
+    {
+        return fixedBlockSize.load();
+    }
+
+    inline bool isUsingFixedBlockSize() const
+    {
+        return getFixedBlockSize() > 0;
+    }
+
+    virtual int getLatency() const; // latency in samples
+
 protected:
     bool bypassed;
+
+private:
+    QAtomicInt fixedBlockSize;
+    QAtomicPointer<FixedBlockAdapter> fixedBlockAdapter; // created in the GUI thread, the audio thread is never allocating
+
+    static const int FIXED_BLOCK_CHANNELS = 2; // the tracks processing chain is stereo
 };
 
 }//namespace
@@ -0,0 +1,60 @@
+#include "DelayLine.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace Audio;
+
+DelayLine::DelayLine(int channels) :
+    buffer(channels),
+    delay(0),
+    position(0)
+{
+}
+
+void DelayLine::setDelay(int delayInSamples)
+{
+    delayInSamples = std::max(0, delayInSamples);
+    if (delayInSamples == delay)
+        return;
+
+    delay = delayInSamples;
+    position = 0;
+    buffer.setFrameLenght(delay);
+    buffer.zero();
+}
+
+void DelayLine::process(const SamplesBuffer &in, SamplesBuffer &out)
+{
+    out.setFrameLenght(in.getFrameLenght());
+    if (delay <= 0) {
+        out.set(in);
+        return;
+    }
+
+    const int frames = in.getFrameLenght();
+    if (frames <= 0)
+        return;
+
+    const int channels = std::min(in.getChannels(), std::min(out.getChannels(), buffer.getChannels()));
+    int newPosition = position;
+    for (int c = 0; c < channels; ++c) {
+        float *inSamples = in.getSamplesArray(c);
+        float *outSamples = out.getSamplesArray(c);
+        float *delayedSamples = buffer.getSamplesArray(c);
+        int index = position;
+        int processed = 0;
+        while (processed < frames) {
+            // copy in contiguous pieces, the circular buffer wraps at 'delay'
+            int piece = std::min(frames - processed, delay - index);
+            for (int s = 0; s < piece; ++s) {
+                float inSample = inSamples[processed + s];
+                outSamples[processed + s] = delayedSamples[index + s];
+                delayedSamples[index + s] = inSample;
+            }
+            processed += piece;
+            index = (index + piece) % delay;
+        }
+        newPosition = index;
+    }
+    position = newPosition;
+}
@@ -0,0 +1,31 @@
+#ifndef _DELAY_LINE_H_
+#define _DELAY_LINE_H_
+
+#include "SamplesBuffer.h"
+
+namespace Audio {
+
+// a circular buffer delaying the samples by a fixed amount, used to compensate the plugins latency
+class DelayLine
+{
+public:
+    explicit DelayLine(int channels);
+
+    void setDelay(int delayInSamples); // the delayed samples are discarded when the delay changes
+
+    inline int getDelay() const
+    {
+        return delay;
+    }
+
+    void process(const SamplesBuffer &in, SamplesBuffer &out); // 'out' receive 'in' samples delayed
+
+private:
+    SamplesBuffer buffer;
+    int delay;
+    int position; // read and write position in the circular buffer
+};
+
+}//namespace
+
+#endif
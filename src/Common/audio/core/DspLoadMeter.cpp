@@ -0,0 +1,40 @@
+#include "DspLoadMeter.h"
+#include <chrono>
+
+using namespace Audio;
+
+const double DspLoadMeter::SMOOTHING = 0.05;
+
+DspLoadMeter::DspLoadMeter() :
+    smoothedLoad(0),
+    publishedLoad(0)
+{
+}
+
+void DspLoadMeter::update(qint64 processingNanoseconds, int frames, int sampleRate)
+{
+    if (frames <= 0 || sampleRate <= 0)
+        return;
+
+    double bufferPeriod = frames * 1000000000.0 / sampleRate;
+    double load = processingNanoseconds / bufferPeriod;
+    smoothedLoad += (load - smoothedLoad) * SMOOTHING;
+    publishedLoad.store(qRound(smoothedLoad * 10000));
+}
+
+float DspLoadMeter::getLoad() const
+{
+    return publishedLoad.load() / 10000.0f;
+}
+
+void DspLoadMeter::reset()
+{
+    smoothedLoad = 0;
+    publishedLoad.store(0);
+}
+
+qint64 DspLoadMeter::now()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,37 @@
+#ifndef _DSP_LOAD_METER_H_
+#define _DSP_LOAD_METER_H_
+
+#include <QAtomicInt>
+#include <QtGlobal>
+
+namespace Audio {
+
+/**
+ * The DSP load is the processing time divided by the buffer period. A load of 1.0 means
+ * all the buffer period was used to process the buffer, bigger values are xruns.
+ * The meter is updated in the audio thread and read in any thread without locks.
+ */
+
+class DspLoadMeter
+{
+public:
+    DspLoadMeter();
+
+    void update(qint64 processingNanoseconds, int frames, int sampleRate); // audio thread only
+
+    float getLoad() const; // smoothed load
+
+    void reset(); // audio thread only
+
+    static qint64 now(); // steady clock timestamp in nanoseconds
+
+private:
+    double smoothedLoad; // audio thread state
+    QAtomicInt publishedLoad; // in 1/10000
+
+    static const double SMOOTHING; // exponential moving average weight of the last buffer
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef _EVENTS_QUEUE_H_
+#define _EVENTS_QUEUE_H_
+
+#include <QAtomicPointer>
+
+namespace Audio {
+
+/**
+ * Multiple producers/single consumer queue used to send objects to the audio thread. The queued
+ * objects are linked using their own 'nextInQueue' pointer (T must have a public 'T *nextInQueue'),
+ * so pushing and taking are not allocating and never lock. The consumer takes all the pending
+ * objects at once with a single atomic exchange, the cost is the same for any number of objects.
+ */
+
+template<typename T>
+class EventsQueue
+{
+public:
+    EventsQueue() :
+        head(nullptr)
+    {
+    }
+
+    // called by any thread, retried only when another thread changed the queue at same time
+    void push(T *item)
+    {
+        T *currentHead;
+        do {
+            currentHead = head.loadAcquire();
+            item->nextInQueue = currentHead;
+        } while (!head.testAndSetRelease(currentHead, item));
+    }
+
+    // the pending objects linked in the push order, nullptr if the queue is empty
+    T *takeAll()
+    {
+        T *item = head.fetchAndStoreAcquire(nullptr);
+        T *first = nullptr;
+        while (item) { // the pushed objects are linked from the newest to the oldest
+            T *next = item->nextInQueue;
+            item->nextInQueue = first;
+            first = item;
+            item = next;
+        }
+        return first;
+    }
+
+    inline bool isEmpty() const
+    {
+        return head.loadAcquire() == nullptr;
+    }
+
+private:
+    QAtomicPointer<T> head; // the newest object
+};
+
+} // namespace
+
+#endif
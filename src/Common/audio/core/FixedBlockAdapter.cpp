@@ -0,0 +1,69 @@
+#include "FixedBlockAdapter.h"
+#include "AudioNodeProcessor.h"
+
+using namespace Audio;
+
+FixedBlockAdapter::FixedBlockAdapter(int channels, int blockSize) :
+    blockSize(toPowerOfTwo(blockSize)),
+    inputFifo(channels),
+    outputFifo(channels),
+    blockInput(channels, this->blockSize),
+    blockOutput(channels, this->blockSize)
+{
+    // allocating the fifos capacity here, the audio thread is not growing the fifos for buffers up to MAX_BLOCK_SIZE frames
+    inputFifo.setFrameLenght(this->blockSize + MAX_BLOCK_SIZE);
+    outputFifo.setFrameLenght(this->blockSize + MAX_BLOCK_SIZE);
+    reset();
+}
+
+int FixedBlockAdapter::toPowerOfTwo(int value)
+{
+    int powerOfTwo = MIN_BLOCK_SIZE;
+    while (powerOfTwo < value && powerOfTwo < MAX_BLOCK_SIZE)
+        powerOfTwo <<= 1;
+    return powerOfTwo;
+}
+
+int FixedBlockAdapter::computeLatency(int blockSize)
+{
+    if (blockSize <= 0)
+        return 0;
+
+    return toPowerOfTwo(blockSize) - 1;
+}
+
+void FixedBlockAdapter::reset()
+{
+    inputFifo.setFrameLenght(0);
+
+    // the output fifo starts with 'latency' silent samples, so we always have enough samples to deliver
+    outputFifo.setFrameLenght(getLatency());
+    outputFifo.zero();
+
+    pendingMidiMessages.clear();
+}
+
+void FixedBlockAdapter::process(AudioNodeProcessor *processor, const SamplesBuffer &in,
+                                SamplesBuffer &out, const QList<Midi::MidiMessage> &midiMessages)
+{
+    int framesToDeliver = out.getFrameLenght();
+    if (framesToDeliver <= 0)
+        return;
+
+    pendingMidiMessages.append(midiMessages);
+    inputFifo.append(in);
+
+    while (inputFifo.getFrameLenght() >= blockSize) {
+        blockInput.set(inputFifo, 0, blockSize, 0);
+        blockOutput.set(blockInput); // VSTs are replacing and VSTis are adding, so the block output start with the input samples (see VstPlugin::process)
+
+        processor->process(blockInput, blockOutput, pendingMidiMessages);
+        pendingMidiMessages.clear(); // midi messages are delivered in the first processed block
+
+        inputFifo.discardFirstSamples(blockSize);
+        outputFifo.append(blockOutput);
+    }
+
+    out.set(outputFifo, 0, framesToDeliver, 0);
+    outputFifo.discardFirstSamples(framesToDeliver);
+}
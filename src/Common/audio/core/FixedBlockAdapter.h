@@ -0,0 +1,64 @@
+#ifndef _FIXED_BLOCK_ADAPTER_H_
+#define _FIXED_BLOCK_ADAPTER_H_
+
+#include "SamplesBuffer.h"
+#include "midi/MidiMessage.h"
+#include <QList>
+
+namespace Audio {
+
+class AudioNodeProcessor;
+
+/**
+ * Buffers the audio driver callbacks (and the sub blocks created when a ninjam interval
+ * boundary splits a callback) and feeds the processor with constant size blocks.
+ * The price is 'blockSize - 1' samples of latency, the minimum latency to never starve
+ * the output, whatever the size of the incoming buffers.
+ */
+
+class FixedBlockAdapter
+{
+public:
+    FixedBlockAdapter(int channels, int blockSize);
+
+    void process(AudioNodeProcessor *processor, const SamplesBuffer &in, SamplesBuffer &out,
+                 const QList<Midi::MidiMessage> &midiMessages);
+
+    void reset(); // discard buffered samples and restore the initial latency
+
+    inline int getBlockSize() const
+    {
+        return blockSize;
+    }
+
+    inline int getChannels() const
+    {
+        return blockInput.getChannels();
+    }
+
+    inline int getLatency() const
+    {
+        return computeLatency(blockSize);
+    }
+
+    static int computeLatency(int blockSize);
+
+    static int toPowerOfTwo(int value); // round up to the next power of two in [MIN_BLOCK_SIZE, MAX_BLOCK_SIZE]
+
+    static const int MIN_BLOCK_SIZE = 16;
+    static const int MAX_BLOCK_SIZE = 8192;
+
+private:
+    int blockSize;
+
+    SamplesBuffer inputFifo; // input samples waiting to complete a block
+    SamplesBuffer outputFifo; // processed samples waiting to be delivered in the next callbacks
+    SamplesBuffer blockInput;
+    SamplesBuffer blockOutput;
+
+    QList<Midi::MidiMessage> pendingMidiMessages; // messages received while a block was not completed
+};
+
+}//namespace
+
+#endif
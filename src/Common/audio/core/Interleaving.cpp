@@ -0,0 +1,152 @@
+#include "Interleaving.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define JT_USE_SSE2
+#endif
+
+namespace Audio {
+namespace Interleaving {
+
+static void deinterleaveGeneric(const float *interleaved, unsigned int stride,
+                                float *const *channels, unsigned int channelCount,
+                                unsigned int firstFrame, unsigned int frames)
+{
+    for (unsigned int c = 0; c < channelCount; ++c) {
+        float *out = channels[c];
+        const float *in = interleaved + c;
+        for (unsigned int i = firstFrame; i < frames; ++i)
+            out[i] = in[i * stride];
+    }
+}
+
+static void interleaveGeneric(const float *const *channels, unsigned int channelCount,
+                              float *interleaved, unsigned int stride,
+                              unsigned int firstFrame, unsigned int frames)
+{
+    for (unsigned int c = 0; c < channelCount; ++c) {
+        const float *in = channels[c];
+        float *out = interleaved + c;
+        for (unsigned int i = firstFrame; i < frames; ++i)
+            out[i * stride] = in[i];
+    }
+}
+
+#ifdef JT_USE_SSE2
+
+// all kernels process 4 frames per iteration and return the number of processed frames
+
+static unsigned int deinterleave2(const float *in, float *const *channels, unsigned int frames)
+{
+    float *left = channels[0];
+    float *right = channels[1];
+    unsigned int frame = 0;
+    for (; frame + 4 <= frames; frame += 4, in += 8) {
+        __m128 a = _mm_loadu_ps(in); // L0 R0 L1 R1
+        __m128 b = _mm_loadu_ps(in + 4); // L2 R2 L3 R3
+        _mm_storeu_ps(left + frame, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(right + frame, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+    return frame;
+}
+
+static unsigned int interleave2(const float *const *channels, float *out, unsigned int frames)
+{
+    const float *left = channels[0];
+    const float *right = channels[1];
+    unsigned int frame = 0;
+    for (; frame + 4 <= frames; frame += 4, out += 8) {
+        __m128 l = _mm_loadu_ps(left + frame);
+        __m128 r = _mm_loadu_ps(right + frame);
+        _mm_storeu_ps(out, _mm_unpacklo_ps(l, r));
+        _mm_storeu_ps(out + 4, _mm_unpackhi_ps(l, r));
+    }
+    return frame;
+}
+
+// transpose a 4x4 block, 'in' rows are 'inStride' floats apart and 'out' rows are 'outStride' floats apart
+static inline void transpose4x4(const float *in, unsigned int inStride, float *const *out,
+                                unsigned int outOffset)
+{
+    __m128 row0 = _mm_loadu_ps(in);
+    __m128 row1 = _mm_loadu_ps(in + inStride);
+    __m128 row2 = _mm_loadu_ps(in + inStride * 2);
+    __m128 row3 = _mm_loadu_ps(in + inStride * 3);
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+    _mm_storeu_ps(out[0] + outOffset, row0);
+    _mm_storeu_ps(out[1] + outOffset, row1);
+    _mm_storeu_ps(out[2] + outOffset, row2);
+    _mm_storeu_ps(out[3] + outOffset, row3);
+}
+
+static inline void transpose4x4(const float *const *in, unsigned int inOffset, float *out,
+                                unsigned int outStride)
+{
+    __m128 row0 = _mm_loadu_ps(in[0] + inOffset);
+    __m128 row1 = _mm_loadu_ps(in[1] + inOffset);
+    __m128 row2 = _mm_loadu_ps(in[2] + inOffset);
+    __m128 row3 = _mm_loadu_ps(in[3] + inOffset);
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+    _mm_storeu_ps(out, row0);
+    _mm_storeu_ps(out + outStride, row1);
+    _mm_storeu_ps(out + outStride * 2, row2);
+    _mm_storeu_ps(out + outStride * 3, row3);
+}
+
+// 4 and 8 channels, the 8 channels frames are transposed as two 4x4 blocks
+static unsigned int deinterleave4N(const float *in, float *const *channels, unsigned int stride,
+                                   unsigned int frames)
+{
+    unsigned int frame = 0;
+    for (; frame + 4 <= frames; frame += 4, in += stride * 4) {
+        for (unsigned int c = 0; c < stride; c += 4)
+            transpose4x4(in + c, stride, channels + c, frame);
+    }
+    return frame;
+}
+
+static unsigned int interleave4N(const float *const *channels, float *out, unsigned int stride,
+                                 unsigned int frames)
+{
+    unsigned int frame = 0;
+    for (; frame + 4 <= frames; frame += 4, out += stride * 4) {
+        for (unsigned int c = 0; c < stride; c += 4)
+            transpose4x4(channels + c, frame, out + c, stride);
+    }
+    return frame;
+}
+
+#endif
+
+void deinterleave(const float *interleaved, unsigned int stride, float *const *channels,
+                  unsigned int channelCount, unsigned int frames)
+{
+    unsigned int processedFrames = 0;
+#ifdef JT_USE_SSE2
+    if (stride == channelCount) {
+        if (channelCount == 2)
+            processedFrames = deinterleave2(interleaved, channels, frames);
+        else if (channelCount == 4 || channelCount == 8)
+            processedFrames = deinterleave4N(interleaved, channels, stride, frames);
+    }
+#endif
+    deinterleaveGeneric(interleaved, stride, channels, channelCount, processedFrames, frames);
+}
+
+void interleave(const float *const *channels, unsigned int channelCount, float *interleaved,
+                unsigned int stride, unsigned int frames)
+{
+    unsigned int processedFrames = 0;
+#ifdef JT_USE_SSE2
+    if (stride == channelCount) {
+        if (channelCount == 2)
+            processedFrames = interleave2(channels, interleaved, frames);
+        else if (channelCount == 4 || channelCount == 8)
+            processedFrames = interleave4N(channels, interleaved, stride, frames);
+    }
+#endif
+    interleaveGeneric(channels, channelCount, interleaved, stride, processedFrames, frames);
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,27 @@
+#ifndef _INTERLEAVING_H_
+#define _INTERLEAVING_H_
+
+namespace Audio {
+
+/**
+ * Conversion kernels between interleaved float samples (audio drivers format) and
+ * separated channel arrays (SamplesBuffer format). The 2, 4 and 8 channels cases
+ * are SIMD transposes when the interleaved frame contains only the converted channels
+ * (stride == channelCount), the other cases use a generic strided loop.
+ */
+
+namespace Interleaving {
+
+// 'stride' is the number of channels in each interleaved frame. 'channelCount' channels are
+// converted, starting at the 'interleaved' pointer.
+void deinterleave(const float *interleaved, unsigned int stride, float *const *channels,
+                  unsigned int channelCount, unsigned int frames);
+
+void interleave(const float *const *channels, unsigned int channelCount, float *interleaved,
+                unsigned int stride, unsigned int frames);
+
+} // namespace
+
+} // namespace
+
+#endif
@@ -1,10 +1,13 @@
 #include "LocalInputGroup.h"
 #include "LocalInputNode.h"
+#include "DelayLine.h"
+#include "SamplesBuffer.h"
 
 using namespace Audio;
 
 LocalInputGroup::LocalInputGroup(int groupIndex, Audio::LocalInputNode *firstInput) :
     groupIndex(groupIndex),
+    alignedBuffer(2),
     transmiting(true)
 {
     addInput(firstInput);
@@ -13,18 +16,48 @@ LocalInputGroup::LocalInputGroup(int groupIndex, Audio::LocalInputNode *firstInp
 LocalInputGroup::~LocalInputGroup()
 {
     groupedInputs.clear();
+    qDeleteAll(delayLines);
+    delayLines.clear();
 }
 
 void LocalInputGroup::addInput(Audio::LocalInputNode *input)
 {
     groupedInputs.append(input);
+    delayLines.insert(input, new Audio::DelayLine(2));
+    updateDelayLines();
+}
+
+int LocalInputGroup::getLatency() const
+{
+    int maxLatency = 0;
+    foreach (Audio::LocalInputNode *inputTrack, groupedInputs)
+        maxLatency = qMax(maxLatency, inputTrack->getProcessorsLatency());
+    return maxLatency;
+}
+
+void LocalInputGroup::updateDelayLines()
+{
+    int groupLatency = getLatency();
+    foreach (Audio::LocalInputNode *inputTrack, groupedInputs)
+        delayLines[inputTrack]->setDelay(groupLatency - inputTrack->getProcessorsLatency());
 }
 
 void LocalInputGroup::mixGroupedInputs(Audio::SamplesBuffer &out)
 {
-    foreach (Audio::LocalInputNode *inputTrack, groupedInputs) {
+    if (groupedInputs.size() == 1) { // nothing to align
+        Audio::LocalInputNode *inputTrack = groupedInputs.first();
         if (!inputTrack->isMuted())
             out.add(inputTrack->getLastBuffer());
+        return;
+    }
+
+    foreach (Audio::LocalInputNode *inputTrack, groupedInputs) {
+        Audio::DelayLine *delayLine = delayLines[inputTrack];
+
+        // muted inputs are delayed too, so the delay line is ready when the input is unmuted
+        delayLine->process(inputTrack->getLastBuffer(), alignedBuffer);
+        if (!inputTrack->isMuted())
+            out.add(alignedBuffer);
     }
 }
 
@@ -32,6 +65,9 @@ void LocalInputGroup::removeInput(Audio::LocalInputNode *input)
 {
     if (!groupedInputs.removeOne(input))
         qCritical() << "the input track was not removed!";
+
+    delete delayLines.take(input);
+    updateDelayLines();
 }
 
 int LocalInputGroup::getMaxInputChannelsForEncoding() const
@@ -2,11 +2,13 @@
 #define _LOCAL_INPUT_GROUP_H_
 
 #include <QList>
+#include <QMap>
+#include "SamplesBuffer.h"
 
 namespace Audio {
 
 class LocalInputNode;
-class SamplesBuffer;
+class DelayLine;
 
 class LocalInputGroup
 {
@@ -26,7 +28,11 @@ public:
         return groupIndex;
     }
 
-    void mixGroupedInputs(Audio::SamplesBuffer &out);
+    void mixGroupedInputs(Audio::SamplesBuffer &out); // the inputs are aligned to compensate the plugins latency
+
+    int getLatency() const; // the max plugins latency between the grouped inputs
+
+    void updateDelayLines(); // called when the plugins latency change, never in the audio thread
 
     void removeInput(Audio::LocalInputNode *input);
 
@@ -42,6 +48,8 @@ public:
 private:
     int groupIndex;
     QList<Audio::LocalInputNode *> groupedInputs;
+    QMap<Audio::LocalInputNode *, Audio::DelayLine *> delayLines; // inputs with less latency are delayed
+    Audio::SamplesBuffer alignedBuffer;
     bool transmiting;
 };
 
@@ -59,6 +59,14 @@ void LocalInputNode::setProcessorsSampleRate(int newSampleRate)
     }
 }
 
+void LocalInputNode::setProcessorsFixedBlockSize(int blockSize)
+{
+    for (int i = 0; i < MAX_PROCESSORS_PER_TRACK; ++i) {
+        if (processors[i])
+            processors[i]->setFixedBlockSize(blockSize);
+    }
+}
+
 void LocalInputNode::closeProcessorsWindows()
 {
     for (int i = 0; i < MAX_PROCESSORS_PER_TRACK; ++i) {
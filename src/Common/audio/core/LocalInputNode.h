@@ -62,6 +62,8 @@ public:
 
     void setProcessorsSampleRate(int newSampleRate);
 
+    void setProcessorsFixedBlockSize(int blockSize);
+
     void closeProcessorsWindows();
 
     bool hasMidiActivity() const;
@@ -0,0 +1,178 @@
+#include "PcmConversion.h"
+#include "Interleaving.h"
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define JT_USE_SSE2
+#endif
+
+namespace Audio {
+namespace PcmConversion {
+
+// the integer samples are scaled using the max positive value, like SamplesBuffer::setInterleaved()
+static const float UINT8_SCALE = 1.0f / 127.0f;
+static const float INT16_SCALE = 1.0f / 32767.0f;
+static const float INT24_SCALE = 1.0f / 8388607.0f;
+static const float INT32_SCALE = 1.0f / 2147483647.0f;
+
+static const unsigned int BLOCK_SAMPLES = 2048; // stack buffer used to convert the interleaved samples
+
+// the 3 bytes sample in the high bytes of a 32 bits integer, the sign is extended with an arithmetic shift
+static inline qint32 packInt24(const uchar *p)
+{
+    return (qint32)(((quint32)p[0] << 8) | ((quint32)p[1] << 16) | ((quint32)p[2] << 24));
+}
+
+int getBytesPerSample(SampleFormat format)
+{
+    switch (format) {
+    case SampleFormat::UInt8:
+        return 1;
+    case SampleFormat::Int16:
+        return 2;
+    case SampleFormat::Int24:
+        return 3;
+    case SampleFormat::Int32:
+    case SampleFormat::Float32:
+        return 4;
+    }
+    return 0;
+}
+
+// all the kernels return the number of converted samples, the remaining samples are converted by the scalar loops
+
+#ifdef JT_USE_SSE2
+
+static unsigned int uint8ToFloat(const uchar *in, float *out, unsigned int samples)
+{
+    const __m128 scale = _mm_set1_ps(UINT8_SCALE);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i offset = _mm_set1_epi16(128);
+    unsigned int i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(in + i));
+        __m128i low = _mm_sub_epi16(_mm_unpacklo_epi8(bytes, zero), offset); // 8 signed shorts
+        __m128i high = _mm_sub_epi16(_mm_unpackhi_epi8(bytes, zero), offset);
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(low, low), 16)), scale));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(low, low), 16)), scale));
+        _mm_storeu_ps(out + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(high, high), 16)), scale));
+        _mm_storeu_ps(out + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(high, high), 16)), scale));
+    }
+    return i;
+}
+
+static unsigned int int16ToFloat(const uchar *in, float *out, unsigned int samples)
+{
+    const __m128 scale = _mm_set1_ps(INT16_SCALE);
+    unsigned int i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        __m128i shorts = _mm_loadu_si128((const __m128i *)(in + i * 2));
+        __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(shorts, shorts), 16); // sign extension
+        __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(shorts, shorts), 16);
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+    }
+    return i;
+}
+
+static unsigned int int24ToFloat(const uchar *in, float *out, unsigned int samples)
+{
+    // SSE2 has no byte shuffle, the samples are packed in the 32 bits lanes and converted 4 at once
+    const __m128 scale = _mm_set1_ps(INT24_SCALE);
+    unsigned int i = 0;
+    for (; i + 4 <= samples; i += 4) {
+        const uchar *p = in + i * 3;
+        __m128i packed = _mm_set_epi32(packInt24(p + 9), packInt24(p + 6), packInt24(p + 3), packInt24(p));
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(packed, 8)), scale));
+    }
+    return i;
+}
+
+static unsigned int int32ToFloat(const uchar *in, float *out, unsigned int samples)
+{
+    const __m128 scale = _mm_set1_ps(INT32_SCALE);
+    unsigned int i = 0;
+    for (; i + 4 <= samples; i += 4) {
+        __m128i ints = _mm_loadu_si128((const __m128i *)(in + i * 4));
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(ints), scale));
+    }
+    return i;
+}
+
+#endif
+
+void toFloat(const uchar *in, SampleFormat format, float *out, unsigned int samples)
+{
+    unsigned int i = 0;
+    switch (format) {
+    case SampleFormat::UInt8:
+#ifdef JT_USE_SSE2
+        i = uint8ToFloat(in, out, samples);
+#endif
+        for (; i < samples; ++i)
+            out[i] = ((int)in[i] - 128) * UINT8_SCALE;
+        break;
+    case SampleFormat::Int16:
+#ifdef JT_USE_SSE2
+        i = int16ToFloat(in, out, samples);
+#endif
+        for (; i < samples; ++i)
+            out[i] = qFromLittleEndian<qint16>(in + i * 2) * INT16_SCALE;
+        break;
+    case SampleFormat::Int24:
+#ifdef JT_USE_SSE2
+        i = int24ToFloat(in, out, samples);
+#endif
+        for (; i < samples; ++i)
+            out[i] = (packInt24(in + i * 3) >> 8) * INT24_SCALE;
+        break;
+    case SampleFormat::Int32:
+#ifdef JT_USE_SSE2
+        i = int32ToFloat(in, out, samples);
+#endif
+        for (; i < samples; ++i)
+            out[i] = qFromLittleEndian<qint32>(in + i * 4) * INT32_SCALE;
+        break;
+    case SampleFormat::Float32:
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+        std::memcpy(out, in, samples * sizeof(float));
+#else
+        for (; i < samples; ++i) {
+            quint32 bits = qFromLittleEndian<quint32>(in + i * 4);
+            std::memcpy(out + i, &bits, sizeof(float));
+        }
+#endif
+        break;
+    }
+}
+
+void toFloat(const uchar *interleaved, SampleFormat format, unsigned int stride, float *const *channels,
+             unsigned int channelCount, unsigned int frames)
+{
+    if (stride == 0 || channelCount == 0 || stride > BLOCK_SAMPLES)
+        return;
+
+    channelCount = std::min(channelCount, stride);
+    const unsigned int bytesPerFrame = getBytesPerSample(format) * stride;
+    const unsigned int blockFrames = BLOCK_SAMPLES / stride;
+    float block[BLOCK_SAMPLES];
+    float *channelArrays[8];
+    for (unsigned int frame = 0; frame < frames; frame += blockFrames) {
+        unsigned int framesToConvert = std::min(blockFrames, frames - frame);
+        toFloat(interleaved + frame * bytesPerFrame, format, block, framesToConvert * stride);
+
+        // the channels are deinterleaved in groups of 8, like SamplesBuffer::setInterleaved()
+        for (unsigned int c = 0; c < channelCount; c += 8) {
+            unsigned int groupChannels = std::min(channelCount - c, 8u);
+            for (unsigned int i = 0; i < groupChannels; ++i)
+                channelArrays[i] = channels[c + i] + frame;
+            Interleaving::deinterleave(block + c, stride, channelArrays, groupChannels, framesToConvert);
+        }
+    }
+}
+
+} // namespace
+} // namespace
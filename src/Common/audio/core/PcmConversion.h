@@ -0,0 +1,37 @@
+#ifndef _PCM_CONVERSION_H_
+#define _PCM_CONVERSION_H_
+
+#include <QtGlobal>
+
+namespace Audio {
+
+/**
+ * Conversion kernels from interleaved little endian PCM samples (wave files format) to separated
+ * float channel arrays (SamplesBuffer format). The samples are converted in small blocks: SIMD
+ * integer to float conversion in a stack buffer, followed by the Interleaving deinterleave kernels.
+ */
+
+namespace PcmConversion {
+
+enum class SampleFormat {
+    UInt8, // 8 bits wave files are unsigned
+    Int16,
+    Int24,
+    Int32,
+    Float32
+};
+
+int getBytesPerSample(SampleFormat format);
+
+// 'stride' is the number of channels in each interleaved frame, the first 'channelCount' channels are converted
+void toFloat(const uchar *interleaved, SampleFormat format, unsigned int stride, float *const *channels,
+             unsigned int channelCount, unsigned int frames);
+
+// convert 'samples' interleaved samples to interleaved floats
+void toFloat(const uchar *in, SampleFormat format, float *out, unsigned int samples);
+
+} // namespace
+
+} // namespace
+
+#endif
@@ -0,0 +1,86 @@
+#include "RenderStatistics.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace Audio;
+
+RenderStatistics::RenderStatistics() :
+    deadline(0),
+    xruns(0),
+    allocations(0),
+    allocatingCallbacks(0)
+{
+}
+
+void RenderStatistics::reset(qint64 deadlineInNanoseconds, int expectedCallbacks)
+{
+    deadline = deadlineInNanoseconds;
+    xruns = 0;
+    allocations = 0;
+    allocatingCallbacks = 0;
+    callbackTimes.clear();
+    callbackTimes.reserve(expectedCallbacks);
+}
+
+void RenderStatistics::addCallback(qint64 nanoseconds, quint64 allocations)
+{
+    callbackTimes.append(nanoseconds);
+
+    if (deadline > 0 && nanoseconds > deadline)
+        xruns++;
+
+    if (allocations > 0) {
+        this->allocations += allocations;
+        allocatingCallbacks++;
+    }
+}
+
+qint64 RenderStatistics::getPercentile(double percentile) const
+{
+    if (callbackTimes.isEmpty())
+        return 0;
+
+    QVector<qint64> sortedTimes(callbackTimes);
+    std::sort(sortedTimes.begin(), sortedTimes.end());
+
+    // nearest rank method
+    int rank = static_cast<int>(std::ceil(percentile / 100.0 * sortedTimes.size()));
+    int index = qBound(0, rank - 1, sortedTimes.size() - 1);
+    return sortedTimes.at(index);
+}
+
+qint64 RenderStatistics::getMaxTime() const
+{
+    if (callbackTimes.isEmpty())
+        return 0;
+
+    return *std::max_element(callbackTimes.begin(), callbackTimes.end());
+}
+
+qint64 RenderStatistics::getTotalTime() const
+{
+    qint64 total = 0;
+    foreach (qint64 time, callbackTimes)
+        total += time;
+    return total;
+}
+
+QString RenderStatistics::toString() const
+{
+    const double nanosecondsPerMs = 1000000.0;
+    QString report;
+    report += QString("callbacks: %1\n").arg(getCallbacks());
+    report += QString("deadline: %1 ms\n").arg(deadline / nanosecondsPerMs, 0, 'f', 3);
+    report += QString("p50: %1 ms\n").arg(getPercentile(50) / nanosecondsPerMs, 0, 'f', 3);
+    report += QString("p99: %1 ms\n").arg(getPercentile(99) / nanosecondsPerMs, 0, 'f', 3);
+    report += QString("max: %1 ms\n").arg(getMaxTime() / nanosecondsPerMs, 0, 'f', 3);
+    report += QString("xruns: %1\n").arg(xruns);
+    report += QString("allocations: %1 in %2 callbacks\n").arg(allocations).arg(allocatingCallbacks);
+
+    qint64 totalTime = getTotalTime();
+    if (totalTime > 0 && deadline > 0) {
+        double realTimeFactor = (double)deadline * getCallbacks() / totalTime;
+        report += QString("speed: %1x real time\n").arg(realTimeFactor, 0, 'f', 1);
+    }
+    return report;
+}
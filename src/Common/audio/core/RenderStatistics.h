@@ -0,0 +1,64 @@
+#ifndef _RENDER_STATISTICS_H_
+#define _RENDER_STATISTICS_H_
+
+#include <QVector>
+#include <QString>
+
+namespace Audio {
+
+/**
+ * Collect the time spent in each audio callback. A callback slower than the
+ * deadline (the buffer duration) is counted as an xrun, a real audio device
+ * would be starved in that callback.
+ */
+
+class RenderStatistics
+{
+public:
+    RenderStatistics();
+
+    void reset(qint64 deadlineInNanoseconds, int expectedCallbacks); // preallocate, so adding a callback is not allocating memory
+    void addCallback(qint64 nanoseconds, quint64 allocations);
+
+    qint64 getPercentile(double percentile) const; // percentile in [0, 100], in nanoseconds
+    qint64 getMaxTime() const;
+    qint64 getTotalTime() const;
+
+    inline qint64 getDeadline() const
+    {
+        return deadline;
+    }
+
+    inline int getCallbacks() const
+    {
+        return callbackTimes.size();
+    }
+
+    inline int getXruns() const
+    {
+        return xruns;
+    }
+
+    inline quint64 getAllocations() const
+    {
+        return allocations;
+    }
+
+    inline int getAllocatingCallbacks() const
+    {
+        return allocatingCallbacks;
+    }
+
+    QString toString() const; // a human readable report
+
+private:
+    QVector<qint64> callbackTimes;
+    qint64 deadline;
+    int xruns;
+    quint64 allocations;
+    int allocatingCallbacks;
+};
+
+} // namespace
+
+#endif
@@ -1,7 +1,14 @@
 #include "SamplesBuffer.h"
+#include "Interleaving.h"
 #include <QDebug>
 #include <cmath>
 #include <algorithm>
+#include <climits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define JT_USE_SSE2
+#endif
 
 using namespace Audio;
 // +++++++++++++++++=
@@ -14,12 +21,14 @@ SamplesBuffer::SamplesBuffer(unsigned int channels) :
     channels(channels),
     frameLenght(0),
     rmsRunningSum(0.0f),
-    rmsWindowSize(13230) //300 ms in 44100 KHz
+    rmsWindowSize(13230), //300 ms in 44100 KHz
+    view(false),
+    viewFrames(0)
 {
     if (channels == 0)
         qCritical() << "AudioSamplesBuffer::channels == 0";
-    for (unsigned int c = 0; c < channels; ++c)
-        samples.push_back(std::vector<float>());
+    storage.resize(channels);
+    updateChannelsPointers();
 
     squaredSums[0] = squaredSums[1] = 0.0f;
     lastRmsValues[0] = lastRmsValues[1] = 0.0f;
@@ -30,20 +39,66 @@ SamplesBuffer::SamplesBuffer(unsigned int channels, unsigned int frameLenght) :
     channels(channels),
     frameLenght(frameLenght),
     rmsRunningSum(0.0f),
-    rmsWindowSize(13230) //300 ms in 44100 KHz
+    rmsWindowSize(13230), //300 ms in 44100 KHz
+    view(false),
+    viewFrames(0)
 {
-    for (unsigned int c = 0; c < channels; ++c)
-        samples.push_back(std::vector<float>(frameLenght));
+    storage.resize(channels, std::vector<float>(frameLenght));
+    updateChannelsPointers();
 }
 
+SamplesBuffer::SamplesBuffer(float *const *channelsArrays, unsigned int channels, unsigned int frameLenght) :
+    channels(channels),
+    frameLenght(frameLenght),
+    rmsRunningSum(0.0f),
+    rmsWindowSize(13230), //300 ms in 44100 KHz
+    view(true),
+    viewFrames(frameLenght)
+{
+    samples.assign(channelsArrays, channelsArrays + channels);
+
+    squaredSums[0] = squaredSums[1] = 0.0f;
+    lastRmsValues[0] = lastRmsValues[1] = 0.0f;
+    summedSamples = 0;
+}
+
+// the copies are always owning the samples, including the copies of views
 SamplesBuffer::SamplesBuffer(const SamplesBuffer &other) :
     channels(other.channels),
     frameLenght(other.frameLenght),
-    samples(other.samples),
     rmsRunningSum(other.rmsRunningSum),
-    rmsWindowSize(other.rmsWindowSize)
+    rmsWindowSize(other.rmsWindowSize),
+    view(false),
+    viewFrames(0)
 {
     // qWarning() << "Samples Buffer copy constructor!";
+    storage.resize(other.samples.size());
+    for (size_t c = 0; c < other.samples.size(); ++c)
+        storage[c].assign(other.samples[c], other.samples[c] + other.getChannelCapacity(c));
+    updateChannelsPointers();
+}
+
+void SamplesBuffer::updateChannelsPointers()
+{
+    samples.resize(storage.size());
+    for (size_t c = 0; c < storage.size(); ++c)
+        samples[c] = storage[c].data();
+}
+
+unsigned int SamplesBuffer::getChannelCapacity(size_t channel) const
+{
+    return isView() ? viewFrames : (unsigned int)storage[channel].size();
+}
+
+void SamplesBuffer::bind(float *const *channelsArrays, unsigned int frameLenght)
+{
+    if (!isView()) {
+        qCritical() << "SamplesBuffer::bind() called in a buffer owning the samples";
+        return;
+    }
+    std::copy(channelsArrays, channelsArrays + samples.size(), samples.begin());
+    this->viewFrames = frameLenght;
+    this->frameLenght = frameLenght;
 }
 
 SamplesBuffer::~SamplesBuffer()
@@ -61,6 +116,8 @@ void SamplesBuffer::invertStereo()
         return; //trying invert a non stereo buffer
 
     std::iter_swap(samples.begin(), samples.begin() + 1); // swap first and second channels
+    if (!isView())
+        std::iter_swap(storage.begin(), storage.begin() + 1);
 }
 
 void SamplesBuffer::discardFirstSamples(unsigned int samplesToDiscard)
@@ -68,8 +125,7 @@ void SamplesBuffer::discardFirstSamples(unsigned int samplesToDiscard)
     int toDiscard = std::min(frameLenght, samplesToDiscard);
     uint newFrameLenght = frameLenght - toDiscard;
     for (uint c = 0; c < channels; ++c) {
-        std::rotate(samples[c].begin(), samples[c].begin() + toDiscard, samples[c].end());
-        // samples[c].erase(samples[c].begin(), samples[c].begin() + toDiscard);
+        std::copy(samples[c] + toDiscard, samples[c] + frameLenght, samples[c]);
     }
     setFrameLenght(newFrameLenght);
 }
@@ -82,11 +138,119 @@ void SamplesBuffer::append(const SamplesBuffer &other)
     set(other, 0, other.frameLenght, internalOffset);
 }
 
+void SamplesBuffer::setInterleaved(const short *interleavedSamples, unsigned int frames,
+                                   unsigned int interleavedChannels)
+{
+    if (channels <= 0 || interleavedChannels <= 0)
+        return;
+
+    setFrameLenght(frames);
+    if (frames == 0)
+        return;
+
+    const float scale = 1.0f / SHRT_MAX;
+    unsigned int frame = 0;
+
+    if (interleavedChannels == 2 && channels == 2) {
+        float *left = &(samples[0][0]);
+        float *right = &(samples[1][0]);
+#ifdef JT_USE_SSE2
+        const __m128 scaleVector = _mm_set1_ps(scale);
+        for (; frame + 4 <= frames; frame += 4) { // 4 stereo frames per iteration
+            __m128i shorts = _mm_loadu_si128((const __m128i *)(interleavedSamples + frame * 2));
+            __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(shorts, shorts), 16); // sign extension
+            __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(shorts, shorts), 16);
+            __m128 lowFloats = _mm_mul_ps(_mm_cvtepi32_ps(low), scaleVector); // L0 R0 L1 R1
+            __m128 highFloats = _mm_mul_ps(_mm_cvtepi32_ps(high), scaleVector); // L2 R2 L3 R3
+            _mm_storeu_ps(left + frame, _mm_shuffle_ps(lowFloats, highFloats, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(right + frame, _mm_shuffle_ps(lowFloats, highFloats, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+#endif
+        for (; frame < frames; ++frame) {
+            left[frame] = interleavedSamples[frame * 2] * scale;
+            right[frame] = interleavedSamples[frame * 2 + 1] * scale;
+        }
+        return;
+    }
+
+    if (interleavedChannels == 1) { // mono samples are copied to all channels
+        float *firstChannel = &(samples[0][0]);
+#ifdef JT_USE_SSE2
+        const __m128 scaleVector = _mm_set1_ps(scale);
+        for (; frame + 8 <= frames; frame += 8) {
+            __m128i shorts = _mm_loadu_si128((const __m128i *)(interleavedSamples + frame));
+            __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(shorts, shorts), 16);
+            __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(shorts, shorts), 16);
+            _mm_storeu_ps(firstChannel + frame, _mm_mul_ps(_mm_cvtepi32_ps(low), scaleVector));
+            _mm_storeu_ps(firstChannel + frame + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scaleVector));
+        }
+#endif
+        for (; frame < frames; ++frame)
+            firstChannel[frame] = interleavedSamples[frame] * scale;
+
+        for (unsigned int c = 1; c < channels; ++c)
+            std::copy(samples[0], samples[0] + frames, samples[c]);
+        return;
+    }
+
+    // generic case, extra interleaved channels are ignored
+    unsigned int channelsToCopy = std::min(channels, interleavedChannels);
+    for (unsigned int c = 0; c < channelsToCopy; ++c) {
+        float *channelSamples = &(samples[c][0]);
+        const short *in = interleavedSamples + c;
+        for (unsigned int i = 0; i < frames; ++i)
+            channelSamples[i] = in[i * interleavedChannels] * scale;
+    }
+}
+
+void SamplesBuffer::setInterleaved(const float *interleavedSamples, unsigned int frames,
+                                   unsigned int interleavedChannels)
+{
+    if (channels <= 0 || interleavedChannels <= 0)
+        return;
+
+    setFrameLenght(frames);
+    if (frames == 0)
+        return;
+
+    // the channels are converted in groups, so no memory is allocated in the audio thread
+    unsigned int channelsToCopy = std::min(channels, interleavedChannels);
+    float *channelArrays[8];
+    for (unsigned int c = 0; c < channelsToCopy; c += 8) {
+        unsigned int groupChannels = std::min(channelsToCopy - c, 8u);
+        for (unsigned int i = 0; i < groupChannels; ++i)
+            channelArrays[i] = &(samples[c + i][0]);
+        Interleaving::deinterleave(interleavedSamples + c, interleavedChannels, channelArrays,
+                                   groupChannels, frames);
+    }
+}
+
+void SamplesBuffer::getInterleaved(float *interleavedSamples, unsigned int frames,
+                                   unsigned int interleavedChannels) const
+{
+    unsigned int framesToCopy = std::min(frames, frameLenght);
+    unsigned int channelsToCopy = std::min(channels, interleavedChannels);
+    if (framesToCopy < frames || channelsToCopy < interleavedChannels)
+        std::fill(interleavedSamples, interleavedSamples + frames * interleavedChannels, 0.0f);
+
+    if (framesToCopy == 0)
+        return;
+
+    const float *channelArrays[8];
+    for (unsigned int c = 0; c < channelsToCopy; c += 8) {
+        unsigned int groupChannels = std::min(channelsToCopy - c, 8u);
+        for (unsigned int i = 0; i < groupChannels; ++i)
+            channelArrays[i] = &(samples[c + i][0]);
+        Interleaving::interleave(channelArrays, groupChannels, interleavedSamples + c,
+                                 interleavedChannels, framesToCopy);
+    }
+}
+
 float *SamplesBuffer::getSamplesArray(unsigned int channel) const
 {
     if (channel > samples.size())
         channel = 0;
-    return const_cast<float *>(&(samples[channel][0]));
+    return samples[channel];
 }
 
 void SamplesBuffer::applyGain(float gainFactor, float boostFactor)
@@ -153,7 +317,19 @@ void SamplesBuffer::applyGain(float gainFactor, float leftGain, float rightGain,
 void SamplesBuffer::zero()
 {
     for (unsigned int c = 0; c < channels; ++c)
-        std::fill(samples[c].begin(), samples[c].end(), (float)0);
+        std::fill(samples[c], samples[c] + getChannelCapacity(c), (float)0);
+}
+
+bool SamplesBuffer::isSilent(float threshold) const
+{
+    for (unsigned int c = 0; c < channels; ++c) {
+        const float *channel = samples[c];
+        for (unsigned int i = 0; i < frameLenght; ++i) {
+            if (std::fabs(channel[i]) > threshold)
+                return false;
+        }
+    }
+    return true;
 }
 
 AudioPeak SamplesBuffer::computePeak()
@@ -252,13 +428,21 @@ void SamplesBuffer::setToMono()
 
 void SamplesBuffer::setToStereo()
 {
-    if (this->samples.size() < 2) {
-        size_t channelsToAdd = 2 - this->samples.size();
-        for (uint c = 0; c < channelsToAdd; ++c)
-            samples.push_back(std::vector<float>(frameLenght));
+    if (isView()) {
+        if (samples.size() < 2)
+            qCritical() << "Can't add channels in a SamplesBuffer view";
+        else
+            this->channels = 2;
+        return;
+    }
+
+    if (this->storage.size() < 2)
+        storage.resize(2);
+    for (unsigned int c = 0; c < storage.size(); ++c) {
+        if (storage[c].size() < frameLenght)
+            storage[c].resize(frameLenght);
     }
-    for (unsigned int c = 0; c < samples.size(); ++c)
-        samples[c].resize(frameLenght);
+    updateChannelsPointers();
     this->channels = 2;
 }
 
@@ -279,9 +463,20 @@ void SamplesBuffer::setFrameLenght(unsigned int newFrameLenght)
     if (newFrameLenght == frameLenght)
         return;
 
+    if (isView()) { // the external arrays can't grow
+        if (newFrameLenght > viewFrames)
+            qCritical() << "SamplesBuffer view is too small:" << newFrameLenght << ">" << viewFrames;
+        this->frameLenght = std::min(newFrameLenght, viewFrames);
+        return;
+    }
+
     if (newFrameLenght > frameLenght) {
-        for (unsigned int c = 0; c < channels; ++c)
-            samples[c].resize(newFrameLenght);
+        for (unsigned int c = 0; c < channels; ++c) {
+            if (storage[c].size() < newFrameLenght) {
+                storage[c].resize(newFrameLenght);
+                samples[c] = storage[c].data();
+            }
+        }
     }
     this->frameLenght = newFrameLenght;
 }
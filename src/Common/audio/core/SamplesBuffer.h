@@ -19,7 +19,14 @@ private:
     int rmsWindowSize; //how many samples until have enough data to compute rms?
     float lastRmsValues[2];
 
-    std::vector< std::vector<float> > samples;
+    std::vector< std::vector<float> > storage; // the owned samples, empty in views
+    std::vector<float *> samples; // the channels arrays, pointing to the storage or to external arrays
+
+    bool view;
+    unsigned int viewFrames; // the external arrays size
+
+    void updateChannelsPointers();
+    unsigned int getChannelCapacity(size_t channel) const;
 
     inline bool channelIsValid(unsigned int channel) const
     {
@@ -35,9 +42,21 @@ private:
 public:
     explicit SamplesBuffer(unsigned int channels);
     explicit SamplesBuffer(unsigned int channels, unsigned int frameLenght);
-    SamplesBuffer(const SamplesBuffer &other);
+    SamplesBuffer(const SamplesBuffer &other); // the copy is owning the samples, including the copies of views
     ~SamplesBuffer();
 
+    /** A view over external channels arrays (audio driver or plugin host buffers), the samples are
+        processed in place and the arrays are not copied. The arrays are not owned and can't grow, so
+        setFrameLenght() is limited to the arrays size. */
+    SamplesBuffer(float *const *channelsArrays, unsigned int channels, unsigned int frameLenght);
+
+    void bind(float *const *channelsArrays, unsigned int frameLenght); // point a view to other arrays, the channels count is not changed
+
+    inline bool isView() const
+    {
+        return view;
+    }
+
     void setRmsWindowSize(int samples);
     static int computeRmsWindowSize(int sampleRate, int windowTimeInMs = 300); //using 300 ms as default
 
@@ -72,6 +91,8 @@ public:
 
     Audio::AudioPeak computePeak();
 
+    bool isSilent(float threshold) const; // all the samples are below the threshold (absolute value)
+
     inline void add(const SamplesBuffer &buffer)
     {
         add(buffer, 0);
@@ -88,6 +109,13 @@ public:
     void set(const SamplesBuffer &buffer, int bufferChannelOffset, int channelsToCopy);
     void set(int channel, int sampleIndex, float sampleValue);
 
+    // convert interleaved 16 bits samples (decoders output) in one pass, the buffer is resized to 'frames'
+    void setInterleaved(const short *interleavedSamples, unsigned int frames, unsigned int interleavedChannels);
+
+    // convert interleaved float samples (audio drivers format), the buffer is resized to 'frames'
+    void setInterleaved(const float *interleavedSamples, unsigned int frames, unsigned int interleavedChannels);
+    void getInterleaved(float *interleavedSamples, unsigned int frames, unsigned int interleavedChannels) const; // missing channels and frames are zeroed
+
     float get(int channel, int sampleIndex) const;
 
     int getFrameLenght() const;// { return frameLenght; }
@@ -0,0 +1,84 @@
+#include "SamplesRingBuffer.h"
+#include <algorithm>
+
+using namespace Audio;
+
+SamplesRingBuffer::SamplesRingBuffer(int channels, int capacity) :
+    capacity(capacity),
+    ring(channels, capacity + 1),
+    readPosition(0),
+    writePosition(0)
+{
+    ring.zero();
+}
+
+int SamplesRingBuffer::computeAvailableFrames(int readPosition, int writePosition) const
+{
+    int available = writePosition - readPosition;
+    if (available < 0)
+        available += getRingSize();
+    return available;
+}
+
+int SamplesRingBuffer::getAvailableFrames() const
+{
+    return computeAvailableFrames(readPosition.loadAcquire(), writePosition.loadAcquire());
+}
+
+int SamplesRingBuffer::getFreeFrames() const
+{
+    return capacity - getAvailableFrames();
+}
+
+void SamplesRingBuffer::reset()
+{
+    readPosition.storeRelease(0);
+    writePosition.storeRelease(0);
+}
+
+int SamplesRingBuffer::write(const SamplesBuffer &samples)
+{
+    int read = readPosition.loadAcquire();
+    int write = writePosition.load(); // only the producer change the write position
+    int freeFrames = capacity - computeAvailableFrames(read, write);
+    int framesToWrite = std::min(samples.getFrameLenght(), freeFrames);
+    if (framesToWrite <= 0)
+        return 0;
+
+    // the samples are copied in two parts when the ring end is reached
+    int firstPart = std::min(framesToWrite, getRingSize() - write);
+    ring.set(samples, 0, firstPart, write);
+    if (firstPart < framesToWrite)
+        ring.set(samples, firstPart, framesToWrite - firstPart, 0);
+
+    writePosition.storeRelease((write + framesToWrite) % getRingSize());
+    return framesToWrite;
+}
+
+int SamplesRingBuffer::read(SamplesBuffer &out, int frames)
+{
+    int read = readPosition.load(); // only the consumer change the read position
+    int write = writePosition.loadAcquire();
+    int framesToRead = std::min(std::min(frames, out.getFrameLenght()), computeAvailableFrames(read, write));
+    if (framesToRead <= 0)
+        return 0;
+
+    int firstPart = std::min(framesToRead, getRingSize() - read);
+    out.set(ring, read, firstPart, 0);
+    if (firstPart < framesToRead)
+        out.set(ring, 0, framesToRead - firstPart, firstPart);
+
+    readPosition.storeRelease((read + framesToRead) % getRingSize());
+    return framesToRead;
+}
+
+int SamplesRingBuffer::discard(int frames)
+{
+    int read = readPosition.load();
+    int framesToDiscard = std::min(frames, computeAvailableFrames(read, writePosition.loadAcquire()));
+    if (framesToDiscard <= 0)
+        return 0;
+
+    readPosition.storeRelease((read + framesToDiscard) % getRingSize());
+    return framesToDiscard;
+}
@@ -0,0 +1,54 @@
+#ifndef _SAMPLES_RING_BUFFER_H_
+#define _SAMPLES_RING_BUFFER_H_
+
+#include "SamplesBuffer.h"
+#include <QAtomicInt>
+
+namespace Audio {
+
+/**
+ * Single producer/single consumer samples FIFO. The producer (a decoding thread) and
+ * the consumer (the audio thread) never lock, the read and write positions are atomics.
+ */
+
+class SamplesRingBuffer
+{
+public:
+    SamplesRingBuffer(int channels, int capacity);
+
+    int write(const SamplesBuffer &samples); // producer side, return how many frames were written
+    int read(SamplesBuffer &out, int frames); // consumer side, return how many frames were copied to 'out'
+    int discard(int frames); // consumer side
+
+    int getAvailableFrames() const;
+    int getFreeFrames() const;
+
+    inline int getCapacity() const
+    {
+        return capacity;
+    }
+
+    inline int getChannels() const
+    {
+        return ring.getChannels();
+    }
+
+    void reset(); // not thread safe, producer and consumer must be stopped
+
+private:
+    int capacity;
+    SamplesBuffer ring; // one extra frame is used to distinguish full and empty states
+    QAtomicInt readPosition;
+    QAtomicInt writePosition;
+
+    inline int getRingSize() const
+    {
+        return capacity + 1;
+    }
+
+    int computeAvailableFrames(int readPosition, int writePosition) const;
+};
+
+}//namespace
+
+#endif
@@ -0,0 +1,46 @@
+#include "FileReader.h"
+#include <algorithm>
+
+using namespace Audio;
+
+void FileReader::read(const QString &filePath, Audio::SamplesBuffer &outBuffer, quint32 &sampleRate)
+{
+    if (!open(filePath))
+        return; // out buffer is not changed
+
+    sampleRate = getSampleRate();
+    if (getChannels() == 1)
+        outBuffer.setToMono();
+    else
+        outBuffer.setToStereo();
+
+    // files with known length are decoded directly in the out buffer, without reallocations
+    qint64 totalFrames = getTotalFrames();
+    unsigned int capacity = totalFrames >= 0 ? (unsigned int)totalFrames : READ_BLOCK_FRAMES;
+    outBuffer.setFrameLenght(capacity);
+
+    unsigned int frames = 0;
+    forever {
+        if (frames == capacity) {
+            if (totalFrames >= 0)
+                break;
+            capacity *= 2; // unknown length, growing geometrically
+            outBuffer.setFrameLenght(capacity);
+        }
+
+        int decodedFrames = readFrames(outBuffer, frames, capacity - frames);
+        if (decodedFrames <= 0)
+            break;
+        frames += decodedFrames;
+    }
+    outBuffer.setFrameLenght(frames);
+
+    close();
+}
+
+void FileReader::copyMonoChannel(SamplesBuffer &outBuffer, unsigned int outOffset, unsigned int frames)
+{
+    const float *monoSamples = outBuffer.getSamplesArray(0) + outOffset;
+    for (int c = 1; c < outBuffer.getChannels(); ++c)
+        std::copy(monoSamples, monoSamples + frames, outBuffer.getSamplesArray(c) + outOffset);
+}
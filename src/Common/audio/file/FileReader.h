@@ -6,11 +6,37 @@
 
 namespace Audio {
 
+/**
+ * The readers are streaming the files: open() is reading only the file headers and each
+ * readFrames() call is decoding a block in the caller buffer, so large files can be
+ * processed without keeping the whole file decoded in memory.
+ */
+
 class FileReader
 {
 public:
-    virtual void read(const QString &filePath, Audio::SamplesBuffer& outBuffer, quint32 &sampleRate) = 0;
     virtual ~FileReader(){}
+
+    // read the whole file, 'outBuffer' is not changed if the file can't be opened
+    virtual void read(const QString &filePath, Audio::SamplesBuffer& outBuffer, quint32 &sampleRate);
+
+    virtual bool open(const QString &filePath) = 0;
+    virtual void close() = 0;
+
+    // decode 'maxFrames' (or less) frames in 'outBuffer' starting at 'outOffset', the buffer must
+    // have room for the frames. Return the decoded frames, zero in the end of file.
+    virtual int readFrames(Audio::SamplesBuffer &outBuffer, unsigned int outOffset, unsigned int maxFrames) = 0;
+
+    virtual quint32 getSampleRate() const = 0;
+    virtual int getChannels() const = 0;
+    virtual qint64 getTotalFrames() const = 0; // -1 when the file length is unknown
+
+protected:
+    // the mono files are copied to all the 'outBuffer' channels
+    static void copyMonoChannel(Audio::SamplesBuffer &outBuffer, unsigned int outOffset, unsigned int frames);
+
+private:
+    static const int READ_BLOCK_FRAMES = 16384; // used to read files with unknown length
 };
 
 }//namespace
@@ -9,16 +9,43 @@ using namespace Audio;
 class NullFileReader : public FileReader
 {
 public:
-    inline void read(const QString &filePath, Audio::SamplesBuffer &outBuffer, quint32 &sampleRate) override{
+    inline bool open(const QString &filePath) override
+    {
         Q_UNUSED(filePath)
+        return false;
+    }
+
+    inline void close() override
+    {
+    }
+
+    inline int readFrames(Audio::SamplesBuffer &outBuffer, unsigned int outOffset, unsigned int maxFrames) override
+    {
         Q_UNUSED(outBuffer)
-        Q_UNUSED(sampleRate)
+        Q_UNUSED(outOffset)
+        Q_UNUSED(maxFrames)
+        return 0;
+    }
+
+    inline quint32 getSampleRate() const override
+    {
+        return 44100;
+    }
+
+    inline int getChannels() const override
+    {
+        return 0;
+    }
+
+    inline qint64 getTotalFrames() const override
+    {
+        return 0;
     }
 };
 
 std::unique_ptr<FileReader> FileReaderFactory::createFileReader(const QString &filePath)
 {
-    QString fileSuffix = QFileInfo(filePath).suffix();
+    QString fileSuffix = QFileInfo(filePath).suffix().toLower();
     if (fileSuffix == "wav") {
         return std::unique_ptr<Audio::WaveFileReader>(new WaveFileReader());
     }
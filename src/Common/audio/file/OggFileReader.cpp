@@ -1,42 +1,161 @@
 #include "OggFileReader.h"
-#include <QDebug>
-#include <QFile>
-#include <QFileInfo>
-#include "audio/vorbis/VorbisDecoder.h"
+#include "log/Logging.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
 
 using namespace Audio;
 
-void OggFileReader::read(const QString &filePath, Audio::SamplesBuffer &outBuffer, quint32 &sampleRate)
+OggFileReader::OggFileReader() :
+    mappedData(nullptr),
+    mappedSize(0),
+    mappedPosition(0),
+    vorbisFileIsOpen(false),
+    sampleRate(44100),
+    channels(0),
+    totalFrames(-1)
 {
-    // Open the ogg file
-    QFile oggFile(filePath);
-    if (!oggFile.open(QFile::ReadOnly)) {
-        qWarning() << "Failed to open OGG file ..." << filePath;
-        return; // Done, out buffer is not changed
+}
+
+OggFileReader::~OggFileReader()
+{
+    close();
+}
+
+void OggFileReader::close()
+{
+    if (vorbisFileIsOpen)
+        ov_clear(&vorbisFile);
+    vorbisFileIsOpen = false;
+
+    if (mappedData)
+        file.unmap(mappedData);
+    mappedData = nullptr;
+    mappedSize = 0;
+    mappedPosition = 0;
+    file.close();
+
+    channels = 0;
+    totalFrames = -1;
+}
+
+bool OggFileReader::open(const QString &filePath)
+{
+    close();
+
+    file.setFileName(filePath);
+    if (!file.open(QFile::ReadOnly)) {
+        qCWarning(jtAudio) << "Failed to open OGG file ..." << filePath;
+        return false;
+    }
+
+    mappedSize = file.size();
+    mappedData = mappedSize > 0 ? file.map(0, mappedSize) : nullptr;
+    if (!mappedData)
+        mappedSize = 0;
+
+    ov_callbacks callbacks;
+    callbacks.read_func = readCallback;
+    callbacks.seek_func = seekCallback;
+    callbacks.close_func = nullptr; // the file is closed in close()
+    callbacks.tell_func = tellCallback;
+
+    int result = ov_open_callbacks(this, &vorbisFile, nullptr, 0, callbacks);
+    if (result != 0) {
+        qCWarning(jtAudio) << "Invalid OGG file" << filePath << "error:" << result;
+        close();
+        return false;
     }
-    else{
-        qDebug() << "Opening " << filePath;
-
-        VorbisDecoder decoder;
-        decoder.setInputData(oggFile.readAll());
-        decoder.initialize(); //read the ogg headers from file
-        sampleRate = decoder.getSampleRate();
-        if (decoder.isMono())
-            outBuffer.setToMono();
-        else
-            outBuffer.setToStereo();
-
-        //decode and append decoded data in 'outBuffer'
-        int decodedFrames = 0;
-        const int MAX_SAMPLES_PER_DECODE = 1024;
-        do
-        {
-            const Audio::SamplesBuffer &decodedBuffer = decoder.decode(MAX_SAMPLES_PER_DECODE);
-            decodedFrames = decodedBuffer.getFrameLenght();
-            if (!decodedBuffer.isEmpty()) {
-                outBuffer.append(decodedBuffer);
-            }
+    vorbisFileIsOpen = true;
+
+    vorbis_info *info = ov_info(&vorbisFile, -1);
+    sampleRate = info->rate;
+    channels = info->channels;
+
+    ogg_int64_t pcmTotal = ov_pcm_total(&vorbisFile, -1);
+    totalFrames = pcmTotal >= 0 ? pcmTotal : -1;
+
+    qCDebug(jtAudio) << "Opening" << filePath << channels << "channels," << sampleRate << "Hz," << totalFrames << "frames";
+    return true;
+}
+
+int OggFileReader::readFrames(SamplesBuffer &outBuffer, unsigned int outOffset, unsigned int maxFrames)
+{
+    if (!vorbisFileIsOpen)
+        return 0;
+
+    unsigned int frames = std::min(maxFrames, (unsigned int)std::max(outBuffer.getFrameLenght() - (int)outOffset, 0));
+    unsigned int decodedFrames = 0;
+    int channelsToCopy = std::min(channels, outBuffer.getChannels());
+    while (decodedFrames < frames) {
+        float **pcm = nullptr;
+        int framesToDecode = (int)std::min(frames - decodedFrames, (unsigned int)MAX_FRAMES_PER_DECODE);
+        long result = ov_read_float(&vorbisFile, &pcm, framesToDecode, nullptr);
+        if (result == OV_HOLE)
+            continue; // interruption in the data, the decoding can continue
+        if (result <= 0) {
+            if (result < 0)
+                qCWarning(jtAudio) << "Error decoding OGG file:" << result;
+            break; // end of file or error
         }
-        while(decodedFrames > 0);
+
+        for (int c = 0; c < channelsToCopy; ++c)
+            std::memcpy(outBuffer.getSamplesArray(c) + outOffset + decodedFrames, pcm[c], result * sizeof(float));
+        decodedFrames += result;
+    }
+
+    if (channels == 1 && decodedFrames > 0)
+        copyMonoChannel(outBuffer, outOffset, decodedFrames);
+
+    return decodedFrames;
+}
+
+size_t OggFileReader::readCallback(void *buffer, size_t size, size_t count, void *reader)
+{
+    OggFileReader *instance = static_cast<OggFileReader *>(reader);
+    size_t bytesToRead = size * count;
+    if (!instance->mappedData) {
+        qint64 bytesRead = instance->file.read(static_cast<char *>(buffer), bytesToRead);
+        return bytesRead > 0 ? bytesRead : 0;
     }
+
+    bytesToRead = std::min(bytesToRead, (size_t)(instance->mappedSize - instance->mappedPosition));
+    std::memcpy(buffer, instance->mappedData + instance->mappedPosition, bytesToRead);
+    instance->mappedPosition += bytesToRead;
+    return bytesToRead;
+}
+
+int OggFileReader::seekCallback(void *reader, ogg_int64_t offset, int whence)
+{
+    OggFileReader *instance = static_cast<OggFileReader *>(reader);
+    qint64 size = instance->mappedData ? instance->mappedSize : instance->file.size();
+    qint64 position = instance->mappedData ? instance->mappedPosition : instance->file.pos();
+    switch (whence) {
+    case SEEK_SET:
+        position = offset;
+        break;
+    case SEEK_CUR:
+        position += offset;
+        break;
+    case SEEK_END:
+        position = size + offset;
+        break;
+    default:
+        return -1;
+    }
+
+    if (position < 0 || position > size)
+        return -1;
+
+    if (instance->mappedData)
+        instance->mappedPosition = position;
+    else if (!instance->file.seek(position))
+        return -1;
+    return 0;
+}
+
+long OggFileReader::tellCallback(void *reader)
+{
+    OggFileReader *instance = static_cast<OggFileReader *>(reader);
+    return (long)(instance->mappedData ? instance->mappedPosition : instance->file.pos());
 }
@@ -2,14 +2,61 @@
 #define OGGFILEREADER_H
 
 #include "FileReader.h"
+#include <QFile>
+#include <vorbis/vorbisfile.h>
 
 namespace Audio {
 
+/**
+ * Ogg vorbis files reader. The vorbisfile library is reading the memory mapped file (or the
+ * file when the mapping is not available) using seekable callbacks, so the file length is
+ * known and the audio is decoded in chunks directly in the caller buffer.
+ */
+
 class OggFileReader : public FileReader
 {
 public:
-    void read(const QString &filePath, Audio::SamplesBuffer &outBuffer, quint32 &sampleRate) override;
+    OggFileReader();
+    ~OggFileReader();
+
+    bool open(const QString &filePath) override;
+    void close() override;
+    int readFrames(Audio::SamplesBuffer &outBuffer, unsigned int outOffset, unsigned int maxFrames) override;
+
+    inline quint32 getSampleRate() const override
+    {
+        return sampleRate;
+    }
+
+    inline int getChannels() const override
+    {
+        return channels;
+    }
+
+    inline qint64 getTotalFrames() const override
+    {
+        return totalFrames;
+    }
+
+private:
+    QFile file;
+    uchar *mappedData; // null when the vorbis data is read from the file
+    qint64 mappedSize;
+    qint64 mappedPosition;
+
+    OggVorbis_File vorbisFile;
+    bool vorbisFileIsOpen;
+
+    quint32 sampleRate;
+    int channels;
+    qint64 totalFrames;
+
+    static const int MAX_FRAMES_PER_DECODE = 4096;
 
+    // vorbisfile callbacks
+    static size_t readCallback(void *buffer, size_t size, size_t count, void *reader);
+    static int seekCallback(void *reader, ogg_int64_t offset, int whence);
+    static long tellCallback(void *reader);
 };
 
 }//namespace
@@ -1,173 +1,195 @@
 #include "WaveFileReader.h"
-#include <QDebug>
-#include <QFile>
-#include <QFileInfo>
-#include <cmath>
+#include "log/Logging.h"
 #include <QtEndian>
-#include <QDataStream>
-#include <memory>
+#include <algorithm>
 
 using namespace Audio;
 
-class SampleExtractor
-{
-public:
-    SampleExtractor(QDataStream *stream)
-        :stream(stream)
-    {
-    }
+namespace {
 
-    virtual float nextSample() = 0;
-protected:
-    QDataStream *stream;
+enum WaveFormat {
+    WAVE_FORMAT_PCM = 1,
+    WAVE_FORMAT_IEEE_FLOAT = 3,
+    WAVE_FORMAT_EXTENSIBLE = 0xFFFE // the real format is in the first 2 bytes of the sub format GUID
 };
 
-class SampleExtractor16Bits : public SampleExtractor
+bool getSampleFormat(quint16 formatTag, quint16 bitsPerSample, PcmConversion::SampleFormat *format)
 {
-    public:
+    if (formatTag == WAVE_FORMAT_IEEE_FLOAT) {
+        *format = PcmConversion::SampleFormat::Float32;
+        return bitsPerSample == 32;
+    }
 
-        SampleExtractor16Bits(QDataStream *stream)
-            :SampleExtractor(stream)
-        {
-            qDebug() << "Creating a SampleExtrator for 16 bits audio";
-        }
+    if (formatTag != WAVE_FORMAT_PCM)
+        return false;
+
+    switch (bitsPerSample) {
+    case 8:
+        *format = PcmConversion::SampleFormat::UInt8;
+        return true;
+    case 16:
+        *format = PcmConversion::SampleFormat::Int16;
+        return true;
+    case 24:
+        *format = PcmConversion::SampleFormat::Int24;
+        return true;
+    case 32:
+        *format = PcmConversion::SampleFormat::Int32;
+        return true;
+    }
+    return false;
+}
 
-        float nextSample() override
-        {
-            qint16 sampleValue;
-            *stream >> sampleValue;
-            return sampleValue / 32767.0f;
-        }
-};
+}
 
-class SampleExtractor24Bits : public SampleExtractor
+WaveFileReader::WaveFileReader() :
+    mappedData(nullptr),
+    sampleFormat(PcmConversion::SampleFormat::Int16),
+    sampleRate(44100),
+    channels(0),
+    bytesPerFrame(0),
+    dataOffset(0),
+    totalFrames(0),
+    position(0)
 {
-    public:
-        SampleExtractor24Bits(QDataStream *stream)
-            :SampleExtractor(stream)
-        {
-            qDebug() << "Creating a SampleExtrator for 24 bits audio";
-        }
+}
 
-        float nextSample() override
-        {
+WaveFileReader::~WaveFileReader()
+{
+    close();
+}
 
-            char buffer[3];
-            stream->readRawData(buffer, 3);
-            qint32 sampleValue = (qint32)((buffer[0] & 0xFF) | (buffer[1] << 8) | (buffer[2] << 16));
-            return sampleValue / 8388607.0; // 8388607 = max value in 24 bits
-        }
-};
+void WaveFileReader::close()
+{
+    if (mappedData)
+        file.unmap(mappedData);
+    mappedData = nullptr;
+    file.close();
+    readBuffer.clear();
+    channels = 0;
+    totalFrames = 0;
+    position = 0;
+}
 
-class SampleExtractor8Bits : public SampleExtractor
+bool WaveFileReader::open(const QString &filePath)
 {
-    public:
-        SampleExtractor8Bits(QDataStream *stream)
-            :SampleExtractor(stream)
-        {
-            qDebug() << "Creating a SampleExtrator for 8 bits audio";
-        }
+    close();
 
-        float nextSample() override
-        {
-            qint8 byte;
-            *stream >> byte;
-            return byte / 127.0;
-        }
-};
+    file.setFileName(filePath);
+    if (!file.open(QFile::ReadOnly)) {
+        qCWarning(jtAudio) << "Failed to open WAV file ..." << filePath;
+        return false;
+    }
 
-class NullSampleExtractor : public SampleExtractor
-{
-    public:
-        NullSampleExtractor()
-            :SampleExtractor(nullptr)
-        {
-        }
+    if (!readHeaders()) {
+        qCWarning(jtAudio) << "Invalid or unsupported WAV file" << filePath;
+        close();
+        return false;
+    }
 
-        float nextSample() override
-        {
-            return 0.0;
-        }
-};
+    mappedData = file.map(0, file.size());
+    if (!mappedData)
+        qCDebug(jtAudio) << "Can't map the WAV file" << filePath << ", reading in blocks";
+
+    qCDebug(jtAudio) << "Opening" << filePath << channels << "channels," << sampleRate << "Hz," << totalFrames << "frames";
+    return true;
+}
 
-class SampleExtractorFactory
+bool WaveFileReader::readHeaders()
 {
-public:
-    static std::unique_ptr<SampleExtractor> createExtractor(QDataStream *stream, quint8 bitsPerSample)
-    {
-        switch (bitsPerSample/8) {
-            case 1: return std::unique_ptr<SampleExtractor8Bits>(new SampleExtractor8Bits(stream));
-            case 2: return std::unique_ptr<SampleExtractor16Bits>(new SampleExtractor16Bits(stream));
-            //case 3: return std::make_unique<SampleExtractor24Bits>(stream);
-            //case 4: return std::make_unique<SampleExtractor32Bits>(stream);
+    // RIFF header, followed by the chunks: 4 bytes ID and 4 bytes size (little endian)
+    QByteArray riffHeader = file.read(12);
+    if (riffHeader.size() < 12 || !riffHeader.startsWith("RIFF") || riffHeader.mid(8, 4) != "WAVE")
+        return false;
+
+    bool formatFound = false;
+    qint64 chunkOffset = 12;
+    qint64 fileSize = file.size();
+    while (chunkOffset + 8 <= fileSize) {
+        file.seek(chunkOffset);
+        QByteArray chunkHeader = file.read(8);
+        if (chunkHeader.size() < 8)
+            return false;
+
+        QByteArray chunkID = chunkHeader.left(4);
+        quint32 chunkSize = qFromLittleEndian<quint32>(reinterpret_cast<const uchar *>(chunkHeader.constData() + 4));
+
+        if (chunkID == "fmt ") {
+            QByteArray format = file.read(qMin(chunkSize, 40u));
+            if (format.size() < 16)
+                return false;
+
+            const uchar *data = reinterpret_cast<const uchar *>(format.constData());
+            quint16 formatTag = qFromLittleEndian<quint16>(data);
+            channels = qFromLittleEndian<quint16>(data + 2);
+            sampleRate = qFromLittleEndian<quint32>(data + 4);
+            quint16 bitsPerSample = qFromLittleEndian<quint16>(data + 14);
+            if (formatTag == WAVE_FORMAT_EXTENSIBLE && format.size() >= 26)
+                formatTag = qFromLittleEndian<quint16>(data + 24);
+
+            if (channels <= 0 || channels > MAX_CHANNELS || !getSampleFormat(formatTag, bitsPerSample, &sampleFormat)) {
+                qCWarning(jtAudio) << "Unsupported WAV format:" << formatTag << bitsPerSample << "bits," << channels << "channels";
+                return false;
+            }
+            bytesPerFrame = PcmConversion::getBytesPerSample(sampleFormat) * channels;
+            formatFound = true;
+        } else if (chunkID == "data") {
+            if (!formatFound)
+                return false;
+
+            // truncated files are accepted, the data chunk size is limited to the file size
+            dataOffset = chunkOffset + 8;
+            qint64 dataSize = qMin((qint64)chunkSize, fileSize - dataOffset);
+            totalFrames = dataSize / bytesPerFrame;
+            return true;
         }
-        qCritical() << "Can't create a SampleExtractor to handle " << bitsPerSample << " bits per sample!";
-        return std::unique_ptr<NullSampleExtractor>(new NullSampleExtractor());
+
+        chunkOffset += 8 + chunkSize + (chunkSize & 1); // the chunks are word aligned
     }
-};
+    return false;
+}
 
-void WaveFileReader::read(const QString &filePath, Audio::SamplesBuffer &outBuffer, quint32 &sampleRate)
+int WaveFileReader::readFrames(SamplesBuffer &outBuffer, unsigned int outOffset, unsigned int maxFrames)
 {
-    // Open the wave file
-    QFile wavFile(filePath);
-    if (!wavFile.open(QFile::ReadOnly)) {
-        qWarning() << "Failed to open WAV file ..." << filePath;
-        return; // Done, out buffer is not changed
-    }
-    else{
-        qDebug() << "Opening " << filePath;
+    if (!file.isOpen())
+        return 0;
+
+    unsigned int frames = (unsigned int)qMin((qint64)maxFrames, totalFrames - position);
+    frames = qMin(frames, (unsigned int)qMax(outBuffer.getFrameLenght() - (int)outOffset, 0));
+    if (frames == 0)
+        return 0;
+
+    unsigned int channelsToConvert = qMin(channels, outBuffer.getChannels());
+    float *channelArrays[MAX_CHANNELS];
+    for (unsigned int c = 0; c < channelsToConvert; ++c)
+        channelArrays[c] = outBuffer.getSamplesArray(c) + outOffset;
+
+    qint64 byteOffset = dataOffset + position * bytesPerFrame;
+    if (mappedData) {
+        PcmConversion::toFloat(mappedData + byteOffset, sampleFormat, channels, channelArrays, channelsToConvert, frames);
+    } else {
+        // reading in blocks, so the memory used is bounded
+        unsigned int blockFrames = qMax(READ_BLOCK_SIZE / bytesPerFrame, 1);
+        file.seek(byteOffset);
+        for (unsigned int frame = 0; frame < frames; frame += blockFrames) {
+            unsigned int framesToRead = qMin(blockFrames, frames - frame);
+            readBuffer.resize(framesToRead * bytesPerFrame);
+            qint64 bytesRead = file.read(readBuffer.data(), readBuffer.size());
+            if (bytesRead < readBuffer.size()) {
+                frames = frame + qMax(bytesRead, (qint64)0) / bytesPerFrame; // file truncated while reading
+                framesToRead = frames - frame;
+            }
+
+            PcmConversion::toFloat(reinterpret_cast<const uchar *>(readBuffer.constData()), sampleFormat, channels,
+                                   channelArrays, channelsToConvert, framesToRead);
+            for (unsigned int c = 0; c < channelsToConvert; ++c)
+                channelArrays[c] += framesToRead;
+        }
     }
 
-    // Read in the whole thing
-    QByteArray wavFileContent = wavFile.readAll();
-
-    // Define the header components
-    quint8 fileType[4];
-    quint32 fileSize;
-    quint8 waveName[4];
-    quint8 fmtName[3];
-    quint32 fmtLength;
-    quint16 fmtType;
-    quint16 channels;
-    quint32 sampleRateXBitsPerSampleXChanngelsDivEight;
-    quint16 bitsPerSampleXChannelsDivEightPointOne;
-    quint16 bitsPerSample;
-    quint8 dataHeader[4];
-    quint32 dataSize;
-
-    // Create a data stream to analyze the data
-    QDataStream stream(&wavFileContent, QIODevice::ReadOnly);
-    stream.setByteOrder(QDataStream::LittleEndian);
-
-    // Now pop off the appropriate data into each header field defined above
-    stream.readRawData((char *)fileType, 4); // "RIFF"
-    stream >> fileSize; // File Size
-    stream.readRawData((char *)waveName, 4); // "WAVE"
-    stream.readRawData((char *)fmtName, 4); // "fmt"
-    stream >> fmtLength; // Format length
-    stream >> fmtType; // Format type
-    stream >> channels; // Number of channels
-    stream >> sampleRate; // Sample rate
-    stream >> sampleRateXBitsPerSampleXChanngelsDivEight; // (Sample Rate * BitsPerSample * Channels) / 8
-    stream >> bitsPerSampleXChannelsDivEightPointOne; // (BitsPerSample * Channels) / 8.1
-    stream >> bitsPerSample; // Bits per sample
-    stream.readRawData((char *)dataHeader, 4); // "data" header
-    stream >> dataSize; // Data Size
-
-    int samples = dataSize / channels / (bitsPerSample/ 8);
-
     if (channels == 1)
-        outBuffer.setToMono();
-    else
-        outBuffer.setToStereo();
-    outBuffer.setFrameLenght(samples);
-
-    // Now pull out the data
-    std::unique_ptr<SampleExtractor> sampleExtractor = SampleExtractorFactory::createExtractor(&stream, bitsPerSample);
-    for (int s = 0; s < samples; ++s) {
-        for (int c = 0; c < channels; ++c) {
-            float sample = sampleExtractor->nextSample();
-            outBuffer.set(c, s, sample);
-        }
-    }
+        copyMonoChannel(outBuffer, outOffset, frames);
+
+    position += frames;
+    return frames;
 }
@@ -2,14 +2,59 @@
 #define WAVEFILEREADER_H
 
 #include "FileReader.h"
+#include "audio/core/PcmConversion.h"
+#include <QFile>
+#include <QByteArray>
 
 namespace Audio {
 
+/**
+ * PCM (8, 16, 24 and 32 bits) and float wave files reader. The file is memory mapped and the
+ * samples are converted in blocks, the file is read in blocks when the mapping is not available.
+ */
+
 class WaveFileReader : public FileReader
 {
 public:
-    void read(const QString &filePath, Audio::SamplesBuffer &outBuffer, quint32 &sampleRate) override;
+    WaveFileReader();
+    ~WaveFileReader();
+
+    bool open(const QString &filePath) override;
+    void close() override;
+    int readFrames(Audio::SamplesBuffer &outBuffer, unsigned int outOffset, unsigned int maxFrames) override;
+
+    inline quint32 getSampleRate() const override
+    {
+        return sampleRate;
+    }
+
+    inline int getChannels() const override
+    {
+        return channels;
+    }
+
+    inline qint64 getTotalFrames() const override
+    {
+        return totalFrames;
+    }
+
+private:
+    QFile file;
+    uchar *mappedData; // null when the file is read in blocks
+    QByteArray readBuffer;
+
+    PcmConversion::SampleFormat sampleFormat;
+    quint32 sampleRate;
+    int channels;
+    int bytesPerFrame;
+    qint64 dataOffset;
+    qint64 totalFrames;
+    qint64 position; // in frames
+
+    bool readHeaders();
 
+    static const int MAX_CHANNELS = 32;
+    static const int READ_BLOCK_SIZE = 64 * 1024; // bytes, used when the file is not mapped
 };
 
 }//namespace
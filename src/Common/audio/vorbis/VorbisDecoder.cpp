@@ -9,6 +9,7 @@
 #include <vorbis/vorbisfile.h>
 #include <QThread>
 #include "log/Logging.h"
+#include "performance/Profiler.h"
 //+++++++++++++++++++++++++++++++++++++++++++
 VorbisDecoder::VorbisDecoder()
     : internalBuffer(2, 4096),
@@ -48,6 +49,7 @@ size_t VorbisDecoder::readOgg(void *oggOutBuffer, size_t size, size_t nmemb, voi
 }
 //+++++++++++++++++++++++++++++++++++++++++++
 const Audio::SamplesBuffer &VorbisDecoder::decode(int maxSamplesToDecode){
+    JT_PROFILE_SCOPE("VorbisDecoder::decode");
     if(!initialized){
         initialize();
     }
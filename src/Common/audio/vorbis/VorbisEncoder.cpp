@@ -3,87 +3,138 @@
 #include <ctime>
 #include <QThread>
 #include "log/Logging.h"
+#include "performance/Profiler.h"
+#include <algorithm>
 
-const float VorbisEncoder::QUALITY = 0.32f;
+const float VorbisEncoder::DEFAULT_QUALITY = 0.32f;
 
 VorbisEncoder::VorbisEncoder()
-    :initialized(false)
+    :channels(1),
+      sampleRate(44100),
+      quality(DEFAULT_QUALITY),
+      initialized(false)
 {
-    init(1, 44100);
+    init();
 }
 
-VorbisEncoder::VorbisEncoder(int channels, int sampleRate):
+VorbisEncoder::VorbisEncoder(int channels, int sampleRate, float quality):
+    channels(channels),
+    sampleRate(sampleRate),
+    quality(quality),
     initialized(false)
 {
-    init(channels, sampleRate);
+    init();
 }
 
-void VorbisEncoder::init(int channels, int sampleRate){
-    qCDebug(jtNinjamVorbisEncoder) << "Initializing VorbisEncoder Thread:" << QThread::currentThreadId();
-    vorbis_info_init(&info);
+void VorbisEncoder::setPagePolicy(int targetPageSize, int maxPageLatency){
+    this->targetPageSize = qMax(targetPageSize, 1);
+    this->maxPageLatency = qMax((qint64)maxPageLatency * sampleRate / 1000, (qint64)1);
+}
 
-    if(vorbis_encode_init_vbr(&info, (long) channels, (long) sampleRate, QUALITY) != 0){
-        qCritical() << "vorbis encoder initialization error!";
-    }
+void VorbisEncoder::init(){
+    qCDebug(jtNinjamVorbisEncoder) << "Initializing VorbisEncoder Thread:" << QThread::currentThreadId();
     vorbis_comment_init(&comment);
     vorbis_comment_add_tag(&comment, "Encoder", "Jamtaba");
 
+    setPagePolicy(DEFAULT_PAGE_SIZE, DEFAULT_PAGE_LATENCY);
+
+    for (int i = 0; i < 2; ++i) {
+        streams[i].allocated = false;
+        streams[i].prepared = false;
+    }
+    currentStream = &streams[0];
+    nextStream = &streams[1];
+
     streamID = 0;
-    isFirstEncoding = true;
 
     totalEncoded = 0;
 }
 
 //++++++++++++++++++++++++++++++++++++++++++
-void VorbisEncoder::clearState(){
-    ogg_stream_clear(&streamState);
-    vorbis_block_clear(&block);
-    vorbis_dsp_clear(&dspState);
-    outBuffer.clear();
+void VorbisEncoder::clearStream(IntervalStream &stream){
+    if (stream.allocated) {
+        ogg_stream_clear(&stream.streamState);
+        vorbis_block_clear(&stream.block);
+        vorbis_dsp_clear(&stream.dspState);
+        vorbis_info_clear(&stream.info);
+    }
+    stream.headers.clear();
+    stream.allocated = false;
+    stream.prepared = false;
 }
 
 VorbisEncoder::~VorbisEncoder() {
     qCDebug(jtNinjamVorbisEncoder) << "ENCODER DESTRUCTOR! Thread:" <<  QThread::currentThreadId();
-    if(initialized){
-        clearState();
-    }
+    clearStream(streams[0]);
+    clearStream(streams[1]);
     vorbis_comment_clear(&comment);
-    vorbis_info_clear(&info);
 }
 //++++++++++++++++++++++++++++++++++++++++++
-void VorbisEncoder::encodeFirstVorbisHeaders(){
-    vorbis_analysis_init(&dspState, &info);
-    vorbis_block_init(&dspState, &block);
-    ogg_stream_init(&streamState, streamID++);
+void VorbisEncoder::prepareStream(IntervalStream &stream){
+    JT_PROFILE_SCOPE("VorbisEncoder::prepareStream");
+
+    clearStream(stream);
+
+    vorbis_info_init(&stream.info);
+    if(vorbis_encode_init_vbr(&stream.info, (long) channels, (long) sampleRate, quality) != 0){
+        qCritical() << "vorbis encoder initialization error!";
+    }
+    stream.quality = quality;
+
+    vorbis_analysis_init(&stream.dspState, &stream.info);
+    vorbis_block_init(&stream.dspState, &stream.block);
+    ogg_stream_init(&stream.streamState, streamID++);
 
     //writing headers
     ogg_packet header, header_comm, header_code;
-    vorbis_analysis_headerout(&dspState, &comment, &header, &header_comm, &header_code);
-    ogg_stream_packetin(&streamState, &header);
-    ogg_stream_packetin(&streamState, &header_comm);
-    ogg_stream_packetin(&streamState, &header_code);
+    vorbis_analysis_headerout(&stream.dspState, &comment, &header, &header_comm, &header_code);
+    ogg_stream_packetin(&stream.streamState, &header);
+    ogg_stream_packetin(&stream.streamState, &header_comm);
+    ogg_stream_packetin(&stream.streamState, &header_code);
 
-    //write ogg_page page in out buffer;
+    //write ogg_page page in headers buffer;
     while (true) {
         ogg_page page;
-        int result = ogg_stream_flush(&streamState, &page);
+        int result = ogg_stream_flush(&stream.streamState, &page);
         if (result == 0) break;
         //header and body
-        outBuffer.append((const char*)page.header, page.header_len);//memcpy(buffer, page.header, page.header_len);
-        outBuffer.append((const char*)page.body, page.body_len);//memcpy(buffer, page.body, page.body_len);
+        stream.headers.append((const char*)page.header, page.header_len);
+        stream.headers.append((const char*)page.body, page.body_len);
+    }
+    stream.lastPageGranule = 0;
+    stream.pendingPageBytes = 0; // the headers are flushed
+    stream.allocated = true;
+    stream.prepared = true;
+}
+
+void VorbisEncoder::prepareNextInterval(){
+    // the stream prepared while the encoder was not encoding (after the interval end) is the stream of the starting interval, it's not changed
+    if (nextStream->prepared && (nextStream->quality == quality || !initialized))
+        return;
+
+    prepareStream(*nextStream);
+}
+
+void VorbisEncoder::startInterval(){
+    JT_PROFILE_SCOPE("VorbisEncoder::startInterval");
+
+    if (!nextStream->prepared) { // first interval, or the encoding thread was busy in the whole interval
+        qCDebug(jtNinjamVorbisEncoder) << "next interval stream not prepared, initializing in the interval start";
+        prepareStream(*nextStream);
     }
+
+    // the previous interval stream is cleared in the next prepareNextInterval() call
+    std::swap(currentStream, nextStream);
+    currentStream->prepared = false;
+    outBuffer = currentStream->headers;
     initialized = true;
-    isFirstEncoding = false;//clear state in next encoding
 }
 
 //++++++++++++++++++++++++++++++++++++++++++
 QByteArray VorbisEncoder::encode(const Audio::SamplesBuffer& samples) {
     //qCDebug(vorbisEncoder) << "Encoding " << samples.getFrameLenght() << " samples.";
     if (!initialized) {
-        if(!isFirstEncoding){
-            clearState();
-        }
-        encodeFirstVorbisHeaders();
+        startInterval();
     }
     else{
         outBuffer.clear();
@@ -91,47 +142,58 @@ QByteArray VorbisEncoder::encode(const Audio::SamplesBuffer& samples) {
 
     if (samples.getFrameLenght() > 0) {//is not the end
         //copy the samples to encode to vorbis input buffer
-        float** vorbisBuffer = vorbis_analysis_buffer(&dspState, samples.getFrameLenght());
+        float** vorbisBuffer = vorbis_analysis_buffer(&currentStream->dspState, samples.getFrameLenght());
 
-        int channels = std::min(info.channels, samples.getChannels());
+        int channels = std::min(this->channels, samples.getChannels());
         for (int c = 0; c < channels; c++) {
             memcpy(vorbisBuffer[c], samples.getSamplesArray(c), samples.getFrameLenght() * sizeof(float));
         }
     }
     //lenght == 0 in the end of interval
-    int result = vorbis_analysis_wrote(&dspState, samples.getFrameLenght()); // tell the library how much we actually submitted
+    int result = vorbis_analysis_wrote(&currentStream->dspState, samples.getFrameLenght()); // tell the library how much we actually submitted
     if(result != 0){
         qCCritical(jtNinjamVorbisEncoder) << "encoder error!";
     }
 
     //++++++++++++++++++++++++ encoding +++++++++
-    bool endOfStream = false;
-    while (vorbis_analysis_blockout(&dspState, &block))
+    ogg_stream_state &streamState = currentStream->streamState;
+    while (vorbis_analysis_blockout(&currentStream->dspState, &currentStream->block))
     {
-        vorbis_analysis(&block, NULL);
-        vorbis_bitrate_addblock(&block);
+        vorbis_analysis(&currentStream->block, NULL);
+        vorbis_bitrate_addblock(&currentStream->block);
         ogg_packet packet;
-        while (vorbis_bitrate_flushpacket(&dspState, &packet))
+        while (vorbis_bitrate_flushpacket(&currentStream->dspState, &packet))
         {
             ogg_stream_packetin(&streamState, &packet);
-            while (!endOfStream)
-            {
-                ogg_page page;
-                if (!ogg_stream_flush(&streamState, &page)) {
-                    break;
-                }
-
-                //header and body
-                outBuffer.append((const char*)page.header, page.header_len);//memcpy(buffer, page.header, page.header_len);
-                outBuffer.append((const char*)page.body, page.body_len);//memcpy(buffer, page.body, page.body_len);
-                qCDebug(jtNinjamVorbisEncoder) << "encoded bytes added to out buffer  bytes:" << outBuffer.size();
-                if (ogg_page_eos(&page))
-                    endOfStream = true;
-            }
+            currentStream->pendingPageBytes += packet.bytes;
+
+            // a page per packet is wasting 27 bytes (page header) and more work in all the receivers
+            bool pageIsFull = currentStream->pendingPageBytes >= targetPageSize;
+            bool pageIsLate = packet.granulepos - currentStream->lastPageGranule >= maxPageLatency;
+            writePages(pageIsFull || pageIsLate);
         }
     }
+
+    if (samples.getFrameLenght() == 0) //end of interval
+        writePages(true);
+
     return outBuffer;
 }
+
+void VorbisEncoder::writePages(bool flush){
+    ogg_stream_state &streamState = currentStream->streamState;
+    ogg_page page;
+    while (flush ? ogg_stream_flush(&streamState, &page) : ogg_stream_pageout(&streamState, &page)) {
+        //header and body
+        outBuffer.append((const char*)page.header, page.header_len);
+        outBuffer.append((const char*)page.body, page.body_len);
+        currentStream->pendingPageBytes = qMax(currentStream->pendingPageBytes - page.body_len, 0L);
+
+        ogg_int64_t granule = ogg_page_granulepos(&page);
+        if (granule >= 0) // -1 when no packet is finished in the page
+            currentStream->lastPageGranule = granule;
+    }
+}
 //++++++++++++++++++++++++++++++++++++++++++
 QByteArray VorbisEncoder::finishIntervalEncoding() {
     QByteArray data = encode(Audio::SamplesBuffer::ZERO_BUFFER);//pass zero samples to vorbis and finalize the encoding process
@@ -10,22 +10,55 @@ class VorbisEncoder
 
 public:
     VorbisEncoder();
-    VorbisEncoder(int channels, int sampleRate);
+    VorbisEncoder(int channels, int sampleRate, float quality = DEFAULT_QUALITY);
     ~VorbisEncoder();
 
     QByteArray encode(const Audio::SamplesBuffer& in);
     QByteArray finishIntervalEncoding();
-    inline int getChannels() const{return info.channels;}
-    inline int getSampleRate() const{return info.rate;}
+    inline int getChannels() const{return channels;}
+    inline int getSampleRate() const{return sampleRate;}
+
+    // the next interval stream (and headers) are initialized before the interval start, and the
+    // previous interval stream is cleared. Called by the encoding thread when there is nothing to encode.
+    void prepareNextInterval();
+
+    // the quality is changed only in the interval start, the stream in encoding is not changed
+    inline void setQuality(float quality){this->quality = quality;}
+    inline float getQuality() const{return quality;}
+
+    // the ogg pages are filled up to 'targetPageSize' bytes (libogg is closing the pages at about 4 KB), or flushed
+    // when the page contains more than 'maxPageLatency' milliseconds of audio. The interval end is always flushed.
+    void setPagePolicy(int targetPageSize, int maxPageLatency);
+
+    static const float DEFAULT_QUALITY;// = 0.32;//vorbis default quality is 0.3
+    static const int DEFAULT_PAGE_SIZE = 4096; // same size of the upload writes
+    static const int DEFAULT_PAGE_LATENCY = 250;
 
 private:
-    static const float QUALITY;// = 0.32;//vorbis default quality is 0.3
-    ogg_stream_state streamState; /* take physical pages, weld into a logical stream of packets */
-    vorbis_info      info; /* struct that stores all the static vorbis bitstream settings */
+    int channels;
+    int sampleRate;
+    float quality;
+    int targetPageSize;
+    qint64 maxPageLatency; // in samples
     vorbis_comment   comment; /* struct that stores all the user comments */
 
-    vorbis_dsp_state dspState; /* central working state for the packet->PCM decoder */
-    vorbis_block     block; /* local working space for packet->PCM decode */
+    struct IntervalStream
+    {
+        vorbis_info      info; /* struct that stores all the static vorbis bitstream settings */
+        float quality;
+        ogg_stream_state streamState; /* take physical pages, weld into a logical stream of packets */
+        vorbis_dsp_state dspState; /* central working state for the packet->PCM decoder */
+        vorbis_block     block; /* local working space for packet->PCM decode */
+        QByteArray headers; // the first ogg pages
+        ogg_int64_t lastPageGranule; // the last sample in the written pages
+        long pendingPageBytes; // packets bytes submitted to the ogg stream and not written in pages yet
+        bool allocated; // the libvorbis and libogg states need to be cleared
+        bool prepared; // initialized and not used yet
+    };
+
+    IntervalStream streams[2];
+    IntervalStream *currentStream; // the interval in encoding
+    IntervalStream *nextStream;
 
     int totalEncoded;
 
@@ -33,12 +66,12 @@ private:
 
     QByteArray outBuffer;
 
-    void init(int channels, int sampleRate);
-
-    void encodeFirstVorbisHeaders();
-    void clearState();
+    void init();
 
-    bool isFirstEncoding;
+    void startInterval();
+    void prepareStream(IntervalStream &stream);
+    void clearStream(IntervalStream &stream);
+    void writePages(bool flush);
 
     int streamID;
 };
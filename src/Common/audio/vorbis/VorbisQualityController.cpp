@@ -0,0 +1,84 @@
+#include "VorbisQualityController.h"
+
+namespace {
+
+const float LEVELS[] = {0.0f, 0.1f, 0.2f, 0.32f, 0.45f, 0.6f}; // vorbis quality is between -0.1 and 1.0
+const int LEVELS_COUNT = sizeof(LEVELS) / sizeof(LEVELS[0]);
+const int DEFAULT_LEVEL = 3;
+
+// upload backlog, relative to the bytes encoded in one interval
+const double SEVERE_BACKLOG = 0.5;
+const double BACKLOG = 0.1;
+const double NO_BACKLOG = 0.02;
+
+// encoder time, relative to the interval time
+const double HIGH_CPU = 0.5;
+const double LOW_CPU = 0.15;
+
+}
+
+const float VorbisQualityController::DEFAULT = LEVELS[DEFAULT_LEVEL];
+
+VorbisQualityController::VorbisQualityController()
+{
+    reset();
+}
+
+void VorbisQualityController::reset()
+{
+    level = DEFAULT_LEVEL;
+    reason = DEFAULT_QUALITY;
+    stableIntervals = 0;
+}
+
+float VorbisQualityController::getQuality() const
+{
+    return LEVELS[level];
+}
+
+int VorbisQualityController::getMaxLevel(int usersInRoom) const
+{
+    return usersInRoom >= CROWDED_ROOM_USERS ? DEFAULT_LEVEL : LEVELS_COUNT - 1;
+}
+
+bool VorbisQualityController::update(const IntervalStatistics &statistics)
+{
+    if (statistics.intervalTime <= 0)
+        return false;
+
+    double backlog = 0;
+    if (statistics.encodedBytes > 0)
+        backlog = (double)statistics.uploadBacklog / statistics.encodedBytes;
+    else if (statistics.uploadBacklog > 0)
+        backlog = SEVERE_BACKLOG; // nothing encoded and the old data is not sent yet
+
+    double cpu = (double)statistics.encodingTime / statistics.intervalTime;
+
+    int oldLevel = level;
+    Reason oldReason = reason;
+    int maxLevel = getMaxLevel(statistics.usersInRoom);
+    if (backlog >= BACKLOG) {
+        level -= backlog >= SEVERE_BACKLOG ? 2 : 1;
+        reason = UPLOAD_BACKLOG;
+        stableIntervals = 0;
+    } else if (cpu >= HIGH_CPU) {
+        level--;
+        reason = ENCODER_CPU;
+        stableIntervals = 0;
+    } else if (level > maxLevel) {
+        level = maxLevel;
+        reason = CROWDED_ROOM;
+        stableIntervals = 0;
+    } else if (backlog <= NO_BACKLOG && cpu <= LOW_CPU) {
+        if (++stableIntervals >= STABLE_INTERVALS_TO_INCREASE && level < maxLevel) {
+            level++;
+            reason = HEADROOM;
+            stableIntervals = 0;
+        }
+    } else {
+        stableIntervals = 0;
+    }
+
+    level = qBound(0, level, LEVELS_COUNT - 1);
+    return level != oldLevel || reason != oldReason;
+}
@@ -0,0 +1,60 @@
+#ifndef _VORBIS_QUALITY_CONTROLLER_H_
+#define _VORBIS_QUALITY_CONTROLLER_H_
+
+#include <QtGlobal>
+
+/**
+ * Choose the Vorbis quality of a channel group. The quality is updated in the interval start,
+ * using the previous interval statistics: the quality is reduced when the upload is late (bytes
+ * waiting in the socket) or when the encoder CPU time is too high, and is slowly increased when
+ * the upload and the CPU have headroom. In crowded rooms the quality is limited to the default
+ * quality, all the users are downloading all the channels.
+ */
+
+class VorbisQualityController
+{
+public:
+    enum Reason {
+        DEFAULT_QUALITY, // no changes since the start
+        UPLOAD_BACKLOG,
+        ENCODER_CPU,
+        CROWDED_ROOM,
+        HEADROOM // upload and CPU are fine, the quality was increased
+    };
+
+    struct IntervalStatistics
+    {
+        qint64 uploadBacklog; // bytes waiting to be sent in the interval start
+        qint64 encodedBytes; // bytes encoded in the previous interval (all channel groups)
+        qint64 encodingTime; // encoder thread time used by the channel group in the previous interval, in nanoseconds
+        qint64 intervalTime; // in nanoseconds
+        int usersInRoom;
+    };
+
+    VorbisQualityController();
+
+    bool update(const IntervalStatistics &statistics); // return true if the quality or the reason was changed
+
+    float getQuality() const;
+
+    inline Reason getReason() const
+    {
+        return reason;
+    }
+
+    void reset();
+
+    static const float DEFAULT; // the old fixed quality
+
+    static const int CROWDED_ROOM_USERS = 8;
+    static const int STABLE_INTERVALS_TO_INCREASE = 4;
+
+private:
+    int level; // index in the quality levels
+    Reason reason;
+    int stableIntervals; // intervals with headroom since the last change
+
+    int getMaxLevel(int usersInRoom) const;
+};
+
+#endif
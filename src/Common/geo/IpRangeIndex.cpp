@@ -0,0 +1,331 @@
+#include "IpRangeIndex.h"
+
+#include "log/Logging.h"
+#include "persistence/CacheHeader.h"
+
+#include <QDataStream>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QtEndian>
+#include <algorithm>
+
+using namespace Geo;
+
+const quint32 IpRangeIndex::INDEX_REVISION = 1;
+
+namespace {
+
+struct IpRange
+{
+    quint32 first;
+    quint32 last;
+    quint16 countryCode;
+
+    bool operator<(const IpRange &other) const
+    {
+        return first < other.first;
+    }
+};
+
+quint16 packCountryCode(const QString &code)
+{
+    if (code.size() != 2 || !code.at(0).isLetter() || !code.at(1).isLetter())
+        return IpRangeIndex::UNKNOWN_COUNTRY; // IP2Location is using '-' for unknown/reserved ranges
+
+    QString upperCode = code.toUpper();
+    return (quint16)((upperCode.at(0).toLatin1() << 8) | upperCode.at(1).toLatin1());
+}
+
+QStringList splitCsvLine(const QString &line)
+{
+    QStringList fields;
+    QString field;
+    bool quoted = false;
+    for (int i = 0; i < line.size(); ++i) {
+        QChar c = line.at(i);
+        if (c == '"') {
+            if (quoted && i + 1 < line.size() && line.at(i + 1) == '"')
+                field += line.at(++i); // escaped quote
+            else
+                quoted = !quoted;
+        } else if (c == ',' && !quoted) {
+            fields.append(field);
+            field.clear();
+        } else {
+            field += c;
+        }
+    }
+    fields.append(field);
+    return fields;
+}
+
+bool parseCsvIp(const QString &field, quint32 *out)
+{
+    if (field.contains('.'))
+        return IpRangeIndex::parseIp(field, out);
+
+    bool ok;
+    *out = field.toUInt(&ok); // IP2Location csv files are using IP numbers
+    return ok;
+}
+
+}
+
+IpRangeIndex::IpRangeIndex() :
+    mappedData(nullptr),
+    ranges(nullptr),
+    rangesCount(0)
+{
+}
+
+IpRangeIndex::~IpRangeIndex()
+{
+    close();
+}
+
+void IpRangeIndex::close()
+{
+    if (mappedData)
+        file.unmap(mappedData);
+    file.close();
+    mappedData = nullptr;
+    ranges = nullptr;
+    rangesCount = 0;
+    countryNames.clear();
+}
+
+bool IpRangeIndex::open(const QString &indexFilePath)
+{
+    close();
+
+    file.setFileName(indexFilePath);
+    if (!file.open(QFile::ReadOnly))
+        return false;
+
+    const qint64 fixedSize = CacheHeader::SIZE + sizeof(quint32);
+    qint64 fileSize = file.size();
+    uchar *data = fileSize > fixedSize ? file.map(0, fileSize) : nullptr;
+    if (!data) {
+        qCWarning(jtIpToLocation) << "Can't map the IP index file" << indexFilePath;
+        file.close();
+        return false;
+    }
+
+    QByteArray headerData = QByteArray::fromRawData(reinterpret_cast<const char *>(data), CacheHeader::SIZE);
+    QDataStream headerStream(headerData);
+    CacheHeader cacheHeader;
+    headerStream >> cacheHeader;
+
+    quint32 count = qFromLittleEndian<quint32>(data + CacheHeader::SIZE);
+    qint64 namesOffset = fixedSize + (qint64)count * RANGE_SIZE;
+    if (!cacheHeader.isValid(INDEX_REVISION) || namesOffset > fileSize) {
+        qCWarning(jtIpToLocation) << "Invalid IP index file" << indexFilePath;
+        file.unmap(data);
+        file.close();
+        return false;
+    }
+
+    mappedData = data;
+    ranges = data + fixedSize;
+    rangesCount = (int)count;
+
+    QByteArray namesData = QByteArray::fromRawData(reinterpret_cast<const char *>(data + namesOffset), fileSize - namesOffset);
+    QDataStream namesStream(namesData);
+    namesStream >> countryNames;
+
+    qCDebug(jtIpToLocation) << rangesCount << "IP ranges and" << countryNames.size() << "countries in" << indexFilePath;
+    return true;
+}
+
+quint32 IpRangeIndex::getRangeStart(int index) const
+{
+    return qFromLittleEndian<quint32>(ranges + index * RANGE_SIZE);
+}
+
+quint16 IpRangeIndex::getRangeCountry(int index) const
+{
+    const uchar *range = ranges + index * RANGE_SIZE;
+    return (quint16)((range[4] << 8) | range[5]);
+}
+
+quint16 IpRangeIndex::lookup(quint32 ip) const
+{
+    // find the last range starting before (or in) the ip
+    int low = 0;
+    int high = rangesCount; // exclusive
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (getRangeStart(middle) <= ip)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    if (low == 0)
+        return UNKNOWN_COUNTRY;
+
+    return getRangeCountry(low - 1);
+}
+
+void IpRangeIndex::lookup(const QVector<quint32> &ips, QVector<quint16> &countryCodes) const
+{
+    countryCodes.fill((quint16)UNKNOWN_COUNTRY, ips.size());
+    if (!isOpen())
+        return;
+
+    QVector<int> order(ips.size());
+    for (int i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&ips](int a, int b) {
+        return ips[a] < ips[b];
+    });
+
+    // each search starts in the range found for the previous (smaller) ip
+    int firstRange = 0;
+    foreach (int ipIndex, order) {
+        quint32 ip = ips[ipIndex];
+        int low = firstRange;
+        int high = rangesCount;
+        while (low < high) {
+            int middle = low + (high - low) / 2;
+            if (getRangeStart(middle) <= ip)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        if (low > 0) {
+            countryCodes[ipIndex] = getRangeCountry(low - 1);
+            firstRange = low - 1;
+        }
+    }
+}
+
+QString IpRangeIndex::getCountryName(quint16 countryCode) const
+{
+    return countryNames.value(countryCode);
+}
+
+QString IpRangeIndex::toCountryCode(quint16 packedCountryCode)
+{
+    if (packedCountryCode == UNKNOWN_COUNTRY)
+        return QString();
+
+    char code[] = {(char)(packedCountryCode >> 8), (char)(packedCountryCode & 0xFF)};
+    return QString::fromLatin1(code, 2);
+}
+
+bool IpRangeIndex::parseIp(const QString &ip, quint32 *out)
+{
+    quint32 result = 0;
+    int parts = 0;
+    int value = -1;
+    for (int i = 0; i <= ip.size(); ++i) {
+        QChar c = i < ip.size() ? ip.at(i) : QChar('.');
+        if (c == '.') {
+            if (value < 0 || value > 255 || parts == 4)
+                return false;
+            result = (result << 8) | (quint32)value;
+            parts++;
+            value = -1;
+        } else if (c.isDigit()) {
+            value = (value < 0 ? 0 : value * 10) + c.digitValue();
+            if (value > 255)
+                return false;
+        } else if ((c == 'x' || c == 'X') && parts == 3 && value < 0) {
+            value = 0; // masked ninjam ip, all the 'x' IPs are in the same /24 range
+        } else {
+            return false;
+        }
+    }
+
+    if (parts != 4)
+        return false;
+
+    *out = result;
+    return true;
+}
+
+bool IpRangeIndex::build(const QString &csvFilePath, const QString &indexFilePath)
+{
+    QFile csvFile(csvFilePath);
+    if (!csvFile.open(QFile::ReadOnly | QFile::Text)) {
+        qCWarning(jtIpToLocation) << "Can't open the IP ranges file" << csvFilePath;
+        return false;
+    }
+
+    QVector<IpRange> csvRanges;
+    QMap<quint16, QString> countryNames;
+    QTextStream stream(&csvFile);
+    stream.setCodec("UTF-8");
+    while (!stream.atEnd()) {
+        QStringList fields = splitCsvLine(stream.readLine());
+        if (fields.size() < 3)
+            continue;
+
+        IpRange range;
+        if (!parseCsvIp(fields.at(0), &range.first) || !parseCsvIp(fields.at(1), &range.last) || range.last < range.first)
+            continue; // csv header or invalid line
+
+        range.countryCode = packCountryCode(fields.at(2));
+        csvRanges.append(range);
+        if (range.countryCode != UNKNOWN_COUNTRY && fields.size() > 3)
+            countryNames.insert(range.countryCode, fields.at(3));
+    }
+
+    // contiguous ranges, the gaps are unknown ranges and the adjacent ranges in same country are merged
+    std::sort(csvRanges.begin(), csvRanges.end());
+    QVector<IpRange> indexRanges;
+    quint64 nextIp = 0;
+    foreach (const IpRange &range, csvRanges) {
+        if (range.last < nextIp)
+            continue; // overlapped range
+
+        quint32 first = qMax((quint64)range.first, nextIp);
+        if (first > nextIp && (indexRanges.isEmpty() || indexRanges.last().countryCode != UNKNOWN_COUNTRY)) {
+            IpRange gap = {(quint32)nextIp, first - 1, UNKNOWN_COUNTRY};
+            indexRanges.append(gap);
+        }
+
+        if (indexRanges.isEmpty() || indexRanges.last().countryCode != range.countryCode) {
+            IpRange indexRange = {first, range.last, range.countryCode};
+            indexRanges.append(indexRange);
+        } else {
+            indexRanges.last().last = range.last;
+        }
+        nextIp = (quint64)range.last + 1;
+    }
+    if (nextIp <= 0xFFFFFFFF && !indexRanges.isEmpty() && indexRanges.last().countryCode != UNKNOWN_COUNTRY) {
+        IpRange end = {(quint32)nextIp, 0xFFFFFFFF, UNKNOWN_COUNTRY}; // the last range is not extended to the end of IP space
+        indexRanges.append(end);
+    }
+
+    QByteArray data;
+    {
+        QDataStream headerStream(&data, QIODevice::WriteOnly);
+        headerStream << CacheHeader(INDEX_REVISION);
+    }
+    int rangesOffset = data.size() + sizeof(quint32);
+    data.resize(rangesOffset + indexRanges.size() * RANGE_SIZE);
+    uchar *out = reinterpret_cast<uchar *>(data.data());
+    qToLittleEndian<quint32>((quint32)indexRanges.size(), out + CacheHeader::SIZE);
+    for (int i = 0; i < indexRanges.size(); ++i) {
+        uchar *range = out + rangesOffset + i * RANGE_SIZE;
+        qToLittleEndian<quint32>(indexRanges.at(i).first, range);
+        range[4] = (uchar)(indexRanges.at(i).countryCode >> 8);
+        range[5] = (uchar)(indexRanges.at(i).countryCode & 0xFF);
+        range[6] = range[7] = 0;
+    }
+    {
+        QDataStream namesStream(&data, QIODevice::Append);
+        namesStream << countryNames;
+    }
+
+    QSaveFile indexFile(indexFilePath);
+    if (!indexFile.open(QFile::WriteOnly) || indexFile.write(data) != data.size() || !indexFile.commit()) {
+        qCCritical(jtIpToLocation) << "Can't write the IP index file" << indexFilePath;
+        return false;
+    }
+
+    qCDebug(jtIpToLocation) << "IP index created with" << indexRanges.size() << "ranges (" << csvRanges.size() << "csv ranges)";
+    return true;
+}
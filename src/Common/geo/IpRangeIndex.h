@@ -0,0 +1,73 @@
+#ifndef IPRANGEINDEX_H
+#define IPRANGEINDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMap>
+#include <QFile>
+
+namespace Geo {
+
+/**
+ * Offline IPv4 -> country index. The index file is built from a IP2Location LITE DB1 csv
+ * (http://lite.ip2location.com) and contains the sorted and contiguous IP ranges, so a lookup
+ * is a binary search in the memory mapped file.
+ *
+ * Index file layout: CacheHeader, ranges count (quint32), ranges (8 bytes each: first IP in
+ * little endian, 2 chars country code, 2 reserved bytes), english country names (QDataStream).
+ */
+
+class IpRangeIndex
+{
+public:
+    IpRangeIndex();
+    ~IpRangeIndex();
+
+    bool open(const QString &indexFilePath);
+    void close();
+
+    inline bool isOpen() const
+    {
+        return ranges != nullptr;
+    }
+
+    inline int getRangesCount() const
+    {
+        return rangesCount;
+    }
+
+    // return the 2 letters country code packed in a quint16 (see toCountryCode()), or UNKNOWN_COUNTRY
+    quint16 lookup(quint32 ip) const;
+
+    // lookup a list of IPs, sorting the IPs first to walk the ranges only one time
+    void lookup(const QVector<quint32> &ips, QVector<quint16> &countryCodes) const;
+
+    QString getCountryName(quint16 countryCode) const; // english name
+
+    static bool build(const QString &csvFilePath, const QString &indexFilePath);
+
+    static bool parseIp(const QString &ip, quint32 *out); // the ninjam masked IPs (last number is 'x') are accepted
+    static QString toCountryCode(quint16 packedCountryCode);
+
+    static const quint16 UNKNOWN_COUNTRY = 0;
+    static const quint32 INDEX_REVISION;
+
+private:
+    QFile file;
+    uchar *mappedData;
+    const uchar *ranges; // points to the mapped data
+    int rangesCount;
+    QMap<quint16, QString> countryNames;
+
+    inline quint32 getRangeStart(int index) const;
+    inline quint16 getRangeCountry(int index) const;
+
+    static const int RANGE_SIZE = 8;
+
+    Q_DISABLE_COPY(IpRangeIndex)
+};
+
+} // namespace
+
+#endif // IPRANGEINDEX_H
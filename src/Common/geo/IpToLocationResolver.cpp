@@ -42,6 +42,14 @@ IpToLocationResolver::~IpToLocationResolver()
     qCDebug(jtIpToLocation) << "IpToLocationResolver destructor";
 }
 
+QList<Location> IpToLocationResolver::resolveAll(const QStringList &ips, const QString &languageCode)
+{
+    QList<Location> locations;
+    foreach (const QString &ip, ips)
+        locations.append(resolve(ip, languageCode));
+    return locations;
+}
+
 // +++++++++++++++++++++++++++++++++++++++++++++++++++
 Location NullIpToLocationResolver::resolve(const QString &ip, const QString &languageCode)
 {
@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QObject>
+#include <QStringList>
 
 namespace Geo {
 class Location
@@ -54,6 +55,7 @@ class IpToLocationResolver : public QObject
 
 public:
     virtual Location resolve(const QString &ip, const QString &languageCode) = 0;
+    virtual QList<Location> resolveAll(const QStringList &ips, const QString &languageCode); // resolve a users list
     virtual ~IpToLocationResolver();
 
 signals:
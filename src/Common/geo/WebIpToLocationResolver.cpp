@@ -12,6 +12,8 @@
 #include <QTextStream>
 #include <QDataStream>
 #include <QTimer>
+#include <QCoreApplication>
+#include <QtConcurrent/QtConcurrent>
 #include "log/Logging.h"
 #include "persistence/CacheHeader.h"
 
@@ -19,6 +21,8 @@ using namespace Geo;
 
 const QString WebIpToLocationResolver::COUNTRY_CODES_FILE = "country_codes_cache.bin";
 const QString WebIpToLocationResolver::COUNTRY_NAMES_FILE_PREFIX = "country_names_cache"; //the language code will be concatenated
+const QString WebIpToLocationResolver::IP_RANGE_INDEX_FILE = "ip_ranges_index.bin";
+const QString WebIpToLocationResolver::IP_RANGES_CSV_FILE = "IP2LOCATION-LITE-DB1.CSV";
 
 const quint32 WebIpToLocationResolver::COUNTRY_NAMES_CACHE_REVISION = 1;
 const quint32 WebIpToLocationResolver::COUNTRY_CODES_CACHE_REVISION = 1;
@@ -28,6 +32,7 @@ WebIpToLocationResolver::WebIpToLocationResolver(const QDir &cacheDir)
      cacheDir(cacheDir)
 {
     QObject::connect(&httpClient, SIGNAL(finished(QNetworkReply*)), this, SLOT(replyFinished(QNetworkReply*)));
+    QObject::connect(&ipRangeIndexBuilder, SIGNAL(finished()), this, SLOT(finishIpRangeIndexBuild()));
 
     loadCountryCodesFromFile();
 
@@ -38,10 +43,13 @@ WebIpToLocationResolver::WebIpToLocationResolver(const QDir &cacheDir)
         loadOldCacheContent();
         deleteOldCacheFile();
     }
+
+    openIpRangeIndex();
 }
 
 WebIpToLocationResolver::~WebIpToLocationResolver()
 {
+    ipRangeIndexBuilder.waitForFinished();
     saveCountryCodesToFile();
     saveCountryNamesToFile();
 }
@@ -84,9 +92,15 @@ bool WebIpToLocationResolver::saveMapToFile(const QString &fileName, const QMap<
 void WebIpToLocationResolver::replyFinished(QNetworkReply *reply){
     QString ip = reply->property("ip").toString();
     QString language = reply->property("language").toString();
+    QString translatedCountryCode = reply->property("translatedCountryCode").toString();
+
+    pendingRequests.remove(ip);
+    pendingTranslations.remove(translatedCountryCode);
 
-    if (language != currentLanguage)
+    if (language != currentLanguage) {
+        reply->deleteLater();
         return; //discard the received data if the language was changed since the last request.
+    }
 
     if(reply->error() == QNetworkReply::NoError ){
         QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
@@ -122,7 +136,11 @@ void WebIpToLocationResolver::replyFinished(QNetworkReply *reply){
 }
 
 // At moment the current api is geoip.nekudo.com. Another option is https://freegeoip.net/json/
-void WebIpToLocationResolver::requestDataFromWebService(const QString &ip){
+QNetworkReply *WebIpToLocationResolver::requestDataFromWebService(const QString &ip){
+    if (pendingRequests.contains(ip))
+        return nullptr; // avoid many requests for the same IP when a room is refreshed
+
+    pendingRequests.insert(ip);
     qCDebug(jtIpToLocation) << "requesting ip " << ip ;
 
     QNetworkRequest request;
@@ -135,6 +153,7 @@ void WebIpToLocationResolver::requestDataFromWebService(const QString &ip){
     reply->setProperty("ip", QVariant(ip));
     reply->setProperty("language", QVariant(currentLanguage));
     QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), this, SLOT(replyError(QNetworkReply::NetworkError)));
+    return reply;
 }
 
 void WebIpToLocationResolver::replyError(QNetworkReply::NetworkError e){
@@ -152,14 +171,68 @@ QString WebIpToLocationResolver::sanitizeLanguageCode(const QString &languageCod
     return languageCode;
 }
 
-Geo::Location WebIpToLocationResolver::resolve(const QString &ip, const QString &languageCode){
-
-    //check for language changes
+void WebIpToLocationResolver::checkLanguageChange(const QString &languageCode)
+{
     QString code = sanitizeLanguageCode(languageCode);
     if (code != currentLanguage) {
         saveCountryNamesToFile(); //save cached country names before change the language
         currentLanguage = code;
         loadCountryNamesFromFile(currentLanguage); //update the country names QMap
+        pendingTranslations.clear();
+    }
+}
+
+Geo::Location WebIpToLocationResolver::buildLocation(const QString &ip, quint16 packedCountryCode)
+{
+    QString countryCode = IpRangeIndex::toCountryCode(packedCountryCode);
+    QString countryName = countryNamesCache.value(countryCode);
+    if (countryName.isEmpty()) {
+        countryName = ipRangeIndex.getCountryName(packedCountryCode); // english name, used until the translated name is received
+        if (currentLanguage != "en" && !pendingTranslations.contains(countryCode) && !pendingRequests.contains(ip)) {
+            pendingTranslations.insert(countryCode); // one request per country, not per user
+            QNetworkReply *reply = requestDataFromWebService(ip);
+            if (reply)
+                reply->setProperty("translatedCountryCode", countryCode);
+        }
+    }
+
+    return Location(countryName, countryCode);
+}
+
+QList<Geo::Location> WebIpToLocationResolver::resolveAll(const QStringList &ips, const QString &languageCode)
+{
+    if (!ipRangeIndex.isOpen())
+        return IpToLocationResolver::resolveAll(ips, languageCode);
+
+    checkLanguageChange(languageCode);
+
+    QVector<quint32> ipNumbers(ips.size());
+    QVector<bool> validIps(ips.size());
+    for (int i = 0; i < ips.size(); ++i)
+        validIps[i] = IpRangeIndex::parseIp(ips.at(i), &ipNumbers[i]);
+
+    QVector<quint16> countryCodes;
+    ipRangeIndex.lookup(ipNumbers, countryCodes);
+
+    QList<Location> locations;
+    for (int i = 0; i < ips.size(); ++i) {
+        if (validIps[i] && countryCodes[i] != IpRangeIndex::UNKNOWN_COUNTRY)
+            locations.append(buildLocation(ips.at(i), countryCodes[i]));
+        else
+            locations.append(resolve(ips.at(i), languageCode));
+    }
+    return locations;
+}
+
+Geo::Location WebIpToLocationResolver::resolve(const QString &ip, const QString &languageCode){
+
+    checkLanguageChange(languageCode);
+
+    quint32 ipNumber;
+    if (ipRangeIndex.isOpen() && IpRangeIndex::parseIp(ip, &ipNumber)) {
+        quint16 countryCode = ipRangeIndex.lookup(ipNumber);
+        if (countryCode != IpRangeIndex::UNKNOWN_COUNTRY)
+            return buildLocation(ip, countryCode);
     }
 
     if (countryCodesCache.contains(ip)) {
@@ -253,6 +326,47 @@ void WebIpToLocationResolver::deleteOldCacheFile()
     cacheFile.remove();
 }
 
+void WebIpToLocationResolver::openIpRangeIndex()
+{
+    QString indexFilePath = cacheDir.absoluteFilePath(IP_RANGE_INDEX_FILE);
+    QString csvFilePath = findIpRangesCsvFile();
+
+    // the index is (re)created when a new csv file is available
+    bool indexIsOutdated = !csvFilePath.isEmpty()
+            && QFileInfo(csvFilePath).lastModified() > QFileInfo(indexFilePath).lastModified();
+
+    if (!indexIsOutdated) {
+        if (ipRangeIndex.open(indexFilePath))
+            return;
+
+        if (csvFilePath.isEmpty()) { // the csv is not shipped with Jamtaba, the users must download it from IP2Location
+            qCInfo(jtIpToLocation) << IP_RANGES_CSV_FILE << "not found in" << cacheDir.absolutePath()
+                                   << "or in the application dir, using the web service to resolve the locations";
+            return;
+        }
+    }
+
+    qCDebug(jtIpToLocation) << "Creating the IP ranges index from" << csvFilePath;
+    ipRangeIndexBuilder.setFuture(QtConcurrent::run(&IpRangeIndex::build, csvFilePath, indexFilePath));
+}
+
+void WebIpToLocationResolver::finishIpRangeIndexBuild()
+{
+    if (ipRangeIndexBuilder.result())
+        ipRangeIndex.open(cacheDir.absoluteFilePath(IP_RANGE_INDEX_FILE));
+}
+
+QString WebIpToLocationResolver::findIpRangesCsvFile() const
+{
+    QList<QDir> dirs;
+    dirs << cacheDir << QDir(QCoreApplication::applicationDirPath());
+    foreach (const QDir &dir, dirs) {
+        if (dir.exists(IP_RANGES_CSV_FILE))
+            return dir.absoluteFilePath(IP_RANGES_CSV_FILE);
+    }
+    return QString();
+}
+
 bool WebIpToLocationResolver::needLoadTheOldCache()
 {
     QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::DataLocation));
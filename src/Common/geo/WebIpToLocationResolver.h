@@ -2,7 +2,10 @@
 #define FREEGEOIPTOLOCATIONRESOLVER_H
 
 #include "IpToLocationResolver.h"
+#include "IpRangeIndex.h"
 #include <QMap>
+#include <QSet>
+#include <QFutureWatcher>
 #include <QLoggingCategory>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
@@ -18,12 +21,24 @@ public:
     WebIpToLocationResolver(const QDir &cacheDir);
     ~WebIpToLocationResolver();
     Geo::Location resolve(const QString &ip, const QString &languageCode) override;
+    QList<Geo::Location> resolveAll(const QStringList &ips, const QString &languageCode) override;
 private:
     QMap<QString, QString> countryCodesCache; // IP -> country code (2 upper case letters)
     QMap<QString, QString> countryNamesCache;// country code => translated country name
     QNetworkAccessManager httpClient;
 
-    void requestDataFromWebService(const QString &ip);
+    // the country codes are resolved offline when the IP index is available, the web service is used only to translate the country names
+    IpRangeIndex ipRangeIndex;
+    QFutureWatcher<bool> ipRangeIndexBuilder;
+    void openIpRangeIndex();
+    QString findIpRangesCsvFile() const;
+    Geo::Location buildLocation(const QString &ip, quint16 packedCountryCode);
+
+    QSet<QString> pendingRequests; // IPs, only one request per IP
+    QSet<QString> pendingTranslations; // country codes waiting for a translated name
+
+    QNetworkReply *requestDataFromWebService(const QString &ip); // return nullptr if the IP is already requested
+    void checkLanguageChange(const QString &languageCode);
 
     //loading
     void loadCountryCodesFromFile();
@@ -48,12 +63,15 @@ private:
 
     static const QString COUNTRY_CODES_FILE;
     static const QString COUNTRY_NAMES_FILE_PREFIX;
+    static const QString IP_RANGE_INDEX_FILE;
+    static const QString IP_RANGES_CSV_FILE;
 
     static const quint32 COUNTRY_CODES_CACHE_REVISION;
     static const quint32 COUNTRY_NAMES_CACHE_REVISION;
 
 private slots:
     void replyFinished(QNetworkReply *);
+    void finishIpRangeIndexBuild();
     void replyError(QNetworkReply::NetworkError);
 };
 }
@@ -11,6 +11,8 @@
 #include <QGridLayout>
 #include <QPushButton>
 #include <QButtonGroup>
+#include <QSlider>
+#include <QSignalBlocker>
 #include <QEvent>
 
 const QColor BaseTrackView::DB_TEXT_COLOR = QColor(0, 0, 0, 120);
@@ -26,7 +28,8 @@ BaseTrackView::BaseTrackView(Controller::MainController *mainController, long tr
     trackID(trackID),
     activated(true),
     narrowed(false),
-    drawDbValue(true)
+    drawDbValue(true),
+    lastDspLoad(-1)
 {
     createLayoutStructure();
     setupVerticalLayout();
@@ -152,6 +155,13 @@ void BaseTrackView::createLayoutStructure()
     meterWidgetsLayout->addLayout(metersLayout, 1);
     meterWidgetsLayout->addWidget(peaksDbLabel);
 
+    dspLoadLabel = new QLabel();
+    dspLoadLabel->setObjectName(QStringLiteral("dspLoadLabel"));
+    dspLoadLabel->setSizePolicy(QSizePolicy(QSizePolicy::Minimum, QSizePolicy::Maximum));
+    dspLoadLabel->setAlignment(Qt::AlignCenter);
+    dspLoadLabel->setToolTip(tr("DSP load: how much of the audio processing time is used by this track and the track plugins"));
+    meterWidgetsLayout->addWidget(dspLoadLabel);
+
     muteButton = new QPushButton();
     muteButton->setObjectName(QStringLiteral("muteButton"));
     muteButton->setEnabled(true);
@@ -303,8 +313,16 @@ void BaseTrackView::updateGuiElements()
 
     // update the track processors. In this moment the VST plugins GUI are updated. Some plugins need this to run your animations (see Ez Drummer, for example);
     Audio::AudioNode *trackNode = mainController->getTrackNode(getTrackID());
-    if (trackNode)
+    if (trackNode) {
         trackNode->updateProcessorsGui();  // call idle in VST plugins
+
+        // how much of the audio callback time is used by this track (and the track plugins)
+        int dspLoad = qRound(trackNode->getDspLoad() * 100);
+        if (dspLoad != lastDspLoad) {
+            dspLoadLabel->setText(QString::number(dspLoad) + "%");
+            lastDspLoad = dspLoad;
+        }
+    }
 }
 
 QSize BaseTrackView::sizeHint() const
@@ -388,6 +406,34 @@ BaseTrackView *BaseTrackView::getTrackViewByID(long trackID)
     return nullptr;
 }
 
+void BaseTrackView::bindToTrack(long newTrackID)
+{
+    unbindTrack();
+    trackID = newTrackID;
+    trackViews.insert(trackID, this);
+
+    // the controls are reset to the default values without signals, the new track node is not changed
+    QSignalBlocker levelSliderBlocker(levelSlider);
+    QSignalBlocker panSliderBlocker(panSlider);
+    levelSlider->setValue(100);
+    panSlider->setValue(0);
+    muteButton->setChecked(false);
+    soloButton->setChecked(false);
+    buttonBoostZero->setChecked(true);
+
+    maxPeak.zero();
+    peaksDbLabel->setText("");
+    setPeaks(0, 0, 0, 0);
+    dspLoadLabel->setText("");
+    lastDspLoad = -1;
+}
+
+void BaseTrackView::unbindTrack()
+{
+    if (trackViews.value(trackID) == this)
+        trackViews.remove(trackID);
+}
+
 void BaseTrackView::setPeaks(float peakLeft, float peakRight, float rmsLeft, float rmsRight)
 {
     peakMeterLeft->setPeak(peakLeft, rmsLeft);
@@ -423,7 +469,7 @@ bool BaseTrackView::eventFilter(QObject *source, QEvent *ev)
 BaseTrackView::~BaseTrackView()
 {
     // qDeleteAll(children());// delete ui;
-    trackViews.remove(this->getTrackID());// remove from static map
+    unbindTrack();// remove from static map
 }
 
 void BaseTrackView::setPan(int value)
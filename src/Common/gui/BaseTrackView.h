@@ -47,6 +47,10 @@ public:
 
     static BaseTrackView *getTrackViewByID(long trackID);
 
+    // used to reuse a view with another track instead of creating a new view
+    virtual void bindToTrack(long trackID);
+    void unbindTrack(); // the view is not returned by getTrackViewByID() until the next bindToTrack()
+
     virtual void setToNarrow();
     virtual void setToWide();
 
@@ -98,6 +102,7 @@ protected:
     AudioMeter *peakMeterRight;
     QBoxLayout *metersLayout;// used to group the two meter bars
     QLabel *peaksDbLabel;
+    QLabel *dspLoadLabel; // how much of the audio callback time is used by the track
     QBoxLayout *meterWidgetsLayout;// used to group meters bars and the max peaks Db label
 
     //level slider
@@ -132,6 +137,7 @@ protected:
 private:
     static QMap<long, BaseTrackView *> trackViews;
     Audio::AudioPeak maxPeak;
+    int lastDspLoad; // in percentage, showed in the dsp load label
 
     void drawFaderDbValue(QPainter &p);
 
@@ -81,15 +81,22 @@ void JamRoomViewPanel::refresh(const Login::RoomInfo &roomInfo)
 
     QList<Login::UserInfo> userInfos = roomInfo.getUsers();
     qSort(userInfos.begin(), userInfos.end(), userInfoLessThan);
+    QList<Login::UserInfo> players;
+    QStringList playersIps;
     foreach (const Login::UserInfo &user, userInfos) {
         if (!userIsBot(user)) {
-            Geo::Location userLocation = mainController->getGeoLocation(user.getIp());
-            QLabel *label = new PlayerLabel(ui->usersPanel, user, userLocation);
-            ui->usersPanel->layout()->addWidget(label);
-            ui->usersPanel->layout()->setAlignment(Qt::AlignTop);
+            players.append(user);
+            playersIps.append(user.getIp());
         }
     }
 
+    QList<Geo::Location> playersLocations = mainController->getGeoLocations(playersIps); // all users resolved in one call
+    for (int i = 0; i < players.size(); ++i) {
+        QLabel *label = new PlayerLabel(ui->usersPanel, players.at(i), playersLocations.at(i));
+        ui->usersPanel->layout()->addWidget(label);
+        ui->usersPanel->layout()->setAlignment(Qt::AlignTop);
+    }
+
     updateButtonListen();
 
     ui->buttonEnter->setEnabled(!roomInfo.isFull());
@@ -10,7 +10,9 @@ LocalTrackGroupView::LocalTrackGroupView(int channelIndex, MainWindow *mainFrame
     index(channelIndex),
     mainFrame(mainFrame),
     peakMeterOnly(false),
-    preparingToTransmit(false)
+    preparingToTransmit(false),
+    encodingQuality(VorbisQualityController::DEFAULT),
+    encodingQualityReason(VorbisQualityController::DEFAULT_QUALITY)
 {
     toolButton = createToolButton();
     topPanel->layout()->addWidget(toolButton);
@@ -49,8 +51,7 @@ void LocalTrackGroupView::translateUi()
 {
     updateXmitButtonText();
 
-    xmitButton->setToolTip(tr("Enable/disable your audio transmission for others"));
-    xmitButton->setAccessibleDescription(toolButton->toolTip());
+    updateXmitButtonToolTip();
 
     toolButton->setToolTip(tr("Add or remove channels..."));
     toolButton->setAccessibleDescription(toolButton->toolTip());
@@ -58,6 +59,41 @@ void LocalTrackGroupView::translateUi()
     groupNameField->setPlaceholderText(tr("channel name"));
 }
 
+void LocalTrackGroupView::setEncodingQuality(float quality, VorbisQualityController::Reason reason)
+{
+    encodingQuality = quality;
+    encodingQualityReason = reason;
+    updateXmitButtonToolTip();
+}
+
+void LocalTrackGroupView::updateXmitButtonToolTip()
+{
+    QString reason;
+    switch (encodingQualityReason) {
+    case VorbisQualityController::DEFAULT_QUALITY:
+        reason = tr("default quality");
+        break;
+    case VorbisQualityController::UPLOAD_BACKLOG:
+        reason = tr("reduced, your upload is slow");
+        break;
+    case VorbisQualityController::ENCODER_CPU:
+        reason = tr("reduced, the encoder is using too much CPU");
+        break;
+    case VorbisQualityController::CROWDED_ROOM:
+        reason = tr("limited, the room is crowded");
+        break;
+    case VorbisQualityController::HEADROOM:
+        reason = tr("increased, your upload and CPU are fine");
+        break;
+    }
+
+    QString toolTip = tr("Enable/disable your audio transmission for others");
+    toolTip += "\n\n" + tr("Encoding quality: %1 (%2)").arg(encodingQuality, 0, 'f', 2).arg(reason);
+    toolTip += "\n" + tr("The quality is adapted in each interval to your upload speed, CPU usage and the room size.");
+    xmitButton->setToolTip(toolTip);
+    xmitButton->setAccessibleDescription(toolTip);
+}
+
 void LocalTrackGroupView::updateXmitButtonText()
 {
     if (peakMeterOnly) {
@@ -3,6 +3,7 @@
 
 #include "TrackGroupView.h"
 #include "LocalTrackView.h"
+#include "audio/vorbis/VorbisQualityController.h"
 
 class MainWindow;
 class QPushButton;
@@ -44,6 +45,8 @@ public:
 
     void resetTracks();
 
+    void setEncodingQuality(float quality, VorbisQualityController::Reason reason); // showed in the xmit button tooltip
+
     void useSmallSpacingInLayouts(bool useSmallSpacing);
     bool isUsingSmallSpacingInLayouts() const;
 
@@ -66,6 +69,9 @@ private:
     QPushButton *xmitButton;
     bool preparingToTransmit;
 
+    float encodingQuality;
+    VorbisQualityController::Reason encodingQualityReason;
+
     int index;
 
     bool peakMeterOnly;
@@ -78,6 +84,7 @@ private:
     void createChannelsActions(QMenu &menu);
 
     void updateXmitButtonText();
+    void updateXmitButtonToolTip();
 
 signals:
     void nameChanged();
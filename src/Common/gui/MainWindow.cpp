@@ -18,7 +18,9 @@
 #include <QRect>
 #include "MainController.h"
 #include "ThemeLoader.h"
-// #include "performance/PerformanceMonitor.h"
+#include <QtConcurrent/QtConcurrent>
+#include <QDateTime>
+#include <QScrollBar>
 
 using namespace Audio;
 using namespace Persistence;
@@ -30,7 +32,8 @@ const QSize MainWindow::MINI_MODE_MIN_SIZE = QSize(800, 600);
 const QSize MainWindow::FULL_VIEW_MODE_MIN_SIZE = QSize(1180, 790);
 const int MainWindow::MINI_MODE_MAX_LOCAL_TRACKS_WIDTH = 185;
 
-// const int MainWindow::PERFORMANCE_MONITOR_REFRESH_TIME = 200;//in miliseconds
+const int MainWindow::PERFORMANCE_MONITOR_REFRESH_TIME = 1000;//in miliseconds
+const int MainWindow::ROOM_STREAMS_PREVIEW_DELAY = 500;//in miliseconds
 
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 MainWindow::MainWindow(Controller::MainController *mainController, QWidget *parent) :
@@ -40,8 +43,8 @@ MainWindow::MainWindow(Controller::MainController *mainController, QWidget *pare
     ninjamWindow(nullptr),
     roomToJump(nullptr),
     fullViewMode(true),
-    chordsPanel(nullptr)
-    // lastPerformanceMonitorUpdate(0)
+    chordsPanel(nullptr),
+    lastPerformanceMonitorUpdate(0)
 {
     qCInfo(jtGUI) << "Creating MainWindow...";
 
@@ -96,7 +99,10 @@ void MainWindow::setLanguage(QAction *languageMenuAction)
     QString locale = languageMenuAction->data().toString();
     loadTranslationFile(locale);
     mainController->setTranslationLanguage(locale);
-    updatePublicRoomsListLayout();
+    foreach (JamRoomViewPanel *roomViewPanel, roomViewPanels) {
+        if (roomViewPanel)
+            roomViewPanel->refresh(roomViewPanel->getRoomInfo()); // translate the users country names
+    }
     if (mainController->isPlayingInNinjamRoom()) {
         ninjamWindow->getChatPanel()->setPreferredTranslationLanguage(locale);
         ninjamWindow->updateGeoLocations();
@@ -174,6 +180,13 @@ void MainWindow::initializeLanguageMenu()
     }
 }
 
+void MainWindow::updateResourcesUsage()
+{
+    PerformanceMonitor::ResourcesUsage usage = resourcesUsageWatcher.result();
+    float dspLoad = mainController ? mainController->getDspLoad() : 0;
+    ui.contentTabWidget->setResourcesUsage(usage.cpuUsage, usage.memoryUsage, dspLoad * 100);
+}
+
 // ++++++++++++++++++++++++=
 void MainWindow::initialize()
 {
@@ -275,8 +288,8 @@ void MainWindow::stopCurrentRoomStream()
 {
     if (mainController->isPlayingRoomStream()) {
         long long roomID = mainController->getCurrentStreamingRoomID();
-        if (roomViewPanels[roomID])
-            roomViewPanels[roomID]->clear(true);
+        if (roomViewPanels.value(roomID))
+            roomViewPanels.value(roomID)->clear(true);
         mainController->stopRoomStream();
     }
 }
@@ -465,8 +478,8 @@ void MainWindow::initializeLoginService()
 {
     Login::LoginService *loginService = this->mainController->getLoginService();
 
-    connect(loginService, SIGNAL(roomsListAvailable(QList<Login::RoomInfo>)), this,
-            SLOT(refreshPublicRoomsList(const QList<Login::RoomInfo> &)));
+    connect(loginService, SIGNAL(roomsListChanged(Login::RoomsListChanges)), this,
+            SLOT(updatePublicRoomsList(Login::RoomsListChanges)));
 
     connect(loginService, SIGNAL(incompatibilityWithServerDetected()), this,
             SLOT(handleIncompatiblity()));
@@ -496,6 +509,7 @@ void MainWindow::changeTab(int index)
     } else {// click in the public rooms tab?
         updatePublicRoomsListLayout();
     }
+    schedulePreviewVisibleRoomStreams();
 }
 
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -593,47 +607,91 @@ bool MainWindow::canUseTwoColumnLayout() const
     return true;
 }
 
-void MainWindow::refreshPublicRoomsList(const QList<Login::RoomInfo> &publicRooms)
+void MainWindow::updatePublicRoomsList(const Login::RoomsListChanges &changes)
 {
-    if (publicRooms.isEmpty())
-        return;
-
     hideBusyDialog();
 
-    QList<Login::RoomInfo> sortedRooms(publicRooms);
-    qSort(sortedRooms.begin(), sortedRooms.end(), jamRoomLessThan);
+    // only the panels of added, removed and changed rooms are touched, the other panels are just moved in the grid
+    foreach (const Login::RoomInfo &roomInfo, changes.getRemovedRooms()) {
+        if (!roomViewPanels.value(roomInfo.getID()))
+            continue;
 
-    int index = 0;
-    foreach (const Login::RoomInfo &roomInfo, sortedRooms) {
-        if (roomInfo.getType() == Login::RoomTYPE::NINJAM) {// skipping other rooms at moment
-            bool twoCollumns = canUseTwoColumnLayout();
-            int rowIndex = twoCollumns ? (index / 2) : (index);
-            int collumnIndex = twoCollumns ? (index % 2) : 0;
-            JamRoomViewPanel *roomViewPanel = roomViewPanels[roomInfo.getID()];
-            if (roomViewPanel) {
-                roomViewPanel->refresh(roomInfo);
-                // check if is playing a public room stream but this room is empty now
-                if (mainController->isPlayingRoomStream()) {
-                    if (roomInfo.isEmpty()
-                        && mainController->getCurrentStreamingRoomID() == roomInfo.getID())
-                        stopCurrentRoomStream();
-                }
-                ui.allRoomsContent->layout()->removeWidget(roomViewPanel); // the widget is removed but added again
-            } else {
-                roomViewPanel = createJamRoomViewPanel(roomInfo);
-                roomViewPanels.insert(roomInfo.getID(), roomViewPanel);
-            }
-            QGridLayout *layout = dynamic_cast<QGridLayout *>(ui.allRoomsContent->layout());
-            layout->addWidget(roomViewPanel, rowIndex, collumnIndex);
-            index++;
+        if (mainController->isPlayingRoomStream() && mainController->getCurrentStreamingRoomID() == roomInfo.getID())
+            stopCurrentRoomStream();
+
+        JamRoomViewPanel *roomViewPanel = roomViewPanels.take(roomInfo.getID());
+        ui.allRoomsContent->layout()->removeWidget(roomViewPanel);
+        roomViewPanel->deleteLater();
+    }
+
+    foreach (const Login::RoomInfo &roomInfo, changes.getAddedRooms()) {
+        if (roomInfo.getType() == Login::RoomTYPE::NINJAM) // skipping other rooms at moment
+            roomViewPanels.insert(roomInfo.getID(), createJamRoomViewPanel(roomInfo));
+    }
+
+    foreach (const Login::RoomInfo &roomInfo, changes.getChangedRooms()) {
+        JamRoomViewPanel *roomViewPanel = roomViewPanels.value(roomInfo.getID());
+        if (!roomViewPanel)
+            continue;
+
+        roomViewPanel->refresh(roomInfo);
+        // check if is playing a public room stream but this room is empty now
+        if (mainController->isPlayingRoomStream()) {
+            if (roomInfo.isEmpty() && mainController->getCurrentStreamingRoomID() == roomInfo.getID())
+                stopCurrentRoomStream();
         }
     }
 
+    updatePublicRoomsListLayout();
+
     if (mainController->isPlayingInNinjamRoom())
         this->ninjamWindow->updateGeoLocations();
+    else
+        schedulePreviewVisibleRoomStreams(); // the panels are visible after the layout update
     /** updating country flag and country names after refresh the public rooms list. This is necessary because the call to webservice used to get country codes and  country names is not synchronous. So, if country code and name are not cached we receive these data from the webservice after some seconds.*/
 }
 
+QList<Login::RoomInfo> MainWindow::getSortedPublicRooms() const
+{
+    QList<Login::RoomInfo> sortedRooms;
+    foreach (JamRoomViewPanel *roomViewPanel, roomViewPanels) {
+        if (roomViewPanel)
+            sortedRooms.append(roomViewPanel->getRoomInfo());
+    }
+    qStableSort(sortedRooms.begin(), sortedRooms.end(), jamRoomLessThan);
+    return sortedRooms;
+}
+
+QList<Login::RoomInfo> MainWindow::getVisiblePublicRooms() const
+{
+    QList<Login::RoomInfo> visibleRooms;
+    if (isMinimized())
+        return visibleRooms;
+
+    // the panels out of the scroll area viewport, or in the hidden public rooms tab, have an empty visible region
+    foreach (const Login::RoomInfo &roomInfo, getSortedPublicRooms()) {
+        JamRoomViewPanel *roomViewPanel = roomViewPanels.value(roomInfo.getID());
+        if (roomViewPanel && !roomViewPanel->visibleRegion().isEmpty())
+            visibleRooms.append(roomInfo);
+    }
+    return visibleRooms;
+}
+
+void MainWindow::schedulePreviewVisibleRoomStreams()
+{
+    if (mainController && !mainController->isPlayingInNinjamRoom())
+        roomStreamsPreviewTimer.start();
+}
+
+void MainWindow::previewVisibleRoomStreams()
+{
+    if (mainController->isPlayingInNinjamRoom())
+        return; // the previews are stopped when entering in a room
+
+    // the hidden rooms previews are stopped, the previewer limit is applied to the visible rooms
+    mainController->previewRoomStreams(getVisiblePublicRooms());
+}
+
 // +++++++++++++++++++++++++++++++++++++
 void MainWindow::playPublicRoomStream(const Login::RoomInfo &roomInfo)
 {
@@ -665,8 +723,8 @@ void MainWindow::tryEnterInRoom(const Login::RoomInfo &roomInfo, const QString &
     // stop room stream before enter in a room
     if (mainController->isPlayingRoomStream()) {
         long long roomID = mainController->getCurrentStreamingRoomID();
-        if (roomViewPanels[roomID])
-            roomViewPanels[roomID]->clear(true);
+        if (roomViewPanels.value(roomID))
+            roomViewPanels.value(roomID)->clear(true);
         mainController->stopRoomStream();
     }
 
@@ -753,6 +811,9 @@ void MainWindow::enterInRoom(const Login::RoomInfo &roomInfo)
     QObject::connect(mainController->getNinjamController(), SIGNAL(intervalBeatChanged(
                                                                        int)), this,
                      SLOT(updateCurrentIntervalBeat(int)));
+    QObject::connect(mainController->getNinjamController(),
+                     SIGNAL(encodingQualityChanged(int, float, VorbisQualityController::Reason)), this,
+                     SLOT(updateEncodingQuality(int, float, VorbisQualityController::Reason)));
 }
 
 void MainWindow::setUserNameReadOnlyStatus(bool readOnly)
@@ -784,6 +845,14 @@ void MainWindow::showMetronomePreferencesDialog()
     openPreferencesDialog(ui.actionMetronome);
 }
 
+void MainWindow::updateEncodingQuality(int groupIndex, float quality, VorbisQualityController::Reason reason)
+{
+    foreach (LocalTrackGroupView *trackGroup, localGroupChannels) {
+        if (trackGroup->getChannelIndex() == groupIndex)
+            trackGroup->setEncodingQuality(quality, reason);
+    }
+}
+
 // +++++++++++++++ PREPARING TO XMIT +++++++++++
 // this signal is received when ninjam controller is ready to transmit (after the 'preparing' intervals).
 void MainWindow::startTransmission()
@@ -828,6 +897,8 @@ void MainWindow::exitFromRoom(bool normalDisconnection, QString disconnectionMes
     setChatVisibility(false);
 
     setInputTracksPreparingStatus(false);/** reset the prepating status when user leave the room. This is specially necessary if user enter in a room and leave before the track is prepared to transmit.*/
+    foreach (LocalTrackGroupView *trackGroup, localGroupChannels)
+        trackGroup->setEncodingQuality(VorbisQualityController::DEFAULT, VorbisQualityController::DEFAULT_QUALITY);
 
     if (!normalDisconnection) {
         if (!disconnectionMessage.isEmpty())
@@ -881,16 +952,16 @@ void MainWindow::timerEvent(QTimerEvent *)
     }
 
     // update cpu and memmory usage
-// qint64 now = QDateTime::currentMSecsSinceEpoch();
-// if(now - lastPerformanceMonitorUpdate >= PERFORMANCE_MONITOR_REFRESH_TIME){
-// ui.tabWidget->setResourcesUsage(performanceMonitor.getCpuUsage(), performanceMonitor.getMemmoryUsage());
-// lastPerformanceMonitorUpdate = now;
-// }
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (now - lastPerformanceMonitorUpdate >= PERFORMANCE_MONITOR_REFRESH_TIME && !resourcesUsageWatcher.isRunning()) {
+        resourcesUsageWatcher.setFuture(QtConcurrent::run(&performanceMonitor, &PerformanceMonitor::getResourcesUsage));
+        lastPerformanceMonitorUpdate = now;
+    }
 
     // update room stream plot
     if (mainController->isPlayingRoomStream()) {
         long long roomID = mainController->getCurrentStreamingRoomID();
-        JamRoomViewPanel *roomView = roomViewPanels[roomID];
+        JamRoomViewPanel *roomView = roomViewPanels.value(roomID);
         if (roomView) {
             bool buffering = mainController->getRoomStreamer()->isBuffering();
             roomView->setShowBufferingState(buffering);
@@ -916,6 +987,8 @@ void MainWindow::resizeEvent(QResizeEvent *ev)
     Q_UNUSED(ev)
     if (busyDialog.isVisible())
         centerBusyDialog();
+
+    schedulePreviewVisibleRoomStreams();
 }
 
 void MainWindow::changeEvent(QEvent *ev)
@@ -927,6 +1000,7 @@ void MainWindow::changeEvent(QEvent *ev)
         showPeakMetersOnlyInLocalControls(
             isRunningInMiniMode() && width() <= MINI_MODE_MIN_SIZE.width());
         updatePublicRoomsListLayout();
+        schedulePreviewVisibleRoomStreams(); // minimized windows are not pre-buffering
     } else if (ev->type() == QEvent::LanguageChange) {
         ui.retranslateUi(this);
         if (ninjamWindow)
@@ -964,6 +1038,8 @@ MainWindow::~MainWindow()
 
     killTimer(timerID);
     qCDebug(jtGUI) << "Main frame timer killed!";
+
+    resourcesUsageWatcher.waitForFinished();// the performance monitor is used in the sampling thread
     qCDebug(jtGUI) << "MainWindow destructor finished.";
 }
 
@@ -1177,10 +1253,26 @@ void MainWindow::changeViewMode()
 
 void MainWindow::updatePublicRoomsListLayout()
 {
-    QList<Login::RoomInfo> roomInfos;
-    foreach (JamRoomViewPanel *roomView, roomViewPanels)
-        roomInfos.append(roomView->getRoomInfo());
-    refreshPublicRoomsList(roomInfos);
+    QGridLayout *layout = dynamic_cast<QGridLayout *>(ui.allRoomsContent->layout());
+    bool twoCollumns = canUseTwoColumnLayout();
+    int index = 0;
+    foreach (const Login::RoomInfo &roomInfo, getSortedPublicRooms()) {
+        int rowIndex = twoCollumns ? (index / 2) : (index);
+        int collumnIndex = twoCollumns ? (index % 2) : 0;
+        index++;
+
+        // the panels already in the right cell are not removed from the layout
+        JamRoomViewPanel *roomViewPanel = roomViewPanels.value(roomInfo.getID());
+        int layoutIndex = layout->indexOf(roomViewPanel);
+        if (layoutIndex >= 0) {
+            int currentRow, currentCollumn, rowSpan, collumnSpan;
+            layout->getItemPosition(layoutIndex, &currentRow, &currentCollumn, &rowSpan, &collumnSpan);
+            if (currentRow == rowIndex && currentCollumn == collumnIndex)
+                continue;
+            layout->removeWidget(roomViewPanel);
+        }
+        layout->addWidget(roomViewPanel, rowIndex, collumnIndex);
+    }
 }
 
 QSize MainWindow::getSanitizedMinimumWindowSize(const QSize &prefferedMinimumWindowSize) const
@@ -1455,6 +1547,8 @@ void MainWindow::setupWidgets()
 
 void MainWindow::setupSignals()
 {
+    connect(&resourcesUsageWatcher, SIGNAL(finished()), this, SLOT(updateResourcesUsage()));
+
     connect(ui.menuPreferences, SIGNAL(triggered(QAction *)), this,
             SLOT(openPreferencesDialog(QAction *)));
 
@@ -1495,6 +1589,12 @@ void MainWindow::setupSignals()
     connect(ui.menuLanguage, SIGNAL(triggered(QAction *)), this, SLOT(setLanguage(QAction *)));
 
     connect(ui.userNameLineEdit, SIGNAL(editingFinished()), this, SLOT(updateUserName()));
+
+    roomStreamsPreviewTimer.setSingleShot(true);
+    roomStreamsPreviewTimer.setInterval(ROOM_STREAMS_PREVIEW_DELAY);
+    connect(&roomStreamsPreviewTimer, SIGNAL(timeout()), this, SLOT(previewVisibleRoomStreams()));
+    connect(ui.allRoomsScroll->verticalScrollBar(), SIGNAL(valueChanged(int)), &roomStreamsPreviewTimer, SLOT(start()));
+    connect(ui.allRoomsScroll->horizontalScrollBar(), SIGNAL(valueChanged(int)), &roomStreamsPreviewTimer, SLOT(start()));
 }
 
 void MainWindow::updateUserName()
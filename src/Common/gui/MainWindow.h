@@ -8,8 +8,10 @@
 #include "persistence/Settings.h"
 #include "LocalTrackGroupView.h"
 #include <QTranslator>
+#include <QFutureWatcher>
+#include <QTimer>
 
-// #include "performance/PerformanceMonitor.h"
+#include "performance/PerformanceMonitor.h"
 
 class PreferencesDialog;
 class LocalTrackView;
@@ -20,6 +22,7 @@ class ChordsPanel;
 
 namespace Login {
 class RoomInfo;
+class RoomsListChanges;
 }
 
 namespace Controller {
@@ -207,7 +210,9 @@ private slots:
 
     void updateLocalInputChannelsGeometry();
 
-    void refreshPublicRoomsList(const QList<Login::RoomInfo> &publicRooms);
+    void updatePublicRoomsList(const Login::RoomsListChanges &changes);
+
+    void updateEncodingQuality(int groupIndex, float quality, VorbisQualityController::Reason reason);
 
     void hideChordsPanel();
 
@@ -225,6 +230,10 @@ private slots:
     void changeTheme(QAction *action);
     void translateThemeMenu();
 
+    void updateResourcesUsage();
+
+    void previewVisibleRoomStreams();
+
 private:
 
     BusyDialog busyDialog;
@@ -249,6 +258,7 @@ private:
     QString passwordToJump;
 
     static bool jamRoomLessThan(const Login::RoomInfo &r1, const Login::RoomInfo &r2);
+    QList<Login::RoomInfo> getSortedPublicRooms() const;
 
     void initializeLoginService();
     void initializeLocalInputChannels(const Persistence::LocalInputTrackSettings &localInputSettings);
@@ -298,9 +308,16 @@ private:
 
     QString getTranslatedThemeName(const QString &themeName);
 
-    // PerformanceMonitor performanceMonitor;//cpu and memmory usage
-    // qint64 lastPerformanceMonitorUpdate;
-    // static const int PERFORMANCE_MONITOR_REFRESH_TIME;
+    PerformanceMonitor performanceMonitor;//cpu and memmory usage
+    QFutureWatcher<PerformanceMonitor::ResourcesUsage> resourcesUsageWatcher;// the resources usage is sampled outside the GUI thread
+    qint64 lastPerformanceMonitorUpdate;
+    static const int PERFORMANCE_MONITOR_REFRESH_TIME;
+
+    // only the visible rooms streams are pre-buffered, the previews are updated when the user stops scrolling or resizing
+    QTimer roomStreamsPreviewTimer;
+    QList<Login::RoomInfo> getVisiblePublicRooms() const;
+    void schedulePreviewVisibleRoomStreams();
+    static const int ROOM_STREAMS_PREVIEW_DELAY;
 
     // TODO:group these 2 related constants?
     static const QSize MINI_MODE_MIN_SIZE;
@@ -81,6 +81,11 @@ NinjamRoomWindow::NinjamRoomWindow(MainWindow *parent, const Login::RoomInfo &ro
 
     initializeVotingExpirationTimers();
 
+    tracksLayoutTimer = new QTimer(this);
+    tracksLayoutTimer->setSingleShot(true);
+    tracksLayoutTimer->setInterval(1000/50); // one frame, same refresh rate used to animate the peaks
+    connect(tracksLayoutTimer, SIGNAL(timeout()), this, SLOT(updateTracksLayout()));
+
     updateBpmBpiLabel();
 
 }
@@ -324,12 +329,11 @@ void NinjamRoomWindow::showLastChordsInChat()
     Login::LoginService *loginService = mainController->getLoginService();
     QString lastChordProgression = loginService->getChordProgressionFor(roomInfo);
     ChatChordsProgressionParser parser;
-    if (parser.containsProgression(lastChordProgression)) {
-        ChordProgression progression = parser.parse(lastChordProgression);
+    ChordProgression progression = parser.parse(lastChordProgression); // empty progression if the string has no chords
+    if (!progression.isEmpty()) {
         QString title = tr("Last chords used");
         chatPanel->addLastChordsMessage(title, progression.toString());
-        chatPanel->addChordProgressionConfirmationMessage(parser.parse(lastChordProgression));
-
+        chatPanel->addChordProgressionConfirmationMessage(progression);
     }
 }
 
@@ -337,13 +341,23 @@ void NinjamRoomWindow::addChatMessage(const Ninjam::User &user, const QString &m
 {
     QString userName = user.getName();
 
-    bool isFirstSystemVoteMessage = Gui::Chat::isFirstSystemVotingMessage(userName, message);
+    // each message is parsed only one time, the user name in system voting messages is always empty
+    Gui::Chat::SystemVotingMessage voteMessage = Gui::Chat::SystemVotingMessage::newEmptyVotingMessage();
+    if (userName.isEmpty())
+        voteMessage = Gui::Chat::parseSystemVotingMessage(message);
+    bool isFirstSystemVoteMessage = voteMessage.isValidVotingMessage() && voteMessage.isFirstVotingMessage();
 
-    bool isChordProgressionMessage = false;
+    ChordProgression chordProgression;
     if (!isFirstSystemVoteMessage) {
-        ChatChordsProgressionParser chordsParser;
-        isChordProgressionMessage = chordsParser.containsProgression(message);
+        try{
+            ChatChordsProgressionParser chordsParser;
+            chordProgression = chordsParser.parse(message); // empty progression if the message has no chords
+        }
+        catch (const std::runtime_error &e) {
+            qCCritical(jtNinjamGUI) << e.what();
+        }
     }
+    bool isChordProgressionMessage = !chordProgression.isEmpty();
 
     bool showBlockButton = canShowBlockButtonInChatMessage(userName);
     bool showTranslationButton = !isChordProgressionMessage;
@@ -351,8 +365,6 @@ void NinjamRoomWindow::addChatMessage(const Ninjam::User &user, const QString &m
 
     static bool localUserWasVotingInLastMessage = false;
     if (isFirstSystemVoteMessage) {
-        Gui::Chat::SystemVotingMessage voteMessage = Gui::Chat::parseSystemVotingMessage(message);
-
         if (!localUserWasVotingInLastMessage) {  //don't create the vote button if local user is proposing BPI or BPM change
             createVoteButton(voteMessage);
         }
@@ -369,7 +381,7 @@ void NinjamRoomWindow::addChatMessage(const Ninjam::User &user, const QString &m
         expirationTimer->start(voteMessage.getExpirationTime() * 1000); //QTimer::start will cancel a previous voting expiration timer
     }
     else if (isChordProgressionMessage) {
-        handleChordProgressionMessage(user, message);
+        handleChordProgressionMessage(user, chordProgression);
     }
 
     localUserWasVotingInLastMessage = Gui::Chat::isLocalUserVotingMessage(message) && user.getName() == mainController->getUserName();
@@ -404,17 +416,10 @@ bool NinjamRoomWindow::canShowBlockButtonInChatMessage(const QString &userName)
     return !userIsBot && !currentUserIsPostingTheChatMessage && !userName.isEmpty();
 }
 
-void NinjamRoomWindow::handleChordProgressionMessage(const Ninjam::User &user, const QString &message)
+void NinjamRoomWindow::handleChordProgressionMessage(const Ninjam::User &user, const ChordProgression &chordProgression)
 {
     Q_UNUSED(user)
-    ChatChordsProgressionParser parser;
-    try{
-        ChordProgression chordProgression = parser.parse(message);
-        chatPanel->addChordProgressionConfirmationMessage(chordProgression);
-    }
-    catch (const std::runtime_error &e) {
-        qCCritical(jtNinjamGUI) << e.what();
-    }
+    chatPanel->addChordProgressionConfirmationMessage(chordProgression);
 }
 
 void NinjamRoomWindow::createVoteButton(const Gui::Chat::SystemVotingMessage &votingMessage)
@@ -473,6 +478,14 @@ void NinjamRoomWindow::hideIntervalDownloadingProgressBar(long trackID)
         trackView->finishCurrentDownload();
 }
 
+void NinjamRoomWindow::updateIntervalStatistics()
+{
+    foreach (NinjamTrackGroupView *trackGroup, trackGroups) {
+        if (trackGroup)
+            trackGroup->updateIntervalStatistics();
+    }
+}
+
 void NinjamRoomWindow::updateIntervalDownloadingProgressBar(long trackID)
 {
     NinjamTrackNode *node = dynamic_cast<NinjamTrackNode *>(mainController->getTrackNode(trackID));
@@ -499,18 +512,40 @@ void NinjamRoomWindow::removeChannel(const Ninjam::User &user, const Ninjam::Use
 
     NinjamTrackGroupView *group = trackGroups[user.getFullName()];
     if (group) {
+        invalidateTracksLayout();
         if (group->getTracksCount() == 1) {// removing the last track, the group is removed too
             trackGroups.remove(user.getFullName());
             ui->tracksPanel->layout()->removeWidget(group);
-            group->deleteLater();
+            if (trackGroupsPool.size() < MAX_POOLED_TRACK_GROUPS) {// the group is reused when the next user enter
+                group->hide();
+                group->getTracks<BaseTrackView *>().first()->unbindTrack();
+                trackGroupsPool.append(group);
+            }
+            else {
+                group->deleteLater();
+            }
         } else {// remove one subchannel
             BaseTrackView *trackView = BaseTrackView::getTrackViewByID(channelID);
             if (trackView)
                 group->removeTrackView(trackView);
         }
     }
+}
 
+void NinjamRoomWindow::invalidateTracksLayout()
+{
+    if (tracksLayoutTimer->isActive())
+        return;
+
+    // the tracks panel is not repainted until all the channels changes in this frame are done
+    ui->tracksPanel->setUpdatesEnabled(false);
+    tracksLayoutTimer->start();
+}
+
+void NinjamRoomWindow::updateTracksLayout()
+{
     updateTracksSizeButtons();
+    ui->tracksPanel->setUpdatesEnabled(true);
 }
 
 NinjamTrackView *NinjamRoomWindow::getTrackViewByID(long trackID)
@@ -539,14 +574,23 @@ void NinjamRoomWindow::addChannel(const Ninjam::User &user, const Ninjam::UserCh
         = cache->getUserCacheEntry(user.getIp(), user.getName(),
                                    static_cast<quint8>(channel.getIndex()));
 
+    invalidateTracksLayout();
+
     if (!trackGroups.contains(user.getFullName())) {// first channel from this user?
         QString channelName = channel.getName();
         QColor userColor = usersColorsPool.get(user.getName());// the user channel and your chat messages are painted with same color
-        NinjamTrackGroupView *trackView = new NinjamTrackGroupView(mainController, channelID,
-                                                                   channelName, userColor, cacheEntry);
+        NinjamTrackGroupView *trackView = nullptr;
+        if (!trackGroupsPool.isEmpty()) {// reusing the view of a leaving user
+            trackView = trackGroupsPool.takeLast();
+            trackView->bindToUser(channelID, channelName, userColor, cacheEntry);
+        }
+        else {
+            trackView = new NinjamTrackGroupView(mainController, channelID, channelName, userColor, cacheEntry);
+        }
         trackView->setOrientation(tracksOrientation);
         trackView->setNarrowStatus(tracksSize == TracksSize::NARROW);
         ui->tracksPanel->layout()->addWidget(trackView);
+        trackView->show();
         trackGroups.insert(user.getFullName(), trackView);
         trackView->setEstimatedChunksPerInterval(calculateEstimatedChunksPerInterval());
     } else {// the second, or third channel from same user, group with other channels
@@ -561,8 +605,6 @@ void NinjamRoomWindow::addChannel(const Ninjam::User &user, const Ninjam::UserCh
         }
     }
     qCDebug(jtNinjamGUI) << "channel view created";
-
-    updateTracksSizeButtons();
 }
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 int NinjamRoomWindow::calculateEstimatedChunksPerInterval() const
@@ -598,6 +640,8 @@ void NinjamRoomWindow::disconnectFromNinjamControllerSignals(Controller::NinjamC
 
     disconnect(ninjamController, SIGNAL(channelAudioFullyDownloaded(long)), this, SLOT(hideIntervalDownloadingProgressBar(long)));
 
+    disconnect(ninjamController, SIGNAL(startingNewInterval()), this, SLOT(updateIntervalStatistics()));
+
     disconnect(ninjamController, SIGNAL(chatMsgReceived(Ninjam::User, QString)), this, SLOT(addChatMessage(Ninjam::User, QString)));
 
     disconnect(ninjamController, SIGNAL(channelXmitChanged(long, bool)), this, SLOT(setChannelXmitStatus(long, bool)));
@@ -697,6 +741,8 @@ void NinjamRoomWindow::setupSignals(Controller::NinjamController* ninjamControll
 
     connect(ninjamController, SIGNAL(channelAudioFullyDownloaded(long)), this, SLOT(hideIntervalDownloadingProgressBar(long)));
 
+    connect(ninjamController, SIGNAL(startingNewInterval()), this, SLOT(updateIntervalStatistics()));
+
     connect(ninjamController, SIGNAL(chatMsgReceived(Ninjam::User, QString)), this, SLOT(addChatMessage(Ninjam::User, QString)));
 
     connect(ninjamController, SIGNAL(topicMessageReceived(QString)), this, SLOT(addServerTopicMessage(QString)));
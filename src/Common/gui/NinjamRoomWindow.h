@@ -73,6 +73,11 @@ protected:
 private:
     MainWindow *mainWindow;
     QMap<QString, NinjamTrackGroupView *> trackGroups;
+    QList<NinjamTrackGroupView *> trackGroupsPool; // views of the leaving users, reused when other users are entering
+    static const int MAX_POOLED_TRACK_GROUPS = 8;
+
+    QTimer *tracksLayoutTimer; // the tracks panel layout is updated one time per frame when many channels are added/removed
+    void invalidateTracksLayout();
     ChatPanel *chatPanel;
 
     QTimer *bpmVotingExpirationTimer;
@@ -83,7 +88,7 @@ private:
     Login::RoomInfo roomInfo;
 
     void createVoteButton(const Gui::Chat::SystemVotingMessage &votingMessage);
-    void handleChordProgressionMessage(const Ninjam::User &user, const QString &message);
+    void handleChordProgressionMessage(const Ninjam::User &user, const ChordProgression &chordProgression);
 
     NinjamPanel *createNinjamPanel();
 
@@ -145,6 +150,7 @@ private slots:
     void setChannelXmitStatus(long channelID, bool transmiting);
     void updateIntervalDownloadingProgressBar(long trackID);
     void hideIntervalDownloadingProgressBar(long trackID);
+    void updateIntervalStatistics();
     void addChatMessage(const Ninjam::User &, const QString &message);
     void addServerTopicMessage(const QString &topicMessage);
     void handleUserLeaving(const QString &userName);
@@ -155,6 +161,8 @@ private slots:
 
     void showServerLicence();
 
+    void updateTracksLayout();
+
     // chat panel
     void voteToChangeBpi(int newBpi);
     void voteToChangeBpm(int newBpm);
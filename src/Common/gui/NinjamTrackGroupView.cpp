@@ -54,19 +54,65 @@ NinjamTrackGroupView::NinjamTrackGroupView(Controller::MainController *mainContr
     newTrackView->setChannelName(channelName);
     newTrackView->setInitialValues(initialValues);
 
+    setUserColor(userColor);
+
+    connect(mainController, SIGNAL(ipResolved(QString)), this, SLOT(updateGeoLocation(QString)));
+
+    //reacting to chat block/unblock events
+    Controller::NinjamController *ninjamController = mainController->getNinjamController();
+    connect(ninjamController, SIGNAL(userBlockedInChat(QString)), this, SLOT(showChatBlockIcon(QString)));
+    connect(ninjamController, SIGNAL(userUnblockedInChat(QString)), this, SLOT(hideChatBlockIcon(QString)));
+}
+
+void NinjamTrackGroupView::bindToUser(long trackID, const QString &channelName, const QColor &userColor,
+                                      const Persistence::CacheEntry &initialValues)
+{
+    Q_ASSERT(trackViews.size() == 1);
+
+    userIP = initialValues.getUserIP();
+    setGroupName(initialValues.getUserName());
+    groupNameLabel->setToolTip(QString());
+    countryLabel->clear();
+    updateGeoLocation();
+
+    bool userIsBlockedInChat = mainController->getNinjamController()->userIsBlockedInChat(initialValues.getUserName());
+    chatBlockIconLabel->setVisible(userIsBlockedInChat);
+
+    NinjamTrackView *trackView = getTracks<NinjamTrackView *>().first();
+    trackView->bindToTrack(trackID);
+    trackView->setChannelName(channelName);
+    trackView->setInitialValues(initialValues);
+
+    setUserColor(userColor);
+}
+
+void NinjamTrackGroupView::setUserColor(const QColor &color)
+{
+    if (color == userColor)
+        return; // avoid the style sheet parsing when the color is not changed
+
+    userColor = color;
     QString styleSheet = "background-color: qlineargradient(x1:0, y1:0, x2:1, y2:0, ";
     styleSheet += "stop: 0 rgba(0, 0, 0, 0), ";
     styleSheet += "stop: 0.35 " + userColor.name() + ", ";
     styleSheet += "stop: 0.65" + userColor.name() + ", ";
     styleSheet += "stop: 1 rgba(0, 0, 0, 0));";
     groupNameLabel->setStyleSheet(styleSheet);
+}
 
-    connect(mainController, SIGNAL(ipResolved(QString)), this, SLOT(updateGeoLocation(QString)));
-
-    //reacting to chat block/unblock events
+void NinjamTrackGroupView::updateIntervalStatistics()
+{
     Controller::NinjamController *ninjamController = mainController->getNinjamController();
-    connect(ninjamController, SIGNAL(userBlockedInChat(QString)), this, SLOT(showChatBlockIcon(QString)));
-    connect(ninjamController, SIGNAL(userUnblockedInChat(QString)), this, SLOT(hideChatBlockIcon(QString)));
+    Ninjam::User user = ninjamController->getUserByName(getGroupName());
+    NinjamTrackNode::IntervalStatistics statistics = ninjamController->getUserIntervalStatistics(user);
+    if (statistics.lateStartedIntervals == 0 && statistics.droppedIntervals == 0) {
+        groupNameLabel->setToolTip(QString());
+        return;
+    }
+
+    QString toolTip = tr("Late intervals: %1").arg(statistics.lateStartedIntervals) + "\n"
+            + tr("Dropped intervals: %1").arg(statistics.droppedIntervals);
+    groupNameLabel->setToolTip(toolTip);
 }
 
 void NinjamTrackGroupView::hideChatBlockIcon(const QString &unblockedUserName)
@@ -179,7 +225,26 @@ void NinjamTrackGroupView::setupVerticalLayout()
 
 NinjamTrackView *NinjamTrackGroupView::createTrackView(long trackID)
 {
-    return new NinjamTrackView(mainController, trackID);
+    if (tracksPool.isEmpty())
+        return new NinjamTrackView(mainController, trackID);
+
+    NinjamTrackView *trackView = tracksPool.takeLast();
+    trackView->bindToTrack(trackID);
+    trackView->show();
+    return trackView;
+}
+
+void NinjamTrackGroupView::releaseTrackView(BaseTrackView *trackView)
+{
+    NinjamTrackView *ninjamTrackView = dynamic_cast<NinjamTrackView *>(trackView);
+    if (!ninjamTrackView || tracksPool.size() >= MAX_POOLED_TRACKS) {
+        TrackGroupView::releaseTrackView(trackView);
+        return;
+    }
+
+    ninjamTrackView->hide();
+    ninjamTrackView->unbindTrack();
+    tracksPool.append(ninjamTrackView);
 }
 
 void NinjamTrackGroupView::setGroupName(const QString &groupName)
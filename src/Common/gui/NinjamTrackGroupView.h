@@ -21,12 +21,16 @@ public:
     NinjamTrackGroupView(Controller::MainController *mainController, long trackID,
                          const QString &channelName, const QColor &userColor, const Persistence::CacheEntry &initialValues);
     ~NinjamTrackGroupView();
+
+    // reuse this group (with one track view) for another user instead of creating a new group
+    void bindToUser(long trackID, const QString &channelName, const QColor &userColor, const Persistence::CacheEntry &initialValues);
     void setNarrowStatus(bool narrow);
     void updateGeoLocation();
     void setGroupName(const QString &groupName);
     QString getGroupName() const override;
     void updateGuiElements();
     void setEstimatedChunksPerInterval(int estimatedChunks);
+    void updateIntervalStatistics(); // late and dropped intervals are showed in the user name tooltip
 
     NinjamTrackView *addTrackView(long trackID) override;
 
@@ -36,6 +40,7 @@ public:
 
 protected:
     NinjamTrackView *createTrackView(long trackID) override;
+    void releaseTrackView(BaseTrackView *trackView) override;
 
     void populateContextMenu(QMenu &contextMenu) override;
 
@@ -46,6 +51,12 @@ private:
     QLabel *chatBlockIconLabel;
     QString userIP;
     Qt::Orientation orientation;
+    QColor userColor;
+
+    QList<NinjamTrackView *> tracksPool; // removed subchannels views, reused in the next subchannels
+    static const int MAX_POOLED_TRACKS = 4;
+
+    void setUserColor(const QColor &color);
 
     void setupHorizontalLayout();
     void setupVerticalLayout();
@@ -40,6 +40,15 @@ void NinjamTrackView::refreshStyleSheet()
     BaseTrackView::refreshStyleSheet();
 }
 
+void NinjamTrackView::bindToTrack(long trackID)
+{
+    BaseTrackView::bindToTrack(trackID);
+
+    setChannelName("");
+    setDownloadedChunksDisplayVisibility(false);
+    setUnlightStatus(true); // disabled/grayed until receive the first bytes, like a new view
+}
+
 void NinjamTrackView::setInitialValues(const Persistence::CacheEntry &initialValues)
 {
     cacheEntry = initialValues;
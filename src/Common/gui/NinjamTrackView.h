@@ -21,6 +21,8 @@ public:
     void setChannelName(const QString &name);
     void setInitialValues(const Persistence::CacheEntry &initialValues);
 
+    void bindToTrack(long trackID) override;
+
     // interval chunks visual feedback
     void incrementDownloadedChunks();// called when a interval part (a chunk) is received
     void finishCurrentDownload(); // called when the interval is fully downloaded
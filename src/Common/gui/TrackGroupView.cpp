@@ -163,12 +163,17 @@ void TrackGroupView::removeTrackView(BaseTrackView *trackView)
 {
     tracksLayout->removeWidget(trackView);
     trackViews.removeOne(trackView);
-    trackView->deleteLater();
+    releaseTrackView(trackView);
     if (trackViews.size() == 1)
         trackViews.at(0)->setToWide();
     updateGeometry();
 }
 
+void TrackGroupView::releaseTrackView(BaseTrackView *trackView)
+{
+    trackView->deleteLater();
+}
+
 void TrackGroupView::removeTrackView(int trackIndex)
 {
     if (trackIndex >= 0 && trackIndex < trackViews.size())
@@ -62,6 +62,7 @@ protected:
     QList<BaseTrackView *> trackViews;
 
     virtual BaseTrackView *createTrackView(long trackID) = 0;
+    virtual void releaseTrackView(BaseTrackView *trackView); // called when the view is removed, the view is deleted by default
 
     QLineEdit *groupNameField;
     QWidget *topPanel;
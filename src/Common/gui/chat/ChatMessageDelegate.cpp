@@ -0,0 +1,250 @@
+#include "ChatMessageDelegate.h"
+#include "ChatMessagesModel.h"
+#include <QPainter>
+#include <QMouseEvent>
+#include <QAbstractItemView>
+#include <QAbstractTextDocumentLayout>
+#include <QDesktopServices>
+#include <QApplication>
+#include <QtMath>
+
+ChatMessageDelegate::ChatMessageDelegate(QObject *parent) :
+    QStyledItemDelegate(parent),
+    textLayouts(ChatMessagesModel::DEFAULT_CAPACITY),
+    messageBorderColor(0, 0, 0, 70),
+    buttonBorderColor(0, 0, 0, 70),
+    activeButtonBorderColor(0, 0, 0, 160)
+{
+    userNameFont = QApplication::font();
+    userNameFont.setPixelSize(10);
+    userNameFont.setBold(true);
+
+    timeStampFont = QApplication::font();
+    timeStampFont.setPixelSize(9);
+    timeStampFont.setItalic(true);
+
+    buttonsFont = QApplication::font();
+    buttonsFont.setPixelSize(8);
+}
+
+void ChatMessageDelegate::clearCache()
+{
+    textLayouts.clear();
+}
+
+const ChatMessage *ChatMessageDelegate::getMessage(const QModelIndex &index)
+{
+    const ChatMessagesModel *model = qobject_cast<const ChatMessagesModel *>(index.model());
+    if (!model || !index.isValid() || index.row() >= model->rowCount())
+        return nullptr;
+    return &model->getMessage(index.row());
+}
+
+int ChatMessageDelegate::getRowWidth(const QStyleOptionViewItem &option)
+{
+    // the same width used in paint() and editorEvent(), the viewport width is used only when the view is not passing the row rect
+    if (option.rect.width() > 0)
+        return option.rect.width();
+
+    const QAbstractItemView *view = qobject_cast<const QAbstractItemView *>(option.widget);
+    if (view)
+        return view->viewport()->width();
+    return 0;
+}
+
+QTextDocument *ChatMessageDelegate::getTextLayout(const ChatMessage &message, int width) const
+{
+    QString html = message.getHtml();
+    TextLayout *layout = textLayouts.object(message.id);
+    if (layout && layout->width == width && layout->html == html)
+        return &layout->document;
+
+    if (!layout) {
+        layout = new TextLayout();
+        textLayouts.insert(message.id, layout);
+    }
+    layout->html = html;
+    layout->width = width;
+    layout->document.setDocumentMargin(0);
+    layout->document.setDefaultFont(QApplication::font());
+    layout->document.setDefaultStyleSheet(QString("body { color: %1; }").arg(message.textColor.name()));
+    layout->document.setHtml("<body>" + html + "</body>");
+    layout->document.setTextWidth(width);
+    return &layout->document;
+}
+
+int ChatMessageDelegate::getHeaderHeight() const
+{
+    return qMax(QFontMetrics(userNameFont).height(), SMALL_BUTTON_SIZE);
+}
+
+QString ChatMessageDelegate::getActionButtonText(const ChatMessage &message)
+{
+    switch (message.type) {
+    case ChatMessage::BPI_VOTE:
+        return tr("Vote - change %1 to %2 ").arg("BPI").arg(message.voteValue);
+    case ChatMessage::BPM_VOTE:
+        return tr("Vote - change %1 to %2 ").arg("BPM").arg(message.voteValue);
+    case ChatMessage::CHORD_PROGRESSION:
+        return tr("Use/load the chords above");
+    case ChatMessage::TEXT:
+        break;
+    }
+    return QString();
+}
+
+ChatMessageDelegate::MessageGeometry ChatMessageDelegate::computeGeometry(const ChatMessage &message, const QRect &rowRect) const
+{
+    MessageGeometry geometry;
+    geometry.frame = rowRect.adjusted(0, 0, -1, -1);
+
+    if (!message.isTextMessage()) { // a right aligned button
+        QFontMetrics metrics(QApplication::font());
+        int width = qMin(metrics.width(getActionButtonText(message)) + PADDING * 4, rowRect.width());
+        int height = metrics.height() + PADDING * 2;
+        geometry.actionButton = QRect(rowRect.right() - width + 1, rowRect.top(), width, height).adjusted(0, 0, -1, -1);
+        return geometry;
+    }
+
+    QRect content = rowRect.adjusted(PADDING, PADDING, -PADDING, -PADDING);
+    int headerHeight = getHeaderHeight();
+
+    int timeStampWidth = QFontMetrics(timeStampFont).width(message.timeStamp.toString("hh:mm:ss"));
+    geometry.timeStamp = QRect(content.right() - timeStampWidth + 1, content.top(), timeStampWidth, headerHeight);
+
+    int buttonsRight = geometry.timeStamp.left() - PADDING;
+    if (message.showBlockButton) {
+        geometry.blockButton = QRect(buttonsRight - SMALL_BUTTON_SIZE + 1, content.top(), SMALL_BUTTON_SIZE, headerHeight - 1);
+        buttonsRight = geometry.blockButton.left() - 2;
+    }
+    if (message.showTranslationButton) {
+        geometry.translateButton = QRect(buttonsRight - SMALL_BUTTON_SIZE + 1, content.top(), SMALL_BUTTON_SIZE, headerHeight - 1);
+        buttonsRight = geometry.translateButton.left() - 2;
+    }
+
+    geometry.userName = QRect(content.left(), content.top(), qMax(0, buttonsRight - content.left()), headerHeight);
+
+    QTextDocument *document = getTextLayout(message, content.width());
+    geometry.text = QRect(content.left(), content.top() + headerHeight + 1, content.width(), qCeil(document->size().height()));
+    return geometry;
+}
+
+QSize ChatMessageDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    const ChatMessage *message = getMessage(index);
+    if (!message)
+        return QSize();
+
+    int width = getRowWidth(option);
+    if (!message->isTextMessage())
+        return QSize(width, QFontMetrics(QApplication::font()).height() + PADDING * 2 + 1);
+
+    QTextDocument *document = getTextLayout(*message, width - PADDING * 2);
+    int height = PADDING * 2 + getHeaderHeight() + 1 + qCeil(document->size().height());
+    return QSize(width, height);
+}
+
+void ChatMessageDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    const ChatMessage *message = getMessage(index);
+    if (!message)
+        return;
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing, false);
+
+    MessageGeometry geometry = computeGeometry(*message, option.rect);
+    bool mouseOver = option.state & QStyle::State_MouseOver;
+
+    if (!message->isTextMessage()) {
+        painter->setPen(mouseOver ? activeButtonBorderColor : buttonBorderColor);
+        painter->setBrush(option.palette.button());
+        painter->drawRect(geometry.actionButton);
+        painter->setPen(option.palette.buttonText().color());
+        painter->drawText(geometry.actionButton, Qt::AlignCenter, getActionButtonText(*message));
+        painter->restore();
+        return;
+    }
+
+    painter->setPen(messageBorderColor);
+    painter->setBrush(message->backgroundColor);
+    painter->drawRect(geometry.frame);
+
+    painter->setPen(message->textColor);
+    if (!message->userName.isEmpty()) {
+        painter->setFont(userNameFont);
+        QString userName = painter->fontMetrics().elidedText(message->userName + ":", Qt::ElideRight, geometry.userName.width());
+        painter->drawText(geometry.userName, Qt::AlignLeft | Qt::AlignVCenter, userName);
+    }
+
+    painter->setFont(timeStampFont);
+    painter->drawText(geometry.timeStamp, Qt::AlignRight | Qt::AlignVCenter, message->timeStamp.toString("hh:mm:ss"));
+
+    painter->setFont(buttonsFont);
+    painter->setBrush(Qt::NoBrush);
+    if (message->showTranslationButton) {
+        painter->setPen(message->showingTranslation ? activeButtonBorderColor : buttonBorderColor);
+        painter->drawRect(geometry.translateButton);
+        painter->setPen(message->textColor);
+        painter->drawText(geometry.translateButton, Qt::AlignCenter, "T");
+    }
+    if (message->showBlockButton) {
+        painter->setPen(buttonBorderColor);
+        painter->drawRect(geometry.blockButton);
+        painter->setPen(message->textColor);
+        painter->drawText(geometry.blockButton, Qt::AlignCenter, "B");
+    }
+
+    QTextDocument *document = getTextLayout(*message, geometry.text.width());
+    painter->translate(geometry.text.topLeft());
+    QAbstractTextDocumentLayout::PaintContext context;
+    context.palette.setColor(QPalette::Text, message->textColor);
+    document->documentLayout()->draw(painter, context);
+
+    painter->restore();
+}
+
+bool ChatMessageDelegate::editorEvent(QEvent *event, QAbstractItemModel *model, const QStyleOptionViewItem &option, const QModelIndex &index)
+{
+    Q_UNUSED(model)
+
+    if (event->type() != QEvent::MouseButtonRelease)
+        return false;
+
+    const ChatMessage *message = getMessage(index);
+    QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+    if (!message || mouseEvent->button() != Qt::LeftButton)
+        return false;
+
+    MessageGeometry geometry = computeGeometry(*message, option.rect);
+    QPoint position = mouseEvent->pos();
+
+    if (!message->isTextMessage()) {
+        if (geometry.actionButton.contains(position)) {
+            emit actionButtonClicked(message->id);
+            return true;
+        }
+        return false;
+    }
+
+    if (message->showTranslationButton && geometry.translateButton.contains(position)) {
+        emit translateButtonClicked(message->id);
+        return true;
+    }
+
+    if (message->showBlockButton && geometry.blockButton.contains(position)) {
+        emit blockButtonClicked(message->userName);
+        return true;
+    }
+
+    if (geometry.text.contains(position)) {
+        QTextDocument *document = getTextLayout(*message, geometry.text.width());
+        QString link = document->documentLayout()->anchorAt(position - geometry.text.topLeft());
+        if (!link.isEmpty()) {
+            QDesktopServices::openUrl(QUrl(link));
+            return true;
+        }
+    }
+
+    return false;
+}
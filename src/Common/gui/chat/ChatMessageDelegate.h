@@ -0,0 +1,88 @@
+#ifndef CHAT_MESSAGE_DELEGATE_H
+#define CHAT_MESSAGE_DELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QTextDocument>
+#include <QCache>
+
+class ChatMessage;
+
+/**
+ * Paint the ChatMessagesModel rows. Only the visible rows are painted, and the messages text
+ * layouts (links, line breaks) are cached, so the chat is not creating widgets for each message.
+ * The small translate (T) and block (B) buttons and the vote/chords buttons are painted too,
+ * the clicks are handled in editorEvent(). The borders colors are set by the themes (ChatPanel properties).
+ */
+
+class ChatMessageDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit ChatMessageDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+    void clearCache();
+
+    inline void setMessageBorderColor(const QColor &color){ messageBorderColor = color; }
+    inline QColor getMessageBorderColor() const{ return messageBorderColor; }
+
+    inline void setButtonBorderColor(const QColor &color){ buttonBorderColor = color; }
+    inline QColor getButtonBorderColor() const{ return buttonBorderColor; }
+
+    // translated messages (T button) and the hovered vote/chords buttons
+    inline void setActiveButtonBorderColor(const QColor &color){ activeButtonBorderColor = color; }
+    inline QColor getActiveButtonBorderColor() const{ return activeButtonBorderColor; }
+
+signals:
+    void translateButtonClicked(quint64 messageID);
+    void blockButtonClicked(const QString &userName);
+    void actionButtonClicked(quint64 messageID); // vote and chord progression buttons
+
+protected:
+    bool editorEvent(QEvent *event, QAbstractItemModel *model, const QStyleOptionViewItem &option, const QModelIndex &index) override;
+
+private:
+    struct TextLayout
+    {
+        QString html;
+        int width;
+        QTextDocument document;
+    };
+
+    struct MessageGeometry
+    {
+        QRect frame;
+        QRect userName;
+        QRect timeStamp;
+        QRect translateButton;
+        QRect blockButton;
+        QRect text;
+        QRect actionButton;
+    };
+
+    mutable QCache<quint64, TextLayout> textLayouts; // message id -> layout, the capacity is the model capacity
+
+    QFont userNameFont;
+    QFont timeStampFont;
+    QFont buttonsFont;
+
+    QColor messageBorderColor;
+    QColor buttonBorderColor;
+    QColor activeButtonBorderColor;
+
+    QTextDocument *getTextLayout(const ChatMessage &message, int width) const;
+    MessageGeometry computeGeometry(const ChatMessage &message, const QRect &rowRect) const;
+    int getHeaderHeight() const;
+
+    static QString getActionButtonText(const ChatMessage &message);
+    static const ChatMessage *getMessage(const QModelIndex &index);
+    static int getRowWidth(const QStyleOptionViewItem &option); // the view width when the option rect is empty
+
+    static const int PADDING = 3;
+    static const int SMALL_BUTTON_SIZE = 14;
+};
+
+#endif
@@ -0,0 +1,195 @@
+#include "ChatMessagesModel.h"
+#include <QRegExp>
+
+ChatMessage::ChatMessage() :
+    id(0),
+    type(TEXT),
+    showingTranslation(false),
+    showTranslationButton(false),
+    showBlockButton(false),
+    voteValue(0)
+{
+}
+
+ChatMessage ChatMessage::newTextMessage(const QString &userName, const QString &text, const QColor &backgroundColor, const QColor &textColor)
+{
+    ChatMessage message;
+    message.userName = userName;
+    message.originalText = text;
+    message.html = toHtml(text);
+    message.backgroundColor = backgroundColor;
+    message.textColor = textColor;
+    message.timeStamp = QTime::currentTime();
+    return message;
+}
+
+ChatMessage ChatMessage::newVoteMessage(Type voteType, quint32 voteValue)
+{
+    ChatMessage message;
+    message.type = voteType;
+    message.voteValue = voteValue;
+    return message;
+}
+
+ChatMessage ChatMessage::newChordProgressionMessage(const ChordProgression &progression)
+{
+    ChatMessage message;
+    message.type = CHORD_PROGRESSION;
+    message.chordProgression = progression;
+    return message;
+}
+
+QString ChatMessage::toHtml(const QString &text)
+{
+    QString html(text);
+    html.replace(QRegExp("<.+?>"), ""); // scape html tags
+    html.replace("\n", "<br/>");
+    html.replace(QRegExp("((?:https?|ftp|www)://\\S+)"), "<a href=\"\\1\">\\1</a>");
+    return html;
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++
+
+ChatMessagesModel::ChatMessagesModel(int capacity, QObject *parent) :
+    QAbstractListModel(parent),
+    messages(qMax(capacity, 1)),
+    first(0),
+    count(0),
+    nextID(1)
+{
+}
+
+int ChatMessagesModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : count;
+}
+
+QVariant ChatMessagesModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= count)
+        return QVariant();
+
+    const ChatMessage &message = at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        return message.isTextMessage() ? message.getHtml() : QVariant();
+    case Qt::ToolTipRole:
+        return message.userName;
+    }
+    return QVariant();
+}
+
+const ChatMessage &ChatMessagesModel::getMessage(int row) const
+{
+    return at(row);
+}
+
+quint64 ChatMessagesModel::append(const ChatMessage &message)
+{
+    if (count == messages.size()) { // drop the oldest message
+        beginRemoveRows(QModelIndex(), 0, 0);
+        messages[first] = ChatMessage(); // release the strings
+        first = (first + 1) % messages.size();
+        count--;
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), count, count);
+    ChatMessage &newMessage = at(count);
+    newMessage = message;
+    newMessage.id = nextID++;
+    count++;
+    endInsertRows();
+
+    return newMessage.id;
+}
+
+int ChatMessagesModel::getRow(quint64 messageID) const
+{
+    // the ids are growing from the oldest to the newest message
+    int low = 0;
+    int high = count - 1;
+    while (low <= high) {
+        int middle = low + (high - low) / 2;
+        quint64 id = at(middle).id;
+        if (id == messageID)
+            return middle;
+        if (id < messageID)
+            low = middle + 1;
+        else
+            high = middle - 1;
+    }
+    return -1;
+}
+
+void ChatMessagesModel::remove(quint64 messageID)
+{
+    int row = getRow(messageID);
+    if (row < 0)
+        return;
+
+    beginRemoveRows(QModelIndex(), row, row);
+    for (int r = row; r < count - 1; ++r)
+        at(r) = at(r + 1);
+    at(count - 1) = ChatMessage();
+    count--;
+    endRemoveRows();
+}
+
+void ChatMessagesModel::removeMessagesFrom(const QString &userName)
+{
+    beginResetModel();
+    int keptMessages = 0;
+    for (int r = 0; r < count; ++r) {
+        if (at(r).userName != userName) {
+            if (r != keptMessages)
+                at(keptMessages) = at(r);
+            keptMessages++;
+        }
+    }
+    for (int r = keptMessages; r < count; ++r)
+        at(r) = ChatMessage();
+    count = keptMessages;
+    endResetModel();
+}
+
+void ChatMessagesModel::clear()
+{
+    beginResetModel();
+    for (int r = 0; r < count; ++r)
+        at(r) = ChatMessage();
+    first = 0;
+    count = 0;
+    endResetModel();
+}
+
+void ChatMessagesModel::setTranslation(quint64 messageID, const QString &translatedText)
+{
+    int row = getRow(messageID);
+    if (row < 0)
+        return; // dropped before the translation is finished
+
+    ChatMessage &message = at(row);
+    message.translatedHtml = ChatMessage::toHtml(translatedText);
+    message.showingTranslation = true;
+    emitMessageChanged(row);
+}
+
+void ChatMessagesModel::setShowingTranslation(quint64 messageID, bool showingTranslation)
+{
+    int row = getRow(messageID);
+    if (row < 0)
+        return;
+
+    ChatMessage &message = at(row);
+    if (message.showingTranslation != showingTranslation) {
+        message.showingTranslation = showingTranslation;
+        emitMessageChanged(row);
+    }
+}
+
+void ChatMessagesModel::emitMessageChanged(int row)
+{
+    QModelIndex changedIndex = index(row);
+    emit dataChanged(changedIndex, changedIndex);
+}
@@ -0,0 +1,107 @@
+#ifndef CHAT_MESSAGES_MODEL_H
+#define CHAT_MESSAGES_MODEL_H
+
+#include <QAbstractListModel>
+#include <QColor>
+#include <QTime>
+#include <QVector>
+#include "gui/chords/ChordProgression.h"
+
+class ChatMessage
+{
+public:
+    enum Type {
+        TEXT,
+        BPI_VOTE,               // 'vote' button, the user is confirming a BPI change
+        BPM_VOTE,
+        CHORD_PROGRESSION       // 'use the chords' button
+    };
+
+    ChatMessage();
+
+    static ChatMessage newTextMessage(const QString &userName, const QString &text, const QColor &backgroundColor, const QColor &textColor);
+    static ChatMessage newVoteMessage(Type voteType, quint32 voteValue);
+    static ChatMessage newChordProgressionMessage(const ChordProgression &progression);
+
+    inline bool isTextMessage() const
+    {
+        return type == TEXT;
+    }
+
+    inline QString getHtml() const // the translated or the original text
+    {
+        return showingTranslation ? translatedHtml : html;
+    }
+
+    quint64 id; // assigned by the model, used to find the message after the ring is rotated
+    Type type;
+    QString userName;
+    QString originalText;       // used in translations
+    QString html;               // html tags escaped and links replaced, computed one time
+    QString translatedHtml;
+    bool showingTranslation;
+    QColor backgroundColor;
+    QColor textColor;
+    QTime timeStamp;
+    bool showTranslationButton;
+    bool showBlockButton;
+    quint32 voteValue;
+    ChordProgression chordProgression;
+
+    static QString toHtml(const QString &text);
+};
+
+/**
+ * The chat messages in a bounded ring. When the ring is full the oldest message is dropped,
+ * so the chat memory and the rows to layout are not growing in long sessions.
+ */
+
+class ChatMessagesModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    explicit ChatMessagesModel(int capacity = DEFAULT_CAPACITY, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    const ChatMessage &getMessage(int row) const;
+
+    quint64 append(const ChatMessage &message); // return the message id
+    void remove(quint64 messageID);
+    void removeMessagesFrom(const QString &userName);
+    void clear();
+
+    int getRow(quint64 messageID) const; // -1 if the message was dropped
+
+    void setTranslation(quint64 messageID, const QString &translatedText);
+    void setShowingTranslation(quint64 messageID, bool showingTranslation);
+
+    inline int getCapacity() const
+    {
+        return messages.size();
+    }
+
+    static const int DEFAULT_CAPACITY = 500;
+
+private:
+    QVector<ChatMessage> messages;
+    int first; // the ring index of the oldest message (row zero)
+    int count;
+    quint64 nextID;
+
+    inline ChatMessage &at(int row)
+    {
+        return messages[(first + row) % messages.size()];
+    }
+
+    inline const ChatMessage &at(int row) const
+    {
+        return messages.at((first + row) % messages.size());
+    }
+
+    void emitMessageChanged(int row);
+};
+
+#endif
@@ -1,11 +1,11 @@
 #include "ChatPanel.h"
 #include "ui_ChatPanel.h"
-#include "ChatMessagePanel.h"
-#include <QWidget>
+#include "ChatMessageDelegate.h"
 #include <QScrollBar>
-#include <QDebug>
 #include <QKeyEvent>
-#include <QWidget>
+#include <QNetworkRequest>
+#include <QApplication>
+#include "log/Logging.h"
 
 const QColor ChatPanel::BOT_COLOR(255, 255, 255, 30);
 
@@ -14,16 +14,28 @@ ChatPanel::ChatPanel(const QStringList &botNames, UsersColorsPool *colorsPool) :
     ui(new Ui::ChatPanel),
     botNames(botNames),
     autoTranslating(false),
+    messagesModel(new ChatMessagesModel(ChatMessagesModel::DEFAULT_CAPACITY, this)),
+    messagesDelegate(new ChatMessageDelegate(this)),
+    translationClient(new QNetworkAccessManager(this)),
     colorsPool(colorsPool)
 {
     ui->setupUi(this);
-    ui->scrollContent->setLayout(new QVBoxLayout(ui->scrollContent));
-    ui->scrollContent->layout()->setContentsMargins(0, 0, 0, 0);
+
+    // the messages are painted by the delegate, only the visible rows are painted
+    ui->chatList->setModel(messagesModel);
+    ui->chatList->setItemDelegate(messagesDelegate);
+    ui->chatList->setMouseTracking(true); // hover feedback in the painted buttons
+
+    connect(messagesDelegate, &ChatMessageDelegate::translateButtonClicked, this, &ChatPanel::toggleTranslation);
+    connect(messagesDelegate, &ChatMessageDelegate::actionButtonClicked, this, &ChatPanel::confirmMessageAction);
+    connect(messagesDelegate, &ChatMessageDelegate::blockButtonClicked, this, &ChatPanel::userBlockingChatMessagesFrom);
+
+    connect(translationClient, &QNetworkAccessManager::finished, this, &ChatPanel::setTranslatedMessage);
 
     connect(ui->chatText, &QLineEdit::returnPressed, this, &ChatPanel::sendNewMessage);
 
     // this event is used to auto scroll down when new messages are added
-    connect(ui->chatScroll->verticalScrollBar(), &QScrollBar::rangeChanged, this, &ChatPanel::autoScroll);
+    connect(ui->chatList->verticalScrollBar(), &QScrollBar::rangeChanged, this, &ChatPanel::autoScroll);
 
     connect(ui->buttonClear, &QPushButton::clicked, this, &ChatPanel::clearMessages);
 
@@ -40,6 +52,7 @@ void ChatPanel::changeEvent(QEvent *e)
 {
     if (e->type() == QEvent::LanguageChange) {
         ui->retranslateUi(this);
+        ui->chatList->viewport()->update(); // repaint the vote buttons
     }
     QWidget::changeEvent(e);
 }
@@ -51,63 +64,53 @@ bool ChatPanel::eventFilter(QObject *obj, QEvent *event)
     return QWidget::eventFilter(obj, event);
 }
 
-void ChatPanel::createVoteButton(const QString &voteType, quint32 value, quint32 expireTime)
+void ChatPanel::addVoteButton(ChatMessage::Type voteType, quint32 value, quint32 expireTime)
 {
-    QPushButton *voteButton = new NinjamVoteButton(voteType, value, expireTime);
-    voteButton->setSizePolicy(QSizePolicy(QSizePolicy::Maximum, QSizePolicy::Preferred));
-    ui->scrollContent->layout()->addWidget(voteButton);
-    ui->scrollContent->layout()->setAlignment(voteButton, Qt::AlignRight);
-    connect(voteButton, &QPushButton::clicked, this, &ChatPanel::confirmVote);
+    quint64 messageID = messagesModel->append(ChatMessage::newVoteMessage(voteType, value));
+
+    // the vote button is removed when the vote expires
+    QTimer::singleShot(expireTime * 1000, this, [=](){
+        messagesModel->remove(messageID);
+    });
 }
 
 void ChatPanel::addBpiVoteConfirmationMessage(quint32 newBpiValue, quint32 expireTime)
 {
-    createVoteButton("BPI", newBpiValue, expireTime);
+    addVoteButton(ChatMessage::BPI_VOTE, newBpiValue, expireTime);
 }
 
 void ChatPanel::addBpmVoteConfirmationMessage(quint32 newBpmValue, quint32 expireTime)
 {
-    createVoteButton("BPM", newBpmValue, expireTime);
-}
-
-void ChatPanel::confirmVote()
-{
-    NinjamVoteButton *voteButton = static_cast<NinjamVoteButton *>(QObject::sender());
-    if (voteButton->isBpiVote())
-        emit userConfirmingVoteToBpiChange(voteButton->getVoteValue());
-    else if (voteButton->isBpmVote())
-        emit userConfirmingVoteToBpmChange(voteButton->getVoteValue());
-
-    voteButton->parentWidget()->layout()->removeWidget(voteButton);
-    voteButton->deleteLater();
+    addVoteButton(ChatMessage::BPM_VOTE, newBpmValue, expireTime);
 }
 
-// ++++++++++++++++++++++++++++++++++
-
-
-
 void ChatPanel::addChordProgressionConfirmationMessage(const ChordProgression &progression)
 {
-    QString buttonText = tr("Use/load the chords above");
-    QPushButton *chordProgressionButton = new ChordProgressionConfirmationButton(buttonText,
-                                                                                 progression);
-    chordProgressionButton->setSizePolicy(QSizePolicy(QSizePolicy::Maximum,
-                                                      QSizePolicy::Preferred));
-    ui->scrollContent->layout()->addWidget(chordProgressionButton);
-    ui->scrollContent->layout()->setAlignment(chordProgressionButton, Qt::AlignRight);
-    connect(chordProgressionButton, &QPushButton::clicked, this, &ChatPanel::confirmChordProgression);
+    messagesModel->append(ChatMessage::newChordProgressionMessage(progression));
 }
 
-// +++++++++++++++++++++++++++++++
-void ChatPanel::confirmChordProgression()
+void ChatPanel::confirmMessageAction(quint64 messageID)
 {
-    ChordProgressionConfirmationButton *chordProgressionButton
-        = qobject_cast<ChordProgressionConfirmationButton *>(QObject::sender());
-
-    emit userConfirmingChordProgression(chordProgressionButton->getChordProgression());
+    int row = messagesModel->getRow(messageID);
+    if (row < 0)
+        return;
+
+    const ChatMessage message = messagesModel->getMessage(row);
+    switch (message.type) {
+    case ChatMessage::BPI_VOTE:
+        emit userConfirmingVoteToBpiChange(message.voteValue);
+        break;
+    case ChatMessage::BPM_VOTE:
+        emit userConfirmingVoteToBpmChange(message.voteValue);
+        break;
+    case ChatMessage::CHORD_PROGRESSION:
+        emit userConfirmingChordProgression(message.chordProgression);
+        break;
+    case ChatMessage::TEXT:
+        return;
+    }
 
-    chordProgressionButton->parentWidget()->layout()->removeWidget(chordProgressionButton);
-    chordProgressionButton->deleteLater();
+    messagesModel->remove(messageID);
 }
 
 // +++++++++++++++
@@ -115,7 +118,7 @@ void ChatPanel::autoScroll(int min, int max)
 {
     Q_UNUSED(min)
     // used to auto scroll down to keep the last added message visible
-    ui->chatScroll->verticalScrollBar()->setValue(max + 10);
+    ui->chatList->verticalScrollBar()->setValue(max);
 }
 
 void ChatPanel::sendNewMessage()
@@ -129,11 +132,9 @@ void ChatPanel::sendNewMessage()
 
 void ChatPanel::updateMessagesGeometry()
 {
-    QList<ChatMessagePanel *> messages = ui->scrollContent->findChildren<ChatMessagePanel *>();
-    foreach (ChatMessagePanel *msg, messages) {
-        msg->setMaximumWidth(ui->scrollContent->width());
-        msg->updateGeometry();
-    }
+    // the cached text layouts are computed using the old width
+    messagesDelegate->clearCache();
+    ui->chatList->doItemsLayout();
 }
 
 void ChatPanel::showTranslationProgressFeedback()
@@ -152,11 +153,7 @@ void ChatPanel::hideTranslationProgressFeedback()
 
 void ChatPanel::addLastChordsMessage(const QString &userName, const QString &message, QColor textColor, QColor backgroundColor)
 {
-    ChatMessagePanel *msgPanel = new ChatMessagePanel(ui->scrollContent, userName, message,
-                                                      backgroundColor, textColor, false, false);
-
-    addMessagePanelInLayout(msgPanel);
-
+    messagesModel->append(ChatMessage::newTextMessage(userName, message, backgroundColor, textColor));
 }
 
 void ChatPanel::addMessage(const QString &userName, const QString &userMessage, bool showTranslationButton, bool showBlockButton)
@@ -165,35 +162,74 @@ void ChatPanel::addMessage(const QString &userName, const QString &userMessage,
     QColor backgroundColor = getUserColor(name);
     bool isBot = backgroundColor == BOT_COLOR;
     QColor textColor = isBot ? QColor(50, 50, 50) : QColor(0, 0, 0);
-    QColor userNameBackgroundColor = backgroundColor;
-    ChatMessagePanel *msgPanel = new ChatMessagePanel(ui->scrollContent, name, userMessage,
-                                                      userNameBackgroundColor, textColor, showTranslationButton, showBlockButton);
 
-    connect(msgPanel, SIGNAL(startingTranslation()), this, SLOT(showTranslationProgressFeedback()));
-    connect(msgPanel, SIGNAL(translationFinished()), this, SLOT(hideTranslationProgressFeedback()));
+    ChatMessage message = ChatMessage::newTextMessage(name, userMessage, backgroundColor, textColor);
+    message.showTranslationButton = showTranslationButton;
+    message.showBlockButton = showBlockButton;
+    quint64 messageID = messagesModel->append(message);
+
+    if (autoTranslating)
+        translate(messageID);// request the translation
+
+}
+
+void ChatPanel::toggleTranslation(quint64 messageID)
+{
+    int row = messagesModel->getRow(messageID);
+    if (row < 0)
+        return;
+
+    const ChatMessage &message = messagesModel->getMessage(row);
+    if (message.showingTranslation)
+        messagesModel->setShowingTranslation(messageID, false);
+    else if (!message.translatedHtml.isEmpty())
+        messagesModel->setShowingTranslation(messageID, true);
+    else
+        translate(messageID);
+}
 
-    connect(msgPanel, &ChatMessagePanel::blockingUser, this, &ChatPanel::userBlockingChatMessagesFrom);
+void ChatPanel::translate(quint64 messageID)
+{
+    int row = messagesModel->getRow(messageID);
+    if (row < 0)
+        return;
 
-    msgPanel->setPrefferedTranslationLanguage(this->autoTranslationLanguage);
+    showTranslationProgressFeedback();
 
-    addMessagePanelInLayout(msgPanel);
+    QString encodedText(QUrl::toPercentEncoding(messagesModel->getMessage(row).originalText));
+    QString url = "http://translate.googleapis.com/translate_a/single?client=gtx&sl=auto&tl="
+                  + autoTranslationLanguage +"&dt=t&q=" + encodedText;
+    QNetworkRequest req;
+    req.setUrl(QUrl(url));
+    req.setAttribute(QNetworkRequest::User, messageID); // the message can be dropped before the reply
+    req.setRawHeader("User-Agent",
+                     "Mozilla/5.0 (Windows NT 6.3; WOW64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/46.0.2490.71 Safari/537.36");
 
-    if (autoTranslating)
-        msgPanel->translate();// request the translation
+    qCDebug(jtGUI) << "Translating:" << url;
 
+    translationClient->get(req);
 }
 
-void ChatPanel::addMessagePanelInLayout(ChatMessagePanel *msgPanel)
+void ChatPanel::setTranslatedMessage(QNetworkReply *reply)
 {
-    ui->scrollContent->layout()->addWidget(msgPanel);
-    if (ui->scrollContent->layout()->count() > MAX_MESSAGES) {
-        // remove the first widget
-        QList<ChatMessagePanel *> panels = ui->scrollContent->findChildren<ChatMessagePanel *>();
-        ui->scrollContent->layout()->removeWidget(panels.first());
-        delete panels.first();
+    quint64 messageID = reply->request().attribute(QNetworkRequest::User).toULongLong();
+
+    if (reply->error() == QNetworkReply::NoError) {
+        QString data(reply->readAll());
+        int startSlash = data.indexOf(QRegExp("\""));
+        int endSlash = data.indexOf(QRegExp("\""), startSlash + 1);
+        QString translatedText = data.mid(startSlash+1, endSlash - startSlash - 1);
+        if (translatedText.isEmpty())
+            translatedText = "translation error!";
+        messagesModel->setTranslation(messageID, translatedText);
+    }
+    else {
+        qCritical() << "Translation error:" << reply->errorString(); // the original text is kept
     }
-    ui->scrollContent->layout()->setAlignment(Qt::AlignTop);
-    ui->scrollContent->layout()->setAlignment(msgPanel, Qt::AlignTop);
+
+    reply->deleteLater();
+
+    hideTranslationProgressFeedback();
 }
 
 // +++++++++++++++++++++++++++++++++++=
@@ -214,31 +250,46 @@ ChatPanel::~ChatPanel()
 
 void ChatPanel::removeMessagesFrom(const QString &userName)
 {
-    // remove message panels from user 'userName'
-    QList<ChatMessagePanel *> panels = ui->scrollContent->findChildren<ChatMessagePanel *>();
-    foreach (ChatMessagePanel *msgPanel, panels) {
-        if (msgPanel->getUserName() == userName ) {
-            ui->scrollContent->layout()->removeWidget(msgPanel);
-            msgPanel->deleteLater();
-        }
-    }
+    messagesModel->removeMessagesFrom(userName);
 }
 
-void ChatPanel::clearMessages()
+QColor ChatPanel::getMessageBorderColor() const
 {
-    // remove message panels
-    QList<ChatMessagePanel *> panels = ui->scrollContent->findChildren<ChatMessagePanel *>();
-    foreach (ChatMessagePanel *msgPanel, panels) {
-        ui->scrollContent->layout()->removeWidget(msgPanel);
-        msgPanel->deleteLater();
-    }
+    return messagesDelegate->getMessageBorderColor();
+}
 
-    // remove Vote and 'load chords' buttons
-    QList<QPushButton *> buttons = ui->scrollContent->findChildren<QPushButton *>();
-    foreach (QPushButton *button, buttons) {
-        ui->scrollContent->layout()->removeWidget(button);
-        button->deleteLater();
-    }
+void ChatPanel::setMessageBorderColor(const QColor &color)
+{
+    messagesDelegate->setMessageBorderColor(color);
+    ui->chatList->viewport()->update();
+}
+
+QColor ChatPanel::getMessageButtonBorderColor() const
+{
+    return messagesDelegate->getButtonBorderColor();
+}
+
+void ChatPanel::setMessageButtonBorderColor(const QColor &color)
+{
+    messagesDelegate->setButtonBorderColor(color);
+    ui->chatList->viewport()->update();
+}
+
+QColor ChatPanel::getMessageActiveButtonBorderColor() const
+{
+    return messagesDelegate->getActiveButtonBorderColor();
+}
+
+void ChatPanel::setMessageActiveButtonBorderColor(const QColor &color)
+{
+    messagesDelegate->setActiveButtonBorderColor(color);
+    ui->chatList->viewport()->update();
+}
+
+void ChatPanel::clearMessages()
+{
+    messagesModel->clear(); // messages, vote and 'load chords' buttons
+    messagesDelegate->clearCache();
 }
 
 void ChatPanel::setPreferredTranslationLanguage(const QString &targetLanguage)
@@ -247,13 +298,7 @@ void ChatPanel::setPreferredTranslationLanguage(const QString &targetLanguage)
     if (languageCode.size() > 2) {
         languageCode = targetLanguage.left(2); //using just the 2 first letters in lower case
     }
-    if (languageCode != autoTranslationLanguage) {
-        autoTranslationLanguage = languageCode;
-        QList<ChatMessagePanel *> panels = ui->scrollContent->findChildren<ChatMessagePanel *>();
-        foreach (ChatMessagePanel *msgPanel, panels) {
-            msgPanel->setPrefferedTranslationLanguage(languageCode);
-        }
-    }
+    autoTranslationLanguage = languageCode;
 }
 
 void ChatPanel::toggleAutoTranslate()
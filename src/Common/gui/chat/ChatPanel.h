@@ -2,23 +2,28 @@
 #define CHATPANEL_H
 
 #include <QWidget>
-#include <QMap>
-#include <QPushButton>
-#include <QList>
 #include <QTimer>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
 #include "chords/ChordProgression.h"
 #include "UsersColorsPool.h"
+#include "ChatMessagesModel.h"
 
 namespace Ui {
 class ChatPanel;
 }
 
-class ChatMessagePanel;
+class ChatMessageDelegate;
 
 class ChatPanel : public QWidget
 {
     Q_OBJECT
 
+    // the messages are painted by ChatMessageDelegate, the themes set these colors using 'qproperty-' in Chat.css
+    Q_PROPERTY(QColor messageBorderColor READ getMessageBorderColor WRITE setMessageBorderColor)
+    Q_PROPERTY(QColor messageButtonBorderColor READ getMessageButtonBorderColor WRITE setMessageButtonBorderColor)
+    Q_PROPERTY(QColor messageActiveButtonBorderColor READ getMessageActiveButtonBorderColor WRITE setMessageActiveButtonBorderColor)
+
 public:
     ChatPanel(const QStringList &botNames, UsersColorsPool *colorsPool);
     virtual ~ChatPanel();
@@ -31,6 +36,13 @@ public:
     void updateMessagesGeometry();// called when user switch from mini mode to full view
     void removeMessagesFrom(const QString &userName);
 
+    QColor getMessageBorderColor() const;
+    void setMessageBorderColor(const QColor &color);
+    QColor getMessageButtonBorderColor() const;
+    void setMessageButtonBorderColor(const QColor &color);
+    QColor getMessageActiveButtonBorderColor() const;
+    void setMessageActiveButtonBorderColor(const QColor &color);
+
 signals:
     void userSendingNewMessage(const QString &msg);
     void userConfirmingVoteToBpiChange(int newBpi);
@@ -43,9 +55,11 @@ private slots:
     void autoScroll(int min, int max);
     void clearMessages();
 
-    void confirmVote();
-    void confirmChordProgression();
     void toggleAutoTranslate();
+    void toggleTranslation(quint64 messageID);
+    void confirmMessageAction(quint64 messageID); // vote and chord progression buttons
+
+    void setTranslatedMessage(QNetworkReply *reply);
 
     void showTranslationProgressFeedback();
     void hideTranslationProgressFeedback();
@@ -60,74 +74,19 @@ private:
     QStringList botNames;
     static const QColor BOT_COLOR;
 
-    static const int MAX_MESSAGES = 50;
-
     QString autoTranslationLanguage;
 
-    void createVoteButton(const QString &voteType, quint32 value, quint32 expireTime);
+    void addVoteButton(ChatMessage::Type voteType, quint32 value, quint32 expireTime);
 
     bool autoTranslating;
 
-    void addMessagePanelInLayout(ChatMessagePanel *msgPanel);
-
-    UsersColorsPool *colorsPool;
-};
-
-class NinjamVoteButton : public QPushButton
-{
-    Q_OBJECT
-
-public:
-    NinjamVoteButton(QString voteType, quint32 voteValue, quint32 expireTime) :
-        voteValue(voteValue),
-        voteType(voteType)
-    {
-        setObjectName("voteButton");
-
-        QString label = tr("Vote - change %1 to %2 ").arg(voteType).arg(QString::number(voteValue));
-        setText(label);
-
-        QTimer::singleShot(expireTime * 1000, this, SLOT(hide()));
-    }
+    ChatMessagesModel *messagesModel;
+    ChatMessageDelegate *messagesDelegate;
 
-    inline int getVoteValue() const
-    {
-        return voteValue;
-    }
+    QNetworkAccessManager *translationClient;
+    void translate(quint64 messageID);
 
-    inline bool isBpiVote() const
-    {
-        return voteType == "BPI";
-    }
-
-    inline bool isBpmVote() const
-    {
-        return voteType == "BPM";
-    }
-
-private:
-    quint32 voteValue;
-    QString voteType;
-};
-
-class ChordProgressionConfirmationButton : public QPushButton
-{
-    Q_OBJECT
-
-public:
-    ChordProgressionConfirmationButton(QString text, ChordProgression progression) :
-        QPushButton(text),
-        progression(progression)
-    {
-    }
-
-    inline ChordProgression getChordProgression() const
-    {
-        return progression;
-    }
-
-private:
-    ChordProgression progression;
+    UsersColorsPool *colorsPool;
 };
 
 #endif // CHATPANEL_H
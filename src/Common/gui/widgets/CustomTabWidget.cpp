@@ -8,24 +8,33 @@ QColor CustomTabWidget::RESOURCES_USAGE_TEXT_COLOR = QColor(255, 255, 255, 160);
 CustomTabWidget::CustomTabWidget(QWidget *parent) :
     QTabWidget(parent),
     cpuUsage(0),
-    memoryUsage(0)
+    memoryUsage(0),
+    dspLoad(0)
 {
 }
 
-void CustomTabWidget::setResourcesUsage(double cpuUsage, int memoryUsage)
+void CustomTabWidget::setResourcesUsage(double cpuUsage, int memoryUsage, double dspLoad)
 {
     this->cpuUsage = cpuUsage;
     this->memoryUsage = memoryUsage;
-    repaint();
+    this->dspLoad = dspLoad;
+    update();
 }
 
-/*
 void CustomTabWidget::paintEvent(QPaintEvent *e){
     QTabWidget::paintEvent(e);
 
     QPainter painter(this);
     //draw the cpu/memory usage background
-    QString string = "CPU: " + QString::number(cpuUsage, 'f', 1) + "%  MEM: " + QString::number(memoryUsage) + " MB";
+    //the cpu and memory usage are negative when the platform performance monitor can't sample them
+    QString string;
+    if(cpuUsage >= 0){
+        string += "CPU: " + QString::number(cpuUsage, 'f', 1) + "%  ";
+    }
+    if(memoryUsage >= 0){
+        string += "MEM: " + QString::number(memoryUsage) + " MB  ";
+    }
+    string += "DSP: " + QString::number(dspLoad, 'f', 0) + "%";
     const int H_MARGIM = 3;
     const int V_MARGIM = 2;
     const int ROUND = 3;
@@ -44,4 +53,3 @@ void CustomTabWidget::paintEvent(QPaintEvent *e){
     painter.drawText(x + H_MARGIM, textY, string);
 
 }
-*/
@@ -7,13 +7,16 @@ class CustomTabWidget : public QTabWidget
 {
 public:
     explicit CustomTabWidget(QWidget *parent);
-    void setResourcesUsage(double cpuUsage, int memoryUsage);// cpu usage in percentage, memoryUsage in megabytes
+    void setResourcesUsage(double cpuUsage, int memoryUsage, double dspLoad);// cpu usage and dsp load in percentage, memoryUsage in megabytes, negative cpu and memory usage are not showed
+protected:
+    void paintEvent(QPaintEvent *) override;
 private:
     static QColor RESOURCES_USAGE_BG_COLOR;
     static QColor RESOURCES_USAGE_TEXT_COLOR;
 
     double cpuUsage;
     int memoryUsage;
+    double dspLoad;
 };
 
 #endif // CUSTOMTABWIDGET_H
@@ -17,6 +17,7 @@ void PlayerLabel::updateText(const Geo::Location &location)
     QString userName = userInfo.getName();
 
     setText(imgHTML + userName + countryNameHTML);
+    setToolTip(getToolTipText(location, userName));
 }
 
 void PlayerLabel::setLocation(const Geo::Location &newLocation)
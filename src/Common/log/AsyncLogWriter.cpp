@@ -0,0 +1,274 @@
+#include "AsyncLogWriter.h"
+
+#include <QTextStream>
+#include <QHash>
+#include <QDir>
+
+AsyncLogWriter::AsyncLogWriter(const QString &logFilePath, bool echoToStdout) :
+    queue(new Slot[QUEUE_CAPACITY]),
+    enqueuePosition(0),
+    dequeuePosition(0),
+    callSites(new CallSite[CALL_SITES]),
+    droppedMessages(0),
+    reportedDroppedMessages(0),
+    stopRequested(0),
+    file(logFilePath),
+    echoToStdout(echoToStdout)
+{
+    for (int i = 0; i < QUEUE_CAPACITY; ++i)
+        queue[i].sequence.store(i);
+
+    for (int i = 0; i < CALL_SITES; ++i)
+        initCallSite(callSites[i]);
+
+    initCallSite(overflowCallSite);
+
+    clock.start();
+
+    file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text);
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    stop();
+    flush();
+
+    delete [] queue;
+    delete [] callSites;
+}
+
+void AsyncLogWriter::initCallSite(CallSite &callSite)
+{
+    callSite.state.store(EMPTY_CALL_SITE);
+    callSite.hash = 0;
+    callSite.file = nullptr;
+    callSite.line = 0;
+    callSite.window.store(-1);
+    callSite.messages.store(0);
+    callSite.suppressedMessages.store(0);
+}
+
+void AsyncLogWriter::stop()
+{
+    stopRequested.store(1);
+    wait(); // the queue and the file are used by the writer thread until run() is finished
+}
+
+void AsyncLogWriter::run()
+{
+    while (!stopRequested.load()) {
+        writePendingRecords();
+        msleep(FLUSH_INTERVAL);
+    }
+    writePendingRecords();
+}
+
+void AsyncLogWriter::flush()
+{
+    writePendingRecords();
+}
+
+qint64 AsyncLogWriter::now() const
+{
+    return clock.elapsed();
+}
+
+AsyncLogWriter::CallSite &AsyncLogWriter::findCallSite(const char *file, int line)
+{
+    uint hash = qHash(QLatin1String(file)) ^ (uint)(line * 31);
+    for (int probe = 0; probe < MAX_CALL_SITE_PROBES; ++probe) {
+        CallSite &callSite = callSites[(hash + probe) & (CALL_SITES - 1)];
+        int state = callSite.state.loadAcquire();
+        if (state == EMPTY_CALL_SITE) {
+            if (callSite.state.testAndSetAcquire(EMPTY_CALL_SITE, CLAIMED_CALL_SITE)) {
+                callSite.hash = hash;
+                callSite.file = file;
+                callSite.line = line;
+                callSite.state.storeRelease(READY_CALL_SITE);
+                return callSite;
+            }
+            state = callSite.state.loadAcquire();
+        }
+
+        while (state == CLAIMED_CALL_SITE) // another thread is writing the key, only 3 stores
+            state = callSite.state.loadAcquire();
+
+        // the same source file can have different pointers (one per translation unit), the strings are compared
+        if (callSite.hash == hash && callSite.line == line && qstrcmp(callSite.file, file) == 0)
+            return callSite;
+    }
+    return overflowCallSite;
+}
+
+int AsyncLogWriter::acquireCallSiteQuota(const QMessageLogContext &context, const QString &message)
+{
+    // in release builds the context file and line are not available (QT_NO_MESSAGELOGCONTEXT), the category and the message start are used to identify the call site
+    CallSite &callSite = context.file ? findCallSite(context.file, context.line)
+                                      : findCallSite(context.category, (int)qHash(QStringRef(&message, 0, qMin(message.size(), 24))));
+
+    int window = (int)(now() / RATE_LIMIT_WINDOW);
+    int callSiteWindow = callSite.window.load();
+    if (callSiteWindow != window && callSite.window.testAndSetOrdered(callSiteWindow, window))
+        callSite.messages.store(0);
+
+    if (callSite.messages.fetchAndAddOrdered(1) >= MAX_MESSAGES_PER_CALL_SITE) {
+        callSite.suppressedMessages.ref();
+        return -1;
+    }
+
+    return callSite.suppressedMessages.fetchAndStoreOrdered(0);
+}
+
+bool AsyncLogWriter::log(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    int suppressedMessages = 0;
+    if (type != QtFatalMsg) {
+        suppressedMessages = acquireCallSiteQuota(context, message);
+        if (suppressedMessages < 0)
+            return false;
+    }
+
+    // bounded multiple producers queue, see http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+    uint position = enqueuePosition.load();
+    Slot *slot = nullptr;
+    forever {
+        slot = &queue[position & (QUEUE_CAPACITY - 1)];
+        int difference = (int)((uint)slot->sequence.loadAcquire() - position);
+        if (difference == 0) {
+            if (enqueuePosition.testAndSetRelaxed((int)position, (int)(position + 1)))
+                break;
+        } else if (difference < 0) { // queue is full
+            droppedMessages.ref();
+            return false;
+        }
+        position = enqueuePosition.load();
+    }
+
+    Record &record = slot->record;
+    record.type = type;
+    record.category = context.category;
+    record.file = context.file;
+    record.function = context.function;
+    record.line = context.line;
+    record.suppressedMessages = suppressedMessages;
+    record.messageSize = toUtf8(message, record.message, MAX_MESSAGE_SIZE);
+
+    slot->sequence.storeRelease((int)(position + 1));
+    return true;
+}
+
+void AsyncLogWriter::writePendingRecords()
+{
+    QMutexLocker locker(&consumerMutex);
+
+    QString batch;
+    QTextStream stream(&batch);
+    forever {
+        Slot &slot = queue[dequeuePosition & (QUEUE_CAPACITY - 1)];
+        int difference = (int)((uint)slot.sequence.loadAcquire() - (dequeuePosition + 1));
+        if (difference < 0)
+            break; // empty
+
+        stream << format(slot.record);
+
+        slot.sequence.storeRelease((int)(dequeuePosition + QUEUE_CAPACITY));
+        dequeuePosition++;
+    }
+
+    int dropped = droppedMessages.load();
+    if (dropped != reportedDroppedMessages) {
+        stream << "jt.Log.WARNING:  " << (dropped - reportedDroppedMessages) << " log messages dropped, the log queue was full" << endl;
+        reportedDroppedMessages = dropped;
+    }
+
+    stream.flush();
+    if (batch.isEmpty())
+        return;
+
+    if (echoToStdout)
+        QTextStream(stdout) << batch;
+
+    if (file.isOpen()) {
+        file.write(batch.toUtf8());
+        file.flush();
+    }
+}
+
+int AsyncLogWriter::toUtf8(const QString &string, char *out, int maxSize)
+{
+    const ushort *utf16 = string.utf16();
+    int size = 0;
+    for (int i = 0; i < string.size(); ++i) {
+        uint codePoint = utf16[i];
+        if (QChar::isHighSurrogate(codePoint) && i + 1 < string.size() && QChar::isLowSurrogate(utf16[i + 1]))
+            codePoint = QChar::surrogateToUcs4(codePoint, utf16[++i]);
+
+        char bytes[4];
+        int bytesCount;
+        if (codePoint < 0x80) {
+            bytes[0] = (char)codePoint;
+            bytesCount = 1;
+        } else if (codePoint < 0x800) {
+            bytes[0] = (char)(0xC0 | (codePoint >> 6));
+            bytes[1] = (char)(0x80 | (codePoint & 0x3F));
+            bytesCount = 2;
+        } else if (codePoint < 0x10000) {
+            bytes[0] = (char)(0xE0 | (codePoint >> 12));
+            bytes[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+            bytes[2] = (char)(0x80 | (codePoint & 0x3F));
+            bytesCount = 3;
+        } else {
+            bytes[0] = (char)(0xF0 | (codePoint >> 18));
+            bytes[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+            bytes[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+            bytes[3] = (char)(0x80 | (codePoint & 0x3F));
+            bytesCount = 4;
+        }
+
+        if (size + bytesCount > maxSize)
+            break; // truncated, but never in the middle of a character
+
+        for (int b = 0; b < bytesCount; ++b)
+            out[size++] = bytes[b];
+    }
+    return size;
+}
+
+QString AsyncLogWriter::format(const Record &record)
+{
+    QString fullFileName(record.file);
+    QString file;
+    int lastPathSeparatorIndex = fullFileName.lastIndexOf(QDir::separator());
+    if (lastPathSeparatorIndex)
+        file = fullFileName.right(fullFileName.size() - lastPathSeparatorIndex - 1);
+    else
+        file = fullFileName;
+
+    QString message = QString::fromUtf8(record.message, record.messageSize);
+    if (record.suppressedMessages > 0)
+        message += QString(" (%1 similar messages suppressed)").arg(record.suppressedMessages);
+
+    QString stringMsg;
+    QTextStream stream(&stringMsg);
+    switch (record.type) {
+    case QtDebugMsg:
+        stream << record.category << ".DEBUG:  " << message << " "  << " in "
+               << file << " " << record.line << endl;
+        break;
+    case QtWarningMsg:
+        stream << record.category << ".WARNING:  " << message <<  record.function
+               <<  " " << file << record.line << endl << endl;
+        break;
+    case QtCriticalMsg:
+        stream << record.category << ".CRITICAL:  " << message <<  record.function
+               << " " << file << record.line << endl << endl;
+        break;
+    case QtFatalMsg:
+        stream << record.category  << ".FATAL:  " << message << record.function
+               << file << record.line << endl << endl;
+        break;
+    default:
+        stream << record.category << ".INFO:  " << message << endl;
+    }
+    return stringMsg;
+}
@@ -0,0 +1,116 @@
+#ifndef ASYNC_LOG_WRITER_H
+#define ASYNC_LOG_WRITER_H
+
+#include <QThread>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QMessageLogContext>
+#include <QMutex>
+#include <QFile>
+
+/**
+ * Log backend used by the Jamtaba message handler. The log messages are copied in fixed size
+ * records and pushed in a lock free queue, so the audio and network threads never wait for the
+ * disk or console. A background thread formats the records and writes them in batches.
+ *
+ * Each call site (source file and line) can log MAX_MESSAGES_PER_CALL_SITE messages in each
+ * RATE_LIMIT_WINDOW, the exceeding messages are counted and reported in the next logged message.
+ * The call sites are stored in an open addressing table and compared by the full key, two call
+ * sites share the rate limit only when the table is full.
+ */
+
+class AsyncLogWriter : public QThread
+{
+public:
+    explicit AsyncLogWriter(const QString &logFilePath, bool echoToStdout = true);
+    ~AsyncLogWriter(); // stop the writer thread and write the pending records
+
+    bool log(QtMsgType type, const QMessageLogContext &context, const QString &message); // lock free, return false if the message is discarded
+
+    void flush(); // write the pending records in the caller thread (used before abort in fatal messages)
+
+    void stop(); // wait until the writer thread is finished
+
+    inline int getDroppedMessages() const
+    {
+        return droppedMessages.load();
+    }
+
+    static const int QUEUE_CAPACITY = 2048; // records, must be a power of two
+    static const int MAX_MESSAGE_SIZE = 480; // utf8 bytes, the long messages are truncated
+    static const int MAX_MESSAGES_PER_CALL_SITE = 20;
+    static const int RATE_LIMIT_WINDOW = 1000; // milliseconds
+    static const int FLUSH_INTERVAL = 100; // milliseconds
+
+protected:
+    void run() override;
+
+    virtual qint64 now() const; // milliseconds, used by the rate limiter
+
+private:
+    struct Record
+    {
+        QtMsgType type;
+        const char *category; // the context strings are static, only the pointers are copied
+        const char *file;
+        const char *function;
+        int line;
+        int suppressedMessages; // messages suppressed by the rate limiter before this message
+        int messageSize;
+        char message[MAX_MESSAGE_SIZE];
+    };
+
+    struct Slot
+    {
+        QAtomicInt sequence;
+        Record record;
+    };
+
+    struct CallSite
+    {
+        QAtomicInt state; // empty, claimed (the key is written) or ready
+        uint hash;
+        const char *file; // the category name when the context file is not available
+        int line; // the message start hash when the context file is not available
+        QAtomicInt window;
+        QAtomicInt messages;
+        QAtomicInt suppressedMessages;
+    };
+
+    enum CallSiteState
+    {
+        EMPTY_CALL_SITE,
+        CLAIMED_CALL_SITE,
+        READY_CALL_SITE
+    };
+
+    static const int CALL_SITES = 4096; // must be a power of two
+    static const int MAX_CALL_SITE_PROBES = 32; // the call sites not found in the probes share the overflow call site
+
+    Slot *queue;
+    QAtomicInt enqueuePosition;
+    uint dequeuePosition;
+    QMutex consumerMutex; // the writer thread and flush() are consumers
+
+    CallSite *callSites;
+    CallSite overflowCallSite;
+    QElapsedTimer clock;
+
+    QAtomicInt droppedMessages; // the queue was full
+    int reportedDroppedMessages;
+
+    QAtomicInt stopRequested;
+
+    QFile file;
+    bool echoToStdout;
+
+    int acquireCallSiteQuota(const QMessageLogContext &context, const QString &message); // return the suppressed messages or -1 when the quota is exhausted
+    CallSite &findCallSite(const char *file, int line); // lock free, the call site is created in the first message
+    static void initCallSite(CallSite &callSite);
+    void writePendingRecords();
+
+    static int toUtf8(const QString &string, char *out, int maxSize); // no allocations
+    static QString format(const Record &record);
+};
+
+#endif // ASYNC_LOG_WRITER_H
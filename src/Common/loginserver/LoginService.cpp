@@ -6,7 +6,7 @@
 #include <QUrlQuery>
 #include <QTimer>
 #include <QDebug>
-#include <QApplication>
+#include <QEventLoop>
 #include "ninjam/Server.h"
 #include "ninjam/Service.h"
 #include "log/Logging.h"
@@ -24,6 +24,11 @@ UserInfo::UserInfo(long long id, const QString &name, const QString &ip) :
 {
 }
 
+bool UserInfo::operator==(const UserInfo &other) const
+{
+    return id == other.id && name == other.name && ip == other.ip;
+}
+
 RoomInfo::RoomInfo(long long id, const QString &roomName, int roomPort, RoomTYPE roomType,
                    int maxUsers, const QList<UserInfo> &users, int maxChannels, int bpi, int bpm, const QString &streamUrl) :
     id(id),
@@ -86,6 +91,62 @@ bool RoomInfo::isEmpty() const
     return true;
 }
 
+bool RoomInfo::hasSameSettings(const RoomInfo &other) const
+{
+    return id == other.id && name == other.name && port == other.port && type == other.type
+           && maxUsers == other.maxUsers && maxChannels == other.maxChannels
+           && streamUrl == other.streamUrl && bpi == other.bpi && bpm == other.bpm;
+}
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+RoomsListChanges::RoomsListChanges()
+{
+}
+
+bool RoomsListChanges::isEmpty() const
+{
+    return addedRooms.isEmpty() && changedRooms.isEmpty() && removedRooms.isEmpty();
+}
+
+RoomsListChanges RoomsListChanges::compute(const QList<RoomInfo> &previousRooms, const QList<RoomInfo> &currentRooms)
+{
+    QMap<long long, int> previousIndexes;
+    for (int i = 0; i < previousRooms.size(); ++i)
+        previousIndexes.insert(previousRooms.at(i).getID(), i);
+
+    RoomsListChanges changes;
+    foreach (const RoomInfo &room, currentRooms) {
+        int previousIndex = previousIndexes.value(room.getID(), -1);
+        if (previousIndex < 0) {
+            changes.addedRooms.append(room);
+            continue;
+        }
+        previousIndexes.remove(room.getID());
+
+        // the users order is not relevant, and the same user (a bot, for example) can be listed more than one time
+        const RoomInfo &previousRoom = previousRooms.at(previousIndex);
+        QList<UserInfo> leftUsers = previousRoom.getUsers();
+        QList<UserInfo> joinedUsers;
+        foreach (const UserInfo &user, room.getUsers()) {
+            if (!leftUsers.removeOne(user))
+                joinedUsers.append(user);
+        }
+
+        if (!joinedUsers.isEmpty() || !leftUsers.isEmpty() || !room.hasSameSettings(previousRoom)) {
+            changes.changedRooms.append(room);
+            if (!joinedUsers.isEmpty())
+                changes.joinedUsers.insert(room.getID(), joinedUsers);
+            if (!leftUsers.isEmpty())
+                changes.leftUsers.insert(room.getID(), leftUsers);
+        }
+    }
+
+    foreach (int previousIndex, previousIndexes.values())
+        changes.removedRooms.append(previousRooms.at(previousIndex));
+
+    return changes;
+}
+
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 class HttpParamsFactory
 {
@@ -140,10 +201,11 @@ LoginService::LoginService(QObject *parent) :
     QObject(parent),
     httpClient(new QNetworkAccessManager(this)),
     pendingReply(nullptr),
+    serverUrl(SERVER),
     connected(false),
     refreshTimer(new QTimer(this))
 {
-    QObject::connect(refreshTimer, SIGNAL(timeout()), this, SLOT(refreshTimerSlot()));
+    QObject::connect(refreshTimer, SIGNAL(timeout()), this, SLOT(refreshRoomsList()));
     // QObject::connect(&httpClient, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), this, SLOT(sslErrorsSlot(QNetworkReply*,QList<QSslError>)));
 }
 
@@ -173,7 +235,12 @@ void LoginService::connectInServer(const QString &userName, int instrumentID,
     }
 }
 
-void LoginService::refreshTimerSlot()
+void LoginService::setServerUrl(const QString &serverUrl)
+{
+    this->serverUrl = serverUrl;
+}
+
+void LoginService::refreshRoomsList()
 {
     QUrlQuery query = HttpParamsFactory::createParametersToRefreshRoomsList();
     pendingReply = sendCommandToServer(query);
@@ -211,7 +278,7 @@ QNetworkReply *LoginService::sendCommandToServer(const QUrlQuery &query, bool sy
         pendingReply->deleteLater();
     }
 
-    QUrl url(SERVER);
+    QUrl url(serverUrl);
     QByteArray postData(query.toString(QUrl::EncodeUnicode).toStdString().c_str());
     QNetworkRequest request(url);
     request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);// disable cache
@@ -301,15 +368,23 @@ void LoginService::connectedSlot()
 
 void LoginService::roomsListReceivedSlot()
 {
-    QString json = QString(pendingReply->readAll());
-    handleJson(json);
+    handleJson(pendingReply->readAll());
 }
 
-void LoginService::handleJson(const QString &json)
+void LoginService::handleJson(const QByteArray &json)
 {
     if (json.isEmpty())
         return;
-    QJsonDocument document = QJsonDocument::fromJson(QByteArray(json.toStdString().c_str()));
+
+    if (connected && json == lastRoomsListJson)
+        return; // nothing changed since the last refresh
+
+    QJsonParseError parseError;
+    QJsonDocument document = QJsonDocument::fromJson(json, &parseError);
+    if (!document.isObject()) {
+        qCWarning(jtLoginService) << "Invalid rooms list received:" << parseError.errorString();
+        return; // the last rooms list is preserved
+    }
     QJsonObject root = document.object();
     if (!connected) {// first time handling json?
         bool clientIsServerCompatible = root["clientCompatibility"].toBool();
@@ -327,11 +402,11 @@ void LoginService::handleJson(const QString &json)
     }
 
     QJsonArray allRooms = root["rooms"].toArray();
-    QList<RoomInfo> publicRooms;
+    QList<RoomInfo> receivedRooms;
     for (int i = 0; i < allRooms.size(); ++i) {
         QJsonObject jsonObject = allRooms[i].toObject();
         Login::RoomInfo roomInfo = buildRoomInfoFromJson(jsonObject);
-        publicRooms.append(roomInfo);
+        receivedRooms.append(roomInfo);
 
         QString lastChordProgression = "" ; //store an empty chord progression by default
         if (jsonObject.contains("lastChordProgression"))
@@ -339,7 +414,17 @@ void LoginService::handleJson(const QString &json)
         QString key = getRoomInfoUniqueName(roomInfo);
         lastChordProgressions.insert(key, lastChordProgression);
     }
-    emit roomsListAvailable(publicRooms);
+
+    RoomsListChanges changes = RoomsListChanges::compute(publicRooms, receivedRooms);
+    publicRooms = receivedRooms;
+    lastRoomsListJson = json;
+
+    if (!changes.isEmpty()) {
+        qCDebug(jtLoginService) << "Rooms list changed:" << changes.getAddedRooms().size() << "added,"
+                                << changes.getChangedRooms().size() << "changed,"
+                                << changes.getRemovedRooms().size() << "removed";
+        emit roomsListChanged(changes);
+    }
 }
 
 QString LoginService::getChordProgressionFor(const RoomInfo &roomInfo) const
@@ -25,6 +25,13 @@ public:
         return name;
     }
 
+    inline long long getId() const
+    {
+        return id;
+    }
+
+    bool operator==(const UserInfo &other) const;
+
 private:
     long long id;
     QString name;
@@ -109,6 +116,8 @@ public:
         return bpi;
     }
 
+    bool hasSameSettings(const RoomInfo &other) const; // compare everything except the users
+
 protected:
     long long id;
     QString name;
@@ -122,6 +131,53 @@ protected:
     int bpm;
 };
 
+// +++++++++++++++++++++++++++++++++++++++++++++++++++
+/**
+ * The differences between two rooms lists received from the server. The rooms are matched by ID,
+ * a room is changed when the users or the settings (bpi, bpm, stream, etc.) are different.
+ */
+class RoomsListChanges
+{
+public:
+    RoomsListChanges();
+
+    static RoomsListChanges compute(const QList<RoomInfo> &previousRooms, const QList<RoomInfo> &currentRooms);
+
+    inline QList<RoomInfo> getAddedRooms() const
+    {
+        return addedRooms;
+    }
+
+    inline QList<RoomInfo> getChangedRooms() const // the new room infos
+    {
+        return changedRooms;
+    }
+
+    inline QList<RoomInfo> getRemovedRooms() const // the last received room infos
+    {
+        return removedRooms;
+    }
+
+    inline QList<UserInfo> getJoinedUsers(long long roomID) const
+    {
+        return joinedUsers.value(roomID);
+    }
+
+    inline QList<UserInfo> getLeftUsers(long long roomID) const
+    {
+        return leftUsers.value(roomID);
+    }
+
+    bool isEmpty() const;
+
+private:
+    QList<RoomInfo> addedRooms;
+    QList<RoomInfo> changedRooms;
+    QList<RoomInfo> removedRooms;
+    QMap<long long, QList<UserInfo> > joinedUsers;
+    QMap<long long, QList<UserInfo> > leftUsers;
+};
+
 // +++++++++++++++++++++++++++++++++++++++++++++++++++
 class LoginService : public QObject
 {
@@ -140,14 +196,24 @@ public:
         return connected;
     }
 
+    inline QList<Login::RoomInfo> getPublicRooms() const // the last received rooms list
+    {
+        return publicRooms;
+    }
+
+    void setServerUrl(const QString &serverUrl); // used to connect in a local server
+
     QString getChordProgressionFor(const Login::RoomInfo &roomInfo) const;
     void sendChordProgressionToServer(const QString &userName,
                                       const QString serverName,
                                       quint32 serverPort,
                                       const QString &chordProgression);
 
+public slots:
+    void refreshRoomsList();
+
 signals:
-    void roomsListAvailable(const QList<Login::RoomInfo> &publicRooms);
+    void roomsListChanged(const Login::RoomsListChanges &changes); // not emitted when the rooms list is not changed
     void incompatibilityWithServerDetected();
     void newVersionAvailableForDownload();
     void errorWhenConnectingToServer(const QString &error);
@@ -161,8 +227,12 @@ private:
     QNetworkReply *pendingReply;
     QNetworkReply *sendCommandToServer(const QUrlQuery &, bool synchronous = false);
     static const QString SERVER;
+    QString serverUrl;
     bool connected;
-    void handleJson(const QString &json);
+    void handleJson(const QByteArray &json);
+
+    QList<RoomInfo> publicRooms;
+    QByteArray lastRoomsListJson; // the json is not parsed again when the rooms list is not changed
 
     RoomInfo buildRoomInfoFromJson(const QJsonObject &json);
 
@@ -178,9 +248,9 @@ private slots:
 
     void errorSlot(QNetworkReply::NetworkError error);
     void connectNetworkReplySlots(QNetworkReply *reply, Command command);
-
-    void refreshTimerSlot();
 };
 }
 
+Q_DECLARE_METATYPE(Login::RoomsListChanges)
+
 #endif
@@ -4,6 +4,7 @@
 #include <QIODevice>
 #include <QDebug>
 #include <QDataStream>
+#include <algorithm>
 
 using namespace Ninjam;
 
@@ -210,6 +211,11 @@ ClientUploadIntervalBegin::ClientUploadIntervalBegin(const QByteArray &GUID, qui
       channelIndex(channelIndex),
       userName(userName)
 {
+    if (GUID.count('\0') == GUID.size()) { // empty interval (silence), the fourCC is zeroed too
+        std::fill(fourCC, fourCC + 4, 0);
+        return;
+    }
+
 	fourCC[0] = 'O';
 	fourCC[1] = 'G';
 	fourCC[2] = 'G';
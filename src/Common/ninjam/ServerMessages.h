@@ -294,6 +294,12 @@ public:
         return fourCC[0] == 0 && fourCC[3] == 0;
     }
 
+    // empty interval (zeroed fourCC), the NINJAM clients are sending empty intervals for silence
+    inline bool isSilentInterval() const
+    {
+        return fourCC[0] == 0 && fourCC[1] == 0 && fourCC[2] == 0 && fourCC[3] == 0;
+    }
+
 private:
     QByteArray GUID;
     quint32 estimatedSize;
@@ -126,6 +126,20 @@ void Service::sendAudioIntervalBegin(const QByteArray &GUID, quint8 channelIndex
         return;
     sendMessageToServer(ClientUploadIntervalBegin(GUID, channelIndex, this->userName));
 }
+
+qint64 Service::getUploadBacklog() const
+{
+    return socket ? socket->bytesToWrite() : 0;
+}
+
+void Service::sendSilentAudioInterval(quint8 channelIndex)
+{
+    qCDebug(jtNinjamProtocol) << "sending silent audio interval";
+    if (!initialized)
+        return;
+    // the zeroed GUID is an empty interval, no upload writes are sent
+    sendMessageToServer(ClientUploadIntervalBegin(QByteArray(16, 0), channelIndex, this->userName));
+}
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 
@@ -270,6 +284,12 @@ void Service::process(const UserInfoChangeNotifyMessage &msg)
 
 void Service::process(const DownloadIntervalBegin &msg)
 {
+    if (msg.isSilentInterval()) { // nothing to download, the interval is completed with no audio data
+        User user = currentServer->getUser(msg.getUserName());
+        emit audioIntervalCompleted(user, msg.getChannelIndex(), QByteArray());
+        return;
+    }
+
     if (!msg.downloadShouldBeStopped() && msg.isValidOggDownload()) {
         quint8 channelIndex = msg.getChannelIndex();
         QString userFullName = msg.getUserName();
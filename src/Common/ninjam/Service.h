@@ -51,6 +51,9 @@ public:
     // audio interval upload
     void sendAudioIntervalPart(const QByteArray &GUID, const QByteArray &encodedAudioBuffer, bool isLastPart);
     void sendAudioIntervalBegin(const QByteArray &GUID, quint8 channelIndex);
+    void sendSilentAudioInterval(quint8 channelIndex); // empty interval, the receivers play silence
+
+    qint64 getUploadBacklog() const; // bytes waiting to be written in the socket
 
     void sendNewChannelsListToServer(const QStringList &channelsNames);
     void sendRemovedChannelIndex(int removedChannelIndex);
@@ -80,7 +83,7 @@ signals:
     void userCountMessageReceived(quint32 users, quint32 maxUsers);
     void serverBpiChanged(quint16 currentBpi, quint16 lastBpi);
     void serverBpmChanged(quint16 currentBpm);
-    void audioIntervalCompleted(const Ninjam::User &user, quint8 channelIndex, const QByteArray &encodedAudioData);
+    void audioIntervalCompleted(const Ninjam::User &user, quint8 channelIndex, const QByteArray &encodedAudioData); // empty data in silent intervals
     void audioIntervalDownloading(const Ninjam::User &user, quint8 channelIndex, int bytesDownloaded);
     void disconnectedFromServer(const Ninjam::Server &server);
     void connectedInServer(const Ninjam::Server &server);
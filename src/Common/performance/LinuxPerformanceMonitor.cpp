@@ -0,0 +1,76 @@
+#include "PerformanceMonitor.h"
+#include "log/Logging.h"
+
+#include <QFile>
+#include <QByteArray>
+#include <QList>
+#include <unistd.h>
+#include <time.h>
+
+PerformanceMonitor::PerformanceMonitor()
+    : lastCpuTime(0),
+      lastSampleTime(0){
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    this->processorsCount = processors > 0 ? processors : 1;
+}
+
+PerformanceMonitor::~PerformanceMonitor(){
+
+}
+
+//the process user and system times are the fields 14 and 15 in /proc/self/stat (man proc)
+//the cpu and the sample times are in nanoseconds
+double PerformanceMonitor::getCpuUsage(){
+    QFile statFile("/proc/self/stat");
+    if(!statFile.open(QFile::ReadOnly)){
+        qWarning() << "Can't get cpu usage! /proc/self/stat can't be opened!";
+        return -1;
+    }
+
+    //the process name (field 2) is inside parenthesis and can contain spaces, the other fields are after the last ')'
+    QByteArray content = statFile.readAll();
+    int processNameEnd = content.lastIndexOf(')');
+    QList<QByteArray> fields = content.mid(processNameEnd + 2).split(' ');
+    const int UTIME_INDEX = 11;//field 14, the first field after the process name is the field 3
+    const int STIME_INDEX = 12;
+    if(processNameEnd < 0 || fields.size() <= STIME_INDEX){
+        return -1;
+    }
+
+    static const long TICKS_PER_SECOND = sysconf(_SC_CLK_TCK);
+    qint64 cpuTicks = fields.at(UTIME_INDEX).toLongLong() + fields.at(STIME_INDEX).toLongLong();
+    qint64 cpuTime = cpuTicks * 1000000000 / TICKS_PER_SECOND;
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    qint64 sampleTime = (qint64)now.tv_sec * 1000000000 + now.tv_nsec;
+
+    double percent = 0;
+    if(lastSampleTime > 0 && sampleTime > lastSampleTime){
+        percent = (double)(cpuTime - lastCpuTime) / (sampleTime - lastSampleTime) / this->processorsCount;
+    }
+    lastCpuTime = cpuTime;
+    lastSampleTime = sampleTime;
+    return percent * 100;
+}
+
+int PerformanceMonitor::getMemmoryUsage(){
+    //the resident set size is in the VmRSS line of /proc/self/status, in kB
+    QFile statusFile("/proc/self/status");
+    if(!statusFile.open(QFile::ReadOnly)){
+        qWarning() << "Can't get memory usage! /proc/self/status can't be opened!";
+        return -1;
+    }
+
+    while(!statusFile.atEnd()){
+        QByteArray line = statusFile.readLine();
+        if(line.startsWith("VmRSS:")){
+            QList<QByteArray> fields = line.simplified().split(' ');
+            if(fields.size() >= 2){
+                static const int DIVIDER = 1024;
+                return fields.at(1).toInt()/DIVIDER;
+            }
+        }
+    }
+    return -1;//VmRSS not found
+}
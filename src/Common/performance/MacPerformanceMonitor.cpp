@@ -1,7 +1,11 @@
 #include "PerformanceMonitor.h"
 
+//the cpu and memory usage are not implemented in Mac yet, the values are reported as not available
 
-PerformanceMonitor::PerformanceMonitor(){
+PerformanceMonitor::PerformanceMonitor()
+    : processorsCount(1),
+      lastCpuTime(0),
+      lastSampleTime(0){
 
 }
 
@@ -10,10 +14,9 @@ PerformanceMonitor::~PerformanceMonitor(){
 }
 
 double PerformanceMonitor::getCpuUsage(){
-    return 0;
+    return -1;
 }
 
 int PerformanceMonitor::getMemmoryUsage(){
-
-    return 0;
+    return -1;
 }
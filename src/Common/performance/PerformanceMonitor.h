@@ -3,17 +3,37 @@
 
 //this class is implemented in different files for multiplatform purposes.
 //The implementation files are WindowsPerformanceMonitor.cpp, MacPerformanceMonitor.cpp
-//and in the future LinuxPerformanceMonitor
+//and LinuxPerformanceMonitor.cpp
 //The correct implementation file is selected in Jamtaba-common.pri
 
+#include <QtGlobal>
+
 class PerformanceMonitor{
 public:
     explicit PerformanceMonitor();
     ~PerformanceMonitor();
-    int getMemmoryUsage();
-    double getCpuUsage();
+    int getMemmoryUsage();// -1 when not available in the platform
+    double getCpuUsage();// -1 when not available in the platform, zero in the first sample
+
+    struct ResourcesUsage{
+        double cpuUsage;// in percentage, negative when not available
+        int memoryUsage;// in megabytes, negative when not available
+    };
+
+    //sample the cpu and memory usage, the system calls can be slow so this function is called outside the GUI thread
+    inline ResourcesUsage getResourcesUsage(){
+        ResourcesUsage usage;
+        usage.cpuUsage = getCpuUsage();
+        usage.memoryUsage = getMemmoryUsage();
+        return usage;
+    }
+
 private:
     int processorsCount;
+
+    //the cpu usage is the process cpu time used between two samples, each monitor has your own samples
+    qint64 lastCpuTime;// process user + system time, in the platform unit
+    qint64 lastSampleTime;// in the same unit of lastCpuTime, zero before the first sample
 };
 
 #endif // PERFORMANCE_MONITOR_H
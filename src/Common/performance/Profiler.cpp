@@ -0,0 +1,223 @@
+#include "Profiler.h"
+#include "log/Logging.h"
+
+#include <QFile>
+#include <QTextStream>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicPointer>
+#include <chrono>
+
+using namespace Profiling;
+
+namespace {
+
+// the events of one thread, written only by this thread and read only by the collector
+class ThreadRing
+{
+public:
+    ThreadRing() :
+        threadIndex(0),
+        events(new Event[Profiler::RING_CAPACITY]),
+        readPosition(0),
+        writePosition(0),
+        droppedEvents(0)
+    {
+    }
+
+    inline void write(const char *name, qint64 start, qint64 end, quintptr tag)
+    {
+        int write = writePosition.load();
+        int nextWrite = (write + 1) % Profiler::RING_CAPACITY;
+        if (nextWrite == readPosition.loadAcquire()) { // full
+            droppedEvents.ref();
+            return;
+        }
+
+        Event &event = events[write];
+        event.name = name;
+        event.start = start;
+        event.duration = end - start;
+        event.tag = tag;
+        event.threadIndex = threadIndex;
+        writePosition.storeRelease(nextWrite);
+    }
+
+    int drain(QVector<Event> &out)
+    {
+        int read = readPosition.load();
+        int write = writePosition.loadAcquire();
+        int drained = 0;
+        while (read != write) {
+            out.append(events[read]);
+            read = (read + 1) % Profiler::RING_CAPACITY;
+            drained++;
+        }
+        readPosition.storeRelease(read);
+        return drained;
+    }
+
+    inline int getDroppedEvents() const
+    {
+        return droppedEvents.load();
+    }
+
+    int threadIndex;
+
+private:
+    Event *events; // preallocated, never released (see bellow)
+    QAtomicInt readPosition;
+    QAtomicInt writePosition;
+    QAtomicInt droppedEvents;
+};
+
+// the rings are never released, the threads can finish while the collector is reading
+QAtomicPointer<ThreadRing> rings; // Profiler::MAX_THREADS rings, allocated when the profiler is enabled
+QAtomicInt claimedRings(0);
+QAtomicInt threadsWithoutRingEvents(0); // events dropped because all the rings were claimed
+QMutex drainMutex; // the consumers are locking, the instrumented threads never lock
+
+thread_local ThreadRing *threadRing = nullptr;
+thread_local bool threadRingUnavailable = false;
+
+// called in the first event of each instrumented thread, nothing is allocated here
+ThreadRing *claimThreadRing()
+{
+    ThreadRing *allRings = rings.loadAcquire();
+    if (!allRings)
+        return nullptr; // the profiler was never enabled
+
+    int index = claimedRings.fetchAndAddOrdered(1);
+    if (index >= Profiler::MAX_THREADS) {
+        threadRingUnavailable = true;
+        return nullptr;
+    }
+    return &allRings[index];
+}
+
+inline int getClaimedRings()
+{
+    return qMin(claimedRings.loadAcquire(), (int)Profiler::MAX_THREADS);
+}
+
+}
+
+QAtomicInt Profiler::enabled(0);
+
+void Profiler::setEnabled(bool enabled)
+{
+    if (enabled && !rings.loadAcquire()) {
+        ThreadRing *allRings = new ThreadRing[MAX_THREADS];
+        for (int i = 0; i < MAX_THREADS; ++i)
+            allRings[i].threadIndex = i;
+        rings.storeRelease(allRings);
+    }
+
+    Profiler::enabled.storeRelease(enabled ? 1 : 0);
+    qCInfo(jtCore) << "Profiler" << (enabled ? "enabled" : "disabled");
+}
+
+void Profiler::record(const char *name, qint64 start, qint64 end, quintptr tag)
+{
+    if (!threadRing) {
+        if (!threadRingUnavailable)
+            threadRing = claimThreadRing();
+        if (!threadRing) {
+            threadsWithoutRingEvents.ref();
+            return;
+        }
+    }
+
+    threadRing->write(name, start, end, tag);
+}
+
+int Profiler::drainEvents(QVector<Event> &out)
+{
+    QMutexLocker locker(&drainMutex);
+    ThreadRing *allRings = rings.loadAcquire();
+    int drained = 0;
+    for (int i = 0; allRings && i < getClaimedRings(); ++i)
+        drained += allRings[i].drain(out);
+    return drained;
+}
+
+int Profiler::getDroppedEvents()
+{
+    ThreadRing *allRings = rings.loadAcquire();
+    int dropped = threadsWithoutRingEvents.load();
+    for (int i = 0; allRings && i < getClaimedRings(); ++i)
+        dropped += allRings[i].getDroppedEvents();
+    return dropped;
+}
+
+qint64 Profiler::now()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// +++++++++++++++++++++++++++++++++++++++++++++
+
+TraceCollector::TraceCollector(QObject *parent) :
+    QObject(parent),
+    discardedEvents(0)
+{
+    timer.setInterval(250);
+    connect(&timer, SIGNAL(timeout()), this, SLOT(collect()));
+}
+
+void TraceCollector::start()
+{
+    timer.start();
+}
+
+void TraceCollector::stop()
+{
+    timer.stop();
+}
+
+void TraceCollector::collect()
+{
+    if (events.size() < MAX_EVENTS) {
+        Profiler::drainEvents(events);
+    } else {
+        QVector<Event> discarded;
+        discardedEvents += Profiler::drainEvents(discarded);
+    }
+}
+
+bool TraceCollector::writeChromeTrace(const QString &filePath)
+{
+    collect();
+
+    QFile file(filePath);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate | QFile::Text)) {
+        qCCritical(jtCore) << "Can't write the profiler trace file" << filePath;
+        return false;
+    }
+
+    qint64 firstTimestamp = events.isEmpty() ? 0 : events.first().start;
+    foreach (const Event &event, events)
+        firstTimestamp = qMin(firstTimestamp, event.start);
+
+    // https://github.com/catapult-project/catapult/wiki/Trace-Event-Format, the 'X' events are complete events (begin and duration)
+    QTextStream stream(&file);
+    stream << "{\"traceEvents\":[\n";
+    for (int i = 0; i < events.size(); ++i) {
+        const Event &event = events.at(i);
+        stream << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1"
+               << ",\"tid\":" << event.threadIndex
+               << ",\"ts\":" << QString::number((event.start - firstTimestamp) / 1000.0, 'f', 3)
+               << ",\"dur\":" << QString::number(event.duration / 1000.0, 'f', 3);
+        if (event.tag)
+            stream << ",\"args\":{\"instance\":\"0x" << QString::number(event.tag, 16) << "\"}";
+        stream << "}";
+        if (i < events.size() - 1)
+            stream << ",";
+        stream << "\n";
+    }
+    stream << "],\n\"otherData\":{\"droppedEvents\":" << (Profiler::getDroppedEvents() + discardedEvents) << "}}\n";
+
+    qCInfo(jtCore) << events.size() << "profiler events written in" << filePath;
+    return stream.status() == QTextStream::Ok;
+}
@@ -0,0 +1,133 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <QAtomicInt>
+#include <QObject>
+#include <QVector>
+#include <QTimer>
+
+/**
+ * Low overhead instrumentation for the audio hot path. The scoped timers write into
+ * per thread single producer/single consumer rings, so the instrumented threads never
+ * lock. When the profiler is disabled a timer costs one atomic load.
+ *
+ * The rings are allocated when the profiler is enabled the first time, each instrumented
+ * thread claims one ring in the first event with an atomic index. The events of the
+ * threads started after all the rings were claimed are dropped.
+ *
+ * The rings are drained by a TraceCollector (in the GUI thread) and the collected
+ * events can be exported as a Chrome trace file (chrome://tracing).
+ */
+
+namespace Profiling {
+
+struct Event
+{
+    const char *name; // always a static string
+    qint64 start; // steady clock, in nanoseconds
+    qint64 duration;
+    quintptr tag; // identify the instance (a node, a plugin, etc.), zero if not used
+    int threadIndex;
+};
+
+class Profiler
+{
+public:
+    static inline bool isEnabled()
+    {
+        return enabled.load() != 0;
+    }
+
+    static void setEnabled(bool enabled); // the first call enabling the profiler allocate the rings, not called in the audio thread
+
+    static void record(const char *name, qint64 start, qint64 end, quintptr tag); // lock free, called in the instrumented thread
+
+    static int drainEvents(QVector<Event> &out); // consumer side, return how many events were drained
+    static int getDroppedEvents(); // events lost because a thread ring was full or no ring was available
+
+    static qint64 now(); // steady clock timestamp in nanoseconds
+
+    static const int RING_CAPACITY = 16384; // events per thread
+    static const int MAX_THREADS = 16; // instrumented threads with a ring
+
+private:
+    static QAtomicInt enabled;
+};
+
+class ScopedTimer
+{
+public:
+    inline explicit ScopedTimer(const char *name, const void *instance = nullptr) :
+        name(name),
+        object(nullptr),
+        tag(reinterpret_cast<quintptr>(instance)),
+        start(Profiler::isEnabled() ? Profiler::now() : 0)
+    {
+    }
+
+    // the object class name is used as the timer name
+    inline explicit ScopedTimer(const QObject *object) :
+        name(nullptr),
+        object(object),
+        tag(reinterpret_cast<quintptr>(object)),
+        start(Profiler::isEnabled() ? Profiler::now() : 0)
+    {
+    }
+
+    inline ~ScopedTimer()
+    {
+        if (start)
+            Profiler::record(object ? object->metaObject()->className() : name, start, Profiler::now(), tag);
+    }
+
+private:
+    const char *name;
+    const QObject *object;
+    quintptr tag;
+    qint64 start;
+
+    Q_DISABLE_COPY(ScopedTimer)
+};
+
+// ++++++++++++++++++++++++++++++++++++++++
+
+class TraceCollector : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TraceCollector(QObject *parent = nullptr);
+
+    void start(); // start draining the profiler rings periodically
+    void stop();
+
+    bool writeChromeTrace(const QString &filePath); // drain the pending events and write the trace file
+
+    inline int getCollectedEvents() const
+    {
+        return events.size();
+    }
+
+    static const int MAX_EVENTS = 2000000; // the oldest events are kept, the new events are discarded
+
+private slots:
+    void collect();
+
+private:
+    QTimer timer;
+    QVector<Event> events;
+    int discardedEvents;
+};
+
+} // namespace
+
+#define JT_PROFILE_CONCAT_(a, b) a ## b
+#define JT_PROFILE_CONCAT(a, b) JT_PROFILE_CONCAT_(a, b)
+
+// scoped timer using a static string as name
+#define JT_PROFILE_SCOPE(name) Profiling::ScopedTimer JT_PROFILE_CONCAT(profilingScopedTimer, __LINE__)(name)
+
+// scoped timer identifying a QObject instance, the object class name is used as the timer name
+#define JT_PROFILE_OBJECT_SCOPE(object) Profiling::ScopedTimer JT_PROFILE_CONCAT(profilingScopedTimer, __LINE__)(static_cast<const QObject *>(object))
+
+#endif // PROFILER_H
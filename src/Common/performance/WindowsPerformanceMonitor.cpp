@@ -1,12 +1,14 @@
 #include "PerformanceMonitor.h"
-#include "../log/logging.h"
+#include "log/Logging.h"
 
 #include "Windows.h"
 #include "psapi.h"
 
 //http://hackage.haskell.org/package/criterion-1.1.0.0/src/cbits/time-windows.c
 
-PerformanceMonitor::PerformanceMonitor(){
+PerformanceMonitor::PerformanceMonitor()
+    : lastCpuTime(0),
+      lastSampleTime(0){
     HANDLE thisProcessHande = GetCurrentProcess();
     SYSTEM_INFO sysInfo;
     BOOL runningInWow64 = false;
@@ -25,33 +27,31 @@ PerformanceMonitor::~PerformanceMonitor(){
 }
 
 //http://stackoverflow.com/questions/63166/how-to-determine-cpu-and-memory-consumption-from-inside-a-process
+//the cpu and the sample times are in 100 nanoseconds units (FILETIME)
 double PerformanceMonitor::getCpuUsage(){
-    static ULARGE_INTEGER lastCPU;
-    static ULARGE_INTEGER lastSysCPU;
-    static ULARGE_INTEGER lastUserCPU;
-    static HANDLE thisProcessHande = GetCurrentProcess();
-
     FILETIME ftime, fsys, fuser;
     ULARGE_INTEGER now, sys, user;
-    double percent;
 
     GetSystemTimeAsFileTime(&ftime);
     memcpy(&now, &ftime, sizeof(FILETIME));
 
-    if(GetProcessTimes(thisProcessHande, &ftime, &ftime, &fsys, &fuser)){
-        memcpy(&sys, &fsys, sizeof(FILETIME));
-        memcpy(&user, &fuser, sizeof(FILETIME));
-        percent = (sys.QuadPart - lastSysCPU.QuadPart) +
-                (user.QuadPart - lastUserCPU.QuadPart);
-        percent /= (now.QuadPart - lastCPU.QuadPart);
-        percent /= this->processorsCount;
-        lastCPU = now;
-        lastUserCPU = user;
-        lastSysCPU = sys;
-        //qInfo() << "percent:" << percent * 100;
-        return percent * 100;
+    if(!GetProcessTimes(GetCurrentProcess(), &ftime, &ftime, &fsys, &fuser)){
+        qWarning() << "Can't get cpu usage! GetProcessTimes fail!";
+        return 0;
     }
-    return 0;
+    memcpy(&sys, &fsys, sizeof(FILETIME));
+    memcpy(&user, &fuser, sizeof(FILETIME));
+    qint64 cpuTime = sys.QuadPart + user.QuadPart;
+    qint64 sampleTime = now.QuadPart;
+
+    //the first sample has nothing to compare
+    double percent = 0;
+    if(lastSampleTime > 0 && sampleTime > lastSampleTime){
+        percent = (double)(cpuTime - lastCpuTime) / (sampleTime - lastSampleTime) / this->processorsCount;
+    }
+    lastCpuTime = cpuTime;
+    lastSampleTime = sampleTime;
+    return percent * 100;
 }
 
 int PerformanceMonitor::getMemmoryUsage(){
@@ -12,6 +12,8 @@ public:
 
     bool isValid(quint32 expectedRevision) const;
 
+    static const quint32 SIZE; // serialized size in bytes
+
 private:
 
     quint32 signature;
@@ -19,7 +21,6 @@ private:
     quint32 size;
 
     static const quint32 SIGNATURE;
-    static const quint32 SIZE;
 };
 
 #endif
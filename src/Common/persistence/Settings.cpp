@@ -111,7 +111,13 @@ void Settings::setPrivateServerData(const QString &server, int serverPort, const
 AudioSettings::AudioSettings() :
     SettingsObject("audio"),
     sampleRate(44100),
-    bufferSize(128)
+    bufferSize(128),
+    pluginsFixedBlockSize(0),
+    nonInterleavedBuffers(false),
+    vstMultiOutputs(false),
+    lateIntervalStartWindow(500),
+    vorbisPageSize(4096),
+    vorbisPageLatency(250)
 {
 }
 
@@ -124,6 +130,12 @@ void AudioSettings::read(const QJsonObject &in)
     lastIn = getValueFromJson(in, "lastIn", 0);
     lastOut = getValueFromJson(in, "lastOut", 0);
     audioDevice = getValueFromJson(in, "audioDevice", -1);
+    pluginsFixedBlockSize = getValueFromJson(in, "pluginsFixedBlockSize", 0);
+    nonInterleavedBuffers = getValueFromJson(in, "nonInterleavedBuffers", false);
+    vstMultiOutputs = getValueFromJson(in, "vstMultiOutputs", false);
+    lateIntervalStartWindow = getValueFromJson(in, "lateIntervalStartWindow", 500);
+    vorbisPageSize = getValueFromJson(in, "vorbisPageSize", 4096);
+    vorbisPageLatency = getValueFromJson(in, "vorbisPageLatency", 250);
 }
 
 void AudioSettings::write(QJsonObject &out) const
@@ -135,6 +147,12 @@ void AudioSettings::write(QJsonObject &out) const
     out["lastIn"] = lastIn;
     out["lastOut"] = lastOut;
     out["audioDevice"] = audioDevice;
+    out["pluginsFixedBlockSize"] = pluginsFixedBlockSize;
+    out["nonInterleavedBuffers"] = nonInterleavedBuffers;
+    out["vstMultiOutputs"] = vstMultiOutputs;
+    out["lateIntervalStartWindow"] = lateIntervalStartWindow;
+    out["vorbisPageSize"] = vorbisPageSize;
+    out["vorbisPageLatency"] = vorbisPageLatency;
 }
 
 // +++++++++++++++++++++++++++++
@@ -614,6 +632,32 @@ void Settings::setBufferSize(int bufferSize)
     audioSettings.bufferSize = bufferSize;
 }
 
+void Settings::setPluginsFixedBlockSize(int blockSize)
+{
+    audioSettings.pluginsFixedBlockSize = blockSize;
+}
+
+void Settings::setUsingNonInterleavedAudioBuffers(bool nonInterleaved)
+{
+    audioSettings.nonInterleavedBuffers = nonInterleaved;
+}
+
+void Settings::setUsingVstMultiOutputs(bool multiOutputs)
+{
+    audioSettings.vstMultiOutputs = multiOutputs;
+}
+
+void Settings::setLateIntervalStartWindow(int milliseconds)
+{
+    audioSettings.lateIntervalStartWindow = qMax(0, milliseconds);
+}
+
+void Settings::setVorbisPagePolicy(int pageSize, int pageLatency)
+{
+    audioSettings.vorbisPageSize = qMax(1, pageSize);
+    audioSettings.vorbisPageLatency = qMax(1, pageLatency);
+}
+
 bool Settings::readFile(const QList<SettingsObject *> &sections)
 {
     QDir configFileDir = Configurator::getInstance()->getBaseDir();
@@ -51,6 +51,12 @@ public:
     int lastIn;
     int lastOut;
     int audioDevice;
+    int pluginsFixedBlockSize; // 0 means plugins are processing the audio driver buffer size
+    bool nonInterleavedBuffers; // audio driver channels are exchanged as separated arrays
+    bool vstMultiOutputs; // the VST plugin is routing each remote user to a separated output pair
+    int lateIntervalStartWindow; // in milliseconds, remote intervals downloaded in this window after the interval start are played
+    int vorbisPageSize; // in bytes, the encoded intervals ogg pages are filled up to this size
+    int vorbisPageLatency; // in milliseconds, the ogg pages are flushed when they contain more audio
 };
 // +++++++++++++++++++++++++++++++++++++
 class MidiSettings : public SettingsObject
@@ -361,6 +367,36 @@ public:
         return audioSettings.bufferSize;
     }
 
+    inline int getPluginsFixedBlockSize() const
+    {
+        return audioSettings.pluginsFixedBlockSize;
+    }
+
+    inline bool isUsingNonInterleavedAudioBuffers() const
+    {
+        return audioSettings.nonInterleavedBuffers;
+    }
+
+    inline bool isUsingVstMultiOutputs() const
+    {
+        return audioSettings.vstMultiOutputs;
+    }
+
+    inline int getLateIntervalStartWindow() const
+    {
+        return audioSettings.lateIntervalStartWindow;
+    }
+
+    inline int getVorbisPageSize() const
+    {
+        return audioSettings.vorbisPageSize;
+    }
+
+    inline int getVorbisPageLatency() const
+    {
+        return audioSettings.vorbisPageLatency;
+    }
+
     // private server
     inline QString getLastPrivateServer() const
     {
@@ -494,6 +530,11 @@ public:
 
     void setSampleRate(int newSampleRate);
     void setBufferSize(int bufferSize);
+    void setPluginsFixedBlockSize(int blockSize);
+    void setUsingNonInterleavedAudioBuffers(bool nonInterleaved);
+    void setUsingVstMultiOutputs(bool multiOutputs);
+    void setLateIntervalStartWindow(int milliseconds);
+    void setVorbisPagePolicy(int pageSize, int pageLatency); // see VorbisEncoder::setPagePolicy()
 
     inline int getFirstGlobalAudioInput() const
     {
@@ -4,12 +4,17 @@
 #include <QFile>
 #include <QStandardPaths>
 #include <QDataStream>
+#include <QSaveFile>
+#include <QMap>
+#include <QtEndian>
+#include <cstring>
 #include "Configurator.h"
 #include "CacheHeader.h"
 
 using namespace Persistence;
 
-const quint32 UsersDataCacheHeader::REVISION = 1;
+const quint32 UsersDataCacheHeader::REVISION = 2;
+const quint32 UsersDataCacheHeader::LEGACY_REVISION = 1;
 
 const bool CacheEntry::DEFAULT_MUTED = false;
 const float CacheEntry::DEFAULT_GAIN = 1.0f;
@@ -109,90 +114,271 @@ void CacheEntry::setGain(float gain)
 }
 
 UsersDataCache::UsersDataCache(const QDir &cacheDir)
-    :CACHE_FILE_NAME("tracks_cache.bin"),
-     cacheDir(cacheDir)
+    :cacheDir(cacheDir),
+     fileRecords(0),
+     CACHE_FILE_NAME("users_cache.dat"),
+     LEGACY_CACHE_FILE_NAME("tracks_cache.bin")
 {
     //check if the tracks_cache_bin file is in the old dir and copy the file to the 'cache' dir.
     //This piece of code will be deleted in future versions.
     QDir baseDir = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
-    QFile oldCacheFile(baseDir.absoluteFilePath(CACHE_FILE_NAME));
+    QFile oldCacheFile(baseDir.absoluteFilePath(LEGACY_CACHE_FILE_NAME));
     if (oldCacheFile.exists()) {
-        if (oldCacheFile.rename(cacheDir.absoluteFilePath(CACHE_FILE_NAME)))
-            qDebug() << CACHE_FILE_NAME << " copyed to the new cache folder!";
+        if (oldCacheFile.rename(cacheDir.absoluteFilePath(LEGACY_CACHE_FILE_NAME)))
+            qDebug() << LEGACY_CACHE_FILE_NAME << " copyed to the new cache folder!";
         else
-            qDebug() << "Error when copying " << CACHE_FILE_NAME << " to the new cache folder!";
+            qDebug() << "Error when copying " << LEGACY_CACHE_FILE_NAME << " to the new cache folder!";
     }
 
+    cacheFile.setFileName(cacheDir.absoluteFilePath(CACHE_FILE_NAME));
     loadCacheEntriesFromFile();
 }
 
 UsersDataCache::~UsersDataCache()
 {
-    if (!cacheEntries.isEmpty())
-        writeCacheEntriesToFile();
+    // all updates are already stored, the file is just compacted
+    if (needsCompaction())
+        compact();
 }
 
 CacheEntry UsersDataCache::getUserCacheEntry(const QString &userIp, const QString &userName,
-                                             quint8 channelID)
+                                             quint8 channelID) const
 {
-    QString userUniqueKey = getUserUniqueKey(userIp, userName, channelID);
-    if (cacheEntries.contains(userUniqueKey))
-        return cacheEntries[userUniqueKey];
-    return CacheEntry(userIp, userName, channelID);// return a entry using default values for pan, gain, mute, etc.
+    CacheEntry entry(userIp, userName, channelID);// using default values for pan, gain, mute, etc.
+
+    QHash<quint64, CacheRecord>::const_iterator iterator = cacheEntries.constFind(getUserUniqueKey(userIp, userName, channelID));
+    if (iterator != cacheEntries.constEnd()) {
+        const CacheRecord &record = iterator.value();
+        entry.setMuted(record.muted);
+        entry.setGain(record.gain);
+        entry.setPan(record.pan);
+        entry.setBoost(record.boost);
+    }
+
+    return entry;
 }
 
-void UsersDataCache::updateUserCacheEntry(CacheEntry entry)
+void UsersDataCache::updateUserCacheEntry(const CacheEntry &entry)
 {
-    QString userKey
-        = getUserUniqueKey(entry.getUserIP(), entry.getUserName(), entry.getChannelID());
-    cacheEntries.insert(userKey, entry);// replace the last value or insert
+    quint64 key = getUserUniqueKey(entry.getUserIP(), entry.getUserName(), entry.getChannelID());
+
+    CacheRecord record;
+    record.muted = entry.isMuted();
+    record.gain = entry.getGain();
+    record.pan = entry.getPan();
+    record.boost = entry.getBoost();
+
+    QHash<quint64, CacheRecord>::iterator iterator = cacheEntries.find(key);
+    if (iterator != cacheEntries.end()) {
+        if (iterator.value() == record)
+            return; // nothing changed, avoid a file write
+        iterator.value() = record;
+    } else {
+        cacheEntries.insert(key, record);
+    }
+
+    appendRecord(key, record);
+
+    if (needsCompaction())
+        compact();
 }
 
-QString UsersDataCache::getUserUniqueKey(const QString &userIp, const QString &userName,
+quint64 UsersDataCache::getUserUniqueKey(const QString &userIp, const QString &userName,
                                          quint8 channelID)
 {
-    // the unique key is just a string...
-    return userIp + userName + QString::number(channelID);
+    static const quint64 FNV_OFFSET_BASIS = Q_UINT64_C(14695981039346656037);
+    static const quint64 FNV_PRIME = Q_UINT64_C(1099511628211);
+
+    quint64 hash = FNV_OFFSET_BASIS;
+    const QString *strings[] = {&userIp, &userName};
+    for (const QString *string : strings) {
+        const ushort *utf16 = string->utf16();
+        for (int i = 0; i < string->size(); ++i) {
+            hash = (hash ^ (utf16[i] & 0xFF)) * FNV_PRIME;
+            hash = (hash ^ (utf16[i] >> 8)) * FNV_PRIME;
+        }
+        hash = (hash ^ 0xFF) * FNV_PRIME; // separator, so ("ab", "c") and ("a", "bc") are different keys
+    }
+    hash = (hash ^ channelID) * FNV_PRIME;
+
+    return hash;
+}
+
+bool UsersDataCache::CacheRecord::operator==(const CacheRecord &other) const
+{
+    return muted == other.muted && gain == other.gain && pan == other.pan && boost == other.boost;
+}
+
+void UsersDataCache::writeRecord(quint64 key, const CacheRecord &record, uchar *out)
+{
+    // little endian: key (8 bytes), muted (1 byte), 3 reserved bytes, gain, pan and boost (4 bytes each)
+    qToLittleEndian<quint64>(key, out);
+    out[8] = record.muted ? 1 : 0;
+    out[9] = out[10] = out[11] = 0;
+
+    const float values[] = {record.gain, record.pan, record.boost};
+    for (int i = 0; i < 3; ++i) {
+        quint32 bits;
+        memcpy(&bits, &values[i], sizeof(bits));
+        qToLittleEndian<quint32>(bits, out + 12 + i * 4);
+    }
+}
+
+UsersDataCache::CacheRecord UsersDataCache::readRecord(const uchar *in, quint64 *key)
+{
+    *key = qFromLittleEndian<quint64>(in);
+
+    CacheRecord record;
+    record.muted = in[8] != 0;
+
+    float values[3];
+    for (int i = 0; i < 3; ++i) {
+        quint32 bits = qFromLittleEndian<quint32>(in + 12 + i * 4);
+        memcpy(&values[i], &bits, sizeof(bits));
+    }
+    record.gain = values[0];
+    record.pan = values[1];
+    record.boost = values[2];
+
+    return record;
 }
 
 void UsersDataCache::loadCacheEntriesFromFile()
 {
-    // load tracks cache content from file
-    QFile cacheFile(cacheDir.absoluteFilePath(CACHE_FILE_NAME));
-    if (cacheFile.open(QFile::ReadOnly)) {
-        QDataStream stream(&cacheFile);
+    if (!cacheFile.exists()) {
+        importLegacyCacheFile();
+        compact(); // create the file
+        return;
+    }
+
+    if (!cacheFile.open(QFile::ReadWrite)) {
+        qCCritical(jtCache) << "Can't open the users cache file in" << cacheFile.fileName();
+        return;
+    }
 
+    qint64 fileSize = cacheFile.size();
+    uchar *mappedData = fileSize > CacheHeader::SIZE ? cacheFile.map(0, fileSize) : nullptr;
+    QByteArray fileContent;
+    if (!mappedData && fileSize > CacheHeader::SIZE)
+        fileContent = cacheFile.readAll(); // mapping is not supported, reading the file is slower but works
+    const uchar *data = mappedData ? mappedData : reinterpret_cast<const uchar *>(fileContent.constData());
+    if (fileSize > CacheHeader::SIZE && (mappedData || fileContent.size() == fileSize)) {
+        QByteArray headerData = QByteArray::fromRawData(reinterpret_cast<const char *>(data), CacheHeader::SIZE);
+        QDataStream stream(headerData);
         CacheHeader cacheHeader;
         stream >> cacheHeader;
-        quint32 expectedHeaderRevision = UsersDataCacheHeader::REVISION;
-        if (cacheHeader.isValid(expectedHeaderRevision))
-            stream >> cacheEntries;
-        else
+        if (cacheHeader.isValid(UsersDataCacheHeader::REVISION)) {
+            // a incomplete record in the file end (crash while writing) is ignored, and removed in the next compaction
+            fileRecords = (fileSize - CacheHeader::SIZE) / RECORD_SIZE;
+            cacheEntries.reserve(fileRecords);
+            const uchar *records = data + CacheHeader::SIZE;
+            for (int i = 0; i < fileRecords; ++i) {
+                quint64 key;
+                CacheRecord record = readRecord(records + i * RECORD_SIZE, &key);
+                cacheEntries.insert(key, record); // the last record wins
+            }
+        } else {
             qCritical() << "Invalid cache header when loading users data cache.";
+        }
+    }
+    if (mappedData)
+        cacheFile.unmap(mappedData);
+
+    qCDebug(jtCache) << "Users cache items loaded from file: " << cacheEntries.size() << "(" << fileRecords << " records)";
+
+    bool hasIncompleteRecord = fileSize != CacheHeader::SIZE + (qint64)fileRecords * RECORD_SIZE;
+    if (hasIncompleteRecord || needsCompaction()) {
+        compact();
+        return;
+    }
+
+    cacheFile.seek(fileSize);
+}
+
+void UsersDataCache::importLegacyCacheFile()
+{
+    QFile legacyFile(cacheDir.absoluteFilePath(LEGACY_CACHE_FILE_NAME));
+    if (!legacyFile.open(QFile::ReadOnly))
+        return;
+
+    QDataStream stream(&legacyFile);
+    CacheHeader cacheHeader;
+    stream >> cacheHeader;
+    if (cacheHeader.isValid(UsersDataCacheHeader::LEGACY_REVISION)) {
+        QMap<QString, CacheEntry> legacyEntries;
+        stream >> legacyEntries;
+        foreach (const CacheEntry &entry, legacyEntries) {
+            quint64 key = getUserUniqueKey(entry.getUserIP(), entry.getUserName(), entry.getChannelID());
+            CacheRecord record;
+            record.muted = entry.isMuted();
+            record.gain = entry.getGain();
+            record.pan = entry.getPan();
+            record.boost = entry.getBoost();
+            cacheEntries.insert(key, record);
+        }
+        qCDebug(jtCache) << cacheEntries.size() << "items imported from" << LEGACY_CACHE_FILE_NAME;
+    }
+
+    legacyFile.close();
+    legacyFile.remove();
+}
 
-        qCDebug(jtCache) << "Tracks cache items loaded from file: " << cacheEntries.size();
+bool UsersDataCache::appendRecord(quint64 key, const CacheRecord &record)
+{
+    if (!cacheFile.isOpen())
+        return false;
+
+    uchar data[RECORD_SIZE];
+    writeRecord(key, record, data);
+    if (cacheFile.write(reinterpret_cast<const char *>(data), RECORD_SIZE) != RECORD_SIZE) {
+        qCCritical(jtCache) << "Can't write in the users cache file" << cacheFile.errorString();
+        return false;
     }
+
+    cacheFile.flush(); // the record is in the OS, the update survive a Jamtaba crash
+    fileRecords++;
+    return true;
+}
+
+bool UsersDataCache::needsCompaction() const
+{
+    return fileRecords >= MIN_RECORDS_TO_COMPACT && fileRecords > cacheEntries.size() * 2;
 }
 
-void UsersDataCache::writeCacheEntriesToFile()
+void UsersDataCache::compact()
 {
-    qCDebug(jtCache) << "Saving cache file";
+    qCDebug(jtCache) << "Compacting the users cache file," << fileRecords << "records," << cacheEntries.size() << "entries";
 
-    QFile cacheFile(cacheDir.absoluteFilePath(CACHE_FILE_NAME));
-    if (cacheFile.open(QFile::WriteOnly)) {
-        qCDebug(jtCache) << "Tracks cache file opened to write.";
-        QDataStream stream(&cacheFile);
+    if (cacheFile.isOpen())
+        cacheFile.close();
 
+    QByteArray data;
+    data.reserve(CacheHeader::SIZE + cacheEntries.size() * RECORD_SIZE);
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
         CacheHeader cacheHeader(UsersDataCacheHeader::REVISION);
         stream << cacheHeader;
+    }
+    data.resize(CacheHeader::SIZE + cacheEntries.size() * RECORD_SIZE);
+    uchar *records = reinterpret_cast<uchar *>(data.data()) + CacheHeader::SIZE;
+    for (QHash<quint64, CacheRecord>::const_iterator i = cacheEntries.constBegin(); i != cacheEntries.constEnd(); ++i) {
+        writeRecord(i.key(), i.value(), records);
+        records += RECORD_SIZE;
+    }
 
-        stream << cacheEntries;
-
-        qCDebug(jtCache) << cacheEntries.size() << " items stored in tracks cache file!";
-    } else {
-        qCCritical(jtCache) << "Can't open the tracks cache file in"
-                            << QFileInfo(cacheFile).absoluteFilePath();
+    // the old file is replaced only if the new file is completely written
+    QSaveFile saveFile(cacheFile.fileName());
+    if (!saveFile.open(QFile::WriteOnly) || saveFile.write(data) != data.size() || !saveFile.commit()) {
+        qCCritical(jtCache) << "Can't write the users cache file in" << cacheFile.fileName();
+        return;
     }
+
+    fileRecords = cacheEntries.size();
+
+    if (cacheFile.open(QFile::ReadWrite))
+        cacheFile.seek(cacheFile.size());
+    else
+        qCCritical(jtCache) << "Can't open the users cache file in" << cacheFile.fileName();
 }
 
 // ++++++++++++++++++
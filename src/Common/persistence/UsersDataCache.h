@@ -2,7 +2,8 @@
 #define USERSDATACACHE_H
 
 #include <QString>
-#include <QMap>
+#include <QHash>
+#include <QFile>
 #include <QRegExp>
 #include <QDir>
 
@@ -17,6 +18,7 @@ namespace Persistence {
  */
 struct UsersDataCacheHeader {
     static const quint32 REVISION;
+    static const quint32 LEGACY_REVISION; // QDataStream serialized QMap in 'tracks_cache.bin'
 };
 
 class CacheEntry // cache entries are per channel, not per user.
@@ -89,6 +91,14 @@ private:
 };
 
 // ++++++++++++++++++++++++++++++++
+
+/**
+ * The cache file is an append only log of fixed size records, the keys are hashed (the user ip,
+ * name and channel are not stored). The file is memory mapped to load the records at startup, each
+ * update is appended (and flushed) immediately, so a crash will not lose the changes. The file is
+ * compacted when the outdated records are the majority.
+ */
+
 class UsersDataCache
 {
 public:
@@ -96,21 +106,54 @@ public:
     ~UsersDataCache();
 
     // return default values for pan, gain and mute if user is not cached yet
-    CacheEntry getUserCacheEntry(const QString &userIp, const QString &userName, quint8 channelID);
+    CacheEntry getUserCacheEntry(const QString &userIp, const QString &userName, quint8 channelID) const;
+
+    void updateUserCacheEntry(const CacheEntry &entry);
+
+    inline int getEntriesCount() const
+    {
+        return cacheEntries.size();
+    }
+
+    inline int getFileRecordsCount() const // include the outdated records
+    {
+        return fileRecords;
+    }
+
+    static const int RECORD_SIZE = 24; // bytes
+    static const int MIN_RECORDS_TO_COMPACT = 256;
 
-    void updateUserCacheEntry(CacheEntry entry);
 private:
-    QMap<QString, CacheEntry> cacheEntries;
+    struct CacheRecord
+    {
+        bool muted;
+        float gain;
+        float pan;
+        float boost;
+
+        bool operator==(const CacheRecord &other) const;
+    };
+
+    QHash<quint64, CacheRecord> cacheEntries;
 
     QDir cacheDir;
+    QFile cacheFile; // kept open to append the updates
+    int fileRecords;
 
-    static QString getUserUniqueKey(const QString &userIp, const QString &userName,
-                                    quint8 channelID);
+    static quint64 getUserUniqueKey(const QString &userIp, const QString &userName,
+                                    quint8 channelID); // FNV-1a hash, no strings are allocated
 
     void loadCacheEntriesFromFile();
-    void writeCacheEntriesToFile();
+    void importLegacyCacheFile(); // the old QDataStream based cache file
+    bool appendRecord(quint64 key, const CacheRecord &record);
+    void compact();
+    bool needsCompaction() const;
+
+    static void writeRecord(quint64 key, const CacheRecord &record, uchar *out);
+    static CacheRecord readRecord(const uchar *in, quint64 *key);
 
     const QString CACHE_FILE_NAME;
+    const QString LEGACY_CACHE_FILE_NAME;
 };
 }// namespace
 
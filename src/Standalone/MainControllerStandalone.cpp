@@ -3,17 +3,24 @@
 #include "midi/RtMidiDriver.h"
 #include "midi/MidiMessage.h"
 #include "audio/PortAudioDriver.h"
+#include "audio/OfflineAudioDriver.h"
+#include "audio/core/AllocationCounter.h"
 #include "audio/core/LocalInputNode.h"
 #include "vst/VstPlugin.h"
 #include "vst/VstHost.h"
 #include "vst/PluginFinder.h"
 #include "audio/core/PluginDescriptor.h"
 #include "NinjamController.h"
+#include "ninjam/Server.h"
+#include "ninjam/User.h"
+#include "audio/vorbis/VorbisEncoder.h"
 #include "vst/VstPluginChecker.h"
 #include "gui/MainWindowStandalone.h"
 
 #include <QDialog>
 #include <QHostAddress>
+#include <QTextStream>
+#include <cmath>
 
 #if _WIN32
     #include "windows.h"
@@ -83,9 +90,11 @@ Audio::Plugin *MainControllerStandalone::addPlugin(quint32 inputTrackIndex, quin
 {
     Audio::Plugin *plugin = createPluginInstance(descriptor);
     if (plugin) {
+        plugin->setFixedBlockSize(settings.getPluginsFixedBlockSize());// before start, so the plugin is started using the right block size
         plugin->start();
         QMutexLocker locker(&mutex);
         getInputTrack(inputTrackIndex)->addProcessor(plugin, pluginSlotIndex);
+        updateInputTrackGroupsLatency();
     }
     return plugin;
 }
@@ -98,6 +107,7 @@ void MainControllerStandalone::removePlugin(int inputTrackIndex, Audio::Plugin *
         Audio::AudioNode *trackNode = getInputTrack(inputTrackIndex);
         if (trackNode)
             trackNode->removeProcessor(plugin);
+        updateInputTrackGroupsLatency();
     }
     catch (...) {
         qCritical() << "Error removing plugin " << pluginName;
@@ -229,6 +239,23 @@ void MainControllerStandalone::setBufferSize(int newBufferSize)
     settings.setBufferSize(newBufferSize);
 }
 
+void MainControllerStandalone::setPluginsFixedBlockSize(int blockSize)
+{
+    QMutexLocker locker(&mutex); // the plugins are suspended and the adapters replaced while the audio thread is not processing
+    foreach (Audio::LocalInputNode *inputNode, inputTracks)
+        inputNode->setProcessorsFixedBlockSize(blockSize);
+    updateInputTrackGroupsLatency();
+    settings.setPluginsFixedBlockSize(blockSize);
+}
+
+void MainControllerStandalone::setUsingNonInterleavedAudioBuffers(bool nonInterleaved)
+{
+    Audio::PortAudioDriver *portAudioDriver = dynamic_cast<Audio::PortAudioDriver *>(audioDriver.data());
+    if (portAudioDriver) // the offline and null drivers are not using PortAudio buffers
+        portAudioDriver->setUsingNonInterleavedBuffers(nonInterleaved);
+    settings.setUsingNonInterleavedAudioBuffers(nonInterleaved);
+}
+
 void MainControllerStandalone::on_audioDriverStarted()
 {
     foreach (Audio::LocalInputNode *inputTrack, inputTracks)
@@ -303,7 +330,19 @@ Controller::NinjamController *MainControllerStandalone::createNinjamController()
 Audio::AudioDriver *MainControllerStandalone::createAudioDriver(
     const Persistence::Settings &settings)
 {
-    return new Audio::PortAudioDriver(
+    if (isUsingOfflineRender()) {
+        int inputs = settings.getLastGlobalAudioInput() - settings.getFirstGlobalAudioInput() + 1;
+        int outputs = settings.getLastGlobalAudioOutput() - settings.getFirstGlobalAudioOutput() + 1;
+        Audio::OfflineAudioDriver *offlineDriver = new Audio::OfflineAudioDriver(
+            this, settings.getLastSampleRate(), settings.getLastBufferSize(), inputs, outputs);
+        if (!offlineDriver->setSource(offlineRenderSource))
+            qCWarning(jtCore) << "Using silence in offline render!";
+        offlineDriver->setRenderLength(offlineRenderLength);
+        QObject::connect(offlineDriver, SIGNAL(renderFinished()), this, SLOT(finishOfflineRender()));
+        return offlineDriver;
+    }
+
+    Audio::PortAudioDriver *driver = new Audio::PortAudioDriver(
         this,
         settings.getLastAudioDevice(),
         settings.getFirstGlobalAudioInput(),
@@ -313,6 +352,8 @@ Audio::AudioDriver *MainControllerStandalone::createAudioDriver(
         settings.getLastSampleRate(),
         settings.getLastBufferSize()
         );
+    driver->setUsingNonInterleavedBuffers(settings.isUsingNonInterleavedAudioBuffers());
+    return driver;
 }
 
 // ++++++++++++++++++++++++++++++++++++++++++
@@ -320,13 +361,17 @@ MainControllerStandalone::MainControllerStandalone(Persistence::Settings setting
                                                    QApplication *application) :
     MainController(settings),
     vstHost(Vst::Host::getInstance()),
-    application(application)
+    application(application),
+    offlineRenderLength(0),
+    offlineRenderUsers(0)
 {
     application->setQuitOnLastWindowClosed(true);
 
     QObject::connect(Vst::Host::getInstance(),
                      SIGNAL(pluginRequestingWindowResize(QString, int, int)),
                      this, SLOT(on_vstPluginRequestedWindowResize(QString, int, int)));
+
+    QObject::connect(&newPluginsDetection, SIGNAL(finished()), this, SLOT(finishNewPluginsDetection()));
 }
 
 void MainControllerStandalone::on_vstPluginRequestedWindowResize(QString pluginName, int newWidht,
@@ -375,7 +420,8 @@ void MainControllerStandalone::start()
     if (audioDriver) {
         if (!audioDriver->canBeStarted())
             useNullAudioDriver();
-        audioDriver->start();
+        if (!isUsingOfflineRender())// the offline render is started in startOfflineRender()
+            audioDriver->start();
     }
     if (midiDriver)
         midiDriver->start(settings.getMidiInputDevicesStatus());
@@ -409,6 +455,7 @@ void MainControllerStandalone::setCSS(const QString &css)
 MainControllerStandalone::~MainControllerStandalone()
 {
     qCDebug(jtCore) << "StandaloneMainController destructor!";
+    newPluginsDetection.waitForFinished(); // the plugin folder index is used by the detection thread
     // pluginsDescriptors.clear();
 }
 
@@ -481,31 +528,37 @@ void MainControllerStandalone::addDefaultPluginsScanPath()
     }
 }
 
-// we need scan plugins when plugins cache is empty OR we have new plugins in scan folders
-// This code is executed whem Jamtaba is started.
-bool MainControllerStandalone::pluginsScanIsNeeded() const
+bool MainControllerStandalone::pluginsCacheIsEmpty() const
 {
-    if (settings.getVstPluginsPaths().isEmpty())// cache is empty?
+    return settings.getVstPluginsPaths().isEmpty();
+}
 
-        return true;
+// This code is executed when Jamtaba is started. Walking big plugins folders can be slow, so
+// the scan folders are checked in a worker thread and only the changed folders are listed.
+void MainControllerStandalone::detectNewPluginsInBackground()
+{
+    if (newPluginsDetection.isRunning())
+        return;
 
-    // checking for new plugins in scan folders
-    QStringList foldersToScan = settings.getVstScanFolders();
+    if (!pluginFolderIndex) {
+        QDir cacheDir = Configurator::getInstance()->getCacheDir();
+        pluginFolderIndex.reset(new Vst::PluginFolderIndex(cacheDir.absoluteFilePath("plugins_folders_index.bin")));
+    }
 
-    QStringList skipList(settings.getBlackListedPlugins());
-    skipList.append(settings.getVstPluginsPaths());
+    QStringList knownPlugins(settings.getBlackListedPlugins());
+    knownPlugins.append(settings.getVstPluginsPaths());
 
-    foreach (const QString &scanFolder, foldersToScan) {
-        QDirIterator folderIterator(scanFolder, QDirIterator::Subdirectories);
-        while (folderIterator.hasNext())
-        {
-            folderIterator.next();// point to next file inside current folder
-            QString filePath = folderIterator.filePath();
-            if (!skipList.contains(filePath) && Vst::PluginChecker::isValidPluginFile(filePath))
-                return true; // a new vst plugin was founded
-        }
+    newPluginsDetection.setFuture(QtConcurrent::run(pluginFolderIndex.data(),
+                                                    &Vst::PluginFolderIndex::newPluginsDetected,
+                                                    settings.getVstScanFolders(), knownPlugins));
+}
+
+void MainControllerStandalone::finishNewPluginsDetection()
+{
+    if (newPluginsDetection.result()) {
+        qCInfo(jtStandalonePluginFinder) << "New plugins detected in scan folders!";
+        scanOnlyNewPlugins();
     }
-    return false;
 }
 
 void MainControllerStandalone::initializePluginsList(const QStringList &paths)
@@ -605,6 +658,107 @@ void MainControllerStandalone::stop()
     qCDebug(jtCore) << "audio and midi drivers released";
 }
 
+void MainControllerStandalone::setOfflineRender(const QString &source, int seconds, int ninjamUsers)
+{
+    offlineRenderSource = source;
+    offlineRenderLength = qMax(0, seconds);
+    offlineRenderUsers = qMax(0, ninjamUsers);
+}
+
+void MainControllerStandalone::startOfflineRender()
+{
+    if (!isUsingOfflineRender() || !audioDriver)
+        return;
+
+    if (offlineRenderUsers > 0)
+        startOfflineJam();
+
+    audioDriver->start();
+}
+
+void MainControllerStandalone::startOfflineJam()
+{
+    // A NINJAM room without server. The remote users intervals are encoded here and added in each interval
+    // start, so the metronome, the intervals decoding and the local inputs encoding are part of the render.
+    // The local inputs are transmitted, the uploads are discarded by the not connected Ninjam::Service.
+    Ninjam::Server server("offline", 0, 1, offlineRenderUsers + 1);
+    server.setBpm(OFFLINE_JAM_BPM);
+    server.setBpi(OFFLINE_JAM_BPI);
+
+    int sampleRate = getSampleRate();
+    long intervalFrames = (long)sampleRate * 60 * OFFLINE_JAM_BPI / OFFLINE_JAM_BPM;
+    offlineJamChannels.clear();
+    offlineJamIntervals.clear();
+    for (int u = 0; u < offlineRenderUsers; ++u) {
+        QString userFullName = QString("offline_user%1@127.0.0.%1").arg(u + 1);
+        Ninjam::UserChannel channel(userFullName, "channel", 0);
+        server.addUser(Ninjam::User(userFullName));
+        server.addUserChannel(channel);
+        offlineJamChannels.append(channel);
+        offlineJamIntervals.append(encodeOfflineInterval(sampleRate, intervalFrames, 110.0 * (u + 2)));
+    }
+
+    stopNinjamController();
+    ninjamController.reset(createNinjamController());
+    setupNinjamControllerSignals();
+    connect(ninjamController.data(), SIGNAL(startingNewInterval()), this, SLOT(addOfflineJamIntervals()), Qt::QueuedConnection);
+    ninjamController->start(server);
+
+    addOfflineJamIntervals(); // played in the second interval, like the intervals downloaded in a real room
+}
+
+void MainControllerStandalone::addOfflineJamIntervals()
+{
+    if (!ninjamController)
+        return;
+
+    for (int i = 0; i < offlineJamChannels.size(); ++i)
+        ninjamController->addEncodedInterval(offlineJamChannels.at(i), offlineJamIntervals.at(i));
+}
+
+QByteArray MainControllerStandalone::encodeOfflineInterval(int sampleRate, long frames, double frequency)
+{
+    // a sine with some noise, the noise is increasing the Vorbis bitrate and the decoding cost
+    static const int BLOCK_FRAMES = 4096; // the encoder is receiving blocks, like in the encoding thread
+    const double phaseIncrement = 2.0 * 3.14159265358979323846 * frequency / sampleRate;
+    VorbisEncoder encoder(2, sampleRate);
+    Audio::SamplesBuffer block(2, BLOCK_FRAMES);
+    QByteArray encodedInterval;
+    for (long frame = 0; frame < frames; frame += BLOCK_FRAMES) {
+        int blockFrames = (int)qMin((long)BLOCK_FRAMES, frames - frame);
+        block.setFrameLenght(blockFrames);
+        for (int i = 0; i < blockFrames; ++i) {
+            float sample = 0.3f * std::sin(phaseIncrement * (frame + i)) + 0.05f * (qrand() / (float)RAND_MAX - 0.5f);
+            block.set(0, i, sample);
+            block.set(1, i, sample);
+        }
+        encodedInterval.append(encoder.encode(block));
+    }
+    encodedInterval.append(encoder.finishIntervalEncoding());
+    return encodedInterval;
+}
+
+void MainControllerStandalone::finishOfflineRender()
+{
+    Audio::OfflineAudioDriver *offlineDriver = qobject_cast<Audio::OfflineAudioDriver *>(audioDriver.data());
+    if (!offlineDriver)
+        return;
+
+    QTextStream out(stdout);
+    out << "Offline render using '" << offlineRenderSource << "', " << offlineDriver->getSampleRate()
+        << " Hz, " << offlineDriver->getBufferSize() << " samples per callback\n";
+    if (offlineRenderUsers > 0)
+        out << "NINJAM room: " << offlineRenderUsers << " remote users, " << OFFLINE_JAM_BPM << " BPM, " << OFFLINE_JAM_BPI << " BPI\n";
+    out << offlineDriver->getStatistics().toString();
+    if (!Audio::AllocationCounter::isEnabled())
+        out << "(allocations are counted only in builds using CONFIG+=count_allocations)\n";
+    else if (!Audio::AllocationCounter::isCountingMalloc())
+        out << "(only the operator new is counted, the malloc/realloc used by the Qt containers are not counted in this platform)\n";
+    out.flush();
+
+    quit();
+}
+
 void MainControllerStandalone::useNullAudioDriver()
 {
     qCWarning(jtCore) << "Audio driver can't be used, using NullAudioDriver!";
@@ -3,10 +3,13 @@
 
 #include "MainController.h"
 #include <QApplication>
+#include <QFutureWatcher>
 #include "vst/PluginFinder.h"
 #include "vst/VstHost.h"
+#include "vst/PluginFolderIndex.h"
 #include "audio/core/Plugins.h"
 #include "audio/core/PluginDescriptor.h"
+#include "ninjam/UserChannel.h"
 
 class QCoreApplication;
 
@@ -38,7 +41,8 @@ public:
 
     void clearPluginsCache();
     QStringList getSteinbergRecommendedPaths();
-    bool pluginsScanIsNeeded() const; // plugins cache is empty OR we have new plugins in scan folders?
+    bool pluginsCacheIsEmpty() const;
+    void detectNewPluginsInBackground(); // the new plugins are scanned when detected in scan folders
 
     void quit();
 
@@ -62,6 +66,11 @@ public:
         return audioDriver.data();
     }
 
+    inline float getDspLoad() const override
+    {
+        return audioDriver ? audioDriver->getDspLoad() : 0;
+    }
+
     inline Midi::MidiDriver *getMidiDriver() const
     {
         return midiDriver.data();
@@ -80,6 +89,15 @@ public:
 
     void useNullAudioDriver();// use when the audio driver fails
 
+    // benchmark: the offline driver is used instead of the audio device and Jamtaba is closed when the render is finished.
+    // 'ninjamUsers' remote users are simulated in a NINJAM room, use zero to render without the room.
+    void setOfflineRender(const QString &source, int seconds, int ninjamUsers);
+    void startOfflineRender(); // called when the local inputs are created
+    inline bool isUsingOfflineRender() const
+    {
+        return offlineRenderLength > 0;
+    }
+
     void setMainWindow(MainWindow *mainWindow) override;
 
     void cancelPluginFinder();
@@ -98,6 +116,8 @@ public:
 public slots:
     void setSampleRate(int newSampleRate) override;
     void setBufferSize(int newBufferSize);
+    void setPluginsFixedBlockSize(int blockSize);// 0 disable the fixed block processing
+    void setUsingNonInterleavedAudioBuffers(bool nonInterleaved);// used in the next audio driver start
 
     void removePluginsScanPath(const QString &path);
     void addPluginsScanPath(const QString &path);
@@ -140,6 +160,9 @@ protected slots:
 
 private slots:
     void on_vstPluginRequestedWindowResize(QString pluginName, int newWidht, int newHeight);
+    void finishNewPluginsDetection();
+    void finishOfflineRender();
+    void addOfflineJamIntervals();
 
 private:
     // VST
@@ -159,6 +182,21 @@ private:
 
     Vst::PluginFinder *createPluginFinder();
 
+    QScopedPointer<Vst::PluginFolderIndex> pluginFolderIndex;
+    QFutureWatcher<bool> newPluginsDetection;
+
+    QString offlineRenderSource;
+    int offlineRenderLength; // in seconds, zero when the audio device is used
+    int offlineRenderUsers;
+    QList<Ninjam::UserChannel> offlineJamChannels; // the simulated remote users channels
+    QList<QByteArray> offlineJamIntervals; // one encoded interval for each channel, added in each interval start
+
+    void startOfflineJam();
+    static QByteArray encodeOfflineInterval(int sampleRate, long frames, double frequency);
+
+    static const int OFFLINE_JAM_BPM = 120;
+    static const int OFFLINE_JAM_BPI = 16;
+
     // used to sort plugins list
     static bool pluginDescriptorLessThan(const Audio::PluginDescriptor &d1,
                                          const Audio::PluginDescriptor &d2);
@@ -102,40 +102,82 @@ void PortAudioDriver::translatePortAudioCallBack(const void *in, void *out, unsi
     if(!inputBuffer || !outputBuffer){
         return;
     }
-    //prepare buffers and expose then to application process
-    inputBuffer->setFrameLenght(framesPerBuffer);
-    outputBuffer->setFrameLenght(framesPerBuffer);
-    if(!globalInputRange.isEmpty()){
-        float* inputs = (float*)in;
-        int inputChannels = globalInputRange.getChannels();
-        for(unsigned int i=0; i < framesPerBuffer; i++){
-            for (int c = 0; c < inputChannels; c++){
-                inputBuffer->set(c, i, *inputs++);
-            }
+    qint64 callbackStart = DspLoadMeter::now();
+
+    int inputChannels = globalInputRange.getChannels();
+    int outputChannels = globalOutputRange.getChannels();
+    bool hasInputs = !globalInputRange.isEmpty() && in;
+
+    if(nonInterleavedBuffers && outputView){
+        // 'in' and 'out' are arrays of channel arrays, the application is processing the portaudio buffers directly
+        SamplesBuffer *inputs = inputBuffer.data();
+        if(hasInputs && inputView){
+            inputView->bind(const_cast<float * const *>(static_cast<const float * const *>(in)), framesPerBuffer); // the inputs are never written
+            inputs = inputView.data();
+        }
+        else{
+            inputBuffer->setFrameLenght(framesPerBuffer);
+            inputBuffer->zero();
+        }
+
+        outputView->bind(static_cast<float * const *>(out), framesPerBuffer);
+        outputView->zero();
+
+        if(mainController){
+            mainController->process(*inputs, *outputView, sampleRate);
         }
     }
     else{
-        inputBuffer->zero();
-    }
+        //prepare buffers and expose then to application process
+        inputBuffer->setFrameLenght(framesPerBuffer);
+        outputBuffer->setFrameLenght(framesPerBuffer);
+        if(hasInputs){
+            inputBuffer->setInterleaved(static_cast<const float *>(in), framesPerBuffer, inputChannels);
+        }
+        else{
+            inputBuffer->zero();
+        }
 
-    outputBuffer->zero();
+        outputBuffer->zero();
 
+        //all application audio processing is computed here
+        if(mainController){
+            mainController->process(*inputBuffer, *outputBuffer, sampleRate);
+        }
+
+        //convert application output buffers to portaudio format
+        outputBuffer->getInterleaved(static_cast<float *>(out), framesPerBuffer, outputChannels);
+    }
 
-    //all application audio processing is computed here
-    if(mainController){
-        mainController->process(*inputBuffer, *outputBuffer, sampleRate);
+    dspLoadMeter.update(DspLoadMeter::now() - callbackStart, framesPerBuffer, sampleRate);
+}
+
+void PortAudioDriver::recreateViews()
+{
+    inputView.reset();
+    outputView.reset();
+    if(!nonInterleavedBuffers){
+        return;
     }
 
-    //convert application output buffers to portaudio format
-    float* outputs = (float*)out;
+    // the arrays are bound in each callback
+    int inputChannels = globalInputRange.getChannels();
+    if(inputChannels > 0){
+        std::vector<float *> inputArrays(inputChannels, nullptr);
+        inputView.reset(new SamplesBuffer(inputArrays.data(), inputChannels, 0));
+    }
     int outputChannels = globalOutputRange.getChannels();
-    for(unsigned int i=0; i < framesPerBuffer; i++){
-        for (int c = 0; c < outputChannels; c++){
-            *outputs++ = outputBuffer->get(c, i);
-        }
+    if(outputChannels > 0){
+        std::vector<float *> outputArrays(outputChannels, nullptr);
+        outputView.reset(new SamplesBuffer(outputArrays.data(), outputChannels, 0));
     }
 }
 
+void PortAudioDriver::setUsingNonInterleavedBuffers(bool nonInterleaved)
+{
+    this->nonInterleavedBuffers = nonInterleaved;
+}
+
 //friend function, receive the pointer to PortAudioDriver instance in userData param
 int portaudioCallBack(const void *inputBuffer, void *outputBuffer,
                       unsigned long framesPerBuffer, const PaStreamCallbackTimeInfo* /*timeInfo*/,
@@ -162,10 +204,15 @@ bool PortAudioDriver::start(){
     ensureOutputRangeIsValid();
 
     recreateBuffers();//adjust the input and output buffers channels
+    recreateViews();
 
     unsigned long framesPerBuffer = bufferSize;// paFramesPerBufferUnspecified;
     qCInfo(jtAudio) << "Starting portaudio driver using" << framesPerBuffer << " as buffer size.";
-    PaSampleFormat sampleFormat = paFloat32;// | paNonInterleaved;
+    PaSampleFormat sampleFormat = paFloat32;
+    if(nonInterleavedBuffers){
+        sampleFormat |= paNonInterleaved;
+        qCInfo(jtAudio) << "Using non interleaved buffers.";
+    }
 
     PaStreamParameters inputParams;
     inputParams.channelCount = globalInputRange.getChannels();// maxInputChannels;//*/ inputChannels;
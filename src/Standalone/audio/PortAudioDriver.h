@@ -41,6 +41,13 @@ public:
     bool hasControlPanel() const override;
     void openControlPanel(void *mainWindowHandle) override;
 
+    // open the stream using paNonInterleaved, so the channels are copied without conversion. Used in the next start().
+    void setUsingNonInterleavedBuffers(bool nonInterleaved);
+    inline bool isUsingNonInterleavedBuffers() const
+    {
+        return nonInterleavedBuffers;
+    }
+
     // portaudio callback function
     friend int portaudioCallBack(const void *inputBuffer, void *outputBuffer,
                                  unsigned long framesPerBuffer,
@@ -52,6 +59,13 @@ private:
     PaStream *paStream;
     void translatePortAudioCallBack(const void *in, void *out, unsigned long framesPerBuffer);
 
+    bool nonInterleavedBuffers;
+
+    // in non interleaved mode the portaudio channels arrays are processed in place, without copies
+    QScopedPointer<SamplesBuffer> inputView;
+    QScopedPointer<SamplesBuffer> outputView;
+    void recreateViews();
+
     void changeInputSelection(int firstInputChannelIndex, int inputChannelCount);
 
     void configureHostSpecificInputParameters(PaStreamParameters &inputParameters);
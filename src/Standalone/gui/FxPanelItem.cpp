@@ -51,6 +51,7 @@ void FxPanelItem::on_buttonClicked()
 {
     if (plugin) {
         this->plugin->setBypass(!this->bypassButton->isChecked());
+        mainController->updateInputTrackGroupsLatency(); // bypassed plugins latency is not compensated
         updateStyleSheet();
     }
 }
@@ -276,6 +276,7 @@ void LocalTrackViewStandalone::addPlugin(Audio::Plugin *plugin, quint32 slotInde
 {
     if (fxPanel) {
         plugin->setBypass(bypassed);
+        controller->updateInputTrackGroupsLatency();
         fxPanel->addPlugin(plugin, slotIndex);
         refreshInputSelectionName();// refresh input type combo box, if the added plugins is a virtual instrument Jamtaba will try auto change the input type to midi
         update();
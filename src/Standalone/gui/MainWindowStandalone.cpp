@@ -330,6 +330,8 @@ PreferencesDialog *MainWindowStandalone::createPreferencesDialog()
 
     connect(dialog, SIGNAL(sampleRateChanged(int)), controller, SLOT(setSampleRate(int)));
     connect(dialog, SIGNAL(bufferSizeChanged(int)), controller, SLOT(setBufferSize(int)));
+    connect(dialog, SIGNAL(pluginsFixedBlockSizeChanged(int)), controller, SLOT(setPluginsFixedBlockSize(int)));
+    connect(dialog, SIGNAL(nonInterleavedBuffersChanged(bool)), controller, SLOT(setUsingNonInterleavedAudioBuffers(bool)));
 
     connect(controller->getPluginFinder(), SIGNAL(scanFinished(bool)), dialog, SLOT(
                 populateVstTab()));
@@ -375,11 +377,15 @@ void MainWindowStandalone::initializePluginFinder()
 
     controller->initializePluginsList(settings.getVstPluginsPaths());// load the cached plugins. The cache can be empty.
 
-    // checking for new plugins...
-    if (controller->pluginsScanIsNeeded()) {// no vsts in database cache or new plugins detected in scan folders?
+    if (controller->isUsingOfflineRender())// benchmarks are not scanning plugins
+        return;
+
+    if (controller->pluginsCacheIsEmpty()) {// no vsts in database cache?
         if (settings.getVstScanFolders().isEmpty())
             controller->addDefaultPluginsScanPath();
         controller->scanOnlyNewPlugins();
+    } else {
+        controller->detectNewPluginsInBackground();// the window is not waiting for the scan folders walk
     }
 }
 
@@ -34,6 +34,13 @@ StandalonePreferencesDialog::StandalonePreferencesDialog(QWidget *parent,
 
     connect(ui->comboSampleRate, SIGNAL(activated(int)), this, SLOT(notifySampleRateChanged()));
     connect(ui->comboBufferSize, SIGNAL(activated(int)), this, SLOT(notifyBufferSizeChanged()));
+    connect(ui->comboPluginsBlockSize, SIGNAL(activated(int)), this, SLOT(notifyPluginsFixedBlockSizeChanged()));
+}
+
+void StandalonePreferencesDialog::notifyPluginsFixedBlockSizeChanged()
+{
+    int newBlockSize = ui->comboPluginsBlockSize->currentData().toInt();
+    emit pluginsFixedBlockSizeChanged(newBlockSize);
 }
 
 void StandalonePreferencesDialog::notifyBufferSizeChanged()
@@ -78,6 +85,9 @@ void StandalonePreferencesDialog::setupSignals()
     connect(ui->buttonControlPanel, SIGNAL(clicked(bool)), this,
             SIGNAL(openingExternalAudioControlPanel()));
 
+    connect(ui->checkBoxNonInterleavedBuffers, SIGNAL(clicked(bool)), this,
+            SIGNAL(nonInterleavedBuffersChanged(bool)));
+
     connect(ui->buttonAddVstScanFolder, SIGNAL(clicked(bool)), this, SLOT(addVstScanFolder()));
 
     connect(ui->buttonClearVstAndScan, SIGNAL(clicked(bool)), this, SIGNAL(
@@ -258,6 +268,7 @@ void StandalonePreferencesDialog::populateAudioTab()
     populateSampleRateCombo();
     populateBufferSizeCombo();
 
+    ui->checkBoxNonInterleavedBuffers->setChecked(settings->isUsingNonInterleavedAudioBuffers());
     ui->buttonControlPanel->setVisible(showAudioDriverControlPanelButton);
 }
 
@@ -398,6 +409,19 @@ void StandalonePreferencesDialog::populateVstTab()
         updateVstList(path);
 
     updateBlackBox();
+
+    populatePluginsBlockSizeCombo();
+}
+
+void StandalonePreferencesDialog::populatePluginsBlockSizeCombo()
+{
+    ui->comboPluginsBlockSize->clear();
+    ui->comboPluginsBlockSize->addItem(tr("Audio driver buffer size"), 0);
+    for (int size = 64; size <= 2048; size *= 2)
+        ui->comboPluginsBlockSize->addItem(QString::number(size), size);
+
+    int index = ui->comboPluginsBlockSize->findData(settings->getPluginsFixedBlockSize());
+    ui->comboPluginsBlockSize->setCurrentIndex(index >= 0 ? index : 0);
 }
 
 void StandalonePreferencesDialog::selectTab(int index)
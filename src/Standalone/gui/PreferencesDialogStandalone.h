@@ -33,6 +33,8 @@ signals:
 
     void sampleRateChanged(int newSampleRate);
     void bufferSizeChanged(int newBufferSize);
+    void pluginsFixedBlockSizeChanged(int newBlockSize); // 0 disable the fixed block processing
+    void nonInterleavedBuffersChanged(bool nonInterleaved);
 
     void vstScanDirRemoved(const QString &scanDir);
     void vstScanDirAdded(const QString &newDir);
@@ -58,6 +60,7 @@ private slots:
 
     void notifySampleRateChanged();
     void notifyBufferSizeChanged();
+    void notifyPluginsFixedBlockSizeChanged();
 
 protected slots:
     void selectTab(int index) override;
@@ -83,6 +86,8 @@ private:
     void populateBufferSizeCombo();
     void populateAudioTab();
 
+    void populatePluginsBlockSizeCombo();
+
     void populateMidiTab();
 
     void createWidgetsToNewFolder(QString path);
@@ -1,6 +1,7 @@
 #include <QApplication>
 #include <QMainWindow>
 #include <QDir>
+#include <QCommandLineParser>
 
 #include "MainControllerStandalone.h"
 #include "gui/MainWindowStandalone.h"
@@ -8,6 +9,7 @@
 #include "log/Logging.h"
 #include "SingleApplication/singleapplication.h"
 #include "Configurator.h"
+#include "performance/Profiler.h"
 
 int main(int argc, char* args[] ){
 
@@ -29,7 +31,30 @@ int main(int argc, char* args[] ){
     QApplication* application = new QApplication(argc, args);
 #endif
 
+    // offline render benchmark, use '-platform offscreen' in machines without display
+    QCommandLineParser parser;
+    QCommandLineOption renderBenchmarkOption("render-benchmark", "Render the audio engine offline, as fast as possible, during <seconds> and print the callbacks statistics.", "seconds");
+    QCommandLineOption renderSourceOption("render-source", "The inputs used in the offline render: silence, sine, noise or a wav/ogg file path.", "source", "sine");
+    QCommandLineOption renderUsersOption("render-ninjam-users", "The remote users simulated in the offline render NINJAM room, each user is sending one Vorbis interval in each interval. Use 0 to render without the room.", "users", "4");
+    parser.addOption(renderBenchmarkOption);
+    parser.addOption(renderSourceOption);
+    parser.addOption(renderUsersOption);
+    QCommandLineOption profileOption("profile", "Enable the audio engine profiler and write a Chrome trace (chrome://tracing) in <file> when Jamtaba is closed.", "file");
+    parser.addOption(profileOption);
+    parser.parse(application->arguments());
+
+    // the profiler is enabled (and the threads rings allocated) before the audio driver is started
+    Profiling::TraceCollector traceCollector;
+    if (parser.isSet(profileOption)) {
+        Profiling::Profiler::setEnabled(true);
+        traceCollector.start();
+    }
+
     Controller::MainControllerStandalone mainController(settings, (QApplication*)application);
+    if (parser.isSet(renderBenchmarkOption))
+        mainController.setOfflineRender(parser.value(renderSourceOption), parser.value(renderBenchmarkOption).toInt(),
+                                        parser.value(renderUsersOption).toInt());
+
     mainController.start();
     if(mainController.isUsingNullAudioDriver()){
         QMessageBox::about(nullptr, "Fatal error!", "Jamtaba can't detect any audio device in your machine!");
@@ -40,7 +65,10 @@ int main(int argc, char* args[] ){
     mainWindow.initialize();
     mainWindow.show();
 
-    mainController.connectInJamtabaServer();
+    if (mainController.isUsingOfflineRender())
+        mainController.startOfflineRender();// the local inputs are created in mainWindow.initialize()
+    else
+        mainController.connectInJamtabaServer();
 
 #ifdef Q_OS_WIN
     //The SingleApplication class implements a showUp() signal. You can bind to that signal to raise your application's
@@ -48,7 +76,12 @@ int main(int argc, char* args[] ){
     QObject::connect(application, SIGNAL(showUp()), &mainWindow, SLOT(raise()));
 #endif
     int execResult = application->exec();
-    mainController.saveLastUserSettings(mainWindow.getInputsSettings());
+    if (parser.isSet(profileOption)) {
+        Profiling::Profiler::setEnabled(false);
+        traceCollector.writeChromeTrace(parser.value(profileOption));
+    }
+    if (!mainController.isUsingOfflineRender())// the benchmarks are not changing the user settings
+        mainController.saveLastUserSettings(mainWindow.getInputsSettings());
     return execResult;
  }
 
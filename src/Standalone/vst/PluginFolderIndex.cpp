@@ -0,0 +1,130 @@
+#include "PluginFolderIndex.h"
+#include "VstPluginChecker.h"
+#include "log/Logging.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+using namespace Vst;
+
+PluginFolderIndex::PluginFolderIndex(const QString &indexFilePath) :
+    indexFilePath(indexFilePath)
+{
+    load();
+}
+
+bool PluginFolderIndex::newPluginsDetected(const QStringList &scanFolders,
+                                           const QStringList &knownPlugins)
+{
+    QSet<QString> currentKnownPlugins = knownPlugins.toSet();
+
+    // some plugin is not known anymore? The unchanged folders can contain this plugin.
+    if (!currentKnownPlugins.contains(this->knownPlugins))
+        folders.clear();
+
+    QHash<QString, FolderEntry> checkedFolders;
+    bool newPluginsFound = false;
+    foreach (const QString &scanFolder, scanFolders) {
+        if (checkFolder(scanFolder, currentKnownPlugins, checkedFolders))
+            newPluginsFound = true;
+    }
+
+    qCDebug(jtStandalonePluginFinder) << "Plugin folders checked:" << checkedFolders.size()
+                                      << "new plugins found:" << newPluginsFound;
+
+    // the removed folders are discarded, only the checked folders are indexed
+    folders = checkedFolders;
+    this->knownPlugins = currentKnownPlugins;
+    save();
+
+    return newPluginsFound;
+}
+
+bool PluginFolderIndex::checkFolder(const QString &folderPath, const QSet<QString> &knownPlugins,
+                                    QHash<QString, FolderEntry> &checkedFolders) const
+{
+    QFileInfo folderInfo(folderPath);
+    if (!folderInfo.isDir() || checkedFolders.contains(folderPath))
+        return false;
+
+    FolderEntry entry;
+    entry.lastModified = folderInfo.lastModified().toMSecsSinceEpoch();
+
+    bool newPluginsFound = false;
+    QHash<QString, FolderEntry>::const_iterator indexedEntry = folders.constFind(folderPath);
+    if (indexedEntry != folders.constEnd() && indexedEntry->lastModified == entry.lastModified) {
+        entry.subFolders = indexedEntry->subFolders; // unchanged folder, no new files inside
+    } else {
+        QDir folder(folderPath);
+        QDir::Filters filters = QDir::AllEntries | QDir::NoDotAndDotDot | QDir::System | QDir::Hidden;
+        foreach (const QFileInfo &fileInfo, folder.entryInfoList(filters)) {
+            QString filePath = fileInfo.filePath();
+            if (fileInfo.isDir() && !fileInfo.isSymLink())
+                entry.subFolders.append(filePath);
+
+            if (!knownPlugins.contains(filePath) && PluginChecker::isValidPluginFile(filePath))
+                newPluginsFound = true;
+        }
+    }
+
+    // folders containing new plugins are not indexed, so they are listed again in the next check
+    qint64 folderAge = QDateTime::currentMSecsSinceEpoch() - entry.lastModified;
+    if (!newPluginsFound && folderAge >= MIN_FOLDER_AGE)
+        checkedFolders.insert(folderPath, entry);
+
+    foreach (const QString &subFolder, entry.subFolders) {
+        if (checkFolder(subFolder, knownPlugins, checkedFolders))
+            newPluginsFound = true;
+    }
+
+    return newPluginsFound;
+}
+
+void PluginFolderIndex::load()
+{
+    QFile indexFile(indexFilePath);
+    if (!indexFile.open(QFile::ReadOnly))
+        return;
+
+    QDataStream stream(&indexFile);
+    quint32 magic, revision;
+    stream >> magic >> revision;
+    if (magic != FILE_MAGIC || revision != FILE_REVISION) {
+        qCWarning(jtStandalonePluginFinder) << "Discarding invalid plugin folders index" << indexFilePath;
+        return;
+    }
+
+    quint32 totalFolders;
+    stream >> knownPlugins >> totalFolders;
+    for (quint32 i = 0; i < totalFolders && stream.status() == QDataStream::Ok; ++i) {
+        QString folderPath;
+        FolderEntry entry;
+        stream >> folderPath >> entry.lastModified >> entry.subFolders;
+        folders.insert(folderPath, entry);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        qCWarning(jtStandalonePluginFinder) << "Corrupted plugin folders index" << indexFilePath;
+        folders.clear();
+        knownPlugins.clear();
+    }
+}
+
+void PluginFolderIndex::save() const
+{
+    QFile indexFile(indexFilePath);
+    if (!indexFile.open(QFile::WriteOnly | QFile::Truncate)) {
+        qCWarning(jtStandalonePluginFinder) << "Can't write the plugin folders index" << indexFilePath;
+        return;
+    }
+
+    QDataStream stream(&indexFile);
+    stream << FILE_MAGIC << FILE_REVISION;
+    stream << knownPlugins << static_cast<quint32>(folders.size());
+    QHash<QString, FolderEntry>::const_iterator iterator = folders.constBegin();
+    for (; iterator != folders.constEnd(); ++iterator)
+        stream << iterator.key() << iterator->lastModified << iterator->subFolders;
+}
@@ -0,0 +1,63 @@
+#ifndef PLUGIN_FOLDER_INDEX_H
+#define PLUGIN_FOLDER_INDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+
+namespace Vst {
+
+/**
+ * Remember the last seen state (the modification time and the sub folders) of every
+ * folder inside the plugins scan folders. Adding or removing a file changes the folder
+ * modification time, so only the folders changed since the last check are listed and
+ * have their files checked. The unchanged folders cost just a stat.
+ *
+ * The index is discarded when some previously known plugin is not known anymore (the
+ * plugins cache was cleared, a plugin was removed from the black list, etc.), because
+ * the unchanged folders can contain plugins to be scanned again.
+ *
+ * The check is not thread safe but can run in any thread, one check at a time.
+ */
+
+class PluginFolderIndex
+{
+public:
+    explicit PluginFolderIndex(const QString &indexFilePath);
+
+    // walk the scan folders updating and saving the index. The known plugins are the cached and black listed plugins.
+    bool newPluginsDetected(const QStringList &scanFolders, const QStringList &knownPlugins);
+
+    inline int getIndexedFolders() const
+    {
+        return folders.size();
+    }
+
+private:
+    struct FolderEntry
+    {
+        qint64 lastModified;
+        QStringList subFolders;
+    };
+
+    QString indexFilePath;
+    QHash<QString, FolderEntry> folders;
+    QSet<QString> knownPlugins; // the known plugins in the last check
+
+    bool checkFolder(const QString &folderPath, const QSet<QString> &knownPlugins,
+                     QHash<QString, FolderEntry> &checkedFolders) const;
+
+    void load();
+    void save() const;
+
+    static const quint32 FILE_MAGIC = 0x4A54504C; // JTPL
+    static const quint32 FILE_REVISION = 1;
+
+    // folders modified in the last seconds are not indexed, the file system can store the modification time using seconds (or worse) precision
+    static const qint64 MIN_FOLDER_AGE = 2000;
+};
+
+}//namespace
+
+#endif
@@ -140,11 +140,12 @@ void VstPlugin::start(){
 
     int outputs = effect->numOutputs;
     int inputs = effect->numInputs;
-    qCDebug(jtVstPlugin) << "Criando internalBuffer com " << outputs << " canais e " << host->getBufferSize() << " samples";
+    int blockSize = getProcessingBlockSize();
+    qCDebug(jtVstPlugin) << "Criando internalBuffer com " << outputs << " canais e " << blockSize << " samples";
 
     //qWarning() << getName() << " ins:" << effect->numInputs << " outs:" << effect->numOutputs;
-    internalOutputBuffer = new Audio::SamplesBuffer(outputs, host->getBufferSize());
-    internalInputBuffer  = new Audio::SamplesBuffer(inputs, host->getBufferSize());
+    internalOutputBuffer = new Audio::SamplesBuffer(outputs, blockSize);
+    internalInputBuffer  = new Audio::SamplesBuffer(inputs, blockSize);
 
     vstOutputArray = new float*[outputs];
     vstInputArray = new float*[inputs];
@@ -155,7 +156,7 @@ void VstPlugin::start(){
     //setting buffer size and sample before open just to avoid problems (I see this trick in VstBoard source code)
     qCDebug(jtVstPlugin) << "setting sample rate and block size " << QThread::currentThreadId();
     effect->dispatcher(effect, effSetSampleRate, 0, 0, NULL, host->getSampleRate());
-    effect->dispatcher(effect, effSetBlockSize, 0, host->getBufferSize(), NULL, 0.0f);
+    effect->dispatcher(effect, effSetBlockSize, 0, blockSize, NULL, 0.0f);
 
     //qCDebug(vst) << "opening" << getName();
     effect->dispatcher(effect, effOpen, 0, 0, NULL, 0.0f);
@@ -163,7 +164,7 @@ void VstPlugin::start(){
 
     qCDebug(jtVstPlugin) << "setting sample rate and block size " << QThread::currentThreadId();
     effect->dispatcher(effect, effSetSampleRate, 0, 0, NULL, host->getSampleRate());
-    effect->dispatcher(effect, effSetBlockSize, 0, host->getBufferSize(), NULL, 0.0f);
+    effect->dispatcher(effect, effSetBlockSize, 0, blockSize, NULL, 0.0f);
     //qCDebug(vst) << "sample rate and block size setted for " << getName();
 
     //qCDebug(vst) << "checking for plugin midi capabilities";
@@ -179,6 +180,44 @@ void VstPlugin::start(){
     suspend();
 }
 
+int VstPlugin::getProcessingBlockSize() const{
+    if(isUsingFixedBlockSize()){
+        return getFixedBlockSize();
+    }
+    return host->getBufferSize();
+}
+
+//called with the audio processing locked (see MainControllerStandalone::setPluginsFixedBlockSize), the plugin is not processing
+void VstPlugin::setFixedBlockSize(int blockSize){
+    Audio::Plugin::setFixedBlockSize(blockSize);
+    if(!effect || !started){
+        return;//the block size will be set in start()
+    }
+
+    //the internal buffers are resized here, the audio thread is not allocating in the first processed block
+    int processingBlockSize = getProcessingBlockSize();
+    internalInputBuffer->setFrameLenght(processingBlockSize);
+    internalOutputBuffer->setFrameLenght(processingBlockSize);
+
+    //effSetBlockSize can be called only when the plugin is suspended
+    bool wasTurnedOn = turnedOn;
+    if(wasTurnedOn){
+        suspend();
+    }
+    effect->dispatcher(effect, effSetBlockSize, 0, processingBlockSize, NULL, 0.0f);
+    if(wasTurnedOn){
+        resume();
+    }
+}
+
+int VstPlugin::getLatency() const{
+    int latency = Audio::Plugin::getLatency();
+    if(effect && loaded){
+        latency += qMax(0, (int)effect->initialDelay);
+    }
+    return latency;
+}
+
 void VstPlugin::setSampleRate(int newSampleRate){
     if(effect){
         effect->dispatcher(effect, effSetSampleRate, 0, 0, NULL, newSampleRate);
@@ -240,7 +279,6 @@ void VstPlugin::fillVstEventsList(const QList<Midi::MidiMessage> &midiBuffer){
 
 void VstPlugin::process(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &outBuffer, const QList<Midi::MidiMessage> &midiBuffer){
 
-    Q_UNUSED(in)
     if( isBypassed() || !effect || !loaded || !started){
         return;
     }
@@ -255,25 +293,43 @@ void VstPlugin::process(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &ou
         effect->dispatcher(effect, effProcessEvents, 0, 0, (void*)&vstMidiEvents, 0);
     }
 
-    internalOutputBuffer->setFrameLenght(outBuffer.getFrameLenght());
-    internalInputBuffer->setFrameLenght(outBuffer.getFrameLenght());
-
-    internalInputBuffer->set(in);
+    VstInt32 sampleFrames = outBuffer.getFrameLenght();
+    bool isSynth = effect->flags & effFlagsIsSynth;
+    bool canReplace = effect->flags & effFlagsCanReplacing;
 
+    // when the channels are matching the chain buffers are passed directly to the plugin, without copies
     int inChannels = internalInputBuffer->getChannels();
+    int outChannels = internalOutputBuffer->getChannels();
+    bool usingChainInput = &in != &outBuffer && in.getChannels() == inChannels && in.getFrameLenght() >= sampleFrames;
+    bool usingChainOutput = canReplace && !isSynth && outBuffer.getChannels() == outChannels;
+
+    const Audio::SamplesBuffer *inputBuffer = &in;
+    if(!usingChainInput){
+        internalInputBuffer->setFrameLenght(sampleFrames);
+        internalInputBuffer->set(in);
+        inputBuffer = internalInputBuffer;
+    }
     for (int c = 0; c < inChannels; ++c) {
-        vstInputArray[c] = internalInputBuffer->getSamplesArray(c);
+        vstInputArray[c] = inputBuffer->getSamplesArray(c);
     }
 
-    int outChannels = internalOutputBuffer->getChannels();
+    Audio::SamplesBuffer *outputBuffer = &outBuffer;
+    if(!usingChainOutput){
+        internalOutputBuffer->setFrameLenght(sampleFrames);
+        outputBuffer = internalOutputBuffer;
+    }
     for (int c = 0; c < outChannels; ++c) {
-        vstOutputArray[c] = internalOutputBuffer->getSamplesArray(c);
+        vstOutputArray[c] = outputBuffer->getSamplesArray(c);
     }
 
-    VstInt32 sampleFrames = outBuffer.getFrameLenght();
-    if(effect->flags & effFlagsCanReplacing){
+    if(canReplace){
         effect->processReplacing(effect, vstInputArray, vstOutputArray, sampleFrames);
     }
+
+    if(usingChainOutput){
+        return; // the plugin replaced the samples in outBuffer
+    }
+
     //after a lot of tests I realize VSTs are processing input samples and
     //replacing the output buffer with these processed samples.
     //But VSTis are generating output samples directly, without touch the input
@@ -281,7 +337,7 @@ void VstPlugin::process(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &ou
     //the output generated by the last processor. So, if VSTis are ignoring this input
     //they will generate a fresh output and replacing the last outputs. The result
     //is just the last VTSi in the chain can be heard.
-    if(effect->flags & effFlagsIsSynth){
+    if(isSynth){
         outBuffer.add(*internalOutputBuffer);//VSTis add and preserve the last generated output samples
     }
     else{
@@ -47,6 +47,10 @@ public:
 
     void setBypass(bool state);
 
+    void setFixedBlockSize(int blockSize) override;
+
+    int getLatency() const override; // the fixed block latency + the plugin initial delay
+
     static QDialog *getPluginEditorWindow(QString pluginName);
 
     bool isVirtualInstrument() const override;
@@ -62,6 +66,7 @@ protected:
     void suspend();
 private:
     bool initPlugin();
+    int getProcessingBlockSize() const; // the fixed block size or the host block size
     AEffect *effect;
     Audio::SamplesBuffer *internalOutputBuffer;
     Audio::SamplesBuffer *internalInputBuffer;
@@ -6,6 +6,7 @@
 #include "Plugin.h"
 #include "log/Logging.h"
 #include "Editor.h"
+#include "audio/core/AudioMixer.h"
 
 using namespace Controller;
 
@@ -83,7 +84,52 @@ void MainControllerVST::setSampleRate(int newSampleRate)
 
 Controller::NinjamController *MainControllerVST::createNinjamController()
 {
-    return new NinjamControllerVST(this);
+    NinjamControllerVST *controller = new NinjamControllerVST(this);
+
+    usersOutputBuses.clear();
+    channelsUsers.clear();
+    if (plugin && plugin->getOutputPairs() > 1) {
+        connect(controller, SIGNAL(channelAdded(Ninjam::User, Ninjam::UserChannel, long)), this, SLOT(routeChannelToOutputBus(Ninjam::User, Ninjam::UserChannel, long)));
+        connect(controller, SIGNAL(channelRemoved(Ninjam::User, Ninjam::UserChannel, long)), this, SLOT(releaseChannelOutputBus(Ninjam::User, Ninjam::UserChannel, long)));
+    }
+
+    return controller;
+}
+
+int MainControllerVST::getFreeOutputBus() const
+{
+    QList<int> usedBuses = usersOutputBuses.values();
+    for (int bus = 1; bus < plugin->getOutputPairs(); ++bus) {
+        if (!usedBuses.contains(bus))
+            return bus;
+    }
+    return Audio::AudioMixer::MASTER_BUS; // all output pairs are used, the next users are mixed in the master output
+}
+
+void MainControllerVST::routeChannelToOutputBus(const Ninjam::User &user, const Ninjam::UserChannel &channel, long channelID)
+{
+    Q_UNUSED(channel)
+
+    QString userFullName = user.getFullName();
+    if (!usersOutputBuses.contains(userFullName)) { // the first channel from this user
+        int bus = getFreeOutputBus();
+        if (bus == Audio::AudioMixer::MASTER_BUS)
+            qCInfo(jtCore) << "No free output pair for" << userFullName << "- using the master output";
+        usersOutputBuses.insert(userFullName, bus);
+    }
+
+    channelsUsers.insert(channelID, userFullName);
+    setTrackOutputBus(channelID, usersOutputBuses[userFullName]);
+}
+
+void MainControllerVST::releaseChannelOutputBus(const Ninjam::User &user, const Ninjam::UserChannel &channel, long channelID)
+{
+    Q_UNUSED(channel)
+
+    QString userFullName = user.getFullName();
+    channelsUsers.remove(channelID);
+    if (!channelsUsers.values().contains(userFullName))
+        usersOutputBuses.remove(userFullName); // the last channel from this user, the output pair can be used by other user
 }
 
 Midi::MidiDriver *MainControllerVST::createMidiDriver()
@@ -11,6 +11,8 @@ class JamtabaPlugin;
 
 class MainControllerVST : public Controller::MainController
 {
+    Q_OBJECT
+
 public:
     MainControllerVST(const Persistence::Settings &settings, JamtabaPlugin *plugin);
     ~MainControllerVST();
@@ -62,15 +64,32 @@ public:
         return emptyBuffer;
     }
 
+public slots:
+    // the hosts are reading the outputs count only when the plugin is loaded, the setting is used in the next plugin instance
+    inline void storeUsingMultiOutputs(bool usingMultiOutputs)
+    {
+        settings.setUsingVstMultiOutputs(usingMultiOutputs);
+    }
+
 protected:
     inline Midi::MidiMessageBuffer pullMidiMessagesFromDevices() override
     {
         static Midi::MidiMessageBuffer emptyBuffer(0);
         return emptyBuffer;
     }
+private slots:
+    // multi output plugin, each remote user is routed to a output pair
+    void routeChannelToOutputBus(const Ninjam::User &user, const Ninjam::UserChannel &channel, long channelID);
+    void releaseChannelOutputBus(const Ninjam::User &user, const Ninjam::UserChannel &channel, long channelID);
+
 private:
     int sampleRate;
     JamtabaPlugin *plugin;
+
+    QMap<QString, int> usersOutputBuses; // remote user full name -> output bus
+    QMap<long, QString> channelsUsers; // channel ID -> remote user full name
+
+    int getFreeOutputBus() const;
 };
 
 #endif // MAINCONTROLLERVST_H
@@ -56,7 +56,8 @@ void MainWindowVST::setFullViewStatus(bool fullViewActivated)
 
 PreferencesDialog *MainWindowVST::createPreferencesDialog()
 {
-    PreferencesDialog * dialog = new VstPreferencesDialog(this);
+    VstPreferencesDialog * dialog = new VstPreferencesDialog(this);
     setupPreferencesDialogSignals(dialog);
+    connect(dialog, SIGNAL(multiOutputsChanged(bool)), getMainController(), SLOT(storeUsingMultiOutputs(bool)));
     return dialog;
 }
@@ -13,6 +13,9 @@
 // anti troll scheme to avoid multiple connections in ninjam servers
 bool JamtabaPlugin::instanceIsInitialized = false;
 
+// the views are created without arrays, the host arrays are bound in processReplacing()
+static float *const UNBOUND_CHANNELS[DEFAULT_INPUTS*2 + MULTI_OUTPUTS*2] = {};
+
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 AudioEffect *createEffectInstance(audioMasterCallback audioMaster)
 {
@@ -31,14 +34,16 @@ JamtabaPlugin::JamtabaPlugin (audioMasterCallback audioMaster) :
     listEvnts(0),
     controller(nullptr),
     running(false),
+    outputPairs(readOutputPairs()),
     inputBuffer(DEFAULT_INPUTS*2),
-    outputBuffer(DEFAULT_OUTPUTS*2),
+    inputView(UNBOUND_CHANNELS, DEFAULT_INPUTS*2, 0),
+    outputView(UNBOUND_CHANNELS, outputPairs*2, 0),
     timeInfo(nullptr),
     hostWasPlayingInLastAudioCallBack(false)
 {
     qCDebug(jtVstPlugin) << "Plugin constructor...";
     setNumInputs(DEFAULT_INPUTS*2);
-    setNumOutputs(DEFAULT_OUTPUTS*2);
+    setNumOutputs(outputPairs*2);
 
     isSynth(false);
     canProcessReplacing(true);
@@ -53,6 +58,14 @@ JamtabaPlugin::JamtabaPlugin (audioMasterCallback audioMaster) :
     qCDebug(jtVstPlugin) << "Plugin constructor done.";
 }
 
+int JamtabaPlugin::readOutputPairs()
+{
+    // the hosts are reading the outputs count only when the plugin is loaded, so changes in this setting are used in the next plugin instance
+    Persistence::Settings settings;
+    settings.load();
+    return settings.isUsingVstMultiOutputs() ? MULTI_OUTPUTS : DEFAULT_OUTPUTS;
+}
+
 QString JamtabaPlugin::getHostName()
 {
     char tempChars[kVstMaxProductStrLen];
@@ -149,6 +162,22 @@ void JamtabaPlugin::close()
     JamtabaPlugin::instanceIsInitialized = false; // the anti troll flag :)
 }
 
+bool JamtabaPlugin::getOutputProperties(VstInt32 index, VstPinProperties *properties)
+{
+    if (!properties || index < 0 || index >= outputPairs * 2)
+        return false;
+
+    int pair = index / 2;
+    QString pairName = pair == 0 ? QString("Master") : QString("User %1").arg(pair);
+    QString label = pairName + (index % 2 == 0 ? " L" : " R");
+    vst_strncpy(properties->label, label.toUtf8().constData(), kVstMaxLabelLen - 1);
+    vst_strncpy(properties->shortLabel, label.toUtf8().constData(), kVstMaxShortLabelLen - 1);
+    properties->flags = kVstPinIsActive;
+    if (index % 2 == 0)
+        properties->flags |= kVstPinIsStereo; // the first pin in each stereo pair
+    return true;
+}
+
 VstInt32 JamtabaPlugin::getNumMidiInputChannels()
 {
     return 0;
@@ -235,23 +264,37 @@ void JamtabaPlugin::processReplacing(float **inputs, float **outputs, VstInt32 s
     }
 
     // ++++++++++ Audio processing +++++++++++++++
-    inputBuffer.setFrameLenght(sampleFrames);
-    for (int c = 0; c < inputBuffer.getChannels(); ++c)
-        memcpy(inputBuffer.getSamplesArray(c), inputs[c], sizeof(float) * sampleFrames);
-
-    outputBuffer.setFrameLenght(sampleFrames);
-    outputBuffer.zero();
+    // the host arrays are processed directly, the inputs are copied only if the host is using the same arrays for inputs and outputs
+    const Audio::SamplesBuffer *in = &inputView;
+    if (hostIsProcessingInPlace(inputs, outputs)) {
+        inputBuffer.setFrameLenght(sampleFrames);
+        for (int c = 0; c < inputBuffer.getChannels(); ++c)
+            memcpy(inputBuffer.getSamplesArray(c), inputs[c], sizeof(float) * sampleFrames);
+        in = &inputBuffer;
+    } else {
+        inputView.bind(inputs, sampleFrames);
+    }
 
-    controller->process(inputBuffer, outputBuffer, this->sampleRate);
+    outputView.bind(outputs, sampleFrames);
+    outputView.zero();
 
-    int channels = outputBuffer.getChannels();
-    for (int c = 0; c < channels; ++c)
-        memcpy(outputs[c], outputBuffer.getSamplesArray(c), sizeof(float) * sampleFrames);
+    controller->process(*in, outputView, this->sampleRate);
 
     // ++++++++++++++++++++++++++++++
     hostWasPlayingInLastAudioCallBack = hostIsPlaying();
 }
 
+bool JamtabaPlugin::hostIsProcessingInPlace(float **inputs, float **outputs) const
+{
+    for (int in = 0; in < inputView.getChannels(); ++in) {
+        for (int out = 0; out < outputView.getChannels(); ++out) {
+            if (inputs[in] == outputs[out])
+                return true;
+        }
+    }
+    return false;
+}
+
 void JamtabaPlugin::setSampleRate(float sampleRate)
 {
     qCDebug(jtVstPlugin) << "JamtabaPlugin::setSampleRate()";
@@ -6,6 +6,7 @@
 #define VST_EVENT_BUFFER_SIZE 1000
 #define DEFAULT_INPUTS 2
 #define DEFAULT_OUTPUTS 1
+#define MULTI_OUTPUTS 8 // master mix and 7 remote users, see Settings::isUsingVstMultiOutputs()
 
 #include "MainControllerVST.h"
 
@@ -41,6 +42,8 @@ public:
     bool getProductString(char *text);
     VstInt32 getVendorVersion();
 
+    bool getOutputProperties(VstInt32 index, VstPinProperties *properties);
+
     VstInt32 getNumMidiInputChannels();
     VstInt32 getNumMidiOutputChannels();
 
@@ -66,6 +69,11 @@ public:
 
     int getHostBpm() const;
 
+    inline int getOutputPairs() const
+    {
+        return outputPairs;
+    }
+
 protected:
     char programName[kVstMaxProgNameLen + 1];
     int sampleRate;
@@ -74,8 +82,13 @@ protected:
 private:
     QScopedPointer<MainControllerVST> controller;
     bool running;
-    Audio::SamplesBuffer inputBuffer;
-    Audio::SamplesBuffer outputBuffer;
+    const int outputPairs; // stereo outputs, the first pair is the master mix
+    Audio::SamplesBuffer inputBuffer; // used when the host is processing in place
+    Audio::SamplesBuffer inputView; // the host arrays are bound in each processReplacing() call
+    Audio::SamplesBuffer outputView;
+
+    bool hostIsProcessingInPlace(float **inputs, float **outputs) const;
+    static int readOutputPairs();
 
     VstTimeInfo *timeInfo;
     bool hostWasPlayingInLastAudioCallBack;
@@ -1,13 +1,39 @@
 #include "VstPreferencesDialog.h"
+#include "persistence/Settings.h"
+#include <QCheckBox>
+#include <QLabel>
+#include <QVBoxLayout>
 
 VstPreferencesDialog::VstPreferencesDialog(QWidget *parent) :
-    PreferencesDialog(parent)
+    PreferencesDialog(parent),
+    multiOutputsCheckBox(nullptr)
 {
     // in Vst plugin some preferences are not available
     // remove the first 3 tabs (audio, midi and VSTs)
     ui->prefsTab->removeTab(0);
     ui->prefsTab->removeTab(0);
     ui->prefsTab->removeTab(0);
+
+    createOutputsTab();
+}
+
+void VstPreferencesDialog::createOutputsTab()
+{
+    QWidget *outputsTab = new QWidget();
+    QVBoxLayout *layout = new QVBoxLayout(outputsTab);
+
+    multiOutputsCheckBox = new QCheckBox(tr("Route each remote user to a separated stereo output"));
+    layout->addWidget(multiOutputsCheckBox);
+
+    // the hosts are reading the outputs count only when the plugin is loaded
+    QLabel *noteLabel = new QLabel(tr("The outputs are changed in the next Jamtaba plugin instance."));
+    noteLabel->setWordWrap(true);
+    layout->addWidget(noteLabel);
+    layout->addStretch();
+
+    ui->prefsTab->addTab(outputsTab, tr("Outputs"));
+
+    connect(multiOutputsCheckBox, SIGNAL(clicked(bool)), this, SIGNAL(multiOutputsChanged(bool)));
 }
 
 void VstPreferencesDialog::initialize(PreferencesTab initialTab, const Persistence::Settings *settings, const QMap<QString, QString> &jamRecorders)
@@ -19,13 +45,22 @@ void VstPreferencesDialog::initialize(PreferencesTab initialTab, const Persisten
 
 void VstPreferencesDialog::selectTab(int index)
 {
-    if (index == 0) //only the recording and metronome tabs are available in VST plugin
+    //only the recording, metronome and outputs tabs are available in VST plugin
+    if (index == 0)
         populateRecordingTab();
-    else
+    else if (index == 1)
         populateMetronomeTab();
+    else
+        populateOutputsTab();
 }
 
 void VstPreferencesDialog::populateAllTabs(){
     populateRecordingTab();
     populateMetronomeTab();
+    populateOutputsTab();
+}
+
+void VstPreferencesDialog::populateOutputsTab()
+{
+    multiOutputsCheckBox->setChecked(settings->isUsingVstMultiOutputs());
 }
@@ -4,6 +4,8 @@
 #include "PreferencesDialog.h"
 #include "ui_PreferencesDialog.h"
 
+class QCheckBox;
+
 class VstPreferencesDialog : public PreferencesDialog
 {
     Q_OBJECT
@@ -12,11 +14,19 @@ public:
     VstPreferencesDialog(QWidget *parent);
     void initialize(PreferencesTab initialTab, const Persistence::Settings *settings, const QMap<QString, QString> &jamRecorders) override;
 
+signals:
+    void multiOutputsChanged(bool usingMultiOutputs);
+
 protected slots:
     void selectTab(int index) override;
 
 protected:
     void populateAllTabs() override;
+
+private:
+    QCheckBox *multiOutputsCheckBox;
+    void createOutputsTab();
+    void populateOutputsTab();
 };
 
 #endif
@@ -0,0 +1,120 @@
+#include "TestAudioMixer.h"
+#include "audio/core/AudioMixer.h"
+#include "audio/core/AudioNode.h"
+#include "midi/MidiMessageBuffer.h"
+#include <QTest>
+
+using namespace Audio;
+
+namespace {
+
+// a node summing a constant value in the output, without gain, pan or plugins
+class ConstantNode : public AudioNode
+{
+public:
+    explicit ConstantNode(float value) :
+        value(value)
+    {
+    }
+
+    void processReplacing(const SamplesBuffer &in, SamplesBuffer &out, int sampleRate,
+                          const Midi::MidiMessageBuffer &midiBuffer) override
+    {
+        Q_UNUSED(in)
+        Q_UNUSED(sampleRate)
+        Q_UNUSED(midiBuffer)
+        for (int c = 0; c < out.getChannels(); ++c) {
+            for (int s = 0; s < out.getFrameLenght(); ++s)
+                out.set(c, s, out.get(c, s) + value);
+        }
+    }
+
+private:
+    float value;
+};
+
+void process(AudioMixer &mixer, SamplesBuffer &out)
+{
+    SamplesBuffer in(2, out.getFrameLenght());
+    in.zero();
+    out.zero();
+    Midi::MidiMessageBuffer midiBuffer(0);
+    mixer.process(in, out, 44100, midiBuffer, false);
+}
+
+void checkChannels(const SamplesBuffer &out, int firstChannel, float expectedValue)
+{
+    for (int c = firstChannel; c < firstChannel + 2; ++c) {
+        for (int s = 0; s < out.getFrameLenght(); ++s)
+            QCOMPARE(out.get(c, s), expectedValue);
+    }
+}
+
+} // namespace
+
+void TestAudioMixer::routedNodesAreNotMixedInTheMasterBus()
+{
+    ConstantNode masterNode(0.25f);
+    ConstantNode routedNode(0.5f);
+    AudioMixer mixer(44100);
+    mixer.addNode(&masterNode);
+    mixer.addNode(&routedNode);
+    mixer.setOutputBus(&routedNode, 1);
+
+    SamplesBuffer out(4, 64);
+    process(mixer, out);
+
+    checkChannels(out, 0, 0.25f); // pair 0 is the master bus, the routed node is excluded
+    checkChannels(out, 2, 0.5f);
+
+    mixer.setOutputBus(&routedNode, AudioMixer::MASTER_BUS); // routed back to the master bus
+    process(mixer, out);
+
+    checkChannels(out, 0, 0.75f);
+    checkChannels(out, 2, 0.0f);
+
+    mixer.removeNode(&masterNode);
+    mixer.removeNode(&routedNode);
+}
+
+void TestAudioMixer::stereoOutputIsMixingAllNodes()
+{
+    ConstantNode masterNode(0.25f);
+    ConstantNode routedNode(0.5f);
+    AudioMixer mixer(44100);
+    mixer.addNode(&masterNode);
+    mixer.addNode(&routedNode);
+    mixer.setOutputBus(&routedNode, 1);
+
+    SamplesBuffer out(2, 64); // only the master bus
+    process(mixer, out);
+
+    checkChannels(out, 0, 0.75f);
+
+    mixer.removeNode(&masterNode);
+    mixer.removeNode(&routedNode);
+}
+
+void TestAudioMixer::invalidBusesAreUsingTheMasterBus()
+{
+    ConstantNode masterNode(0.25f);
+    ConstantNode routedNode(0.5f);
+    AudioMixer mixer(44100);
+    mixer.addNode(&masterNode);
+    mixer.addNode(&routedNode);
+
+    SamplesBuffer out(4, 64);
+
+    mixer.setOutputBus(&routedNode, AudioMixer::MAX_OUTPUT_BUSES); // buses are not created in the audio thread
+    process(mixer, out);
+    checkChannels(out, 0, 0.75f);
+    checkChannels(out, 2, 0.0f);
+
+    mixer.setOutputBus(&routedNode, 2); // valid bus, but the output has only 2 stereo pairs
+    process(mixer, out);
+    checkChannels(out, 0, 0.75f);
+    checkChannels(out, 2, 0.0f);
+
+    mixer.removeNode(&masterNode);
+    mixer.removeNode(&routedNode);
+}
@@ -0,0 +1,16 @@
+#ifndef TEST_AUDIO_MIXER_H
+#define TEST_AUDIO_MIXER_H
+
+#include <QObject>
+
+class TestAudioMixer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void routedNodesAreNotMixedInTheMasterBus();
+    void stereoOutputIsMixingAllNodes();
+    void invalidBusesAreUsingTheMasterBus();
+};
+
+#endif
@@ -0,0 +1,44 @@
+#include "TestDelayLine.h"
+#include "audio/core/DelayLine.h"
+#include "audio/core/SamplesBuffer.h"
+#include <QTest>
+
+using namespace Audio;
+
+void TestDelayLine::delayedSamples_data()
+{
+    QTest::addColumn<int>("delay");
+    QTest::addColumn<QString>("bufferSizes");
+
+    QTest::newRow("No delay") << 0 << "64,64";
+    QTest::newRow("Delay smaller than buffers") << 10 << "64,33,128";
+    QTest::newRow("Delay bigger than buffers") << 100 << "16,7,64,32,128";
+}
+
+void TestDelayLine::delayedSamples()
+{
+    QFETCH(int, delay);
+    QFETCH(QString, bufferSizes);
+
+    DelayLine delayLine(1);
+    delayLine.setDelay(delay);
+    QCOMPARE(delayLine.getDelay(), delay);
+
+    int position = 0;
+    foreach (const QString &size, bufferSizes.split(",")) {
+        int frames = size.toInt();
+        SamplesBuffer in(1, frames);
+        SamplesBuffer out(1, frames);
+        for (int s = 0; s < frames; ++s)
+            in.set(0, s, position + s + 1);
+
+        delayLine.process(in, out);
+
+        for (int s = 0; s < frames; ++s) {
+            int delayedPosition = position + s - delay;
+            float expectedValue = delayedPosition >= 0 ? delayedPosition + 1 : 0;
+            QCOMPARE(out.get(0, s), expectedValue);
+        }
+        position += frames;
+    }
+}
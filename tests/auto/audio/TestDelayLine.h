@@ -0,0 +1,15 @@
+#ifndef TEST_DELAY_LINE_H
+#define TEST_DELAY_LINE_H
+
+#include <QObject>
+
+class TestDelayLine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void delayedSamples_data();
+    void delayedSamples();
+};
+
+#endif
@@ -0,0 +1,41 @@
+#include "TestDspLoadMeter.h"
+#include "audio/core/DspLoadMeter.h"
+#include <QTest>
+
+using namespace Audio;
+
+void TestDspLoadMeter::loadConvergesToProcessingRatio_data()
+{
+    QTest::addColumn<int>("sampleRate");
+    QTest::addColumn<int>("frames");
+    QTest::addColumn<float>("expectedLoad");
+
+    QTest::newRow("Idle") << 44100 << 128 << 0.0f;
+    QTest::newRow("Half buffer period") << 48000 << 256 << 0.5f;
+    QTest::newRow("Xruns") << 96000 << 64 << 1.5f;
+}
+
+void TestDspLoadMeter::loadConvergesToProcessingRatio()
+{
+    QFETCH(int, sampleRate);
+    QFETCH(int, frames);
+    QFETCH(float, expectedLoad);
+
+    qint64 bufferPeriod = (qint64)frames * 1000000000 / sampleRate;
+    DspLoadMeter meter;
+    for (int i = 0; i < 1000; ++i)
+        meter.update(bufferPeriod * expectedLoad, frames, sampleRate);
+
+    QVERIFY(qAbs(meter.getLoad() - expectedLoad) < 0.001f);
+
+    meter.reset();
+    QCOMPARE(meter.getLoad(), 0.0f);
+}
+
+void TestDspLoadMeter::invalidBuffersAreIgnored()
+{
+    DspLoadMeter meter;
+    meter.update(1000000, 0, 44100);
+    meter.update(1000000, 128, 0);
+    QCOMPARE(meter.getLoad(), 0.0f);
+}
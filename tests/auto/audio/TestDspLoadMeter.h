@@ -0,0 +1,16 @@
+#ifndef TEST_DSP_LOAD_METER_H
+#define TEST_DSP_LOAD_METER_H
+
+#include <QObject>
+
+class TestDspLoadMeter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void loadConvergesToProcessingRatio_data();
+    void loadConvergesToProcessingRatio();
+    void invalidBuffersAreIgnored();
+};
+
+#endif
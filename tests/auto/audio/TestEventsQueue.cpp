@@ -0,0 +1,108 @@
+#include "TestEventsQueue.h"
+#include "audio/core/EventsQueue.h"
+#include <QTest>
+#include <QThread>
+#include <QVector>
+
+using namespace Audio;
+
+namespace {
+
+struct Event
+{
+    Event(int producer = 0, int value = 0) :
+        producer(producer),
+        value(value),
+        nextInQueue(nullptr)
+    {
+    }
+
+    int producer;
+    int value;
+    Event *nextInQueue;
+};
+
+class ProducerThread : public QThread
+{
+public:
+    ProducerThread(EventsQueue<Event> &queue, QVector<Event> &events) :
+        queue(queue),
+        events(events)
+    {
+    }
+
+protected:
+    void run() override
+    {
+        for (int i = 0; i < events.size(); ++i)
+            queue.push(&events[i]);
+    }
+
+private:
+    EventsQueue<Event> &queue;
+    QVector<Event> &events;
+};
+
+} // namespace
+
+void TestEventsQueue::takeAllInPushOrder()
+{
+    EventsQueue<Event> queue;
+    QVERIFY(queue.isEmpty());
+    QVERIFY(queue.takeAll() == nullptr);
+
+    QVector<Event> events;
+    for (int i = 0; i < 5; ++i)
+        events.append(Event(0, i));
+    for (int i = 0; i < events.size(); ++i)
+        queue.push(&events[i]);
+    QVERIFY(!queue.isEmpty());
+
+    int expectedValue = 0;
+    for (Event *event = queue.takeAll(); event; event = event->nextInQueue)
+        QCOMPARE(event->value, expectedValue++);
+    QCOMPARE(expectedValue, events.size());
+    QVERIFY(queue.isEmpty());
+
+    // the taken events can be pushed again (the return queue)
+    queue.push(&events[3]);
+    Event *event = queue.takeAll();
+    QCOMPARE(event, &events[3]);
+    QVERIFY(event->nextInQueue == nullptr);
+}
+
+void TestEventsQueue::concurrentProducers()
+{
+    static const int PRODUCERS = 4;
+    static const int EVENTS_PER_PRODUCER = 20000;
+
+    EventsQueue<Event> queue;
+    QVector<QVector<Event> > events(PRODUCERS);
+    QList<ProducerThread *> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        for (int i = 0; i < EVENTS_PER_PRODUCER; ++i)
+            events[p].append(Event(p, i));
+        producers.append(new ProducerThread(queue, events[p]));
+    }
+    foreach (ProducerThread *producer, producers)
+        producer->start();
+
+    // the consumer is taking while the producers are pushing, the order of each producer is preserved
+    QVector<int> nextValues(PRODUCERS, 0);
+    int takenEvents = 0;
+    bool ordered = true;
+    while (takenEvents < PRODUCERS * EVENTS_PER_PRODUCER) {
+        for (Event *event = queue.takeAll(); event; event = event->nextInQueue) {
+            ordered &= event->value == nextValues[event->producer];
+            nextValues[event->producer] = event->value + 1;
+            takenEvents++;
+        }
+    }
+
+    foreach (ProducerThread *producer, producers) {
+        producer->wait();
+        delete producer;
+    }
+    QVERIFY(ordered);
+    QVERIFY(queue.isEmpty());
+}
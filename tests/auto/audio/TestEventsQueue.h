@@ -0,0 +1,15 @@
+#ifndef TEST_EVENTS_QUEUE_H
+#define TEST_EVENTS_QUEUE_H
+
+#include <QObject>
+
+class TestEventsQueue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void takeAllInPushOrder();
+    void concurrentProducers();
+};
+
+#endif
@@ -0,0 +1,115 @@
+#include "TestFixedBlockAdapter.h"
+#include "audio/core/FixedBlockAdapter.h"
+#include "audio/core/AudioNodeProcessor.h"
+#include "audio/core/SamplesBuffer.h"
+#include <QTest>
+#include <QPoint>
+
+using namespace Audio;
+
+class PassThroughProcessor : public AudioNodeProcessor
+{
+public:
+    void process(const SamplesBuffer &in, SamplesBuffer &out, const QList<Midi::MidiMessage> &midiMessages) override
+    {
+        Q_UNUSED(midiMessages)
+        processedBlocks.append(in.getFrameLenght());
+        out.set(in);
+    }
+
+    void suspend() override {}
+    void resume() override {}
+    void updateGui() override {}
+    void openEditor(const QPoint &) override {}
+    void closeEditor() override {}
+
+    QList<int> processedBlocks;
+};
+
+void TestFixedBlockAdapter::powerOfTwoBlockSize_data()
+{
+    QTest::addColumn<int>("requestedSize");
+    QTest::addColumn<int>("expectedSize");
+
+    QTest::newRow("Power of two is preserved") << 256 << 256;
+    QTest::newRow("Rounding up") << 300 << 512;
+    QTest::newRow("Small values") << 1 << FixedBlockAdapter::MIN_BLOCK_SIZE;
+    QTest::newRow("Huge values") << 100000 << FixedBlockAdapter::MAX_BLOCK_SIZE;
+}
+
+void TestFixedBlockAdapter::powerOfTwoBlockSize()
+{
+    QFETCH(int, requestedSize);
+    QFETCH(int, expectedSize);
+
+    QCOMPARE(FixedBlockAdapter::toPowerOfTwo(requestedSize), expectedSize);
+
+    PassThroughProcessor processor;
+    processor.setFixedBlockSize(requestedSize);
+    QCOMPARE(processor.getFixedBlockSize(), expectedSize);
+    QCOMPARE(processor.getLatency(), expectedSize - 1);
+}
+
+void TestFixedBlockAdapter::irregularBuffersAreDelayedByLatency_data()
+{
+    QTest::addColumn<int>("blockSize");
+    QTest::addColumn<QString>("bufferSizes");
+
+    QTest::newRow("Irregular sub blocks") << 64 << "100,37,256,5,300,1,64";
+    QTest::newRow("Buffers smaller than block") << 128 << "10,20,30,40,50,60,70";
+    QTest::newRow("Buffers equal to block") << 32 << "32,32,32,32";
+}
+
+void TestFixedBlockAdapter::irregularBuffersAreDelayedByLatency()
+{
+    QFETCH(int, blockSize);
+    QFETCH(QString, bufferSizes);
+
+    PassThroughProcessor processor;
+    processor.setFixedBlockSize(blockSize);
+    int latency = processor.getLatency();
+
+    int position = 0;
+    foreach (const QString &size, bufferSizes.split(",")) {
+        int frames = size.toInt();
+        SamplesBuffer in(1, frames);
+        SamplesBuffer out(1, frames);
+        for (int s = 0; s < frames; ++s)
+            in.set(0, s, position + s + 1);
+
+        processor.processBuffered(in, out, QList<Midi::MidiMessage>());
+
+        for (int s = 0; s < frames; ++s) {
+            int delayedPosition = position + s - latency;
+            float expectedValue = delayedPosition >= 0 ? delayedPosition + 1 : 0;
+            QCOMPARE(out.get(0, s), expectedValue);
+        }
+        position += frames;
+    }
+
+    foreach (int processedBlock, processor.processedBlocks)
+        QCOMPARE(processedBlock, blockSize);
+}
+
+void TestFixedBlockAdapter::disabledAdapterIsNotDelaying()
+{
+    PassThroughProcessor processor;
+    processor.setFixedBlockSize(64);
+    processor.setFixedBlockSize(0);
+    QCOMPARE(processor.getFixedBlockSize(), 0);
+    QCOMPARE(processor.getLatency(), 0);
+
+    SamplesBuffer in(2, 100);
+    SamplesBuffer out(2, 100);
+    for (int s = 0; s < 100; ++s) {
+        in.set(0, s, s + 1);
+        in.set(1, s, -(s + 1));
+    }
+
+    processor.processBuffered(in, out, QList<Midi::MidiMessage>());
+
+    QCOMPARE(processor.processedBlocks.size(), 1);
+    QCOMPARE(processor.processedBlocks.first(), 100); // the driver buffer size
+    QCOMPARE(out.get(0, 0), 1.0f);
+    QCOMPARE(out.get(1, 99), -100.0f);
+}
@@ -0,0 +1,20 @@
+#ifndef TEST_FIXED_BLOCK_ADAPTER_H
+#define TEST_FIXED_BLOCK_ADAPTER_H
+
+#include <QObject>
+
+class TestFixedBlockAdapter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void powerOfTwoBlockSize_data();
+    void powerOfTwoBlockSize();
+
+    void irregularBuffersAreDelayedByLatency_data();
+    void irregularBuffersAreDelayedByLatency();
+
+    void disabledAdapterIsNotDelaying();
+};
+
+#endif
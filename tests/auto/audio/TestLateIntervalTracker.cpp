@@ -0,0 +1,159 @@
+#include "TestLateIntervalTracker.h"
+#include "audio/LateIntervalTracker.h"
+#include <QTest>
+
+using namespace Audio;
+
+void TestLateIntervalTracker::intervalsDownloadedInTheWindowAreStarted_data()
+{
+    QTest::addColumn<int>("sampleRate");
+    QTest::addColumn<int>("frames");
+    QTest::addColumn<int>("waitedBlocks");
+
+    QTest::newRow("Started in the first block") << 44100 << 256 << 1;
+    QTest::newRow("Started after 10 blocks") << 44100 << 128 << 10;
+    QTest::newRow("Started in the window end") << 48000 << 480 << 50; // 500 ms
+}
+
+void TestLateIntervalTracker::intervalsDownloadedInTheWindowAreStarted()
+{
+    QFETCH(int, sampleRate);
+    QFETCH(int, frames);
+    QFETCH(int, waitedBlocks);
+
+    LateIntervalTracker tracker;
+    tracker.setWindow(500);
+    tracker.startNewInterval(false, true, true); // previous interval received, the current interval is downloading
+    QVERIFY(tracker.isWaiting());
+
+    for (int block = 0; block < waitedBlocks; ++block)
+        QVERIFY(tracker.wait(frames, sampleRate));
+
+    QCOMPARE(tracker.getWaitedFrames(), frames * waitedBlocks);
+    QCOMPARE(tracker.getSampleRate(), sampleRate);
+
+    // the interval position is the skip offset, the silent blocks included
+    QCOMPARE(tracker.start(), frames * waitedBlocks);
+    QVERIFY(!tracker.isWaiting());
+    QCOMPARE(tracker.getLateStartedIntervals(), 1u);
+    QCOMPARE(tracker.getDroppedIntervals(), 0u);
+}
+
+void TestLateIntervalTracker::intervalsOutsideTheWindowAreDropped()
+{
+    LateIntervalTracker tracker;
+    tracker.setWindow(100);
+    tracker.startNewInterval(false, true, true);
+
+    int waitedBlocks = 0;
+    while (tracker.wait(441, 44100)) // 10 ms blocks
+        waitedBlocks++;
+
+    QCOMPARE(waitedBlocks, 10);
+    QVERIFY(!tracker.isWaiting());
+    QCOMPARE(tracker.getDroppedIntervals(), 1u);
+    QCOMPARE(tracker.getLateStartedIntervals(), 0u);
+
+    QVERIFY(!tracker.wait(441, 44100)); // silent until the next interval
+    tracker.startNewInterval(true, false, false);
+    QCOMPARE(tracker.getDroppedIntervals(), 1u); // counted once
+}
+
+void TestLateIntervalTracker::disabledWindowIsDroppingLateIntervals()
+{
+    LateIntervalTracker tracker;
+    tracker.setWindow(0);
+    tracker.startNewInterval(false, true, true);
+
+    QVERIFY(!tracker.isWaiting());
+    QCOMPARE(tracker.getDroppedIntervals(), 1u);
+}
+
+void TestLateIntervalTracker::notDownloadedIntervalsAreDroppedInTheNextInterval()
+{
+    LateIntervalTracker tracker;
+    tracker.setWindow(60000); // bigger than the interval
+    tracker.startNewInterval(false, true, true);
+    QVERIFY(tracker.wait(256, 44100));
+
+    tracker.startNewInterval(false, true, false); // still downloading in the next interval
+    QCOMPARE(tracker.getDroppedIntervals(), 1u);
+    QVERIFY(tracker.isWaiting());
+    QCOMPARE(tracker.getWaitedFrames(), 0); // waiting from the new interval start
+}
+
+void TestLateIntervalTracker::transmissionStartedInTheMiddleOfIntervalIsNotDropping()
+{
+    LateIntervalTracker tracker;
+    tracker.setWindow(0);
+    tracker.startNewInterval(false, true, false); // nothing played in the previous interval
+    QCOMPARE(tracker.getDroppedIntervals(), 0u);
+
+    tracker.setWindow(100);
+    tracker.startNewInterval(false, true, false);
+    QVERIFY(tracker.isWaiting());
+    while (tracker.wait(441, 44100)) {}
+    QCOMPARE(tracker.getDroppedIntervals(), 0u);
+}
+
+void TestLateIntervalTracker::receivedIntervalsAreNotWaited()
+{
+    LateIntervalTracker tracker;
+    tracker.setWindow(500);
+
+    tracker.startNewInterval(true, true, true); // next interval downloading, but the current interval is received
+    QVERIFY(!tracker.isWaiting());
+
+    tracker.startNewInterval(false, false, true); // the user stopped the transmission
+    QVERIFY(!tracker.isWaiting());
+    QVERIFY(!tracker.wait(256, 44100));
+
+    QCOMPARE(tracker.getDroppedIntervals(), 0u);
+    QCOMPARE(tracker.getLateStartedIntervals(), 0u);
+}
+
+void TestLateIntervalTracker::canceledIntervalsAreNotCounted()
+{
+    LateIntervalTracker tracker;
+    tracker.setWindow(500);
+    tracker.startNewInterval(false, true, true);
+    tracker.cancel(); // intervals discarded
+
+    QVERIFY(!tracker.isWaiting());
+    tracker.startNewInterval(true, false, false);
+    QCOMPARE(tracker.getDroppedIntervals(), 0u);
+    QCOMPARE(tracker.getLateStartedIntervals(), 0u);
+}
+
+void TestLateIntervalTracker::alwaysLateIntervalsAreRefillingTheQueue()
+{
+    // the user intervals are always downloaded 100 ms after the interval start
+    const int maxLateStarts = LateIntervalTracker::MAX_CONSECUTIVE_LATE_STARTS;
+    LateIntervalTracker tracker;
+    tracker.setWindow(500);
+
+    tracker.startNewInterval(false, true, true);
+    for (int interval = 0; interval < maxLateStarts; ++interval) {
+        QVERIFY(tracker.isWaiting());
+        for (int block = 0; block < 10; ++block)
+            QVERIFY(tracker.wait(441, 44100));
+        tracker.start();
+        tracker.startNewInterval(false, true, true); // the queue is empty, the next interval is late again
+    }
+
+    // not waited, the downloaded interval is played in full in the next interval
+    QVERIFY(!tracker.isWaiting());
+    QVERIFY(!tracker.wait(441, 44100));
+    QCOMPARE(tracker.getLateStartedIntervals(), (quint32)maxLateStarts);
+
+    // the queue is refilled, the next intervals are not late
+    for (int interval = 0; interval < 3; ++interval) {
+        tracker.startNewInterval(true, true, true);
+        QVERIFY(!tracker.isWaiting());
+    }
+    QCOMPARE(tracker.getLateStartedIntervals(), (quint32)maxLateStarts);
+
+    // the late start is used again when the queue is empty
+    tracker.startNewInterval(false, true, true);
+    QVERIFY(tracker.isWaiting());
+}
@@ -0,0 +1,22 @@
+#ifndef TEST_LATE_INTERVAL_TRACKER_H
+#define TEST_LATE_INTERVAL_TRACKER_H
+
+#include <QObject>
+
+class TestLateIntervalTracker : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void intervalsDownloadedInTheWindowAreStarted_data();
+    void intervalsDownloadedInTheWindowAreStarted();
+    void intervalsOutsideTheWindowAreDropped();
+    void disabledWindowIsDroppingLateIntervals();
+    void notDownloadedIntervalsAreDroppedInTheNextInterval();
+    void transmissionStartedInTheMiddleOfIntervalIsNotDropping();
+    void receivedIntervalsAreNotWaited();
+    void canceledIntervalsAreNotCounted();
+    void alwaysLateIntervalsAreRefillingTheQueue();
+};
+
+#endif
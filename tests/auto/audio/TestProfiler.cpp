@@ -0,0 +1,106 @@
+#include "TestProfiler.h"
+#include "performance/Profiler.h"
+#include <QTest>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <thread>
+
+using namespace Profiling;
+
+void TestProfiler::init()
+{
+    QVector<Event> pendingEvents;
+    Profiler::drainEvents(pendingEvents); // the profiler rings are global
+}
+
+void TestProfiler::cleanup()
+{
+    Profiler::setEnabled(false);
+}
+
+void TestProfiler::disabledTimersAreNotRecorded()
+{
+    Profiler::setEnabled(false);
+    {
+        JT_PROFILE_SCOPE("disabled");
+    }
+
+    QVector<Event> events;
+    QCOMPARE(Profiler::drainEvents(events), 0);
+    QVERIFY(events.isEmpty());
+}
+
+void TestProfiler::scopedTimersAreRecorded()
+{
+    Profiler::setEnabled(true);
+    int instance = 0;
+    {
+        JT_PROFILE_SCOPE("outer");
+        {
+            Profiling::ScopedTimer timer("inner", &instance);
+        }
+    }
+
+    QVector<Event> events;
+    QCOMPARE(Profiler::drainEvents(events), 2);
+
+    // the inner timer is finished (and recorded) first
+    QCOMPARE(QString(events.at(0).name), QString("inner"));
+    QCOMPARE(events.at(0).tag, reinterpret_cast<quintptr>(&instance));
+    QCOMPARE(QString(events.at(1).name), QString("outer"));
+    QCOMPARE(events.at(1).tag, quintptr(0));
+    QVERIFY(events.at(1).start <= events.at(0).start);
+    QVERIFY(events.at(1).duration >= events.at(0).duration);
+    QCOMPARE(events.at(0).threadIndex, events.at(1).threadIndex);
+}
+
+void TestProfiler::eventsAreDroppedWhenRingIsFull()
+{
+    Profiler::setEnabled(true); // the rings are allocated when the profiler is enabled
+    int droppedEvents = Profiler::getDroppedEvents();
+    for (int i = 0; i < Profiler::RING_CAPACITY + 10; ++i)
+        Profiler::record("event", i, i + 1, 0);
+
+    QVector<Event> events;
+    Profiler::drainEvents(events);
+    QCOMPARE(events.size(), Profiler::RING_CAPACITY - 1); // one slot is always empty
+    QCOMPARE(Profiler::getDroppedEvents() - droppedEvents, 11);
+    QCOMPARE(events.last().start, qint64(Profiler::RING_CAPACITY - 2)); // the oldest events are kept
+}
+
+void TestProfiler::threadsAreUsingDifferentRings()
+{
+    Profiler::setEnabled(true);
+    Profiler::record("main thread", 1, 2, 0);
+    std::thread otherThread([]() {
+        Profiler::record("other thread", 3, 4, 0);
+    });
+    otherThread.join();
+
+    QVector<Event> events;
+    QCOMPARE(Profiler::drainEvents(events), 2);
+    QVERIFY(events.at(0).threadIndex != events.at(1).threadIndex);
+}
+
+void TestProfiler::enabledTimerOverhead()
+{
+    Profiler::setEnabled(true);
+    const int TIMERS = 1000; // less than the ring capacity, the events are not dropped
+    QVector<qint64> times;
+    QVector<Event> events;
+    for (int repetition = 0; repetition < 101; ++repetition) {
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < TIMERS; ++i) {
+            JT_PROFILE_SCOPE("overhead");
+        }
+        times.append(timer.nsecsElapsed() / TIMERS);
+        events.clear();
+        Profiler::drainEvents(events);
+    }
+
+    std::sort(times.begin(), times.end());
+    qint64 median = times.at(times.size() / 2);
+    qInfo() << "Enabled scoped timer:" << median << "ns";
+    QTest::setBenchmarkResult(median, QTest::WalltimeNanoseconds);
+}
@@ -0,0 +1,20 @@
+#ifndef TEST_PROFILER_H
+#define TEST_PROFILER_H
+
+#include <QObject>
+
+class TestProfiler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void disabledTimersAreNotRecorded();
+    void scopedTimersAreRecorded();
+    void eventsAreDroppedWhenRingIsFull();
+    void threadsAreUsingDifferentRings();
+    void enabledTimerOverhead(); // benchmark, the median time of one scoped timer
+};
+
+#endif
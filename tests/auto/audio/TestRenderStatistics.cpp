@@ -0,0 +1,46 @@
+#include "TestRenderStatistics.h"
+#include "audio/core/RenderStatistics.h"
+#include <QTest>
+
+using namespace Audio;
+
+void TestRenderStatistics::percentiles()
+{
+    RenderStatistics statistics;
+    statistics.reset(1000, 100);
+    for (int i = 100; i >= 1; --i) // callbacks added in reverse order
+        statistics.addCallback(i, 0);
+
+    QCOMPARE(statistics.getCallbacks(), 100);
+    QCOMPARE(statistics.getPercentile(50), qint64(50));
+    QCOMPARE(statistics.getPercentile(99), qint64(99));
+    QCOMPARE(statistics.getPercentile(100), qint64(100));
+    QCOMPARE(statistics.getMaxTime(), qint64(100));
+    QCOMPARE(statistics.getTotalTime(), qint64(5050));
+}
+
+void TestRenderStatistics::xrunsAndAllocations()
+{
+    RenderStatistics statistics;
+    statistics.reset(10, 4);
+    statistics.addCallback(5, 0);
+    statistics.addCallback(10, 3); // exactly in the deadline is not a xrun
+    statistics.addCallback(11, 0);
+    statistics.addCallback(30, 2);
+
+    QCOMPARE(statistics.getXruns(), 2);
+    QCOMPARE(statistics.getAllocations(), quint64(5));
+    QCOMPARE(statistics.getAllocatingCallbacks(), 2);
+
+    statistics.reset(10, 4);
+    QCOMPARE(statistics.getCallbacks(), 0);
+    QCOMPARE(statistics.getXruns(), 0);
+}
+
+void TestRenderStatistics::emptyStatistics()
+{
+    RenderStatistics statistics;
+    QCOMPARE(statistics.getPercentile(50), qint64(0));
+    QCOMPARE(statistics.getMaxTime(), qint64(0));
+    QVERIFY(!statistics.toString().isEmpty());
+}
@@ -0,0 +1,16 @@
+#ifndef TEST_RENDER_STATISTICS_H
+#define TEST_RENDER_STATISTICS_H
+
+#include <QObject>
+
+class TestRenderStatistics : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void percentiles();
+    void xrunsAndAllocations();
+    void emptyStatistics();
+};
+
+#endif
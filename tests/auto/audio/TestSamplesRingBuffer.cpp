@@ -0,0 +1,90 @@
+#include "TestSamplesRingBuffer.h"
+#include "audio/core/SamplesRingBuffer.h"
+#include "audio/core/SamplesBuffer.h"
+#include <QTest>
+
+using namespace Audio;
+
+void TestSamplesRingBuffer::writeAndRead_data()
+{
+    QTest::addColumn<int>("capacity");
+    QTest::addColumn<int>("writeSize");
+    QTest::addColumn<int>("readSize");
+
+    QTest::newRow("Same write and read sizes") << 64 << 16 << 16;
+    QTest::newRow("Wrapping the ring end") << 50 << 16 << 16;
+    QTest::newRow("Reading smaller blocks") << 100 << 32 << 7;
+    QTest::newRow("Writing smaller blocks") << 100 << 7 << 32;
+}
+
+void TestSamplesRingBuffer::writeAndRead()
+{
+    QFETCH(int, capacity);
+    QFETCH(int, writeSize);
+    QFETCH(int, readSize);
+
+    SamplesRingBuffer ring(2, capacity);
+    QCOMPARE(ring.getAvailableFrames(), 0);
+    QCOMPARE(ring.getFreeFrames(), capacity);
+
+    int writtenFrames = 0;
+    int readFrames = 0;
+    const int totalFrames = capacity * 5;
+    while (readFrames < totalFrames) {
+        if (writtenFrames < totalFrames && ring.getFreeFrames() >= writeSize) {
+            SamplesBuffer in(2, writeSize);
+            for (int s = 0; s < writeSize; ++s) {
+                in.set(0, s, writtenFrames + s);
+                in.set(1, s, -(writtenFrames + s));
+            }
+            QCOMPARE(ring.write(in), writeSize);
+            writtenFrames += writeSize;
+            continue;
+        }
+
+        SamplesBuffer out(2, readSize);
+        int frames = ring.read(out, readSize);
+        QVERIFY(frames > 0);
+        for (int s = 0; s < frames; ++s) {
+            QCOMPARE(out.get(0, s), (float)(readFrames + s));
+            QCOMPARE(out.get(1, s), (float)-(readFrames + s));
+        }
+        readFrames += frames;
+        QCOMPARE(ring.getAvailableFrames(), writtenFrames - readFrames);
+    }
+}
+
+void TestSamplesRingBuffer::writeInFullRing()
+{
+    SamplesRingBuffer ring(1, 10);
+    SamplesBuffer in(1, 8);
+    in.zero();
+
+    QCOMPARE(ring.write(in), 8);
+    QCOMPARE(ring.write(in), 2); // just 2 free frames
+    QCOMPARE(ring.getFreeFrames(), 0);
+    QCOMPARE(ring.write(in), 0);
+
+    QCOMPARE(ring.discard(5), 5);
+    QCOMPARE(ring.getAvailableFrames(), 5);
+
+    ring.reset();
+    QCOMPARE(ring.getAvailableFrames(), 0);
+}
+
+void TestSamplesRingBuffer::monoSamplesInStereoRing()
+{
+    SamplesRingBuffer ring(2, 16);
+    SamplesBuffer in(1, 4);
+    for (int s = 0; s < 4; ++s)
+        in.set(0, s, s + 1);
+
+    ring.write(in);
+
+    SamplesBuffer out(2, 4);
+    QCOMPARE(ring.read(out, 4), 4);
+    for (int s = 0; s < 4; ++s) {
+        QCOMPARE(out.get(0, s), (float)(s + 1));
+        QCOMPARE(out.get(1, s), (float)(s + 1));
+    }
+}
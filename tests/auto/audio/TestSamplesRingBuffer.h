@@ -0,0 +1,18 @@
+#ifndef TEST_SAMPLES_RING_BUFFER_H
+#define TEST_SAMPLES_RING_BUFFER_H
+
+#include <QObject>
+
+class TestSamplesRingBuffer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void writeAndRead_data();
+    void writeAndRead();
+
+    void writeInFullRing();
+    void monoSamplesInStereoRing();
+};
+
+#endif
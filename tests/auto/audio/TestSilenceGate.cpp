@@ -0,0 +1,84 @@
+#include "TestSilenceGate.h"
+#include "audio/SilenceGate.h"
+#include "audio/core/SamplesBuffer.h"
+#include <QTest>
+
+using namespace Audio;
+
+static SamplesBuffer createBlock(float value, int frames = 256)
+{
+    SamplesBuffer block(2, frames);
+    for (int c = 0; c < block.getChannels(); ++c) {
+        for (int s = 0; s < frames; ++s)
+            block.set(c, s, value);
+    }
+    return block;
+}
+
+void TestSilenceGate::silentIntervalIsSentAsEmptyInterval()
+{
+    SilenceGate gate;
+    SamplesBuffer silence = createBlock(0);
+
+    QCOMPARE(gate.process(silence, true, false), SilenceGate::HOLD_SILENCE);
+    QCOMPARE(gate.process(silence, false, false), SilenceGate::HOLD_SILENCE);
+    QCOMPARE(gate.process(silence, false, true), SilenceGate::SEND_SILENT_INTERVAL);
+}
+
+void TestSilenceGate::leadingSilenceIsHeldUntilSound()
+{
+    SilenceGate gate;
+    SamplesBuffer silence = createBlock(0, 100);
+    SamplesBuffer sound = createBlock(0.5f);
+
+    QCOMPARE(gate.process(silence, true, false), SilenceGate::HOLD_SILENCE);
+    QCOMPARE(gate.process(silence, false, false), SilenceGate::HOLD_SILENCE);
+    QVERIFY(gate.isGating());
+
+    // the held silence is encoded before the first sound
+    QCOMPARE(gate.process(sound, false, false), SilenceGate::ENCODE_HELD_SILENCE);
+    QVERIFY(!gate.isGating());
+    QCOMPARE(gate.takeHeldSilence(), 200L);
+    QCOMPARE(gate.takeHeldSilence(), 0L);
+}
+
+void TestSilenceGate::gateIsOpenUntilTheIntervalEnd()
+{
+    SilenceGate gate;
+    QCOMPARE(gate.process(createBlock(0.5f), true, false), SilenceGate::ENCODE_HELD_SILENCE);
+    QCOMPARE(gate.takeHeldSilence(), 0L); // sound in the interval start
+
+    // the silence after the first sound is encoded
+    QCOMPARE(gate.process(createBlock(0), false, false), SilenceGate::ENCODE);
+    QCOMPARE(gate.process(createBlock(0), false, true), SilenceGate::ENCODE);
+}
+
+void TestSilenceGate::partialIntervalIsNotGated()
+{
+    SilenceGate gate; // the transmission is started in the middle of the interval
+    QCOMPARE(gate.process(createBlock(0), false, false), SilenceGate::ENCODE);
+    QCOMPARE(gate.process(createBlock(0), false, true), SilenceGate::ENCODE);
+}
+
+void TestSilenceGate::thresholdIsUsed()
+{
+    SilenceGate gate; // -100 dB
+    QCOMPARE(gate.process(createBlock(SilenceGate::DEFAULT_THRESHOLD / 2), true, false), SilenceGate::HOLD_SILENCE);
+    QCOMPARE(gate.process(createBlock(-SilenceGate::DEFAULT_THRESHOLD * 2), false, false), SilenceGate::ENCODE_HELD_SILENCE);
+
+    SilenceGate customGate(0.1f);
+    QCOMPARE(customGate.process(createBlock(0.05f), true, false), SilenceGate::HOLD_SILENCE);
+    QCOMPARE(customGate.process(createBlock(0.2f), false, false), SilenceGate::ENCODE_HELD_SILENCE);
+}
+
+void TestSilenceGate::gateIsClosedInTheNextInterval()
+{
+    SilenceGate gate;
+    QCOMPARE(gate.process(createBlock(0.5f), true, true), SilenceGate::ENCODE_HELD_SILENCE);
+    gate.takeHeldSilence();
+
+    // a new interval, the held silence of the previous interval is not used
+    QCOMPARE(gate.process(createBlock(0), true, false), SilenceGate::HOLD_SILENCE);
+    QCOMPARE(gate.process(createBlock(0.5f), false, true), SilenceGate::ENCODE_HELD_SILENCE);
+    QCOMPARE(gate.takeHeldSilence(), 256L);
+}
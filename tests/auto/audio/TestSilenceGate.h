@@ -0,0 +1,19 @@
+#ifndef TEST_SILENCE_GATE_H
+#define TEST_SILENCE_GATE_H
+
+#include <QObject>
+
+class TestSilenceGate : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void silentIntervalIsSentAsEmptyInterval();
+    void leadingSilenceIsHeldUntilSound();
+    void gateIsOpenUntilTheIntervalEnd();
+    void partialIntervalIsNotGated();
+    void thresholdIsUsed();
+    void gateIsClosedInTheNextInterval();
+};
+
+#endif
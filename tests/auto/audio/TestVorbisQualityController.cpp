@@ -0,0 +1,89 @@
+#include "TestVorbisQualityController.h"
+#include "audio/vorbis/VorbisQualityController.h"
+#include <QTest>
+
+namespace {
+
+VorbisQualityController::IntervalStatistics createStatistics(qint64 uploadBacklog, double cpu, int users = 2)
+{
+    VorbisQualityController::IntervalStatistics statistics;
+    statistics.uploadBacklog = uploadBacklog;
+    statistics.encodedBytes = 100000;
+    statistics.intervalTime = 8000000000LL; // 8 seconds
+    statistics.encodingTime = (qint64)(statistics.intervalTime * cpu);
+    statistics.usersInRoom = users;
+    return statistics;
+}
+
+}
+
+void TestVorbisQualityController::uploadBacklogReducesQuality_data()
+{
+    QTest::addColumn<qint64>("uploadBacklog");
+    QTest::addColumn<float>("expectedQuality");
+
+    QTest::newRow("Small backlog") << (qint64)1000 << VorbisQualityController::DEFAULT;
+    QTest::newRow("Late upload") << (qint64)20000 << 0.2f;
+    QTest::newRow("Very late upload") << (qint64)80000 << 0.1f;
+}
+
+void TestVorbisQualityController::uploadBacklogReducesQuality()
+{
+    QFETCH(qint64, uploadBacklog);
+    QFETCH(float, expectedQuality);
+
+    VorbisQualityController controller;
+    controller.update(createStatistics(uploadBacklog, 0.01));
+    QCOMPARE(controller.getQuality(), expectedQuality);
+    if (expectedQuality < VorbisQualityController::DEFAULT)
+        QCOMPARE(controller.getReason(), VorbisQualityController::UPLOAD_BACKLOG);
+
+    // the quality is never below the minimum level
+    for (int i = 0; i < 10; ++i)
+        controller.update(createStatistics(80000, 0.01));
+    QCOMPARE(controller.getQuality(), 0.0f);
+}
+
+void TestVorbisQualityController::encoderCpuReducesQuality()
+{
+    VorbisQualityController controller;
+    QVERIFY(controller.update(createStatistics(0, 0.7)));
+    QCOMPARE(controller.getQuality(), 0.2f);
+    QCOMPARE(controller.getReason(), VorbisQualityController::ENCODER_CPU);
+}
+
+void TestVorbisQualityController::headroomIncreasesQualitySlowly()
+{
+    VorbisQualityController controller;
+    for (int i = 1; i < VorbisQualityController::STABLE_INTERVALS_TO_INCREASE; ++i) {
+        QVERIFY(!controller.update(createStatistics(0, 0.01)));
+        QCOMPARE(controller.getQuality(), VorbisQualityController::DEFAULT);
+    }
+
+    QVERIFY(controller.update(createStatistics(0, 0.01)));
+    QCOMPARE(controller.getQuality(), 0.45f);
+    QCOMPARE(controller.getReason(), VorbisQualityController::HEADROOM);
+
+    // a late interval restart the stable intervals count
+    controller.update(createStatistics(20000, 0.01));
+    QCOMPARE(controller.getQuality(), VorbisQualityController::DEFAULT);
+    controller.update(createStatistics(0, 0.01));
+    QCOMPARE(controller.getQuality(), VorbisQualityController::DEFAULT);
+}
+
+void TestVorbisQualityController::crowdedRoomLimitsQuality()
+{
+    VorbisQualityController controller;
+    for (int i = 0; i < VorbisQualityController::STABLE_INTERVALS_TO_INCREASE * 2; ++i)
+        controller.update(createStatistics(0, 0.01));
+    QCOMPARE(controller.getQuality(), 0.6f);
+
+    int users = VorbisQualityController::CROWDED_ROOM_USERS;
+    QVERIFY(controller.update(createStatistics(0, 0.01, users)));
+    QCOMPARE(controller.getQuality(), VorbisQualityController::DEFAULT);
+    QCOMPARE(controller.getReason(), VorbisQualityController::CROWDED_ROOM);
+
+    for (int i = 0; i < VorbisQualityController::STABLE_INTERVALS_TO_INCREASE * 2; ++i)
+        controller.update(createStatistics(0, 0.01, users));
+    QCOMPARE(controller.getQuality(), VorbisQualityController::DEFAULT);
+}
@@ -0,0 +1,18 @@
+#ifndef TEST_VORBIS_QUALITY_CONTROLLER_H
+#define TEST_VORBIS_QUALITY_CONTROLLER_H
+
+#include <QObject>
+
+class TestVorbisQualityController : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void uploadBacklogReducesQuality_data();
+    void uploadBacklogReducesQuality();
+    void encoderCpuReducesQuality();
+    void headroomIncreasesQualitySlowly();
+    void crowdedRoomLimitsQuality();
+};
+
+#endif
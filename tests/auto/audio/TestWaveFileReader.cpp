@@ -0,0 +1,226 @@
+#include "TestWaveFileReader.h"
+#include "audio/file/WaveFileReader.h"
+#include "audio/core/SamplesBuffer.h"
+#include <QTest>
+#include <QFile>
+#include <QDataStream>
+#include <QtEndian>
+#include <cmath>
+
+using namespace Audio;
+
+static const quint16 FORMAT_PCM = 1;
+static const quint16 FORMAT_FLOAT = 3;
+static const quint16 FORMAT_EXTENSIBLE = 0xFFFE;
+static const int SAMPLE_RATE = 48000;
+
+double TestWaveFileReader::getSampleValue(int frame, int channel)
+{
+    return std::sin(frame * 0.3 + channel) * 0.9;
+}
+
+QByteArray TestWaveFileReader::createSample(int bitsPerSample, bool floatFormat, int frame, int channel)
+{
+    double value = getSampleValue(frame, channel);
+    uchar bytes[4];
+    if (floatFormat) {
+        float floatValue = (float)value;
+        quint32 bits;
+        memcpy(&bits, &floatValue, sizeof(float));
+        qToLittleEndian<quint32>(bits, bytes);
+        return QByteArray((const char *)bytes, 4);
+    }
+
+    switch (bitsPerSample) {
+    case 8:
+        bytes[0] = (uchar)((int)(value * 127) + 128); // 8 bits wave files are unsigned
+        return QByteArray((const char *)bytes, 1);
+    case 16:
+        qToLittleEndian<qint16>((qint16)(value * 32767), bytes);
+        return QByteArray((const char *)bytes, 2);
+    case 24:
+        qToLittleEndian<qint32>((qint32)(value * 8388607), bytes);
+        return QByteArray((const char *)bytes, 3);
+    default:
+        qToLittleEndian<qint32>((qint32)(value * 2147483647.0), bytes);
+        return QByteArray((const char *)bytes, 4);
+    }
+}
+
+float TestWaveFileReader::getExpectedSample(int bitsPerSample, bool floatFormat, int frame, int channel)
+{
+    double value = getSampleValue(frame, channel);
+    if (floatFormat)
+        return (float)value;
+
+    switch (bitsPerSample) {
+    case 8:
+        return (int)(value * 127) / 127.0f;
+    case 16:
+        return (qint16)(value * 32767) / 32767.0f;
+    case 24:
+        return (qint32)(value * 8388607) / 8388607.0f;
+    default:
+        return (float)((qint32)(value * 2147483647.0) / 2147483647.0);
+    }
+}
+
+QString TestWaveFileReader::createWaveFile(const QString &fileName, quint16 formatTag, int bitsPerSample, int channels,
+                                           int frames, bool listChunk, int missingBytes)
+{
+    bool floatFormat = formatTag == FORMAT_FLOAT;
+    QByteArray samples;
+    for (int f = 0; f < frames; ++f) {
+        for (int c = 0; c < channels; ++c)
+            samples.append(createSample(bitsPerSample, floatFormat, f, c));
+    }
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    quint32 fmtSize = formatTag == FORMAT_EXTENSIBLE ? 40 : 16;
+    stream.writeRawData("RIFF", 4);
+    stream << (quint32)0; // not used by the reader
+    stream.writeRawData("WAVE", 4);
+
+    if (listChunk) {
+        stream.writeRawData("LIST", 4);
+        stream << (quint32)5;
+        stream.writeRawData("abcde", 5);
+        stream << (quint8)0; // padding byte
+    }
+
+    stream.writeRawData("fmt ", 4);
+    stream << fmtSize;
+    stream << formatTag;
+    stream << (quint16)channels;
+    stream << (quint32)SAMPLE_RATE;
+    stream << (quint32)(SAMPLE_RATE * channels * bitsPerSample / 8);
+    stream << (quint16)(channels * bitsPerSample / 8);
+    stream << (quint16)bitsPerSample;
+    if (formatTag == FORMAT_EXTENSIBLE) {
+        stream << (quint16)22; // extension size
+        stream << (quint16)bitsPerSample; // valid bits
+        stream << (quint32)0; // channels mask
+        stream << FORMAT_PCM; // sub format GUID, the other bytes are not used
+        stream.writeRawData("\x00\x00\x00\x00\x10\x00\x80\x00\x00\xAA\x00\x38\x9B\x71", 14);
+    }
+
+    stream.writeRawData("data", 4);
+    stream << (quint32)samples.size();
+    stream.writeRawData(samples.constData(), samples.size() - missingBytes);
+
+    QString filePath = dir.path() + "/" + fileName;
+    QFile file(filePath);
+    file.open(QFile::WriteOnly);
+    file.write(data);
+    return filePath;
+}
+
+void TestWaveFileReader::readFormats_data()
+{
+    QTest::addColumn<int>("formatTag");
+    QTest::addColumn<int>("bitsPerSample");
+    QTest::addColumn<int>("channels");
+    QTest::addColumn<bool>("listChunk");
+
+    // 37 frames: SIMD blocks and the remaining samples are converted
+    QTest::newRow("8 bits mono") << (int)FORMAT_PCM << 8 << 1 << false;
+    QTest::newRow("8 bits stereo") << (int)FORMAT_PCM << 8 << 2 << false;
+    QTest::newRow("16 bits mono") << (int)FORMAT_PCM << 16 << 1 << false;
+    QTest::newRow("16 bits stereo") << (int)FORMAT_PCM << 16 << 2 << true;
+    QTest::newRow("24 bits mono") << (int)FORMAT_PCM << 24 << 1 << true;
+    QTest::newRow("24 bits stereo") << (int)FORMAT_PCM << 24 << 2 << false;
+    QTest::newRow("24 bits extensible") << (int)FORMAT_EXTENSIBLE << 24 << 2 << false;
+    QTest::newRow("32 bits stereo") << (int)FORMAT_PCM << 32 << 2 << false;
+    QTest::newRow("float mono") << (int)FORMAT_FLOAT << 32 << 1 << false;
+    QTest::newRow("float stereo") << (int)FORMAT_FLOAT << 32 << 2 << true;
+    QTest::newRow("16 bits 6 channels") << (int)FORMAT_PCM << 16 << 6 << false; // only 2 channels are read
+}
+
+void TestWaveFileReader::readFormats()
+{
+    QFETCH(int, formatTag);
+    QFETCH(int, bitsPerSample);
+    QFETCH(int, channels);
+    QFETCH(bool, listChunk);
+
+    const int frames = 37;
+    QString filePath = createWaveFile("formats.wav", formatTag, bitsPerSample, channels, frames, listChunk);
+
+    WaveFileReader reader;
+    SamplesBuffer buffer(2);
+    quint32 sampleRate = 0;
+    reader.read(filePath, buffer, sampleRate);
+
+    QCOMPARE(sampleRate, (quint32)SAMPLE_RATE);
+    QCOMPARE(buffer.getFrameLenght(), frames);
+    QCOMPARE(buffer.getChannels(), channels == 1 ? 1 : 2);
+
+    bool floatFormat = formatTag == FORMAT_FLOAT;
+    for (int c = 0; c < buffer.getChannels(); ++c) {
+        for (int f = 0; f < frames; ++f)
+            QVERIFY(qAbs(buffer.get(c, f) - getExpectedSample(bitsPerSample, floatFormat, f, c)) < 0.000001f);
+    }
+}
+
+void TestWaveFileReader::streamingRead()
+{
+    const int frames = 1000;
+    QString filePath = createWaveFile("streaming.wav", FORMAT_PCM, 16, 1, frames);
+
+    WaveFileReader reader;
+    QVERIFY(reader.open(filePath));
+    QCOMPARE(reader.getChannels(), 1);
+    QCOMPARE(reader.getTotalFrames(), (qint64)frames);
+
+    // mono file decoded in a stereo buffer, in blocks
+    const int blockFrames = 64;
+    SamplesBuffer block(2, blockFrames);
+    int position = 0;
+    forever {
+        int readFrames = reader.readFrames(block, 0, blockFrames);
+        if (readFrames == 0)
+            break;
+
+        QVERIFY(readFrames <= blockFrames);
+        for (int f = 0; f < readFrames; ++f) {
+            float expected = getExpectedSample(16, false, position + f, 0);
+            QCOMPARE(block.get(0, f), expected);
+            QCOMPARE(block.get(1, f), expected);
+        }
+        position += readFrames;
+    }
+    QCOMPARE(position, frames);
+}
+
+void TestWaveFileReader::truncatedFile()
+{
+    // the data chunk size is bigger than the file, the incomplete frame is discarded
+    QString filePath = createWaveFile("truncated.wav", FORMAT_PCM, 24, 2, 100, false, 10);
+
+    WaveFileReader reader;
+    SamplesBuffer buffer(2);
+    quint32 sampleRate = 0;
+    reader.read(filePath, buffer, sampleRate);
+    QCOMPARE(buffer.getFrameLenght(), 98);
+    QCOMPARE(buffer.get(1, 97), getExpectedSample(24, false, 97, 1));
+}
+
+void TestWaveFileReader::invalidFile()
+{
+    QString filePath = dir.path() + "/invalid.wav";
+    QFile file(filePath);
+    file.open(QFile::WriteOnly);
+    file.write("RIFF....WAVEdata");
+    file.close();
+
+    WaveFileReader reader;
+    QVERIFY(!reader.open(filePath));
+
+    SamplesBuffer buffer(2, 10);
+    quint32 sampleRate = 0;
+    reader.read(filePath, buffer, sampleRate);
+    QCOMPARE(buffer.getFrameLenght(), 10); // not changed
+    QCOMPARE(sampleRate, (quint32)0);
+}
@@ -0,0 +1,31 @@
+#ifndef TEST_WAVE_FILE_READER_H
+#define TEST_WAVE_FILE_READER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QTemporaryDir>
+
+class TestWaveFileReader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void readFormats_data();
+    void readFormats();
+
+    void streamingRead();
+    void truncatedFile();
+    void invalidFile();
+
+private:
+    QTemporaryDir dir;
+
+    QString createWaveFile(const QString &fileName, quint16 formatTag, int bitsPerSample, int channels, int frames,
+                           bool listChunk = false, int missingBytes = 0);
+
+    static QByteArray createSample(int bitsPerSample, bool floatFormat, int frame, int channel);
+    static float getExpectedSample(int bitsPerSample, bool floatFormat, int frame, int channel);
+    static double getSampleValue(int frame, int channel); // between -1 and 1
+};
+
+#endif
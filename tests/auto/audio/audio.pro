@@ -1,6 +1,6 @@
 QT += testlib
 QT -= gui
-CONFIG += testcase
+CONFIG += testcase c++11
 TEMPLATE = app
 TARGET = audio
 
@@ -11,7 +11,108 @@ VPATH += ../../../src/Common
 HEADERS += audio/core/SamplesBuffer.h
 SOURCES += audio/core/SamplesBuffer.cpp
 
+HEADERS += audio/core/Interleaving.h
+SOURCES += audio/core/Interleaving.cpp
+
+HEADERS += audio/core/PcmConversion.h
+SOURCES += audio/core/PcmConversion.cpp
+
+HEADERS += audio/file/FileReader.h
+SOURCES += audio/file/FileReader.cpp
+
+HEADERS += audio/file/WaveFileReader.h
+SOURCES += audio/file/WaveFileReader.cpp
+
 HEADERS += audio/core/AudioPeak.h
 SOURCES += audio/core/AudioPeak.cpp
 
+HEADERS += midi/MidiMessage.h
+SOURCES += midi/MidiMessage.cpp
+
+HEADERS += audio/core/AudioNodeProcessor.h
+SOURCES += audio/core/AudioNodeProcessor.cpp
+
+HEADERS += audio/core/FixedBlockAdapter.h
+SOURCES += audio/core/FixedBlockAdapter.cpp
+
+HEADERS += audio/core/DelayLine.h
+SOURCES += audio/core/DelayLine.cpp
+
+HEADERS += audio/core/SamplesRingBuffer.h
+SOURCES += audio/core/SamplesRingBuffer.cpp
+
+HEADERS += audio/core/EventsQueue.h
+
+HEADERS += audio/core/AudioNode.h
+SOURCES += audio/core/AudioNode.cpp
+
+HEADERS += audio/core/AudioMixer.h
+SOURCES += audio/core/AudioMixer.cpp
+
+HEADERS += audio/SamplesBufferResampler.h
+SOURCES += audio/SamplesBufferResampler.cpp
+
+HEADERS += audio/Resampler.h
+SOURCES += audio/Resampler.cpp
+
+HEADERS += midi/MidiMessageBuffer.h
+SOURCES += midi/MidiMessageBuffer.cpp
+
+HEADERS += audio/core/RenderStatistics.h
+SOURCES += audio/core/RenderStatistics.cpp
+
+HEADERS += audio/core/DspLoadMeter.h
+SOURCES += audio/core/DspLoadMeter.cpp
+
+HEADERS += audio/LateIntervalTracker.h
+SOURCES += audio/LateIntervalTracker.cpp
+
+HEADERS += audio/SilenceGate.h
+SOURCES += audio/SilenceGate.cpp
+
+HEADERS += audio/vorbis/VorbisQualityController.h
+SOURCES += audio/vorbis/VorbisQualityController.cpp
+
+HEADERS += performance/Profiler.h
+SOURCES += performance/Profiler.cpp
+
+HEADERS += log/Logging.h
+SOURCES += log/logging.cpp
+
+HEADERS += TestFixedBlockAdapter.h
+SOURCES += TestFixedBlockAdapter.cpp
+
+HEADERS += TestDelayLine.h
+SOURCES += TestDelayLine.cpp
+
+HEADERS += TestSamplesRingBuffer.h
+SOURCES += TestSamplesRingBuffer.cpp
+
+HEADERS += TestEventsQueue.h
+SOURCES += TestEventsQueue.cpp
+
+HEADERS += TestRenderStatistics.h
+SOURCES += TestRenderStatistics.cpp
+
+HEADERS += TestDspLoadMeter.h
+SOURCES += TestDspLoadMeter.cpp
+
+HEADERS += TestProfiler.h
+SOURCES += TestProfiler.cpp
+
+HEADERS += TestWaveFileReader.h
+SOURCES += TestWaveFileReader.cpp
+
+HEADERS += TestVorbisQualityController.h
+SOURCES += TestVorbisQualityController.cpp
+
+HEADERS += TestLateIntervalTracker.h
+SOURCES += TestLateIntervalTracker.cpp
+
+HEADERS += TestAudioMixer.h
+SOURCES += TestAudioMixer.cpp
+
+HEADERS += TestSilenceGate.h
+SOURCES += TestSilenceGate.cpp
+
 SOURCES += test_Audio.cpp
@@ -1,7 +1,21 @@
 #include <QObject>
 #include <QtTest/QtTest>
 #include <QString>
+#include <QVector>
+#include <climits>
 #include "audio/core/SamplesBuffer.h"
+#include "TestFixedBlockAdapter.h"
+#include "TestDelayLine.h"
+#include "TestSamplesRingBuffer.h"
+#include "TestEventsQueue.h"
+#include "TestRenderStatistics.h"
+#include "TestDspLoadMeter.h"
+#include "TestProfiler.h"
+#include "TestWaveFileReader.h"
+#include "TestVorbisQualityController.h"
+#include "TestLateIntervalTracker.h"
+#include "TestAudioMixer.h"
+#include "TestSilenceGate.h"
 
 using namespace Audio;
 
@@ -32,6 +46,18 @@ private slots:
     void setFrameLenghtIsPreservingSamples();
     void setFrameLenghtIsPreservingSamples_data();
 
+    void setInterleaved_data();
+    void setInterleaved();
+
+    void interleavedFloats_data();
+    void interleavedFloats(); // deinterleave and interleave again
+
+    void viewIsProcessingInPlace(); // the external arrays are changed, the copies are owning the samples
+
+    void isSilent_data();
+    void isSilent();
+    void isSilentIsCheckingAllChannels();
+
 private:
     SamplesBuffer createBuffer(QString comaSeparatedValues);
     void checkExpectedValues(QString comaSeparatedExpectedValues, const SamplesBuffer &buffer);
@@ -266,10 +292,184 @@ void TestSamplesBuffer::append_data()
     QTest::newRow("Appending zero samples") << "1,2,3" << "" << "1,2,3";
 }
 
+void TestSamplesBuffer::setInterleaved_data()
+{
+    QTest::addColumn<int>("bufferChannels");
+    QTest::addColumn<int>("interleavedChannels");
+    QTest::addColumn<int>("frames");
+
+    QTest::newRow("Stereo, vectorized frames only") << 2 << 2 << 8;
+    QTest::newRow("Stereo, odd frames") << 2 << 2 << 13;
+    QTest::newRow("Mono") << 1 << 1 << 21;
+    QTest::newRow("Mono in stereo buffer") << 2 << 1 << 9;
+    QTest::newRow("Stereo in mono buffer") << 1 << 2 << 5;
+}
+
+void TestSamplesBuffer::setInterleaved()
+{
+    QFETCH(int, bufferChannels);
+    QFETCH(int, interleavedChannels);
+    QFETCH(int, frames);
+
+    QVector<short> interleaved(frames * interleavedChannels);
+    for (int i = 0; i < interleaved.size(); ++i)
+        interleaved[i] = (i % 2) ? -i * 100 : i * 100;
+    interleaved[0] = SHRT_MAX;
+
+    SamplesBuffer buffer(bufferChannels);
+    buffer.setInterleaved(interleaved.data(), frames, interleavedChannels);
+    QCOMPARE(buffer.getFrameLenght(), frames);
+
+    for (int c = 0; c < bufferChannels; ++c) {
+        int interleavedChannel = qMin(c, interleavedChannels - 1);
+        for (int s = 0; s < frames; ++s) {
+            float expected = interleaved[s * interleavedChannels + interleavedChannel] / (float)SHRT_MAX;
+            QVERIFY(qAbs(buffer.get(c, s) - expected) < 0.000001f);
+        }
+    }
+    QCOMPARE(buffer.get(0, 0), 1.0f);
+}
+
+void TestSamplesBuffer::interleavedFloats_data()
+{
+    QTest::addColumn<int>("bufferChannels");
+    QTest::addColumn<int>("interleavedChannels");
+    QTest::addColumn<int>("frames");
+
+    QTest::newRow("Stereo") << 2 << 2 << 13;
+    QTest::newRow("4 channels") << 4 << 4 << 11;
+    QTest::newRow("8 channels") << 8 << 8 << 19;
+    QTest::newRow("6 channels") << 6 << 6 << 7;
+    QTest::newRow("10 channels") << 10 << 10 << 9;
+    QTest::newRow("Mono") << 1 << 1 << 5;
+    QTest::newRow("More interleaved channels") << 2 << 3 << 6;
+    QTest::newRow("Less interleaved channels") << 4 << 2 << 6;
+}
+
+void TestSamplesBuffer::interleavedFloats()
+{
+    QFETCH(int, bufferChannels);
+    QFETCH(int, interleavedChannels);
+    QFETCH(int, frames);
+
+    QVector<float> interleaved(frames * interleavedChannels);
+    for (int i = 0; i < interleaved.size(); ++i)
+        interleaved[i] = i / (float)interleaved.size();
+
+    SamplesBuffer buffer(bufferChannels);
+    buffer.setInterleaved(interleaved.data(), frames, interleavedChannels);
+    QCOMPARE(buffer.getFrameLenght(), frames);
+
+    int copiedChannels = qMin(bufferChannels, interleavedChannels);
+    for (int c = 0; c < copiedChannels; ++c) {
+        for (int s = 0; s < frames; ++s)
+            QCOMPARE(buffer.get(c, s), interleaved[s * interleavedChannels + c]);
+    }
+
+    QVector<float> output(frames * interleavedChannels, -1.0f);
+    buffer.getInterleaved(output.data(), frames, interleavedChannels);
+    for (int i = 0; i < output.size(); ++i) {
+        float expected = (i % interleavedChannels) < copiedChannels ? interleaved[i] : 0.0f; // missing channels are zeroed
+        QCOMPARE(output[i], expected);
+    }
+}
+
+void TestSamplesBuffer::viewIsProcessingInPlace()
+{
+    float left[4] = {1, 2, 3, 4};
+    float right[4] = {5, 6, 7, 8};
+    float *arrays[] = {left, right};
+
+    SamplesBuffer view(arrays, 2, 4);
+    QVERIFY(view.isView());
+    QVERIFY(view.getSamplesArray(1) == right);
+
+    SamplesBuffer copy(view);
+    QVERIFY(!copy.isView());
+
+    view.applyGain(2.0f, 1.0f);
+    QCOMPARE(left[3], 8.0f);
+    QCOMPARE(right[0], 10.0f);
+    QCOMPARE(copy.get(0, 3), 4.0f); // the copy is not changed
+
+    view.setFrameLenght(2);
+    view.setFrameLenght(10); // the external arrays can't grow
+    QCOMPARE(view.getFrameLenght(), 4);
+
+    float otherLeft[2] = {1, 1};
+    float otherRight[2] = {1, 1};
+    float *otherArrays[] = {otherLeft, otherRight};
+    view.bind(otherArrays, 2);
+    view.zero();
+    QCOMPARE(view.getFrameLenght(), 2);
+    QCOMPARE(otherRight[1], 0.0f);
+    QCOMPARE(left[0], 2.0f); // not bound anymore
+}
+
+void TestSamplesBuffer::isSilent_data()
+{
+    QTest::addColumn<QString>("samples");
+    QTest::addColumn<float>("threshold");
+    QTest::addColumn<bool>("expectedSilent");
+
+    QTest::newRow("Zeroed samples") << "0,0,0" << 0.00001f << true;
+    QTest::newRow("Samples below the threshold") << "0.000001,-0.000009,0" << 0.00001f << true;
+    QTest::newRow("Sample in the threshold") << "0,0.00001,0" << 0.00001f << true;
+    QTest::newRow("Positive sample above the threshold") << "0,0,0.0001" << 0.00001f << false;
+    QTest::newRow("Negative sample above the threshold") << "-0.0001,0,0" << 0.00001f << false;
+    QTest::newRow("Empty buffer") << "" << 0.00001f << true;
+}
+
+void TestSamplesBuffer::isSilent()
+{
+    QFETCH(QString, samples);
+    QFETCH(float, threshold);
+    QFETCH(bool, expectedSilent);
+
+    SamplesBuffer buffer = createBuffer(samples);
+    QCOMPARE(buffer.isSilent(threshold), expectedSilent);
+}
+
+void TestSamplesBuffer::isSilentIsCheckingAllChannels()
+{
+    SamplesBuffer buffer(2, 4);
+    buffer.zero();
+    QVERIFY(buffer.isSilent(0.00001f));
+
+    buffer.set(1, 3, 0.5f); // only the last right sample
+    QVERIFY(!buffer.isSilent(0.00001f));
+}
+
 int main(int argc, char *argv[])
 {
-    TestSamplesBuffer test;
-    return QTest::qExec(&test, argc, argv);
+    TestSamplesBuffer testSamplesBuffer;
+    TestFixedBlockAdapter testFixedBlockAdapter;
+    TestDelayLine testDelayLine;
+    TestSamplesRingBuffer testSamplesRingBuffer;
+    TestEventsQueue testEventsQueue;
+    TestRenderStatistics testRenderStatistics;
+    TestDspLoadMeter testDspLoadMeter;
+    TestProfiler testProfiler;
+    TestWaveFileReader testWaveFileReader;
+    TestVorbisQualityController testVorbisQualityController;
+    TestLateIntervalTracker testLateIntervalTracker;
+    TestAudioMixer testAudioMixer;
+    TestSilenceGate testSilenceGate;
+    int testResults = 0;
+    testResults |= QTest::qExec(&testSamplesBuffer, argc, argv);
+    testResults |= QTest::qExec(&testFixedBlockAdapter, argc, argv);
+    testResults |= QTest::qExec(&testDelayLine, argc, argv);
+    testResults |= QTest::qExec(&testSamplesRingBuffer, argc, argv);
+    testResults |= QTest::qExec(&testEventsQueue, argc, argv);
+    testResults |= QTest::qExec(&testRenderStatistics, argc, argv);
+    testResults |= QTest::qExec(&testDspLoadMeter, argc, argv);
+    testResults |= QTest::qExec(&testProfiler, argc, argv);
+    testResults |= QTest::qExec(&testWaveFileReader, argc, argv);
+    testResults |= QTest::qExec(&testVorbisQualityController, argc, argv);
+    testResults |= QTest::qExec(&testLateIntervalTracker, argc, argv);
+    testResults |= QTest::qExec(&testAudioMixer, argc, argv);
+    testResults |= QTest::qExec(&testSilenceGate, argc, argv);
+    return testResults;
 }
 
 #include "test_Audio.moc"
@@ -5,6 +5,11 @@ SUBDIRS += \
     audio \
     geo \
     gui/chords \
+    log \
+    loginserver \
     midi \
     ninjam \
     persistence \
+    streaming \
+    vorbis \
+    vst \
@@ -1,7 +1,7 @@
 
 QT += testlib
 QT -= gui
-CONFIG += testcase
+CONFIG += testcase c++11
 TEMPLATE = app
 TARGET = geo
 INCLUDEPATH += .
@@ -10,7 +10,11 @@ VPATH += ../../../src/Common
 
 HEADERS += log/logging.h
 HEADERS += geo/IpToLocationResolver.h
+HEADERS += geo/IpRangeIndex.h
+HEADERS += persistence/CacheHeader.h
 
 SOURCES += log/logging.cpp
 SOURCES += geo/IpToLocationResolver.cpp
+SOURCES += geo/IpRangeIndex.cpp
+SOURCES += persistence/CacheHeader.cpp
 SOURCES += tst_GeoLocation.cpp
@@ -2,7 +2,9 @@
 #include <QString>
 #include <QtTest/QtTest>
 #include "geo/IpToLocationResolver.h"
+#include "geo/IpRangeIndex.h"
 #include <QDebug>
+#include <QTemporaryDir>
 
 using namespace Geo;
 
@@ -38,11 +40,133 @@ void TestGeoLocation::stripHtmlTags_data()
     QTest::newRow("No Html tags to strip") << "Country name" << "Country name";
 }
 
+class TestIpRangeIndex: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void parseIp_data();
+    void parseIp();
+    void lookup_data();
+    void lookup();
+    void batchLookup();
+    void countryNames();
+
+private:
+    QTemporaryDir dir;
+    IpRangeIndex index;
+};
+
+void TestIpRangeIndex::initTestCase()
+{
+    // IP2Location LITE DB1 format, the dotted IPs are accepted too
+    QFile csvFile(dir.path() + "/ranges.csv");
+    QVERIFY(csvFile.open(QFile::WriteOnly | QFile::Text));
+    csvFile.write("\"0\",\"16777215\",\"-\",\"-\"\n"
+                  "\"16777216\",\"16777471\",\"AU\",\"Australia\"\n"
+                  "\"16777472\",\"16778239\",\"CN\",\"China\"\n"
+                  "\"16778240\",\"16779263\",\"AU\",\"Australia\"\n"
+                  "\"3137339392\",\"3137339647\",\"BR\",\"Brazil\"\n" // 187.0.0.0 - 187.0.0.255
+                  "\"3137339648\",\"3137339903\",\"BR\",\"Brazil\"\n" // adjacent range, merged
+                  "\"200.0.0.0\",\"200.0.0.255\",\"KR\",\"Korea, Republic of\"\n");
+    csvFile.close();
+
+    QString indexFilePath = dir.path() + "/index.bin";
+    QVERIFY(IpRangeIndex::build(csvFile.fileName(), indexFilePath));
+    QVERIFY(index.open(indexFilePath));
+}
+
+void TestIpRangeIndex::parseIp_data()
+{
+    QTest::addColumn<QString>("ip");
+    QTest::addColumn<bool>("valid");
+    QTest::addColumn<quint32>("expected");
+
+    QTest::newRow("Full IP") << "1.0.0.1" << true << (quint32)16777217;
+    QTest::newRow("Masked IP") << "187.0.1.x" << true << (quint32)3137339648u;
+    QTest::newRow("Out of range") << "256.0.0.1" << false << (quint32)0;
+    QTest::newRow("Three fields") << "1.0.0" << false << (quint32)0;
+    QTest::newRow("Masked in wrong field") << "1.x.0.1" << false << (quint32)0;
+    QTest::newRow("Empty") << "" << false << (quint32)0;
+}
+
+void TestIpRangeIndex::parseIp()
+{
+    QFETCH(QString, ip);
+    QFETCH(bool, valid);
+    QFETCH(quint32, expected);
+
+    quint32 value = 0;
+    QCOMPARE(IpRangeIndex::parseIp(ip, &value), valid);
+    if (valid)
+        QCOMPARE(value, expected);
+}
+
+void TestIpRangeIndex::lookup_data()
+{
+    QTest::addColumn<QString>("ip");
+    QTest::addColumn<QString>("countryCode");
+
+    QTest::newRow("Reserved range") << "0.0.0.1" << "";
+    QTest::newRow("First IP in range") << "1.0.0.0" << "AU";
+    QTest::newRow("Last IP in range") << "1.0.0.255" << "AU";
+    QTest::newRow("Next range") << "1.0.1.0" << "CN";
+    QTest::newRow("Merged range") << "187.0.1.x" << "BR";
+    QTest::newRow("Gap between ranges") << "100.0.0.1" << "";
+    QTest::newRow("Dotted csv range") << "200.0.0.x" << "KR";
+    QTest::newRow("After last range") << "255.255.255.255" << "";
+}
+
+void TestIpRangeIndex::lookup()
+{
+    QFETCH(QString, ip);
+    QFETCH(QString, countryCode);
+
+    quint32 ipNumber;
+    QVERIFY(IpRangeIndex::parseIp(ip, &ipNumber));
+    QCOMPARE(IpRangeIndex::toCountryCode(index.lookup(ipNumber)), countryCode);
+}
+
+void TestIpRangeIndex::batchLookup()
+{
+    QStringList ips;
+    ips << "200.0.0.x" << "1.0.0.3" << "187.0.0.x" << "1.0.1.0" << "1.0.0.4" << "100.0.0.1";
+
+    QVector<quint32> ipNumbers(ips.size());
+    for (int i = 0; i < ips.size(); ++i)
+        QVERIFY(IpRangeIndex::parseIp(ips.at(i), &ipNumbers[i]));
+
+    QVector<quint16> countryCodes;
+    index.lookup(ipNumbers, countryCodes);
+    QCOMPARE(countryCodes.size(), ips.size());
+    for (int i = 0; i < ips.size(); ++i)
+        QCOMPARE(countryCodes.at(i), index.lookup(ipNumbers.at(i)));
+}
+
+void TestIpRangeIndex::countryNames()
+{
+    quint32 ip;
+    QVERIFY(IpRangeIndex::parseIp("200.0.0.1", &ip));
+    QCOMPARE(index.getCountryName(index.lookup(ip)), QString("Korea, Republic of"));
+    QCOMPARE(index.getRangesCount(), 9); // unknown, AU, CN, AU, unknown, BR (merged), unknown, KR, unknown
+}
 
 int main(int argc, char *argv[])
 {
-    TestGeoLocation test;
-    return QTest::qExec(&test, argc, argv);
+    int status = 0;
+
+    {
+        TestGeoLocation test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestIpRangeIndex test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    return status;
 }
 
 #include "tst_GeoLocation.moc"
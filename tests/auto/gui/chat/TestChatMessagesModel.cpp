@@ -0,0 +1,95 @@
+#include "TestChatMessagesModel.h"
+#include "gui/chat/ChatMessagesModel.h"
+#include <QTest>
+
+static ChatMessage newMessage(const QString &userName, const QString &text)
+{
+    return ChatMessage::newTextMessage(userName, text, Qt::white, Qt::black);
+}
+
+void TestChatMessagesModel::oldestMessageIsDroppedWhenFull()
+{
+    ChatMessagesModel model(3);
+    for (int i = 0; i < 5; ++i)
+        model.append(newMessage("user", QString::number(i)));
+
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.getMessage(0).originalText, QString("2"));
+    QCOMPARE(model.getMessage(2).originalText, QString("4"));
+}
+
+void TestChatMessagesModel::findingRowsAfterRingRotation()
+{
+    ChatMessagesModel model(4);
+    QList<quint64> ids;
+    for (int i = 0; i < 6; ++i)
+        ids << model.append(newMessage("user", QString::number(i)));
+
+    QCOMPARE(model.getRow(ids.at(0)), -1); // dropped
+    QCOMPARE(model.getRow(ids.at(1)), -1);
+    for (int i = 2; i < 6; ++i)
+        QCOMPARE(model.getRow(ids.at(i)), i - 2);
+}
+
+void TestChatMessagesModel::removingMessage()
+{
+    ChatMessagesModel model(3);
+    QList<quint64> ids;
+    for (int i = 0; i < 4; ++i)
+        ids << model.append(newMessage("user", QString::number(i)));
+
+    model.remove(ids.at(2));
+
+    QCOMPARE(model.rowCount(), 2);
+    QCOMPARE(model.getRow(ids.at(2)), -1);
+    QCOMPARE(model.getRow(ids.at(3)), 1);
+    QCOMPARE(model.getMessage(0).originalText, QString("1"));
+
+    model.append(newMessage("user", "4")); // reusing the removed slot
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.getMessage(2).originalText, QString("4"));
+}
+
+void TestChatMessagesModel::removingMessagesFromUser()
+{
+    ChatMessagesModel model(4);
+    model.append(newMessage("user", "0"));
+    model.append(newMessage("blocked", "1"));
+    model.append(newMessage("user", "2"));
+    model.append(newMessage("blocked", "3"));
+    quint64 lastID = model.append(newMessage("user", "4")); // rotating the ring
+
+    model.removeMessagesFrom("blocked");
+
+    QCOMPARE(model.rowCount(), 2);
+    QCOMPARE(model.getMessage(0).originalText, QString("2"));
+    QCOMPARE(model.getRow(lastID), 1);
+}
+
+void TestChatMessagesModel::settingTranslation()
+{
+    ChatMessagesModel model(2);
+    quint64 id = model.append(newMessage("user", "hello"));
+
+    model.setTranslation(id, "ola");
+    const ChatMessage &message = model.getMessage(model.getRow(id));
+    QVERIFY(message.showingTranslation);
+    QCOMPARE(message.getHtml(), QString("ola"));
+
+    model.setShowingTranslation(id, false);
+    QCOMPARE(model.getMessage(0).getHtml(), QString("hello"));
+
+    // the translation reply can arrive after the message is dropped
+    model.append(newMessage("user", "1"));
+    model.append(newMessage("user", "2"));
+    model.setTranslation(id, "ola");
+    QVERIFY(!model.getMessage(0).showingTranslation);
+}
+
+void TestChatMessagesModel::scapingHtmlAndReplacingLinks()
+{
+    QCOMPARE(ChatMessage::toHtml("<b>bold</b>"), QString("bold"));
+    QCOMPARE(ChatMessage::toHtml("line 1\nline 2"), QString("line 1<br/>line 2"));
+    QCOMPARE(ChatMessage::toHtml("see http://www.jamtaba.com"),
+             QString("see <a href=\"http://www.jamtaba.com\">http://www.jamtaba.com</a>"));
+}
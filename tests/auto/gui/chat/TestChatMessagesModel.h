@@ -0,0 +1,19 @@
+#ifndef TEST_CHAT_MESSAGES_MODEL_H
+#define TEST_CHAT_MESSAGES_MODEL_H
+
+#include <QObject>
+
+class TestChatMessagesModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void oldestMessageIsDroppedWhenFull();
+    void findingRowsAfterRingRotation();
+    void removingMessage();
+    void removingMessagesFromUser();
+    void settingTranslation();
+    void scapingHtmlAndReplacingLinks();
+};
+
+#endif
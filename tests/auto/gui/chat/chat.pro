@@ -2,7 +2,7 @@
 #TODO create a test-common.pri to share common tests configuration
 
 QT += testlib core network
-QT -= gui
+QT += gui
 CONFIG += testcase c++11
 TEMPLATE = app
 TARGET = testChat
@@ -14,7 +14,9 @@ VPATH += ../../../../src/Common
 HEADERS += log/logging.h
 HEADERS += TestChatChordsProgressionParser.h
 HEADERS += TestChatVotingMessages.h
+HEADERS += TestChatMessagesModel.h
 HEADERS += gui/chat/NinjamVotingMessageParser.h
+HEADERS += gui/chat/ChatMessagesModel.h
 
 SOURCES += log/logging.cpp
 SOURCES += gui/chords/ChatChordsProgressionParser.cpp
@@ -24,6 +26,8 @@ SOURCES += gui/chords/ChordProgression.cpp
 SOURCES += gui/BpiUtils.cpp
 SOURCES += TestChatChordsProgressionParser.cpp
 SOURCES += TestChatVotingMessages.cpp
+SOURCES += TestChatMessagesModel.cpp
 SOURCES += gui/chat/NinjamVotingMessageParser.cpp
+SOURCES += gui/chat/ChatMessagesModel.cpp
 
 SOURCES += test_Chat.cpp
@@ -1,16 +1,19 @@
 #include <QTest>
 #include "TestChatChordsProgressionParser.h"
 #include "TestChatVotingMessages.h"
+#include "TestChatMessagesModel.h"
 
 int main(int argc, char *argv[])
 {
     TestChatChordsProgressionParser testChatParser;
     TestChatVotingMessages testVotingMessage;
+    TestChatMessagesModel testMessagesModel;
     int result = 0;
 
 
     result += QTest::qExec(&testChatParser);
     result += QTest::qExec(&testVotingMessage);
+    result += QTest::qExec(&testMessagesModel);
 
     return result > 0 ? -result : 0;
 }
@@ -0,0 +1,14 @@
+QT += testlib
+QT -= gui
+QT += concurrent
+CONFIG += testcase c++11
+TEMPLATE = app
+TARGET = log
+INCLUDEPATH += .
+INCLUDEPATH += ../../../src/Common
+VPATH += ../../../src/Common
+
+HEADERS += log/AsyncLogWriter.h
+
+SOURCES += log/AsyncLogWriter.cpp
+SOURCES += tst_AsyncLogWriter.cpp
@@ -0,0 +1,184 @@
+#include <QObject>
+#include <QString>
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QtConcurrent>
+#include "log/AsyncLogWriter.h"
+
+// the rate limit windows are changed by the tests, not by the elapsed time
+class ManualClockLogWriter : public AsyncLogWriter
+{
+public:
+    explicit ManualClockLogWriter(const QString &logFilePath) :
+        AsyncLogWriter(logFilePath, false),
+        time(0)
+    {
+    }
+
+    inline void advance(qint64 milliseconds)
+    {
+        time += milliseconds;
+    }
+
+protected:
+    qint64 now() const override
+    {
+        return time;
+    }
+
+private:
+    qint64 time;
+};
+
+class TestAsyncLogWriter: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void messagesAreWritten();
+    void callSitesAreRateLimited();
+    void callSitesAreNotSharingTheRateLimit();
+    void sameSourceFileIsTheSameCallSite();
+    void longMessagesAreTruncated();
+    void concurrentProducers();
+
+private:
+    QStringList readLines(const QString &filePath);
+};
+
+QStringList TestAsyncLogWriter::readLines(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QFile::ReadOnly | QFile::Text))
+        return QStringList();
+    return QString::fromUtf8(file.readAll()).split("\n", QString::SkipEmptyParts);
+}
+
+void TestAsyncLogWriter::messagesAreWritten()
+{
+    QTemporaryDir dir;
+    QString logFile = dir.path() + "/log.txt";
+    {
+        AsyncLogWriter writer(logFile, false);
+        writer.start();
+        QMessageLogContext context("test.cpp", 10, "function", "jt.Test");
+        QVERIFY(writer.log(QtInfoMsg, context, QString::fromUtf8("first message \xc3\xa1")));
+        QVERIFY(writer.log(QtInfoMsg, context, "second message"));
+    } // the pending messages are written in destructor
+
+    QStringList lines = readLines(logFile);
+    QCOMPARE(lines.size(), 2);
+    QCOMPARE(lines.at(0), QString::fromUtf8("jt.Test.INFO:  first message \xc3\xa1"));
+    QCOMPARE(lines.at(1), QString("jt.Test.INFO:  second message"));
+}
+
+void TestAsyncLogWriter::callSitesAreRateLimited()
+{
+    QTemporaryDir dir;
+    QString logFile = dir.path() + "/log.txt";
+    ManualClockLogWriter writer(logFile);
+
+    QMessageLogContext floodingContext("test.cpp", 20, "function", "jt.Test");
+    const int floodingMessages = AsyncLogWriter::MAX_MESSAGES_PER_CALL_SITE * 10;
+    int writtenMessages = 0;
+    for (int i = 0; i < floodingMessages; ++i) {
+        if (writer.log(QtInfoMsg, floodingContext, "flooding"))
+            writtenMessages++;
+    }
+    QCOMPARE(writtenMessages, (int)AsyncLogWriter::MAX_MESSAGES_PER_CALL_SITE);
+
+    // other call sites are not affected
+    QMessageLogContext otherContext("other.cpp", 20, "function", "jt.Test");
+    QVERIFY(writer.log(QtInfoMsg, otherContext, "other call site"));
+
+    // the suppressed messages are reported when the next rate limit window starts
+    writer.advance(AsyncLogWriter::RATE_LIMIT_WINDOW);
+    QVERIFY(writer.log(QtInfoMsg, floodingContext, "flooding"));
+
+    writer.flush();
+    QStringList lines = readLines(logFile);
+    QCOMPARE(lines.size(), writtenMessages + 2);
+    int suppressedMessages = floodingMessages - writtenMessages;
+    QVERIFY(lines.last().contains(QString("(%1 similar messages suppressed)").arg(suppressedMessages)));
+}
+
+void TestAsyncLogWriter::callSitesAreNotSharingTheRateLimit()
+{
+    QTemporaryDir dir;
+    ManualClockLogWriter writer(dir.path() + "/log.txt");
+
+    QMessageLogContext floodingContext("test.cpp", 20, "function", "jt.Test");
+    for (int i = 0; i <= AsyncLogWriter::MAX_MESSAGES_PER_CALL_SITE; ++i)
+        writer.log(QtInfoMsg, floodingContext, "flooding");
+    QVERIFY(!writer.log(QtInfoMsg, floodingContext, "flooding"));
+
+    // many call sites, none is sharing the flooding call site quota
+    for (int line = 1; line <= 1000; ++line) {
+        QMessageLogContext context("test.cpp", 1000 + line, "function", "jt.Test");
+        QVERIFY2(writer.log(QtInfoMsg, context, "message"), qPrintable(QString("line %1").arg(line)));
+    }
+}
+
+void TestAsyncLogWriter::sameSourceFileIsTheSameCallSite()
+{
+    QTemporaryDir dir;
+    ManualClockLogWriter writer(dir.path() + "/log.txt");
+
+    // the same file name with different pointers, as in different translation units
+    QByteArray firstFileName("test.cpp");
+    QByteArray secondFileName("test.cpp");
+    QMessageLogContext firstContext(firstFileName.constData(), 20, "function", "jt.Test");
+    QMessageLogContext secondContext(secondFileName.constData(), 20, "function", "jt.Test");
+
+    for (int i = 0; i < AsyncLogWriter::MAX_MESSAGES_PER_CALL_SITE; ++i)
+        QVERIFY(writer.log(QtInfoMsg, firstContext, "message"));
+
+    QVERIFY(!writer.log(QtInfoMsg, secondContext, "message"));
+}
+
+void TestAsyncLogWriter::longMessagesAreTruncated()
+{
+    QTemporaryDir dir;
+    QString logFile = dir.path() + "/log.txt";
+    AsyncLogWriter writer(logFile, false);
+
+    QMessageLogContext context("test.cpp", 30, "function", "jt.Test");
+    QString longMessage(AsyncLogWriter::MAX_MESSAGE_SIZE * 2, QChar('x'));
+    QVERIFY(writer.log(QtInfoMsg, context, longMessage));
+
+    writer.flush();
+    QStringList lines = readLines(logFile);
+    QCOMPARE(lines.size(), 1);
+    QCOMPARE(lines.first(), "jt.Test.INFO:  " + QString(AsyncLogWriter::MAX_MESSAGE_SIZE, QChar('x')));
+}
+
+void TestAsyncLogWriter::concurrentProducers()
+{
+    QTemporaryDir dir;
+    QString logFile = dir.path() + "/log.txt";
+    AsyncLogWriter writer(logFile, false);
+    writer.start();
+
+    const int producers = 4;
+    const int messagesPerProducer = AsyncLogWriter::MAX_MESSAGES_PER_CALL_SITE;
+    QList<QFuture<void>> futures;
+    for (int p = 0; p < producers; ++p) {
+        futures.append(QtConcurrent::run([&writer, p, messagesPerProducer]() {
+            QMessageLogContext context("test.cpp", 100 + p, "function", "jt.Test"); // one call site per producer
+            for (int i = 0; i < messagesPerProducer; ++i)
+                writer.log(QtInfoMsg, context, QString("producer %1 message %2").arg(p).arg(i));
+        }));
+    }
+    for (QFuture<void> &future : futures)
+        future.waitForFinished();
+
+    writer.stop();
+    writer.flush();
+
+    QCOMPARE(writer.getDroppedMessages(), 0);
+    QCOMPARE(readLines(logFile).size(), producers * messagesPerProducer);
+}
+
+QTEST_MAIN(TestAsyncLogWriter)
+
+#include "tst_AsyncLogWriter.moc"
@@ -0,0 +1,36 @@
+QT += testlib core network
+QT -= gui
+CONFIG += testcase c++11
+TEMPLATE = app
+TARGET = testLoginServer
+INCLUDEPATH += .
+INCLUDEPATH += ../streaming
+INCLUDEPATH += ../../../src/Common
+VPATH += ../../../src/Common
+
+HEADERS += log/logging.h
+HEADERS += loginserver/LoginService.h
+HEADERS += loginserver/natmap.h
+HEADERS += ninjam/Server.h
+HEADERS += ninjam/User.h
+HEADERS += ninjam/UserChannel.h
+HEADERS += ninjam/Service.h
+
+SOURCES += log/logging.cpp
+SOURCES += loginserver/LoginService.cpp
+SOURCES += ninjam/Server.cpp
+SOURCES += ninjam/User.cpp
+SOURCES += ninjam/UserChannel.cpp
+SOURCES += ninjam/Service.cpp
+SOURCES += ninjam/ServerMessages.cpp
+SOURCES += ninjam/ServerMessagesHandler.cpp
+SOURCES += ninjam/ClientMessages.cpp
+
+# the local http server is shared with the streaming tests
+HEADERS += ../streaming/HttpStandIn.h
+SOURCES += ../streaming/HttpStandIn.cpp
+
+SOURCES += tst_LoginService.cpp
+
+RESOURCES += \
+    loginServerTestsResources.qrc
@@ -0,0 +1,206 @@
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+#include "loginserver/LoginService.h"
+#include "loginserver/natmap.h"
+#include "HttpStandIn.h"
+
+using namespace Login;
+
+static const int TIMEOUT = 5000;
+
+// the json files are rooms lists recorded from the Jamtaba server
+class TestLoginService : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void firstRoomsListIsAdded();
+    void onlyTheChangesAreEmitted();
+    void unchangedRoomsListIsNotEmitted();
+    void removedRoom();
+    void invalidRoomsListIsIgnored();
+    void usersOrderIsNotAChange();
+    void duplicatedUsers();
+
+private:
+    static void connectInServer(LoginService &service, HttpStandIn &server, const QString &fileName);
+    static RoomsListChanges refresh(LoginService &service, HttpStandIn &server, const QString &fileName, QSignalSpy &spy);
+    static QStringList getUsersNames(const QList<UserInfo> &users);
+    static QList<long long> getRoomsIDs(const QList<RoomInfo> &rooms);
+};
+
+void TestLoginService::initTestCase()
+{
+    qRegisterMetaType<Login::RoomsListChanges>();
+}
+
+void TestLoginService::connectInServer(LoginService &service, HttpStandIn &server, const QString &fileName)
+{
+    service.setServerUrl(server.getUrl(fileName));
+    service.connectInServer("tester", 0, "channel", NatMap(), "2.0", "test", 44100);
+}
+
+RoomsListChanges TestLoginService::refresh(LoginService &service, HttpStandIn &server, const QString &fileName, QSignalSpy &spy)
+{
+    int emittedSignals = spy.count();
+    service.setServerUrl(server.getUrl(fileName));
+    service.refreshRoomsList();
+    if (!spy.wait(TIMEOUT) || spy.count() == emittedSignals)
+        return RoomsListChanges();
+
+    return spy.last().at(0).value<RoomsListChanges>();
+}
+
+QStringList TestLoginService::getUsersNames(const QList<UserInfo> &users)
+{
+    QStringList names;
+    foreach (const UserInfo &user, users)
+        names.append(user.getName());
+    return names;
+}
+
+QList<long long> TestLoginService::getRoomsIDs(const QList<RoomInfo> &rooms)
+{
+    QList<long long> ids;
+    foreach (const RoomInfo &room, rooms)
+        ids.append(room.getID());
+    return ids;
+}
+
+void TestLoginService::firstRoomsListIsAdded()
+{
+    HttpStandIn server(":/json");
+    LoginService service;
+    QSignalSpy spy(&service, SIGNAL(roomsListChanged(Login::RoomsListChanges)));
+
+    connectInServer(service, server, "rooms-1.json");
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 1, TIMEOUT);
+
+    RoomsListChanges changes = spy.at(0).at(0).value<RoomsListChanges>();
+    QCOMPARE(changes.getAddedRooms().size(), 3);
+    QVERIFY(changes.getChangedRooms().isEmpty());
+    QVERIFY(changes.getRemovedRooms().isEmpty());
+    QCOMPARE(service.getPublicRooms().size(), 3);
+    QCOMPARE(service.getPublicRooms().at(0).getUsers().size(), 3);
+}
+
+void TestLoginService::onlyTheChangesAreEmitted()
+{
+    HttpStandIn server(":/json");
+    LoginService service;
+    QSignalSpy spy(&service, SIGNAL(roomsListChanged(Login::RoomsListChanges)));
+    connectInServer(service, server, "rooms-1.json");
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 1, TIMEOUT);
+
+    RoomsListChanges changes = refresh(service, server, "rooms-2.json", spy);
+    QCOMPARE(spy.count(), 2);
+
+    // the ninbot.com users are reordered only
+    QCOMPARE(getRoomsIDs(changes.getAddedRooms()), QList<long long>() << 4785074604081152LL);
+    QCOMPARE(getRoomsIDs(changes.getChangedRooms()), QList<long long>() << 5707702298738688LL << 6192449487634432LL);
+    QVERIFY(changes.getRemovedRooms().isEmpty());
+
+    QCOMPARE(getUsersNames(changes.getJoinedUsers(5707702298738688LL)), QStringList() << "bob");
+    QCOMPARE(getUsersNames(changes.getLeftUsers(5707702298738688LL)), QStringList() << "elieser");
+
+    // bpm changed, no users changes
+    QVERIFY(changes.getJoinedUsers(6192449487634432LL).isEmpty());
+    QVERIFY(changes.getLeftUsers(6192449487634432LL).isEmpty());
+    QCOMPARE(changes.getChangedRooms().at(1).getBpm(), 110);
+
+    QCOMPARE(service.getPublicRooms().size(), 4);
+}
+
+void TestLoginService::unchangedRoomsListIsNotEmitted()
+{
+    HttpStandIn server(":/json");
+    LoginService service;
+    QSignalSpy spy(&service, SIGNAL(roomsListChanged(Login::RoomsListChanges)));
+    connectInServer(service, server, "rooms-2.json");
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 1, TIMEOUT);
+
+    service.refreshRoomsList();
+    QTRY_COMPARE_WITH_TIMEOUT(server.getServedRequests(), 2, TIMEOUT);
+    QTest::qWait(100); // the reply is handled after the request is served
+
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(service.getPublicRooms().size(), 4);
+}
+
+void TestLoginService::removedRoom()
+{
+    HttpStandIn server(":/json");
+    LoginService service;
+    QSignalSpy spy(&service, SIGNAL(roomsListChanged(Login::RoomsListChanges)));
+    connectInServer(service, server, "rooms-2.json");
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 1, TIMEOUT);
+
+    RoomsListChanges changes = refresh(service, server, "rooms-3.json", spy);
+    QVERIFY(changes.getAddedRooms().isEmpty());
+    QVERIFY(changes.getChangedRooms().isEmpty());
+    QCOMPARE(changes.getRemovedRooms().size(), 1);
+    QCOMPARE(changes.getRemovedRooms().first().getName(), QString("ninjamer.com"));
+    QCOMPARE(changes.getRemovedRooms().first().getUsers().size(), 2); // the last received room info
+    QCOMPARE(service.getPublicRooms().size(), 3);
+}
+
+void TestLoginService::invalidRoomsListIsIgnored()
+{
+    HttpStandIn server(":/json");
+    LoginService service;
+    QSignalSpy spy(&service, SIGNAL(roomsListChanged(Login::RoomsListChanges)));
+    connectInServer(service, server, "rooms-1.json");
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 1, TIMEOUT);
+
+    service.setServerUrl(server.getUrl("truncated.json"));
+    service.refreshRoomsList();
+    QTRY_COMPARE_WITH_TIMEOUT(server.getServedRequests(), 2, TIMEOUT);
+    QTest::qWait(100);
+
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(service.getPublicRooms().size(), 3); // not all rooms removed
+
+    RoomsListChanges changes = refresh(service, server, "rooms-2.json", spy);
+    QCOMPARE(changes.getAddedRooms().size(), 1);
+    QCOMPARE(changes.getChangedRooms().size(), 2);
+}
+
+void TestLoginService::usersOrderIsNotAChange()
+{
+    QList<UserInfo> users;
+    users << UserInfo(0, "ninbot", "127.0.0.x") << UserInfo(0, "ezee", "177.142.36.x");
+    QList<UserInfo> reorderedUsers;
+    reorderedUsers << users.at(1) << users.at(0);
+
+    QList<RoomInfo> previous;
+    previous << RoomInfo(1, "ninbot.com", 2049, RoomTYPE::NINJAM, 8, users, 0, 16, 120, "");
+    QList<RoomInfo> current;
+    current << RoomInfo(1, "ninbot.com", 2049, RoomTYPE::NINJAM, 8, reorderedUsers, 0, 16, 120, "");
+
+    QVERIFY(RoomsListChanges::compute(previous, current).isEmpty());
+    QVERIFY(RoomsListChanges::compute(previous, previous).isEmpty());
+}
+
+void TestLoginService::duplicatedUsers()
+{
+    QList<UserInfo> users;
+    users << UserInfo(0, "Jambot", "127.0.0.x") << UserInfo(0, "Jambot", "127.0.0.x");
+    QList<UserInfo> oneUser;
+    oneUser << UserInfo(0, "Jambot", "127.0.0.x");
+
+    QList<RoomInfo> previous;
+    previous << RoomInfo(1, "ninbot.com", 2049, RoomTYPE::NINJAM, 8, users, 0, 16, 120, "");
+    QList<RoomInfo> current;
+    current << RoomInfo(1, "ninbot.com", 2049, RoomTYPE::NINJAM, 8, oneUser, 0, 16, 120, "");
+
+    RoomsListChanges changes = RoomsListChanges::compute(previous, current);
+    QCOMPARE(changes.getChangedRooms().size(), 1);
+    QVERIFY(changes.getJoinedUsers(1).isEmpty());
+    QCOMPARE(getUsersNames(changes.getLeftUsers(1)), QStringList() << "Jambot");
+}
+
+QTEST_MAIN(TestLoginService)
+
+#include "tst_LoginService.moc"
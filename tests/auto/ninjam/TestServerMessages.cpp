@@ -150,6 +150,39 @@ void TestServerMessages::downloadIntervalBegin()
     QCOMPARE(msg.getUserName(), QString(userName));
 }
 
+void TestServerMessages::downloadSilentIntervalBegin()
+{
+    // empty interval: zeroed GUID and fourCC, no download writes
+    QByteArray GUID(16, 0);
+    quint32 estimatedSize = 0;
+    quint8 channelIndex = 1;
+    const char *userName = "testUserName\0";
+
+    quint32 payload = 16 + 4 + 4 + 1 + qstrlen(userName)+1;
+
+    QByteArray device;
+    {
+        QDataStream stream(&device, QIODevice::WriteOnly);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        stream.writeRawData(GUID, 16);
+        stream << estimatedSize;
+        for (int k = 0; k < 4; ++k) {
+            stream << (quint8)0;
+        }
+        stream << channelIndex;
+        stream.writeRawData( userName, qstrlen(userName)+1);
+    }
+
+    DownloadIntervalBegin msg(payload);
+    QDataStream stream(&device, QIODevice::ReadOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream >> msg;
+
+    QVERIFY(msg.isSilentInterval());
+    QVERIFY(!msg.isValidOggDownload());
+    QCOMPARE(msg.getChannelIndex(), channelIndex);
+}
+
 void TestServerMessages::authChallengeMessage_data()
 {
     QTest::addColumn<QString>("licenceText");
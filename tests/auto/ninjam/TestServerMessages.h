@@ -27,6 +27,7 @@ private slots:
     void userInfoChangeNotifyMessage();
 
     void downloadIntervalBegin();
+    void downloadSilentIntervalBegin();
 
     void downloadIntervalWrite_data();
     void downloadIntervalWrite();
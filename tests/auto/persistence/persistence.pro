@@ -1,7 +1,7 @@
 
 QT += testlib
 QT -= gui
-CONFIG += testcase
+CONFIG += testcase c++11
 TEMPLATE = app
 TARGET = persistence
 INCLUDEPATH += .
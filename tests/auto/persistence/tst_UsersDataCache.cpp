@@ -2,6 +2,7 @@
 #include <QObject>
 #include <QString>
 #include <QtTest/QtTest>
+#include <QTemporaryDir>
 #include "persistence/UsersDataCache.h"
 #include "persistence/CacheHeader.h"
 
@@ -36,14 +37,120 @@ private slots:
     void setPanGuard();
 };
 
-// NOTE: UsersDataCache class was not able to test without side effect
-// because destructor write to storage directly.
+// the UsersDataCache tests are using a temporary cache dir
 class TestUsersDataCache: public QObject
 {
     Q_OBJECT
 private slots:
+    void defaultEntry();
+    void entriesAreRestored();
+    void updatesAreStoredImmediately();
+    void fileIsCompacted();
+    void incompleteRecordIsIgnored();
+
+private:
+    static void setValues(CacheEntry &entry, bool muted, float gain, float pan, float boost);
 };
 
+void TestUsersDataCache::setValues(CacheEntry &entry, bool muted, float gain, float pan, float boost)
+{
+    entry.setMuted(muted);
+    entry.setGain(gain);
+    entry.setPan(pan);
+    entry.setBoost(boost);
+}
+
+void TestUsersDataCache::defaultEntry()
+{
+    QTemporaryDir dir;
+    UsersDataCache cache(QDir(dir.path()));
+    CacheEntry entry = cache.getUserCacheEntry("10.0.0.x", "anon", 1);
+    QCOMPARE(entry.getUserName(), QStringLiteral("anon"));
+    QCOMPARE(entry.getChannelID(), static_cast<quint8>(1));
+    QCOMPARE(entry.getGain(), CacheEntry::DEFAULT_GAIN);
+    QCOMPARE(cache.getEntriesCount(), 0);
+}
+
+void TestUsersDataCache::entriesAreRestored()
+{
+    QTemporaryDir dir;
+    {
+        UsersDataCache cache(QDir(dir.path()));
+        CacheEntry entry("10.0.0.x", "anon", 1);
+        setValues(entry, true, 0.5f, -1.0f, 2.0f);
+        cache.updateUserCacheEntry(entry);
+
+        CacheEntry otherChannel("10.0.0.x", "anon", 2);
+        setValues(otherChannel, false, 0.25f, 1.0f, 1.0f);
+        cache.updateUserCacheEntry(otherChannel);
+    }
+
+    UsersDataCache cache(QDir(dir.path()));
+    QCOMPARE(cache.getEntriesCount(), 2);
+
+    CacheEntry entry = cache.getUserCacheEntry("10.0.0.x", "anon", 1);
+    QCOMPARE(entry.isMuted(), true);
+    QCOMPARE(entry.getGain(), 0.5f);
+    QCOMPARE(entry.getPan(), -1.0f);
+    QCOMPARE(entry.getBoost(), 2.0f);
+
+    QCOMPARE(cache.getUserCacheEntry("10.0.0.x", "anon", 2).getGain(), 0.25f);
+    QCOMPARE(cache.getUserCacheEntry("10.0.0.x", "anonymous", 1).getGain(), CacheEntry::DEFAULT_GAIN);
+}
+
+void TestUsersDataCache::updatesAreStoredImmediately()
+{
+    QTemporaryDir dir;
+    UsersDataCache cache(QDir(dir.path()));
+    CacheEntry entry("10.0.0.x", "anon", 0);
+    setValues(entry, false, 0.75f, 0.0f, 1.0f);
+    cache.updateUserCacheEntry(entry);
+
+    // the first cache is not destroyed, like in a crash
+    UsersDataCache otherCache(QDir(dir.path()));
+    QCOMPARE(otherCache.getUserCacheEntry("10.0.0.x", "anon", 0).getGain(), 0.75f);
+}
+
+void TestUsersDataCache::fileIsCompacted()
+{
+    QTemporaryDir dir;
+    UsersDataCache cache(QDir(dir.path()));
+    CacheEntry entry("10.0.0.x", "anon", 0);
+    for (int i = 0; i < UsersDataCache::MIN_RECORDS_TO_COMPACT * 3; ++i) {
+        entry.setGain(i / 100.0f);
+        cache.updateUserCacheEntry(entry);
+    }
+
+    QCOMPARE(cache.getEntriesCount(), 1);
+    QVERIFY(cache.getFileRecordsCount() < UsersDataCache::MIN_RECORDS_TO_COMPACT);
+    QCOMPARE(cache.getUserCacheEntry("10.0.0.x", "anon", 0).getGain(), entry.getGain());
+}
+
+void TestUsersDataCache::incompleteRecordIsIgnored()
+{
+    QTemporaryDir dir;
+    QString cacheFilePath;
+    {
+        UsersDataCache cache(QDir(dir.path()));
+        CacheEntry entry("10.0.0.x", "anon", 0);
+        setValues(entry, true, 0.5f, 0.0f, 1.0f);
+        cache.updateUserCacheEntry(entry);
+    }
+
+    // simulating a crash while a record is written
+    QStringList files = QDir(dir.path()).entryList(QDir::Files);
+    QCOMPARE(files.size(), 1);
+    QFile cacheFile(QDir(dir.path()).absoluteFilePath(files.first()));
+    QVERIFY(cacheFile.open(QFile::Append));
+    cacheFile.write("trash");
+    cacheFile.close();
+
+    UsersDataCache cache(QDir(dir.path()));
+    QCOMPARE(cache.getEntriesCount(), 1);
+    QCOMPARE(cache.getUserCacheEntry("10.0.0.x", "anon", 0).getGain(), 0.5f);
+    QCOMPARE(cache.getFileRecordsCount(), 1);
+}
+
 void TestCacheHeader::invalidRevision()
 {
     QFETCH(quint32, expectedRevision);
@@ -0,0 +1,57 @@
+#include "HttpStandIn.h"
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QFile>
+
+HttpStandIn::HttpStandIn(const QString &filesDirectory, QObject *parent) :
+    QTcpServer(parent),
+    filesDirectory(filesDirectory),
+    servedRequests(0)
+{
+    connect(this, SIGNAL(newConnection()), this, SLOT(acceptConnection()));
+    listen(QHostAddress::LocalHost);
+}
+
+QString HttpStandIn::getUrl(const QString &fileName) const
+{
+    return QString("http://127.0.0.1:%1/%2").arg(serverPort()).arg(fileName);
+}
+
+void HttpStandIn::acceptConnection()
+{
+    while (hasPendingConnections()) {
+        QTcpSocket *socket = nextPendingConnection();
+        connect(socket, SIGNAL(readyRead()), this, SLOT(readRequest()));
+        connect(socket, SIGNAL(disconnected()), socket, SLOT(deleteLater()));
+    }
+}
+
+void HttpStandIn::readRequest()
+{
+    QTcpSocket *socket = qobject_cast<QTcpSocket *>(sender());
+    if (!socket || !socket->canReadLine())
+        return;
+
+    // request line: GET /file HTTP/1.1, the headers are ignored
+    QList<QByteArray> requestLine = socket->readLine().trimmed().split(' ');
+    socket->readAll();
+    QString path = requestLine.size() > 1 ? QString::fromUtf8(requestLine.at(1)) : QString();
+    path = path.section("?", 0, 0); // the query is used just to create different urls to the same file
+    sendResponse(socket, path);
+}
+
+void HttpStandIn::sendResponse(QTcpSocket *socket, const QString &path)
+{
+    QFile file(filesDirectory + path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        socket->write("HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\n\r\n");
+    } else {
+        QByteArray content = file.readAll();
+        socket->write("HTTP/1.0 200 OK\r\n");
+        socket->write("Content-Type: audio/mpeg\r\n");
+        socket->write(QString("Content-Length: %1\r\n\r\n").arg(content.size()).toUtf8());
+        socket->write(content);
+        servedRequests++;
+    }
+    socket->disconnectFromHost();
+}
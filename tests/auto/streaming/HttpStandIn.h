@@ -0,0 +1,35 @@
+#ifndef HTTP_STAND_IN_H
+#define HTTP_STAND_IN_H
+
+#include <QTcpServer>
+#include <QString>
+
+class QTcpSocket;
+
+// a minimal local http server used in place of the ninjam streams server, the files are served from a resources directory
+class HttpStandIn : public QTcpServer
+{
+    Q_OBJECT
+
+public:
+    explicit HttpStandIn(const QString &filesDirectory, QObject *parent = nullptr);
+
+    QString getUrl(const QString &fileName) const;
+
+    inline int getServedRequests() const
+    {
+        return servedRequests;
+    }
+
+private slots:
+    void acceptConnection();
+    void readRequest();
+
+private:
+    QString filesDirectory;
+    int servedRequests;
+
+    void sendResponse(QTcpSocket *socket, const QString &path);
+};
+
+#endif
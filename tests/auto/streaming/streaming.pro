@@ -0,0 +1,63 @@
+QT += testlib core network
+QT -= gui
+CONFIG += testcase c++11
+TEMPLATE = app
+TARGET = streaming
+INCLUDEPATH += .
+INCLUDEPATH += ../../../src/Common
+INCLUDEPATH += ../../../libs/includes/minimp3
+VPATH += ../../../src/Common
+
+HEADERS += log/logging.h
+HEADERS += audio/core/SamplesBuffer.h
+HEADERS += audio/core/AudioPeak.h
+HEADERS += audio/core/SamplesRingBuffer.h
+HEADERS += audio/codec.h
+HEADERS += audio/Mp3DecoderPool.h
+HEADERS += audio/RoomStreamPreviewer.h
+
+SOURCES += log/logging.cpp
+SOURCES += audio/core/SamplesBuffer.cpp
+
+HEADERS += audio/core/Interleaving.h
+SOURCES += audio/core/Interleaving.cpp
+SOURCES += audio/core/AudioPeak.cpp
+SOURCES += audio/core/SamplesRingBuffer.cpp
+SOURCES += audio/codec.cpp
+SOURCES += audio/Mp3DecoderPool.cpp
+SOURCES += audio/RoomStreamPreviewer.cpp
+
+HEADERS += HttpStandIn.h
+SOURCES += HttpStandIn.cpp
+
+SOURCES += tst_RoomStreamPreviewer.cpp
+
+RESOURCES += \
+    streamingTestsResources.qrc
+
+# the minimp3 static library is the same used in Jamtaba
+linux {
+    contains(QMAKE_HOST.arch, x86_64) {
+        LIBS_PATH = "static/linux64"
+    } else {
+        LIBS_PATH = "static/linux32"
+    }
+}
+macx {
+    LIBS_PATH = "static/mac64"
+}
+win32-msvc* {
+    !contains(QMAKE_TARGET.arch, x86_64) {
+        LIBS_PATH = "static/win32-msvc"
+    } else {
+        LIBS_PATH = "static/win64-msvc"
+    }
+}
+win32-g++ {
+    LIBS_PATH = "static/win32-mingw"
+}
+win32-msvc*:CONFIG(debug, debug|release) {
+    LIBS += -L$$PWD/../../../libs/$$LIBS_PATH -lminimp3d
+} else {
+    LIBS += -L$$PWD/../../../libs/$$LIBS_PATH -lminimp3
+}
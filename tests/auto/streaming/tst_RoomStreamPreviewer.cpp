@@ -0,0 +1,146 @@
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QFile>
+#include <QElapsedTimer>
+#include "audio/RoomStreamPreviewer.h"
+#include "audio/Mp3DecoderPool.h"
+#include "audio/codec.h"
+#include "HttpStandIn.h"
+
+using namespace Audio;
+
+static const int TIMEOUT = 5000;
+static const int FILE_FRAMES = 77 * 1152; // the test files have 77 mp3 frames
+
+class TestRoomStreamPreviewer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void previewsAreDecodedInParallel();
+    void oldestPreviewIsStopped();
+    void audiblePreviewIsNotStopped();
+    void nonAudibleStreamKeepsTheRecentSamples();
+    void audibleStreamWaitsForTheConsumer();
+
+private:
+    static QByteArray readTestFile(const QString &fileName);
+};
+
+QByteArray TestRoomStreamPreviewer::readTestFile(const QString &fileName)
+{
+    QFile file(":/mp3/" + fileName);
+    file.open(QIODevice::ReadOnly);
+    return file.readAll();
+}
+
+void TestRoomStreamPreviewer::previewsAreDecodedInParallel()
+{
+    HttpStandIn server(":/mp3");
+    QVERIFY(server.isListening());
+
+    RoomStreamPreviewer previewer(4, 2);
+    QSharedPointer<Mp3Stream> stereoStream = previewer.startPreview(server.getUrl("silence-stereo.mp3"));
+    QSharedPointer<Mp3Stream> monoStream = previewer.startPreview(server.getUrl("silence-mono.mp3"));
+
+    QTRY_COMPARE_WITH_TIMEOUT(stereoStream->getRingBuffer().getAvailableFrames(), FILE_FRAMES, TIMEOUT);
+    QTRY_COMPARE_WITH_TIMEOUT(monoStream->getRingBuffer().getAvailableFrames(), FILE_FRAMES, TIMEOUT);
+
+    QCOMPARE(stereoStream->getSampleRate(), 44100);
+    QCOMPARE(monoStream->getSampleRate(), 44100);
+    QCOMPARE(server.getServedRequests(), 2);
+
+    // starting a previewed stream again is not downloading the stream again
+    QCOMPARE(previewer.startPreview(server.getUrl("silence-stereo.mp3")), stereoStream);
+    QCOMPARE(previewer.getPreviewedStreams().size(), 2);
+}
+
+void TestRoomStreamPreviewer::oldestPreviewIsStopped()
+{
+    HttpStandIn server(":/mp3");
+    RoomStreamPreviewer previewer(2, 1);
+
+    QString firstUrl = server.getUrl("silence-mono.mp3?room=1");
+    QString secondUrl = server.getUrl("silence-mono.mp3?room=2");
+    QString thirdUrl = server.getUrl("silence-mono.mp3?room=3");
+
+    previewer.startPreview(firstUrl);
+    previewer.startPreview(secondUrl);
+    previewer.startPreview(thirdUrl);
+
+    QCOMPARE(previewer.getPreviewedStreams(), QStringList() << secondUrl << thirdUrl);
+    QVERIFY(!previewer.isPreviewing(firstUrl));
+}
+
+void TestRoomStreamPreviewer::audiblePreviewIsNotStopped()
+{
+    HttpStandIn server(":/mp3");
+    RoomStreamPreviewer previewer(2, 1);
+
+    QString firstUrl = server.getUrl("silence-mono.mp3?room=1");
+    QString secondUrl = server.getUrl("silence-mono.mp3?room=2");
+    QString thirdUrl = server.getUrl("silence-mono.mp3?room=3");
+
+    previewer.startPreview(firstUrl)->setAudible(true);
+    previewer.startPreview(secondUrl);
+    previewer.startPreview(thirdUrl);
+
+    QCOMPARE(previewer.getPreviewedStreams(), QStringList() << firstUrl << thirdUrl);
+}
+
+void TestRoomStreamPreviewer::nonAudibleStreamKeepsTheRecentSamples()
+{
+    const int ringCapacity = 10000;
+    QSharedPointer<Mp3Stream> stream(new Mp3Stream(new Mp3DecoderMiniMp3(), ringCapacity));
+    Mp3DecoderPool pool(1);
+    pool.addStream(stream);
+
+    stream->addBytes(readTestFile("silence-stereo.mp3"));
+    pool.wakeUp();
+
+    // all bytes are decoded and the oldest samples are dropped
+    QTRY_VERIFY_WITH_TIMEOUT(!stream->hasWorkToDo(), TIMEOUT);
+    QCOMPARE(stream->getRingBuffer().getAvailableFrames(), ringCapacity);
+
+    pool.removeStream(stream);
+}
+
+void TestRoomStreamPreviewer::audibleStreamWaitsForTheConsumer()
+{
+    const int ringCapacity = 10000;
+    QSharedPointer<Mp3Stream> stream(new Mp3Stream(new Mp3DecoderMiniMp3(), ringCapacity));
+    stream->setAudible(true);
+    Mp3DecoderPool pool(1);
+    pool.addStream(stream);
+
+    stream->addBytes(readTestFile("silence-stereo.mp3"));
+    pool.wakeUp();
+
+    // the ring is full but no samples are dropped, the decoding continues when the samples are consumed
+    SamplesRingBuffer &ringBuffer = stream->getRingBuffer();
+    QTRY_COMPARE_WITH_TIMEOUT(ringBuffer.getAvailableFrames(), ringCapacity, TIMEOUT);
+    QVERIFY(stream->getBufferedBytes() > 0);
+
+    int consumedFrames = 0;
+    SamplesBuffer out(2, 1024);
+    QElapsedTimer timer;
+    timer.start();
+    while (consumedFrames < FILE_FRAMES && timer.elapsed() < TIMEOUT) {
+        int frames = ringBuffer.read(out, out.getFrameLenght());
+        if (frames <= 0)
+            QTest::qWait(5);
+        consumedFrames += frames;
+    }
+    QCOMPARE(consumedFrames, FILE_FRAMES);
+
+    pool.removeStream(stream);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    TestRoomStreamPreviewer test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "tst_RoomStreamPreviewer.moc"
@@ -0,0 +1,233 @@
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QElapsedTimer>
+#include <QtEndian>
+#include <QVector>
+#include <cmath>
+#include <algorithm>
+#include "audio/vorbis/VorbisEncoder.h"
+#include "audio/core/SamplesBuffer.h"
+
+using namespace Audio;
+
+static const int SAMPLE_RATE = 44100;
+static const int BLOCK_SIZE = 256; // audio callback size, the encoder receives the same blocks
+static const int INTERVALS = 50;
+
+class TestVorbisEncoder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void intervalsStartWithTheHeaders();
+    void preparedStreamIsUsedInTheNextInterval();
+    void pagesAreFilledUpToTheTargetSize();
+    void pagesAreFlushedByTheLatency();
+    void intervalEndIsFlushed();
+
+    // measurement, the interval bytes with one page per packet and with the default page policy
+    void bytesPerInterval();
+
+    // benchmarks, the result is the median time to encode the first block of an interval
+    void intervalBoundaryWithPreparedStream();
+    void intervalBoundaryWithoutPreparedStream();
+
+private:
+    struct Page
+    {
+        qint64 granule; // -1 when no packet is finished in the page
+        int bodySize;
+    };
+
+    static QList<Page> parsePages(const QByteArray &oggData);
+    static QByteArray encodeInterval(VorbisEncoder &encoder, int frames);
+    static SamplesBuffer createSineBlock(int channels, int frames);
+    static qint64 measureIntervalBoundary(bool preparingNextInterval);
+};
+
+SamplesBuffer TestVorbisEncoder::createSineBlock(int channels, int frames)
+{
+    const double phaseIncrement = 2.0 * 3.14159265358979323846 * 440.0 / SAMPLE_RATE; // 440 Hz
+    SamplesBuffer block(channels, frames);
+    for (int c = 0; c < channels; ++c) {
+        for (int s = 0; s < frames; ++s)
+            block.set(c, s, 0.5f * std::sin(phaseIncrement * s));
+    }
+    return block;
+}
+
+QList<TestVorbisEncoder::Page> TestVorbisEncoder::parsePages(const QByteArray &oggData)
+{
+    QList<Page> pages;
+    int position = 0;
+    while (position + 27 <= oggData.size()) {
+        if (!oggData.mid(position, 4).startsWith("OggS"))
+            break;
+
+        const uchar *header = reinterpret_cast<const uchar *>(oggData.constData() + position);
+        int segments = header[26];
+        Page page;
+        page.granule = qFromLittleEndian<qint64>(header + 6);
+        page.bodySize = 0;
+        for (int s = 0; s < segments; ++s)
+            page.bodySize += header[27 + s];
+
+        pages.append(page);
+        position += 27 + segments + page.bodySize;
+    }
+    return pages;
+}
+
+QByteArray TestVorbisEncoder::encodeInterval(VorbisEncoder &encoder, int frames)
+{
+    SamplesBuffer block = createSineBlock(2, BLOCK_SIZE);
+    QByteArray interval;
+    for (int encodedFrames = 0; encodedFrames < frames; encodedFrames += BLOCK_SIZE)
+        interval.append(encoder.encode(block));
+    interval.append(encoder.finishIntervalEncoding());
+    return interval;
+}
+
+qint64 TestVorbisEncoder::measureIntervalBoundary(bool preparingNextInterval)
+{
+    VorbisEncoder encoder(2, SAMPLE_RATE);
+    SamplesBuffer block = createSineBlock(2, BLOCK_SIZE);
+
+    QVector<qint64> boundaryTimes;
+    QElapsedTimer timer;
+    for (int interval = 0; interval < INTERVALS; ++interval) {
+        timer.start();
+        encoder.encode(block); // the interval start
+        boundaryTimes.append(timer.nsecsElapsed());
+
+        for (int i = 0; i < 20; ++i)
+            encoder.encode(block);
+        encoder.finishIntervalEncoding();
+
+        if (preparingNextInterval)
+            encoder.prepareNextInterval(); // done by the encoding thread when there is nothing to encode
+    }
+
+    boundaryTimes.removeFirst(); // the first interval is never prepared
+    std::sort(boundaryTimes.begin(), boundaryTimes.end());
+    return boundaryTimes.at(boundaryTimes.size() / 2);
+}
+
+void TestVorbisEncoder::intervalsStartWithTheHeaders()
+{
+    VorbisEncoder encoder(2, SAMPLE_RATE);
+    SamplesBuffer block = createSineBlock(2, BLOCK_SIZE);
+
+    for (int interval = 0; interval < 3; ++interval) {
+        QByteArray intervalStart = encoder.encode(block);
+        QVERIFY(intervalStart.startsWith("OggS"));
+        encoder.finishIntervalEncoding();
+        encoder.prepareNextInterval();
+    }
+}
+
+void TestVorbisEncoder::preparedStreamIsUsedInTheNextInterval()
+{
+    VorbisEncoder encoder(2, SAMPLE_RATE);
+    SamplesBuffer block = createSineBlock(2, BLOCK_SIZE);
+
+    QByteArray firstInterval = encoder.encode(block);
+    firstInterval.append(encoder.finishIntervalEncoding());
+
+    encoder.prepareNextInterval();
+    QByteArray secondInterval = encoder.encode(block);
+    secondInterval.append(encoder.finishIntervalEncoding());
+
+    // same settings, the second interval differs only in the ogg stream serial number and in the pages CRC
+    QCOMPARE(secondInterval.size(), firstInterval.size());
+    QVERIFY(secondInterval != firstInterval);
+}
+
+void TestVorbisEncoder::pagesAreFilledUpToTheTargetSize()
+{
+    const int pageSize = 1024;
+    VorbisEncoder encoder(2, SAMPLE_RATE);
+    encoder.setPagePolicy(pageSize, 60000); // the pages are not flushed by the latency
+
+    QList<Page> pages = parsePages(encodeInterval(encoder, SAMPLE_RATE * 5));
+    QVERIFY(pages.size() > 3);
+
+    // the header pages (granule 0) and the interval end page are flushed without filling
+    for (int p = 0; p < pages.size() - 1; ++p) {
+        if (pages.at(p).granule != 0)
+            QVERIFY2(pages.at(p).bodySize >= pageSize, qPrintable(QString("page %1 has %2 bytes").arg(p).arg(pages.at(p).bodySize)));
+    }
+}
+
+void TestVorbisEncoder::pagesAreFlushedByTheLatency()
+{
+    const int pageLatency = 100; // milliseconds
+    VorbisEncoder encoder(2, SAMPLE_RATE);
+    encoder.setPagePolicy(1024 * 1024, pageLatency); // the pages are never full
+
+    QList<Page> pages = parsePages(encodeInterval(encoder, SAMPLE_RATE * 5));
+
+    // the page is flushed after the packet exceeding the latency, a vorbis packet has at most 1024 samples (long blocks)
+    const qint64 maxPageSamples = (qint64)SAMPLE_RATE * pageLatency / 1000 + 1024;
+    qint64 lastGranule = 0;
+    int audioPages = 0;
+    foreach (const Page &page, pages) {
+        if (page.granule <= 0)
+            continue;
+        QVERIFY(page.granule - lastGranule <= maxPageSamples);
+        lastGranule = page.granule;
+        audioPages++;
+    }
+    QVERIFY(audioPages >= 5000 / (pageLatency * 2)); // each page has between 'pageLatency' and 'pageLatency' + 1 packet
+}
+
+void TestVorbisEncoder::intervalEndIsFlushed()
+{
+    VorbisEncoder encoder(2, SAMPLE_RATE);
+    encoder.setPagePolicy(1024 * 1024, 60000); // only the interval end is flushing the audio pages
+
+    QList<Page> pages = parsePages(encodeInterval(encoder, SAMPLE_RATE));
+    QVERIFY(!pages.isEmpty());
+    QVERIFY(pages.last().granule >= SAMPLE_RATE); // all the encoded samples are in the interval pages
+}
+
+// reference (libvorbis 1.3.7, 440 Hz sine): the baseline encoder sent 236861 bytes in 3449 pages, the default
+// page policy 144872 bytes in 42 pages. The packets are the same (140273 bytes), only the page headers changed
+void TestVorbisEncoder::bytesPerInterval()
+{
+    const int intervalFrames = SAMPLE_RATE * 10;
+
+    VorbisEncoder pagePerPacketEncoder(2, SAMPLE_RATE);
+    pagePerPacketEncoder.setPagePolicy(1, 1); // all the packets are flushed, as before the page policy
+    QByteArray pagePerPacketInterval = encodeInterval(pagePerPacketEncoder, intervalFrames);
+
+    VorbisEncoder defaultEncoder(2, SAMPLE_RATE);
+    QByteArray defaultInterval = encodeInterval(defaultEncoder, intervalFrames);
+
+    qInfo() << "10 seconds interval, one page per packet:" << pagePerPacketInterval.size() << "bytes in"
+            << parsePages(pagePerPacketInterval).size() << "pages";
+    qInfo() << "10 seconds interval, default page policy:" << defaultInterval.size() << "bytes in"
+            << parsePages(defaultInterval).size() << "pages";
+
+    QVERIFY(defaultInterval.size() < pagePerPacketInterval.size());
+}
+
+// reference (libvorbis 1.3.7, g++ -O2, 1 vCPU Xeon VM): the baseline encoder (stream and headers created
+// in the first encode() of each interval) took 3.4 - 4.3 ms, the prepared stream 1.5 - 1.7 us
+void TestVorbisEncoder::intervalBoundaryWithPreparedStream()
+{
+    qint64 median = measureIntervalBoundary(true);
+    qInfo() << "Interval start with the prepared stream:" << median << "ns";
+    QTest::setBenchmarkResult(median, QTest::WalltimeNanoseconds);
+}
+
+void TestVorbisEncoder::intervalBoundaryWithoutPreparedStream()
+{
+    qint64 median = measureIntervalBoundary(false); // the stream is initialized in the interval start, as before
+    qInfo() << "Interval start initializing the stream:" << median << "ns";
+    QTest::setBenchmarkResult(median, QTest::WalltimeNanoseconds);
+}
+
+QTEST_APPLESS_MAIN(TestVorbisEncoder)
+
+#include "tst_VorbisEncoder.moc"
@@ -0,0 +1,59 @@
+QT += testlib
+QT -= gui
+CONFIG += testcase c++11
+TEMPLATE = app
+TARGET = vorbis
+INCLUDEPATH += .
+INCLUDEPATH += ../../../src/Common
+INCLUDEPATH += ../../../libs/includes/ogg
+INCLUDEPATH += ../../../libs/includes/vorbis
+VPATH += ../../../src/Common
+
+HEADERS += log/Logging.h
+SOURCES += log/logging.cpp
+
+HEADERS += audio/core/SamplesBuffer.h
+SOURCES += audio/core/SamplesBuffer.cpp
+
+HEADERS += audio/core/Interleaving.h
+SOURCES += audio/core/Interleaving.cpp
+
+HEADERS += audio/core/AudioPeak.h
+SOURCES += audio/core/AudioPeak.cpp
+
+HEADERS += performance/Profiler.h
+SOURCES += performance/Profiler.cpp
+
+HEADERS += audio/vorbis/VorbisEncoder.h
+SOURCES += audio/vorbis/VorbisEncoder.cpp
+
+SOURCES += tst_VorbisEncoder.cpp
+
+# the vorbis and ogg static libraries are the same used in Jamtaba
+linux {
+    contains(QMAKE_HOST.arch, x86_64) {
+        LIBS_PATH = "static/linux64"
+    } else {
+        LIBS_PATH = "static/linux32"
+    }
+}
+macx {
+    LIBS_PATH = "static/mac64"
+}
+win32-msvc* {
+    !contains(QMAKE_TARGET.arch, x86_64) {
+        LIBS_PATH = "static/win32-msvc"
+    } else {
+        LIBS_PATH = "static/win64-msvc"
+    }
+}
+win32-g++ {
+    LIBS_PATH = "static/win32-mingw"
+}
+win32-msvc*:CONFIG(debug, debug|release) {
+    LIBS += -L$$PWD/../../../libs/$$LIBS_PATH -lvorbisd -loggd
+} else:win32-msvc* {
+    LIBS += -L$$PWD/../../../libs/$$LIBS_PATH -lvorbis -logg
+} else {
+    LIBS += -L$$PWD/../../../libs/$$LIBS_PATH -lvorbisenc -lvorbis -logg
+}
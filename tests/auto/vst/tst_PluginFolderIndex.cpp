@@ -0,0 +1,211 @@
+#include <QObject>
+#include <QString>
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+#include "vst/PluginFolderIndex.h"
+#include "vst/VstPluginChecker.h"
+
+using namespace Vst;
+
+// the platform checkers are not linked, the '.plugin' files are the valid plugins in these tests
+bool PluginChecker::isValidPluginFile(const QString &pluginPath)
+{
+    return pluginPath.endsWith(".plugin") && QFileInfo(pluginPath).isFile();
+}
+
+// the PluginFolderIndex tests are using a temporary scan folder and index file
+class TestPluginFolderIndex: public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void recentFolderIsNotIndexed();
+    void unchangedFolderIsIndexed();
+    void addedPluginIsDetected();
+    void addedPluginInSubFolderIsDetected();
+    void removedPluginIsNotDetected();
+    void modifiedPluginIsNotListingTheFolder();
+    void forgottenPluginIsDetectedInUnchangedFolder();
+    void indexIsRestored();
+
+private:
+    QTemporaryDir *scanDir;
+    QTemporaryDir *indexDir;
+
+    QString indexFilePath() const;
+    QString pluginPath(const QString &fileName) const;
+    static void createFile(const QString &filePath, const QByteArray &content = "plugin");
+    static void waitFolderAge();
+};
+
+void TestPluginFolderIndex::init()
+{
+    scanDir = new QTemporaryDir();
+    indexDir = new QTemporaryDir();
+}
+
+void TestPluginFolderIndex::cleanup()
+{
+    delete scanDir;
+    delete indexDir;
+}
+
+QString TestPluginFolderIndex::indexFilePath() const
+{
+    return indexDir->path() + "/plugin_folders.dat";
+}
+
+QString TestPluginFolderIndex::pluginPath(const QString &fileName) const
+{
+    return scanDir->path() + "/" + fileName;
+}
+
+void TestPluginFolderIndex::createFile(const QString &filePath, const QByteArray &content)
+{
+    QFile file(filePath);
+    QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+    file.write(content);
+}
+
+// the folders modified in the last 2 seconds are not indexed
+void TestPluginFolderIndex::waitFolderAge()
+{
+    QTest::qSleep(2100);
+}
+
+void TestPluginFolderIndex::recentFolderIsNotIndexed()
+{
+    createFile(pluginPath("a.plugin"));
+
+    PluginFolderIndex index(indexFilePath());
+    QVERIFY(!index.newPluginsDetected(QStringList(scanDir->path()), QStringList(pluginPath("a.plugin"))));
+    QCOMPARE(index.getIndexedFolders(), 0);
+}
+
+void TestPluginFolderIndex::unchangedFolderIsIndexed()
+{
+    createFile(pluginPath("a.plugin"));
+    waitFolderAge();
+
+    PluginFolderIndex index(indexFilePath());
+    QStringList knownPlugins(pluginPath("a.plugin"));
+    QVERIFY(!index.newPluginsDetected(QStringList(scanDir->path()), knownPlugins));
+    QCOMPARE(index.getIndexedFolders(), 1);
+
+    QVERIFY(!index.newPluginsDetected(QStringList(scanDir->path()), knownPlugins));
+    QCOMPARE(index.getIndexedFolders(), 1);
+}
+
+void TestPluginFolderIndex::addedPluginIsDetected()
+{
+    createFile(pluginPath("a.plugin"));
+    waitFolderAge();
+
+    PluginFolderIndex index(indexFilePath());
+    QStringList knownPlugins(pluginPath("a.plugin"));
+    QVERIFY(!index.newPluginsDetected(QStringList(scanDir->path()), knownPlugins));
+
+    createFile(pluginPath("b.plugin"));
+    QVERIFY(index.newPluginsDetected(QStringList(scanDir->path()), knownPlugins));
+    QCOMPARE(index.getIndexedFolders(), 0); // the folder is listed again until the new plugin is known
+
+    QVERIFY(index.newPluginsDetected(QStringList(scanDir->path()), knownPlugins));
+
+    waitFolderAge();
+    knownPlugins.append(pluginPath("b.plugin"));
+    QVERIFY(!index.newPluginsDetected(QStringList(scanDir->path()), knownPlugins));
+    QCOMPARE(index.getIndexedFolders(), 1);
+}
+
+void TestPluginFolderIndex::addedPluginInSubFolderIsDetected()
+{
+    QVERIFY(QDir(scanDir->path()).mkpath("sub/folder"));
+    waitFolderAge();
+
+    PluginFolderIndex index(indexFilePath());
+    QVERIFY(!index.newPluginsDetected(QStringList(scanDir->path()), QStringList()));
+    QCOMPARE(index.getIndexedFolders(), 3);
+
+    // only the sub folder modification time is changed
+    createFile(pluginPath("sub/folder/a.plugin"));
+    QVERIFY(index.newPluginsDetected(QStringList(scanDir->path()), QStringList()));
+    QCOMPARE(index.getIndexedFolders(), 2);
+}
+
+void TestPluginFolderIndex::removedPluginIsNotDetected()
+{
+    createFile(pluginPath("a.plugin"));
+    createFile(pluginPath("b.plugin"));
+    waitFolderAge();
+
+    PluginFolderIndex index(indexFilePath());
+    QStringList knownPlugins;
+    knownPlugins << pluginPath("a.plugin") << pluginPath("b.plugin");
+    QVERIFY(!index.newPluginsDetected(QStringList(scanDir->path()), knownPlugins));
+
+    QVERIFY(QFile::remove(pluginPath("b.plugin")));
+    QVERIFY(!index.newPluginsDetected(QStringList(scanDir->path()), knownPlugins));
+    QCOMPARE(index.getIndexedFolders(), 0); // modified now, indexed again in the next checks
+
+    waitFolderAge();
+    QVERIFY(!index.newPluginsDetected(QStringList(scanDir->path()), knownPlugins));
+    QCOMPARE(index.getIndexedFolders(), 1);
+}
+
+void TestPluginFolderIndex::modifiedPluginIsNotListingTheFolder()
+{
+    createFile(pluginPath("a.plugin"));
+    waitFolderAge();
+
+    PluginFolderIndex index(indexFilePath());
+    QStringList knownPlugins(pluginPath("a.plugin"));
+    QVERIFY(!index.newPluginsDetected(QStringList(scanDir->path()), knownPlugins));
+
+    // writing a file is not changing the folder modification time
+    QDateTime folderModification = QFileInfo(scanDir->path()).lastModified();
+    createFile(pluginPath("a.plugin"), "updated plugin");
+    QCOMPARE(QFileInfo(scanDir->path()).lastModified(), folderModification);
+
+    QVERIFY(!index.newPluginsDetected(QStringList(scanDir->path()), knownPlugins));
+    QCOMPARE(index.getIndexedFolders(), 1);
+}
+
+void TestPluginFolderIndex::forgottenPluginIsDetectedInUnchangedFolder()
+{
+    createFile(pluginPath("a.plugin"));
+    waitFolderAge();
+
+    PluginFolderIndex index(indexFilePath());
+    QVERIFY(!index.newPluginsDetected(QStringList(scanDir->path()), QStringList(pluginPath("a.plugin"))));
+    QCOMPARE(index.getIndexedFolders(), 1);
+
+    // the plugins cache was cleared, the unchanged folder is listed again
+    QVERIFY(index.newPluginsDetected(QStringList(scanDir->path()), QStringList()));
+    QCOMPARE(index.getIndexedFolders(), 0);
+}
+
+void TestPluginFolderIndex::indexIsRestored()
+{
+    createFile(pluginPath("a.plugin"));
+    waitFolderAge();
+
+    QStringList knownPlugins(pluginPath("a.plugin"));
+    {
+        PluginFolderIndex index(indexFilePath());
+        QVERIFY(!index.newPluginsDetected(QStringList(scanDir->path()), knownPlugins));
+    }
+
+    PluginFolderIndex index(indexFilePath());
+    QCOMPARE(index.getIndexedFolders(), 1);
+
+    createFile(pluginPath("b.plugin"));
+    QVERIFY(index.newPluginsDetected(QStringList(scanDir->path()), knownPlugins));
+}
+
+QTEST_MAIN(TestPluginFolderIndex)
+
+#include "tst_PluginFolderIndex.moc"
@@ -0,0 +1,18 @@
+QT += testlib
+QT -= gui
+CONFIG += testcase c++11
+TEMPLATE = app
+TARGET = vst
+INCLUDEPATH += .
+INCLUDEPATH += ../../../src/Common
+INCLUDEPATH += ../../../src/Standalone
+VPATH += ../../../src/Common
+VPATH += ../../../src/Standalone
+
+HEADERS += log/Logging.h
+HEADERS += vst/VstPluginChecker.h
+HEADERS += vst/PluginFolderIndex.h
+
+SOURCES += log/logging.cpp
+SOURCES += vst/PluginFolderIndex.cpp
+SOURCES += tst_PluginFolderIndex.cpp
@@ -5,21 +5,27 @@ TARGET = testChat
 INCLUDEPATH += .
 INCLUDEPATH += ../../../../src/Common
 INCLUDEPATH += ../../../../src/Common/gui
+INCLUDEPATH += ../../../../src/Common/gui/chat
 VPATH += ../../../../src/Common
 
 HEADERS += log/logging.h
-HEADERS += gui/ChatMessagePanel.h
-HEADERS += gui/ChatPanel.h
+HEADERS += gui/chat/ChatMessagesModel.h
+HEADERS += gui/chat/ChatMessageDelegate.h
+HEADERS += gui/chat/ChatPanel.h
 HEADERS += gui/UsersColorsPool.h
 
 SOURCES += log/logging.cpp
-SOURCES += gui/ChatMessagePanel.cpp
-SOURCES += gui/ChatPanel.cpp
+SOURCES += gui/chat/ChatMessagesModel.cpp
+SOURCES += gui/chat/ChatMessageDelegate.cpp
+SOURCES += gui/chat/ChatPanel.cpp
+SOURCES += gui/chords/Chord.cpp
+SOURCES += gui/chords/ChordProgressionMeasure.cpp
+SOURCES += gui/chords/ChordProgression.cpp
+SOURCES += gui/BpiUtils.cpp
 SOURCES += gui/UsersColorsPool.cpp
 
 SOURCES += test_Chat.cpp
 
-FORMS += gui/ChatMessagePanel.ui
-FORMS += gui/ChatPanel.ui
+FORMS += gui/chat/ChatPanel.ui
 
 RESOURCES += resources.qrc
@@ -1,5 +1,4 @@
 #include <QApplication>
-#include "ChatMessagePanel.h"
 #include "ChatPanel.h"
 #include <QDebug>
 #include <QDir>
@@ -24,6 +23,12 @@ int main(int argc, char *argv[])
     chatPanel.addMessage("A_big_user_name_", "A big message text to see if the layout is working ok when users decide chat using long texts :)", true);
     chatPanel.addMessage("Jamtaba", "User XXX leave the room", false);
     chatPanel.addMessage("ninjamers.servebeer.com", "Welcome!", true);
+    chatPanel.addMessage("Linker", "link test http://www.jamtaba.com", true, true);
+    chatPanel.addBpiVoteConfirmationMessage(32, 60);
+
+    // the oldest messages are dropped when the chat is full
+    for (int i = 0; i < 1000; ++i)
+        chatPanel.addMessage("Flooder", QString("message %1").arg(i), true, true);
 
     chatPanel.show();
     chatPanel.setMinimumHeight(600);